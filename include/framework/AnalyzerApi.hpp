@@ -16,8 +16,20 @@
 #include "System.hpp"
 #include "LockedDeque.hpp"
 #include "BinaryStructuredDataEngine.hpp"  // In this header file also defined "BinaryDataEngine.hpp".
+#include "BinaryStructuredDataColumns.hpp"
 #include "Parser.hpp"
+#include "Framer.hpp"
+#include "Resolver.hpp"
+#include "ReceiveBuffer.hpp"
+#include "TimingWheel.hpp"
+#include "CaptureFilter.hpp"
+#include "PacketCapture.hpp"
 #include "Socket.hpp"
+#include "TlsEngine.hpp"
+#include "ConnectionPool.hpp"
+#include "ConnectScanner.hpp"
+#include "TlsScanner.hpp"
+#include "TlsHelloProber.hpp"
 #include "Utilities.hpp"
 #include "Notification.hpp"
 
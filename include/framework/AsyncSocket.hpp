@@ -0,0 +1,400 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_ASYNC_SOCKET_HPP
+#define PROTOCOL_ANALYZER_ASYNC_SOCKET_HPP
+
+#if !defined(__cpp_impl_coroutine)
+#error "AsyncSocket.hpp requires C++20 coroutines: link the target with AnalyzerCoroutines library and set CXX_STANDARD 20."
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <exception>
+#include <coroutine>
+#include <type_traits>
+#include <unordered_map>
+
+#include "Mutex.hpp"
+#include "Socket.hpp"
+
+
+#define DEFAULT_LOOP_WAIT   (-1)  // Waiting time of the event loop if there are no ready coroutines (limited by the deadlines of reactor).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @struct AsyncPromiseBase
+     * @brief Common part of the promises of AsyncTask coroutines.
+     */
+    struct AsyncPromiseBase
+    {
+        // Coroutine which awaits this coroutine.
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        // Awaitable object which transfers the control to the awaiting coroutine at the end.
+        struct FinalAwaiter
+        {
+            bool await_ready(void) const noexcept { return false; }
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend (std::coroutine_handle<Promise> handle) const noexcept { return handle.promise().continuation; }
+            void await_resume(void) const noexcept { }
+        };
+
+        std::suspend_always initial_suspend(void) const noexcept { return { }; }
+        FinalAwaiter final_suspend(void) const noexcept { return { }; }
+        void unhandled_exception(void) const noexcept { std::terminate(); }
+    };
+
+    // Part of the promise which stores the result of coroutine.
+    template <typename Type>
+    struct AsyncPromiseValue : AsyncPromiseBase
+    {
+        Type value = { };
+        void return_value (Type result) noexcept { value = std::move(result); }
+    };
+
+    template <>
+    struct AsyncPromiseValue<void> : AsyncPromiseBase
+    {
+        void return_void(void) const noexcept { }
+    };
+
+
+    /**
+     * @class AsyncTask   AsyncSocket.hpp   "include/framework/AsyncSocket.hpp"
+     * @brief This class defined the lazy coroutine which returns the value of Type to the awaiting coroutine.
+     *
+     * @note Coroutine starts when it is awaited (co_await) or spawned in EventLoop, and resumes the awaiting coroutine at the end.
+     * @note If memory for coroutine cannot be allocated, then the awaiting coroutine obtains the default value of Type.
+     */
+    template <typename Type>
+    class AsyncTask
+    {
+    public:
+        struct promise_type : AsyncPromiseValue<Type>
+        {
+            AsyncTask get_return_object(void) noexcept { return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            static AsyncTask get_return_object_on_allocation_failure(void) noexcept { return AsyncTask(nullptr); }
+        };
+
+        // Awaitable object which starts the coroutine and returns its result.
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready(void) const noexcept { return (handle == nullptr || handle.done() == true); }
+            std::coroutine_handle<> await_suspend (std::coroutine_handle<> awaiting) const noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            Type await_resume(void) const noexcept
+            {
+                if constexpr (std::is_void_v<Type> == false) {
+                    return (handle != nullptr) ? std::move(handle.promise().value) : Type();
+                }
+            }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle = nullptr;
+
+        explicit AsyncTask (std::coroutine_handle<promise_type> coroutine) noexcept : handle(coroutine) { }
+
+    public:
+        AsyncTask (const AsyncTask &) = delete;
+        AsyncTask & operator= (const AsyncTask &) = delete;
+
+        AsyncTask (AsyncTask && other) noexcept : handle(std::exchange(other.handle, nullptr)) { }
+        AsyncTask & operator= (AsyncTask && other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle != nullptr) { handle.destroy(); }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        // Return true if the coroutine is created.
+        inline bool IsValid(void) const noexcept { return (handle != nullptr); }
+
+        Awaiter operator co_await(void) && noexcept { return Awaiter { handle }; }
+
+        ~AsyncTask(void) noexcept
+        {
+            if (handle != nullptr) { handle.destroy(); }
+        }
+    };
+
+
+    /**
+     * @class EventLoop   AsyncSocket.hpp   "include/framework/AsyncSocket.hpp"
+     * @brief This class defined the per-thread event loop which resumes the coroutines by the events of SocketStatePool reactor.
+     *
+     * @note All coroutines and sockets of the event loop are used by the thread of this event loop.
+     *       Only Post and Stop methods may be called from other threads.
+     */
+    class EventLoop
+    {
+    public:
+        /**
+         * @struct Waiter
+         * @brief The coroutine which waits the readiness of socket descriptor.
+         */
+        struct Waiter
+        {
+            // Suspended coroutine.
+            std::coroutine_handle<> handle = nullptr;
+            // Socket descriptor.
+            int32_t fd = INVALID_SOCKET;
+            // Expected socket status (STATUS_READ or STATUS_WRITE).
+            uint16_t expected = 0;
+            // Obtained socket statuses (zero if timeout expired).
+            uint16_t status = 0;
+            // Event loop of waiting.
+            EventLoop * loop = nullptr;
+            // Deadline of waiting in the timing wheel of reactor.
+            WheelTimer timer;
+        };
+
+        /**
+         * @struct WaitAwaiter
+         * @brief Awaitable object which suspends the coroutine until the socket descriptor becomes ready or timeout expires.
+         */
+        struct WaitAwaiter
+        {
+            EventLoop & loop;
+            int32_t fd;
+            int32_t time;
+            Waiter waiter;
+
+            bool await_ready(void) const noexcept { return false; }
+            bool await_suspend (std::coroutine_handle<> handle) noexcept
+            {
+                waiter.handle = handle;
+                return loop.AddWaiter(fd, waiter, time);
+            }
+            uint16_t await_resume(void) const noexcept { return waiter.status; }
+        };
+
+        /**
+         * @struct ScheduleAwaiter
+         * @brief Awaitable object which resumes the coroutine at the next iteration of event loop.
+         */
+        struct ScheduleAwaiter
+        {
+            EventLoop & loop;
+
+            bool await_ready(void) const noexcept { return false; }
+            void await_suspend (std::coroutine_handle<> handle) noexcept { loop.ready.push_back(handle); }
+            void await_resume(void) const noexcept { }
+        };
+
+    private:
+        // Coroutine which starts the spawned task and is destroyed at the end.
+        struct Runner
+        {
+            struct promise_type
+            {
+                Runner get_return_object(void) const noexcept { return { }; }
+                static Runner get_return_object_on_allocation_failure(void) noexcept { return { }; }
+                std::suspend_never initial_suspend(void) const noexcept { return { }; }
+                std::suspend_never final_suspend(void) const noexcept { return { }; }
+                void return_void(void) const noexcept { }
+                void unhandled_exception(void) const noexcept { std::terminate(); }
+            };
+        };
+
+        // Waiters of one socket descriptor.
+        struct Descriptor
+        {
+            Waiter * reader = nullptr;
+            Waiter * writer = nullptr;
+        };
+
+        // Reactor of the thread.
+        SocketStatePool & reactor;
+        // Waiters of socket descriptors.
+        std::unordered_map<int32_t, Descriptor> waiters = { };
+        // Coroutines which are ready for resumption.
+        std::vector<std::coroutine_handle<>> ready = { };
+        // Coroutines which are posted by other threads.
+        std::vector<std::coroutine_handle<>> posted = { };
+        // Mutex value for thread-safe access to posted coroutines.
+        system::LocalMutex mutex = { };
+        // Descriptor of eventfd which wakes the event loop.
+        int32_t wakeup = INVALID_SOCKET;
+        // Number of spawned tasks which are not completed.
+        std::size_t active = 0;
+        // Flag that indicates that the event loop must be stopped.
+        std::atomic<bool> stopped = false;
+
+        EventLoop(void) noexcept;
+
+        // Coroutine which runs the spawned task.
+        Runner Start (AsyncTask<void> /*task*/) noexcept;
+        // Resume the waiter of socket descriptor with the obtained statuses.
+        void Complete (Waiter *& /*waiter*/, uint16_t /*status*/) noexcept;
+        // Resume the waiters of socket descriptors which are ready.
+        void Dispatch (const std::vector<int32_t> & /*descriptors*/) noexcept;
+        // Resume the waiter with expired timeout.
+        static void Expire (void * /*context*/) noexcept;
+        // Return the waiting time of reactor (deadlines of waiters are taken into account by the reactor).
+        int32_t GetWaitingTime(void) noexcept;
+
+    public:
+        EventLoop (EventLoop &&) = delete;
+        EventLoop (const EventLoop &) = delete;
+        EventLoop & operator= (EventLoop &&) = delete;
+        EventLoop & operator= (const EventLoop &) = delete;
+
+        /**
+         * @fn static EventLoop & EventLoop::Instance() noexcept;
+         * @brief Method that returns the event loop of the calling thread.
+         * @return The event loop of the calling thread.
+         */
+        static EventLoop & Instance(void) noexcept;
+
+        /**
+         * @fn void EventLoop::Spawn (AsyncTask<void> &&) noexcept;
+         * @brief Method that adds the task to the event loop.
+         * @param [in] task - Coroutine which is started at the next iteration of event loop.
+         */
+        void Spawn (AsyncTask<void> && /*task*/) noexcept;
+
+        /**
+         * @fn bool EventLoop::Run() noexcept;
+         * @brief Method that resumes the coroutines of event loop until all spawned tasks are completed.
+         * @return True - if all spawned tasks are completed, otherwise - false (event loop is stopped or an error occurred).
+         *
+         * @note Tasks which are not completed stay suspended and continue at the next call of Run method.
+         */
+        bool Run(void) noexcept;
+
+        // Stop the event loop after the current iteration (thread-safe).
+        void Stop(void) noexcept;
+
+        /**
+         * @fn void EventLoop::Post (std::coroutine_handle<>) noexcept;
+         * @brief Method that resumes the coroutine in the thread of event loop (thread-safe).
+         * @param [in] handle - Suspended coroutine.
+         */
+        void Post (std::coroutine_handle<>) noexcept;
+
+        /**
+         * @fn bool EventLoop::AddWaiter (int32_t, Waiter &, int32_t) noexcept;
+         * @brief Method that adds the waiter of socket descriptor.
+         * @param [in] fd - Socket descriptor which is registered in the reactor of the thread.
+         * @param [in,out] waiter - Waiter of socket descriptor.
+         * @param [in] time - Waiting time in milliseconds (negative value - infinite).
+         * @return True - if coroutine must be suspended, otherwise - false (waiter.status contains the result).
+         *
+         * @note This method is called after the operation is failed with EAGAIN, so the saved expected status is reset.
+         */
+        bool AddWaiter (int32_t /*fd*/, Waiter & /*waiter*/, int32_t /*time*/) noexcept;
+
+        // Return the awaitable object which waits until the socket descriptor obtains the status (STATUS_READ or STATUS_WRITE).
+        inline WaitAwaiter Wait (const int32_t fd, const uint16_t status, const int32_t time) noexcept {
+            return WaitAwaiter { *this, fd, time, Waiter { nullptr, fd, status, 0, this, WheelTimer() } };
+        }
+        // Return the awaitable object which resumes the coroutine at the next iteration of event loop.
+        inline ScheduleAwaiter Schedule(void) noexcept { return ScheduleAwaiter { *this }; }
+        // Return the number of spawned tasks which are not completed.
+        inline std::size_t Active(void) const noexcept { return active; }
+
+        ~EventLoop(void) noexcept;
+    };
+
+
+    /**
+     * @class AsyncSocket   AsyncSocket.hpp   "include/framework/AsyncSocket.hpp"
+     * @brief This class defined the coroutine interface of Socket and SocketSSL classes.
+     *
+     * @note Socket must be created in the thread of event loop, so the socket descriptor is registered in its reactor.
+     * @note Socket, AsyncSocket and the data buffers must be valid until the awaited operation is completed.
+     * @note Each operation uses the connection timeout of socket as the waiting time of readiness.
+     */
+    class AsyncSocket
+    {
+    private:
+        // Wrapped socket.
+        Socket & socket;
+        // Event loop of the thread.
+        EventLoop & loop;
+
+        // Wait until the socket is ready for the operation which returned SOCKET_WANT_READ or SOCKET_WANT_WRITE.
+        AsyncTask<bool> WaitFor (int32_t /*want*/) noexcept;
+
+    public:
+        AsyncSocket (AsyncSocket &&) = delete;
+        AsyncSocket (const AsyncSocket &) = delete;
+        AsyncSocket & operator= (AsyncSocket &&) = delete;
+        AsyncSocket & operator= (const AsyncSocket &) = delete;
+
+        explicit AsyncSocket (Socket & sock, EventLoop & eventLoop = EventLoop::Instance()) noexcept
+            : socket(sock), loop(eventLoop)
+        { }
+
+        /**
+         * @fn AsyncTask<bool> AsyncSocket::AsyncConnect (std::string, uint16_t) noexcept;
+         * @brief Method that connects to the external host without blocking the thread.
+         * @param [in] host - Name or IPv4/IPv6 address of external host.
+         * @param [in] port - External port.
+         * @return True - if connection (and SSL handshake for SocketSSL) is established, otherwise - false.
+         *
+         * @note Host name is resolved by ResolverCache and the resolver threads if it is not cached.
+         */
+        AsyncTask<bool> AsyncConnect (std::string /*host*/, uint16_t /*port*/) noexcept;
+
+        // Perform the SSL handshake without blocking the thread (always true for Socket).
+        AsyncTask<bool> AsyncHandshake(void) noexcept;
+
+        /**
+         * @fn AsyncTask<bool> AsyncSocket::AsyncSend (const char *, std::size_t) noexcept;
+         * @brief Method that sends all data without blocking the thread.
+         * @param [in] data - Pointer to data for sending.
+         * @param [in] length - Length of sending data.
+         * @return True - if all data is sent, otherwise - false.
+         */
+        AsyncTask<bool> AsyncSend (const char * /*data*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn AsyncTask<int32_t> AsyncSocket::AsyncRecv (char *, std::size_t) noexcept;
+         * @brief Method that receives the available data without blocking the thread.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @return Number of received bytes (zero if timeout expired or connection is closed) or SOCKET_ERROR.
+         */
+        AsyncTask<int32_t> AsyncRecv (char * /*data*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn AsyncTask<bool> AsyncSocket::AsyncRecv (char *, std::size_t, std::size_t &, Framer &) noexcept;
+         * @brief Method that receives exactly one frame without blocking the thread.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @param [out] obtainLength - Length of received frame.
+         * @param [in,out] framer - Framer which determines the end of frame.
+         * @return True - if frame is received, otherwise - false (socket is closed if framer rejects the data).
+         */
+        AsyncTask<bool> AsyncRecv (char * /*data*/, std::size_t /*length*/, std::size_t & /*obtainLength*/, Framer & /*framer*/) noexcept;
+
+        // Return the wrapped socket.
+        inline Socket & GetSocket(void) noexcept { return socket; }
+        // Return the event loop of socket.
+        inline EventLoop & GetEventLoop(void) noexcept { return loop; }
+
+        ~AsyncSocket(void) = default;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_ASYNC_SOCKET_HPP
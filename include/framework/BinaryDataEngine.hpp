@@ -7,6 +7,7 @@
 #define PROTOCOL_ANALYZER_BINARY_DATA_ENGINE_HPP
 
 #include <map>  // std::pair.
+#include <optional>  // std::optional.
 #include <ostream>  // std::ostream.
 
 #include "System.hpp"  // system::allocMemoryForArray.
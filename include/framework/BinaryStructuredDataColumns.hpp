@@ -0,0 +1,271 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_BINARY_STRUCTURED_DATA_COLUMNS_HPP
+#define PROTOCOL_ANALYZER_BINARY_STRUCTURED_DATA_COLUMNS_HPP
+
+#include "BinaryStructuredDataEngine.hpp"  // types::BinaryStructuredDataEngine, types::DATA_PATTERN_TYPE.
+
+
+namespace analyzer::framework::common::types
+{
+    /**
+     * @struct ColumnStatistics
+     * @brief Structure that contains the statistics of one decoded column.
+     */
+    struct ColumnStatistics
+    {
+        // Count of valid rows which are included in statistics.
+        std::size_t count = 0;
+        // Minimum value in the column.
+        uint64_t minimum = 0;
+        // Maximum value in the column.
+        uint64_t maximum = 0;
+        // Sum of all values in the column (modulo 2^64).
+        uint64_t sum = 0;
+    };
+
+
+    /**
+     * @class BinaryStructuredDataColumns   BinaryStructuredDataColumns.hpp   "include/framework/BinaryStructuredDataColumns.hpp"
+     * @brief Class that decodes a batch of records with the same structure into contiguous per-field arrays of native integers.
+     *
+     * @note Each field of the pattern up to 64 bits is stored in a separate column of the smallest fitting unsigned type.
+     * @note Fields longer than 64 bits are not decoded into columns (use BinaryStructuredDataEngine for them).
+     * @note Records are decoded by blocks of rows, field by field, so the inner loops are fixed-stride scalar gathers with byte swap.
+     * @note No explicit SIMD instructions are used: the simple form of the inner loops only allows the compiler to auto-vectorize them.
+     */
+    class BinaryStructuredDataColumns
+    {
+    private:
+        /**
+         * @var static constexpr std::size_t blockRows;
+         * @brief Count of rows decoded at once by each field (block of records stays in the cache while all fields are decoded).
+         */
+        static constexpr std::size_t blockRows = 256;
+
+        /**
+         * @var uint16_t fieldsCount;
+         * @brief Count of fields in the record layout.
+         */
+        uint16_t fieldsCount = 0;
+        /**
+         * @var std::unique_ptr<std::size_t[]> fieldOffsets;
+         * @brief Array that contains the bit offset of each field and the total bit length of the record as last element.
+         */
+        std::unique_ptr<std::size_t[]> fieldOffsets = nullptr;
+        /**
+         * @var std::unique_ptr<uint8_t[]> columnWidths;
+         * @brief Array that contains the size in bytes of each column element (zero if the field is not decoded).
+         */
+        std::unique_ptr<uint8_t[]> columnWidths = nullptr;
+        /**
+         * @var std::unique_ptr<std::unique_ptr<std::byte[]>[]> columns;
+         * @brief Array of contiguous columns of decoded values.
+         */
+        std::unique_ptr<std::unique_ptr<std::byte[]>[]> columns = nullptr;
+        /**
+         * @var std::unique_ptr<uint8_t[]> validRows;
+         * @brief Array that indicates whether each row was decoded from the record of sufficient length.
+         */
+        std::unique_ptr<uint8_t[]> validRows = nullptr;
+        /**
+         * @var std::size_t recordSize;
+         * @brief Size of one record in bytes.
+         */
+        std::size_t recordSize = 0;
+        /**
+         * @var std::size_t rowsCount;
+         * @brief Count of decoded rows.
+         */
+        std::size_t rowsCount = 0;
+        /**
+         * @var std::size_t rowsCapacity;
+         * @brief Count of rows for which the memory of columns is allocated.
+         */
+        std::size_t rowsCapacity = 0;
+        /**
+         * @var DATA_PATTERN_TYPE patternType;
+         * @brief Unit of measure of the field sizes in the record layout.
+         */
+        DATA_PATTERN_TYPE patternType = PATTERN_BYTES;
+        /**
+         * @var DATA_ENDIAN_TYPE dataEndianType;
+         * @brief Endian type of the fields in decoded records.
+         */
+        DATA_ENDIAN_TYPE dataEndianType = DATA_BIG_ENDIAN;
+
+
+        /**
+         * @fn bool BinaryStructuredDataColumns::Reserve (std::size_t) noexcept;
+         * @brief Method that allocates the memory of all columns for the selected count of rows.
+         * @param [in] rows - Required count of rows.
+         * @return True - if the memory is allocated successfully, otherwise - false.
+         */
+        bool Reserve (std::size_t /*rows*/) noexcept;
+
+        /**
+         * @fn template <typename Address>
+         * void BinaryStructuredDataColumns::DecodeRows (Address, std::size_t) noexcept;
+         * @brief Method that decodes the selected count of records into columns after the last decoded row.
+         * @tparam [in] Address - Type of functor that returns pointer to the record by it's index.
+         * @param [in] address - Functor that returns pointer to the record by it's index (nullptr if the record is invalid).
+         * @param [in] count - Count of records.
+         */
+        template <typename Address>
+        void DecodeRows (Address /*address*/, std::size_t /*count*/) noexcept;
+
+    public:
+        BinaryStructuredDataColumns (BinaryStructuredDataColumns &&) = delete;
+        BinaryStructuredDataColumns (const BinaryStructuredDataColumns &) = delete;
+        BinaryStructuredDataColumns & operator= (BinaryStructuredDataColumns &&) = delete;
+        BinaryStructuredDataColumns & operator= (const BinaryStructuredDataColumns &) = delete;
+
+        /**
+         * @fn BinaryStructuredDataColumns::BinaryStructuredDataColumns() noexcept;
+         * @brief Default constructor of BinaryStructuredDataColumns class.
+         */
+        BinaryStructuredDataColumns(void) noexcept = default;
+
+        /**
+         * @fn BinaryStructuredDataColumns::~BinaryStructuredDataColumns() noexcept;
+         * @brief Default destructor of BinaryStructuredDataColumns class.
+         */
+        ~BinaryStructuredDataColumns(void) noexcept = default;
+
+        /**
+         * @fn bool BinaryStructuredDataColumns::CreateLayout (const uint16_t *, uint16_t, DATA_PATTERN_TYPE, DATA_ENDIAN_TYPE) noexcept;
+         * @brief Method that sets the layout of decoded records and removes all decoded rows.
+         * @param [in] pattern - Array that contains the pattern of records.
+         * @param [in] size - Size of the pattern array.
+         * @param [in] type - Unit of measure of the field sizes in the pattern. Default: PATTERN_BYTES.
+         * @param [in] endian - Endian of the fields in records. Default: DATA_BIG_ENDIAN.
+         * @return True - if the layout is created successfully, otherwise - false.
+         *
+         * @note If the bit-pattern is used then parameter 'endian' is ignored and records are read in network bit order.
+         */
+        bool CreateLayout (const uint16_t * /*pattern*/, uint16_t /*size*/, DATA_PATTERN_TYPE /*type*/ = PATTERN_BYTES, DATA_ENDIAN_TYPE /*endian*/ = DATA_BIG_ENDIAN) noexcept;
+
+        /**
+         * @fn bool BinaryStructuredDataColumns::CreateLayout (const BinaryStructuredDataEngine &) noexcept;
+         * @brief Method that sets the layout of decoded records as in the selected structured data and removes all decoded rows.
+         * @param [in] engine - Const lvalue reference of the BinaryStructuredDataEngine class with required pattern.
+         * @return True - if the layout is created successfully, otherwise - false.
+         */
+        bool CreateLayout (const BinaryStructuredDataEngine & /*engine*/) noexcept;
+
+        /**
+         * @fn std::size_t BinaryStructuredDataColumns::DecodeStream (const std::byte *, std::size_t) noexcept;
+         * @brief Method that decodes the concatenated stream of records and appends them to the columns.
+         * @param [in] stream - Pointer to the stream of records.
+         * @param [in] length - Length of the stream in bytes.
+         * @return Count of decoded records.
+         *
+         * @note Incomplete record at the end of the stream is ignored.
+         */
+        std::size_t DecodeStream (const std::byte * /*stream*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn std::size_t BinaryStructuredDataColumns::DecodeRecords (const std::byte * const *, const std::size_t *, std::size_t) noexcept;
+         * @brief Method that decodes the array of separate records and appends them to the columns.
+         * @param [in] records - Array of pointers to records.
+         * @param [in] lengths - Array of record lengths in bytes.
+         * @param [in] count - Count of records.
+         * @return Count of records that were decoded as valid rows.
+         *
+         * @note Each input record adds one row. If the record is shorter than the layout then the row is zero-filled and marked invalid.
+         */
+        std::size_t DecodeRecords (const std::byte * const * /*records*/, const std::size_t * /*lengths*/, std::size_t /*count*/) noexcept;
+
+        /**
+         * @fn void BinaryStructuredDataColumns::ClearRows() noexcept;
+         * @brief Method that removes all decoded rows without releasing memory.
+         */
+        inline void ClearRows(void) noexcept { rowsCount = 0; }
+
+        /**
+         * @fn inline std::size_t BinaryStructuredDataColumns::RowsCount() const noexcept;
+         * @brief Method that returns the count of decoded rows.
+         * @return Count of decoded rows.
+         */
+        inline std::size_t RowsCount(void) const noexcept { return rowsCount; }
+
+        /**
+         * @fn inline std::size_t BinaryStructuredDataColumns::RecordSize() const noexcept;
+         * @brief Method that returns the size of one record in bytes.
+         * @return Size of one record in bytes.
+         */
+        inline std::size_t RecordSize(void) const noexcept { return recordSize; }
+
+        /**
+         * @fn inline uint16_t BinaryStructuredDataColumns::FieldsCount() const noexcept;
+         * @brief Method that returns the count of fields in the record layout.
+         * @return Count of fields in the record layout.
+         */
+        inline uint16_t FieldsCount(void) const noexcept { return fieldsCount; }
+
+        /**
+         * @fn inline std::size_t BinaryStructuredDataColumns::GetColumnWidth (uint16_t) const noexcept;
+         * @brief Method that returns the size of one element of the selected column in bytes.
+         * @param [in] fieldIndex - Index of field in the record layout.
+         * @return Size of one element in bytes (1, 2, 4, 8) or zero if the column does not exist.
+         */
+        inline std::size_t GetColumnWidth (const uint16_t fieldIndex) const noexcept
+        {
+            return (fieldIndex < fieldsCount) ? columnWidths[fieldIndex] : 0;
+        }
+
+        /**
+         * @fn inline bool BinaryStructuredDataColumns::IsValidRow (std::size_t) const noexcept;
+         * @brief Method that checks that the selected row is decoded from the record of sufficient length.
+         * @param [in] row - Index of row.
+         * @return True - if the row is valid, otherwise - false.
+         */
+        inline bool IsValidRow (const std::size_t row) const noexcept
+        {
+            return (row < rowsCount && validRows[row] != 0);
+        }
+
+        /**
+         * @fn template <typename Type>
+         * const Type * BinaryStructuredDataColumns::GetColumn (uint16_t) const noexcept;
+         * @brief Method that returns the contiguous array of decoded values of the selected field.
+         * @tparam [in] Type - Unsigned integer typename of the column element. MUST be equal to the column width.
+         * @param [in] fieldIndex - Index of field in the record layout.
+         * @return Pointer to the array of RowsCount() elements or nullptr if the column does not exist or type is mismatched.
+         */
+        template <typename Type>
+        const Type * GetColumn (const uint16_t fieldIndex) const noexcept
+        {
+            static_assert(std::is_integral<Type>::value == true && std::is_unsigned<Type>::value == true,
+                          "It is not possible for this method to use type that is not an unsigned integer.");
+
+            if (GetColumnWidth(fieldIndex) != sizeof(Type) || columns == nullptr) { return nullptr; }
+            return reinterpret_cast<const Type*>(columns[fieldIndex].get());
+        }
+
+        /**
+         * @fn std::size_t BinaryStructuredDataColumns::CountOutOfRange (uint16_t, uint64_t, uint64_t) const noexcept;
+         * @brief Method that counts the valid rows in which the value of the selected field is out of the range.
+         * @param [in] fieldIndex - Index of field in the record layout.
+         * @param [in] minimum - Minimum valid value.
+         * @param [in] maximum - Maximum valid value.
+         * @return Count of rows with value out of the range.
+         */
+        std::size_t CountOutOfRange (uint16_t /*fieldIndex*/, uint64_t /*minimum*/, uint64_t /*maximum*/) const noexcept;
+
+        /**
+         * @fn ColumnStatistics BinaryStructuredDataColumns::GetColumnStatistics (uint16_t) const noexcept;
+         * @brief Method that calculates the statistics of the selected field over all valid rows.
+         * @param [in] fieldIndex - Index of field in the record layout.
+         * @return Statistics of the column (zero count if the column does not exist).
+         */
+        ColumnStatistics GetColumnStatistics (uint16_t /*fieldIndex*/) const noexcept;
+    };
+
+}  // namespace types.
+
+
+#endif  // PROTOCOL_ANALYZER_BINARY_STRUCTURED_DATA_COLUMNS_HPP
@@ -22,6 +22,21 @@ namespace analyzer::framework::common::types
 #define STRUCTURED_DATA_HANDLING_MODE   (DATA_MODE_INDEPENDENT | DATA_MODE_SAFE_OPERATOR | DATA_MODE_ALLOCATION | DATA_MODE_OPERATOR_ALIGN_LOW_ORDER)
 
 
+    /**
+     * @enum DATA_PATTERN_TYPE
+     * @brief Unit of measure of the field sizes in the pattern of BinaryStructuredDataEngine class.
+     *
+     * @note The value of each type is equal to the number of bits in one unit of the pattern.
+     * @note Structured data with bit-pattern is stored packed (without alignment of fields to the byte boundary).
+     * @note Structured data with bit-pattern is always stored in DATA_BIG_ENDIAN endian type (network bit order).
+     */
+    enum DATA_PATTERN_TYPE : uint8_t
+    {
+        PATTERN_BITS = 0x01,  // Each element of the pattern defines the size of the field in bits.
+        PATTERN_BYTES = 0x08  // Each element of the pattern defines the size of the field in bytes.
+    };
+
+
     /**
      * @class BinaryStructuredDataEngine   BinaryStructuredDataEngine.hpp   "include/framework/BinaryStructuredDataEngine.hpp"
      * @brief Main class of analyzer framework that contains binary structured data and gives an interface to work with it.
@@ -48,6 +63,18 @@ namespace analyzer::framework::common::types
          * @brief Array that contains the pattern of stored structured data in bits.
          */
         std::unique_ptr<uint16_t[]> dataPattern = nullptr;
+        /**
+         * @var std::unique_ptr<std::size_t[]> fieldOffsets;
+         * @brief Array that contains the bit offset of each field and the total bit length of all fields as last element.
+         *
+         * @note This array is used to find the position of any field in constant time.
+         */
+        std::unique_ptr<std::size_t[]> fieldOffsets = nullptr;
+        /**
+         * @var DATA_PATTERN_TYPE patternType;
+         * @brief Unit of measure of the field sizes in the stored pattern.
+         */
+        DATA_PATTERN_TYPE patternType = PATTERN_BYTES;
         /**
          * @var DATA_ENDIAN_TYPE dataEndianType;
          * @brief Endian type of stored structured data.
@@ -55,6 +82,42 @@ namespace analyzer::framework::common::types
         DATA_ENDIAN_TYPE dataEndianType = BinaryDataEngine::system_endian;
 
 
+        /**
+         * @fn bool BinaryStructuredDataEngine::AssignPattern (const uint16_t *, uint16_t, DATA_PATTERN_TYPE) noexcept;
+         * @brief Method that saves the pattern of structured data and calculates the bit offsets of all fields.
+         * @param [in] pattern - Array that contains the pattern of structured data.
+         * @param [in] size - Size of the pattern array.
+         * @param [in] type - Unit of measure of the field sizes in the pattern.
+         * @return True - if the pattern is saved successfully, otherwise - false.
+         */
+        bool AssignPattern (const uint16_t * /*pattern*/, uint16_t /*size*/, DATA_PATTERN_TYPE /*type*/) noexcept;
+
+        /**
+         * @fn static inline std::size_t BinaryStructuredDataEngine::GetPatternBitLength (const uint16_t *, uint16_t, DATA_PATTERN_TYPE) noexcept;
+         * @brief Method that returns the total length of all fields of the pattern in bits.
+         * @param [in] pattern - Array that contains the pattern of structured data.
+         * @param [in] size - Size of the pattern array.
+         * @param [in] type - Unit of measure of the field sizes in the pattern.
+         * @return Total length of all fields of the pattern in bits.
+         */
+        static inline std::size_t GetPatternBitLength (const uint16_t* const pattern, const uint16_t size, const DATA_PATTERN_TYPE type) noexcept
+        {
+            return static_cast<std::size_t>(std::accumulate(pattern, pattern + size, std::size_t(0))) * type;
+        }
+
+        /**
+         * @fn inline bool BinaryStructuredDataEngine::IsByteAlignedField (uint16_t) const noexcept;
+         * @brief Method that checks that the selected field starts and ends on the byte boundary.
+         * @param [in] fieldIndex - Index of field in structured data.
+         * @return True - if the selected field is aligned to the byte boundary, otherwise - false.
+         *
+         * @attention Before using this method, MUST be checked that the index does not out-of-range.
+         */
+        inline bool IsByteAlignedField (const uint16_t fieldIndex) const noexcept
+        {
+            return (fieldOffsets[fieldIndex] % 8 == 0 && fieldOffsets[fieldIndex + 1] % 8 == 0);
+        }
+
         /**
          * @fn template <uint8_t Mode>
          * std::size_t BinaryStructuredDataEngine::GetBitOffset (const uint16_t, const uint16_t) const noexcept;
@@ -72,13 +135,13 @@ namespace analyzer::framework::common::types
         [[nodiscard]]
         std::size_t GetBitOffset (const uint16_t fieldIndex, const uint16_t bitIndex) const noexcept
         {
-            if (fieldIndex < fieldsCount && bitIndex < dataPattern[fieldIndex] * 8)
+            if (fieldIndex < fieldsCount && bitIndex < GetFieldBitLength(fieldIndex))
             {
-                const std::size_t offset = static_cast<std::size_t>(std::accumulate(dataPattern.get(), dataPattern.get() + fieldIndex, 0)) * 8;
+                const std::size_t offset = fieldOffsets[fieldIndex];
                 if constexpr (Mode == DATA_MODE_INDEPENDENT) { return offset + bitIndex; }
 
                 if (dataEndianType == DATA_BIG_ENDIAN) {
-                    return offset + dataPattern[fieldIndex] * 8 - bitIndex - 1;
+                    return fieldOffsets[fieldIndex + 1] - bitIndex - 1;
                 }
                 // If data endian type is DATA_LITTLE_ENDIAN.
                 return offset + (bitIndex >> 3) * 8 - bitIndex % 8 + 7;
@@ -104,14 +167,23 @@ namespace analyzer::framework::common::types
         ~BinaryStructuredDataEngine(void) noexcept { Reset(); }
 
         /**
-         * @fn BinaryStructuredDataEngine::BinaryStructuredDataEngine (BinaryDataEngine &, const uint16_t *, uint16_t, DATA_ENDIAN_TYPE) noexcept;
+         * @fn BinaryStructuredDataEngine::BinaryStructuredDataEngine (BinaryDataEngine &, const uint16_t *, uint16_t, DATA_ENDIAN_TYPE, DATA_PATTERN_TYPE) noexcept;
          * @brief Constructor of BinaryStructuredDataEngine class with prepared structured data.
          * @param [in] input - Lvalue reference of moved BinaryDataEngine class.
-         * @param [in] pattern - Array that contains the pattern of inputted structure data in bytes.
+         * @param [in] pattern - Array that contains the pattern of inputted structure data.
          * @param [in] size - Size of the pattern array.
          * @param [in] endian - Endian of stored structured data. Default: Local System Type (DATA_SYSTEM_ENDIAN).
+         * @param [in] type - Unit of measure of the field sizes in the pattern. Default: PATTERN_BYTES.
+         *
+         * @note If the bit-pattern is used then the endian of stored structured data is always DATA_BIG_ENDIAN.
+         *
+         * @attention Need to check existence of data after use this constructor.
          */
-        BinaryStructuredDataEngine (BinaryDataEngine & /*input*/, const uint16_t * /*pattern*/, uint16_t /*size*/, DATA_ENDIAN_TYPE endian = BinaryDataEngine::system_endian) noexcept;
+        BinaryStructuredDataEngine (BinaryDataEngine & /*input*/,
+                                    const uint16_t *   /*pattern*/,
+                                    uint16_t           /*size*/,
+                                    DATA_ENDIAN_TYPE   /*endian*/ = BinaryDataEngine::system_endian,
+                                    DATA_PATTERN_TYPE  /*type*/   = PATTERN_BYTES) noexcept;
 
         /**
          * @fn BinaryStructuredDataEngine::BinaryStructuredDataEngine (const BinaryStructuredDataEngine &) noexcept;
@@ -131,40 +203,41 @@ namespace analyzer::framework::common::types
 
         /**
          * @fn template <DATA_ENDIAN_TYPE Endian, typename Type>
-         * bool BinaryStructuredDataEngine::AssignData (const Type *, const uint16_t * const, const uint16_t) noexcept;
+         * bool BinaryStructuredDataEngine::AssignData (const Type *, const uint16_t * const, const uint16_t, const DATA_PATTERN_TYPE) noexcept;
          * @brief Method that assign binary data into internal state of structured data.
          * @tparam [in] Endian - Endian of input data. Default: Local System Type (DATA_SYSTEM_ENDIAN).
          * @tparam [in] Type - Typename of copied structured data.
          * @tparam [in] memory - POD type structure for assignment.
-         * @param [in] pattern - Array that contains the byte-pattern of inputted structured data.
+         * @param [in] pattern - Array that contains the pattern of inputted structured data.
          * @param [in] size - Size of the pattern array.
+         * @param [in] type - Unit of measure of the field sizes in the pattern. Default: PATTERN_BYTES.
          * @return True - if data assignment is successful, otherwise - false.
          *
          * @note Input type MUST be a POD type.
+         * @note If the bit-pattern is used then input data MUST be packed in network bit order and parameter 'Endian' is ignored.
          */
         template <DATA_ENDIAN_TYPE Endian = DATA_SYSTEM_ENDIAN, typename Type>
-        bool AssignData (const Type* memory, const uint16_t* const pattern, const uint16_t size) noexcept
+        bool AssignData (const Type* memory, const uint16_t* const pattern, const uint16_t size, const DATA_PATTERN_TYPE type = PATTERN_BYTES) noexcept
         {
             static_assert(is_pod_type<Type>::value == true, "It is not possible to use not POD type for this method.");
             if (memory == nullptr) { return false; }
 
-            const std::size_t bytes = static_cast<std::size_t>(std::accumulate(pattern, pattern + size, 0));
+            // Packed bit-pattern may contain several unused low-order bits in the last byte.
+            const std::size_t bytes = (GetPatternBitLength(pattern, size, type) + 7) / 8;
             if (bytes != sizeof(Type)) { return false; }
 
             data = BinaryDataEngine(bytes, STRUCTURED_DATA_HANDLING_MODE, DATA_BIG_ENDIAN);
             if (data == false) { return false; }
 
-            if (data.AssignData(memory, 1) == false) {
+            if (data.AssignData(memory, 1) == false || AssignPattern(pattern, size, type) == false) {
                 Clear();
                 return false;
             }
 
-            dataPattern = system::allocMemoryForArray<uint16_t>(size, pattern, size * sizeof(uint16_t));
-            if (dataPattern == nullptr) {
-                Clear();
-                return false;
+            if (type == PATTERN_BITS) {
+                dataEndianType = DATA_BIG_ENDIAN;
+                return true;
             }
-            fieldsCount = size;
 
             const DATA_ENDIAN_TYPE inputEndian = (Endian == DATA_SYSTEM_ENDIAN) ? BinaryDataEngine::system_endian : Endian;
             if (inputEndian != dataEndianType) {
@@ -177,13 +250,54 @@ namespace analyzer::framework::common::types
         }
 
         /**
-         * @fn bool BinaryStructuredDataEngine::CreateTemplate (const uint16_t *, uint16_t) noexcept;
+         * @fn bool BinaryStructuredDataEngine::CreateTemplate (const uint16_t *, uint16_t, DATA_PATTERN_TYPE) noexcept;
          * @brief Method that creates empty structured data template.
-         * @param [in] pattern - Array that contains the byte-pattern of inputted structured data.
-         * @param [in] size - Size of the byte-pattern array.
+         * @param [in] pattern - Array that contains the pattern of inputted structured data.
+         * @param [in] size - Size of the pattern array.
+         * @param [in] type - Unit of measure of the field sizes in the pattern. Default: PATTERN_BYTES.
          * @return True - if creating the data structure template successfully, otherwise - false.
+         *
+         * @note If the bit-pattern is used then the fields are stored packed and the endian type is changed to DATA_BIG_ENDIAN.
          */
-        bool CreateTemplate (const uint16_t * /*pattern*/, uint16_t /*size*/) noexcept;
+        bool CreateTemplate (const uint16_t * /*pattern*/, uint16_t /*size*/, DATA_PATTERN_TYPE /*type*/ = PATTERN_BYTES) noexcept;
+
+        /**
+         * @fn inline DATA_PATTERN_TYPE BinaryStructuredDataEngine::PatternType() const noexcept;
+         * @brief Method that returns the unit of measure of the field sizes in the stored pattern.
+         * @return PATTERN_BITS(0x01) - if the stored pattern is bit-pattern, otherwise - PATTERN_BYTES(0x08).
+         */
+        inline DATA_PATTERN_TYPE PatternType(void) const noexcept { return patternType; }
+
+        /**
+         * @fn inline uint16_t BinaryStructuredDataEngine::FieldsCount() const noexcept;
+         * @brief Method that returns the count of fields in stored structured data.
+         * @return Count of fields in stored structured data.
+         */
+        inline uint16_t FieldsCount(void) const noexcept { return fieldsCount; }
+
+        /**
+         * @fn inline std::size_t BinaryStructuredDataEngine::GetFieldBitOffset (uint16_t) const noexcept;
+         * @brief Method that returns the offset of the first bit of selected field in stored structured data.
+         * @param [in] fieldIndex - Index of field in structured data.
+         * @return Bit offset of selected field or 'BinaryDataEngine::npos' if selected index is out-of-range.
+         *
+         * @note The resulting bit offset is obtained in DATA_MODE_INDEPENDENT handling mode.
+         */
+        inline std::size_t GetFieldBitOffset (const uint16_t fieldIndex) const noexcept
+        {
+            return (fieldIndex < fieldsCount) ? fieldOffsets[fieldIndex] : BinaryDataEngine::npos;
+        }
+
+        /**
+         * @fn inline std::size_t BinaryStructuredDataEngine::GetFieldBitLength (uint16_t) const noexcept;
+         * @brief Method that returns the length of selected field in bits.
+         * @param [in] fieldIndex - Index of field in structured data.
+         * @return Length of selected field in bits or zero if selected index is out-of-range.
+         */
+        inline std::size_t GetFieldBitLength (const uint16_t fieldIndex) const noexcept
+        {
+            return (fieldIndex < fieldsCount) ? fieldOffsets[fieldIndex + 1] - fieldOffsets[fieldIndex] : 0;
+        }
 
         /**
          * @fn inline DATA_ENDIAN_TYPE BinaryStructuredDataEngine::DataEndianType() const noexcept;
@@ -225,23 +339,24 @@ namespace analyzer::framework::common::types
          * @return True - if value assignment is successful, otherwise - false.
          *
          * @note Input type MUST be a POD type.
+         * @note If the bit-pattern is used then the selected field MUST be aligned to the byte boundary.
          */
         template <DATA_ENDIAN_TYPE Endian = DATA_SYSTEM_ENDIAN, typename Type>
         bool SetField (const uint16_t fieldIndex, const Type value) const noexcept
         {
             static_assert(is_pod_type<Type>::value == true, "It is not possible to use not POD type for this method.");
 
-            if (fieldIndex < fieldsCount && sizeof(Type) == dataPattern[fieldIndex])
+            if (fieldIndex < fieldsCount && sizeof(Type) * 8 == GetFieldBitLength(fieldIndex) && IsByteAlignedField(fieldIndex) == true)
             {
                 BinaryDataEngine sequence(DATA_MODE_DEFAULT, (Endian == DATA_SYSTEM_ENDIAN) ? BinaryDataEngine::system_endian : Endian);
                 if (sequence.AssignData<Type>(&value, 1) == false) { return false; }
                 sequence.SetDataEndianType(dataEndianType);  // Change data endian type to internal endian format.
 
-                // Calculate byte offset to start byte in selected field.
-                const std::size_t offset = static_cast<std::size_t>(std::accumulate(dataPattern.get(), dataPattern.get() + fieldIndex, 0));
+                // Get byte offset to start byte in selected field.
+                const std::size_t offset = fieldOffsets[fieldIndex] / 8;
 
                 // Copy new field value.
-                for (std::size_t idx = 0; idx < dataPattern[fieldIndex]; ++idx) {
+                for (std::size_t idx = 0; idx < sizeof(Type); ++idx) {
                     *data.GetAt(offset + idx) = *sequence.GetAt(idx);
                 }
                 return true;
@@ -258,17 +373,19 @@ namespace analyzer::framework::common::types
          * @param [in] fieldIndex - Index of field in structured data.
          * @return Field value under selected index in BinaryDataEngine format in specified data handling and endian types.
          *
+         * @note If the bit-pattern is used then the selected field MUST be aligned to the byte boundary (use GetBitField method otherwise).
+         *
          * @attention Need to check existence of data after use this method.
          */
         template <uint8_t Mode = DATA_MODE_DEFAULT, DATA_ENDIAN_TYPE Endian = DATA_SYSTEM_ENDIAN>
         BinaryDataEngine GetField (const uint16_t fieldIndex) const noexcept
         {
-            if (fieldIndex < fieldsCount)
+            if (fieldIndex < fieldsCount && IsByteAlignedField(fieldIndex) == true)
             {
                 // Get index of first byte of selected field (Not consider the type of endian in which data are presented).
-                const std::size_t byteIndex = static_cast<std::size_t>(std::accumulate(dataPattern.get(), dataPattern.get() + fieldIndex, 0));
+                const std::size_t byteIndex = fieldOffsets[fieldIndex] / 8;
                 BinaryDataEngine result(Mode, dataEndianType);
-                if (result.AssignData(data.Data() + byteIndex, data.Data() + byteIndex + dataPattern[fieldIndex]) == true)
+                if (result.AssignData(data.Data() + byteIndex, data.Data() + fieldOffsets[fieldIndex + 1] / 8) == true)
                 {
                     // Change data endian type to specified output endian format.
                     result.SetDataEndianType((Endian == DATA_SYSTEM_ENDIAN) ? BinaryDataEngine::system_endian : Endian);
@@ -295,7 +412,7 @@ namespace analyzer::framework::common::types
                           std::is_default_constructible<Type>::value == true,
                           "It is not possible for this method to use type without binary operators and default constructor.");
 
-            if (fieldIndex < fieldsCount && bitIndex + length - 1 < dataPattern[fieldIndex] * 8 && length <= sizeof(Type) * 8)
+            if (fieldIndex < fieldsCount && static_cast<std::size_t>(bitIndex) + length - 1 < GetFieldBitLength(fieldIndex) && length <= sizeof(Type) * 8)
             {
                 Type result = { };
                 for (uint16_t idx = 0; idx < length; ++idx)
@@ -310,6 +427,113 @@ namespace analyzer::framework::common::types
             return Type();
         }
 
+        /**
+         * @fn template <typename Type>
+         * Type BinaryStructuredDataEngine::GetBitField (const uint16_t) const noexcept;
+         * @brief Method that extracts the value of selected field of structured data as native unsigned integer.
+         * @tparam [in] Type - Unsigned integer typename to which the field value will be converted.
+         * @param [in] fieldIndex - Index of field in structured data.
+         * @return Value of the selected field in native format or zero if an error occurred.
+         *
+         * @note This method reads the field by whole bytes and works for fields of any size up to the size of output type.
+         * @note For packed bit-pattern the field value is read in network bit order (from high to low order).
+         */
+        template <typename Type>
+        Type GetBitField (const uint16_t fieldIndex) const noexcept
+        {
+            static_assert(std::is_integral<Type>::value == true && std::is_unsigned<Type>::value == true && sizeof(Type) <= sizeof(uint64_t),
+                          "It is not possible for this method to use type that is not an unsigned integer.");
+
+            const std::size_t length = GetFieldBitLength(fieldIndex);
+            if (length == 0 || length > sizeof(Type) * 8) { return Type(); }
+
+            const std::byte* const memory = data.Data();
+            const std::size_t offset = fieldOffsets[fieldIndex];
+            uint64_t result = 0;
+
+            // In this case the field is aligned to the byte boundary and stored from low to high order.
+            if (dataEndianType == DATA_LITTLE_ENDIAN)
+            {
+                for (std::size_t idx = fieldOffsets[fieldIndex + 1] / 8; idx > offset / 8; --idx) {
+                    result = (result << 8) | std::to_integer<uint64_t>(memory[idx - 1]);
+                }
+                return static_cast<Type>(result);
+            }
+
+            const std::size_t first = offset / 8;
+            const std::size_t last = (offset + length - 1) / 8;
+            const std::size_t tail = 7 - (offset + length - 1) % 8;  // Count of unused low-order bits in the last byte.
+
+            result = std::to_integer<uint64_t>(memory[first]) & (0xFFU >> (offset % 8));
+            if (first == last) {
+                return static_cast<Type>(result >> tail);
+            }
+
+            for (std::size_t idx = first + 1; idx < last; ++idx) {
+                result = (result << 8) | std::to_integer<uint64_t>(memory[idx]);
+            }
+            result = (result << (8 - tail)) | (std::to_integer<uint64_t>(memory[last]) >> tail);
+            return static_cast<Type>(result);
+        }
+
+        /**
+         * @fn template <typename Type>
+         * bool BinaryStructuredDataEngine::SetBitField (const uint16_t, const Type) const noexcept;
+         * @brief Method that inserts the native unsigned integer value into the selected field of structured data.
+         * @tparam [in] Type - Unsigned integer typename of the inserted value.
+         * @param [in] fieldIndex - Index of field in structured data.
+         * @param [in] value - Field value in native format. High-order bits that do not fit in the field are ignored.
+         * @return True - if value insertion is successful, otherwise - false.
+         *
+         * @note This method writes the field by whole bytes and does not change the neighboring fields.
+         * @note For packed bit-pattern the field value is written in network bit order (from high to low order).
+         */
+        template <typename Type>
+        bool SetBitField (const uint16_t fieldIndex, const Type value) const noexcept
+        {
+            static_assert(std::is_integral<Type>::value == true && std::is_unsigned<Type>::value == true && sizeof(Type) <= sizeof(uint64_t),
+                          "It is not possible for this method to use type that is not an unsigned integer.");
+
+            const std::size_t length = GetFieldBitLength(fieldIndex);
+            if (length == 0 || length > sizeof(uint64_t) * 8) { return false; }
+
+            std::byte* const memory = data.data.get();
+            const std::size_t offset = fieldOffsets[fieldIndex];
+            uint64_t rest = static_cast<uint64_t>(value);
+
+            // In this case the field is aligned to the byte boundary and stored from low to high order.
+            if (dataEndianType == DATA_LITTLE_ENDIAN)
+            {
+                for (std::size_t idx = offset / 8; idx < fieldOffsets[fieldIndex + 1] / 8; ++idx) {
+                    memory[idx] = static_cast<std::byte>(rest & 0xFFU);
+                    rest >>= 8;
+                }
+                return true;
+            }
+
+            const std::size_t first = offset / 8;
+            const std::size_t last = (offset + length - 1) / 8;
+            const std::size_t tail = 7 - (offset + length - 1) % 8;  // Count of unused low-order bits in the last byte.
+
+            const auto headMask = static_cast<std::byte>(0xFFU >> (offset % 8));
+            const auto tailMask = static_cast<std::byte>((0xFFU << tail) & 0xFFU);
+            if (first == last)
+            {
+                const std::byte mask = headMask & tailMask;
+                memory[first] = (memory[first] & ~mask) | (static_cast<std::byte>((rest << tail) & 0xFFU) & mask);
+                return true;
+            }
+
+            memory[last] = (memory[last] & ~tailMask) | (static_cast<std::byte>((rest << tail) & 0xFFU) & tailMask);
+            rest >>= (8 - tail);
+            for (std::size_t idx = last - 1; idx > first; --idx) {
+                memory[idx] = static_cast<std::byte>(rest & 0xFFU);
+                rest >>= 8;
+            }
+            memory[first] = (memory[first] & ~headMask) | (static_cast<std::byte>(rest & 0xFFU) & headMask);
+            return true;
+        }
+
         /**
          * @fn BinaryDataEngine BinaryStructuredDataEngine::GetFieldByReference (uint16_t) const noexcept;
          * @brief Method that returns field value of structured data under selected index by reference.
@@ -317,6 +541,7 @@ namespace analyzer::framework::common::types
          * @return Field value under selected index with referenced data in BinaryDataEngine format.
          *
          * @note The field reference value is always returns in internal data endian type and DATA_MODE_DEFAULT data handling mode.
+         * @note If the bit-pattern is used then the selected field MUST be aligned to the byte boundary.
          *
          * @attention Need to check existence of data after use this method.
          */
@@ -335,7 +560,7 @@ namespace analyzer::framework::common::types
         template <uint8_t Mode = DATA_MODE_DEPENDENT>
         bool SetFieldBit (const uint16_t fieldIndex, const uint16_t bitIndex, const bool value = true) const noexcept
         {
-            if (fieldIndex < fieldsCount && bitIndex < dataPattern[fieldIndex] * 8)
+            if (fieldIndex < fieldsCount && bitIndex < GetFieldBitLength(fieldIndex))
             {
                 const std::size_t bitOffset = GetBitOffset<Mode>(fieldIndex, bitIndex);
                 if (bitOffset != BinaryDataEngine::npos) {
@@ -360,7 +585,7 @@ namespace analyzer::framework::common::types
         template <uint8_t Mode = DATA_MODE_DEPENDENT>
         bool GetFieldBit (const uint16_t fieldIndex, const uint16_t bitIndex) const noexcept
         {
-            if (fieldIndex < fieldsCount && bitIndex < dataPattern[fieldIndex] * 8)
+            if (fieldIndex < fieldsCount && bitIndex < GetFieldBitLength(fieldIndex))
             {
                 const std::size_t bitOffset = GetBitOffset<Mode>(fieldIndex, bitIndex);
                 if (bitOffset != BinaryDataEngine::npos) {
@@ -387,9 +612,11 @@ namespace analyzer::framework::common::types
 
         /**
          * @fn std::pair<uint16_t, const uint16_t *> BinaryStructuredDataEngine::GetPattern (uint16_t) const noexcept;
-         * @brief Method that returns the internal byte-pattern with length from the specified position.
-         * @param [in] fieldIndex - Index of field from which the internal byte-pattern will be returned. Default: 0.
-         * @return Internal byte-pattern with it's length from the specified position or nullptr if an error occurred.
+         * @brief Method that returns the internal pattern with length from the specified position.
+         * @param [in] fieldIndex - Index of field from which the internal pattern will be returned. Default: 0.
+         * @return Internal pattern with it's length from the specified position or nullptr if an error occurred.
+         *
+         * @note The unit of measure of the returned pattern is defined by PatternType() method.
          */
         std::pair<uint16_t, const uint16_t *> GetPattern (uint16_t /*fieldIndex*/ = 0) const noexcept;
 
@@ -471,7 +698,7 @@ namespace analyzer::framework::common::types
                         {
                             if (idx % 8 == 0 && blockBitCount != 0) { stream << ' '; }
                             stream << engine.data.BitsTransform().Test(idx);
-                            if (++blockBitCount == engine.dataPattern[patternBlock] * 8) {
+                            if (++blockBitCount == engine.GetFieldBitLength(patternBlock)) {
                                 if (++patternBlock == engine.fieldsCount) { break; }
                                 stream << "    ";
                                 blockBitCount = 0;
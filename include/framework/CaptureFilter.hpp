@@ -0,0 +1,127 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_CAPTURE_FILTER_HPP
+#define PROTOCOL_ANALYZER_CAPTURE_FILTER_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <sys/socket.h>
+#include <linux/filter.h>
+
+
+#define CAPTURE_FILTER_SNAPLEN       262144  // Number of bytes of frame which are accepted by filter.
+#define MAXIMUM_FILTER_INSTRUCTIONS  4096    // Maximum number of instructions of classic BPF program (BPF_MAXINSNS).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @class CaptureFilter   CaptureFilter.hpp   "include/framework/CaptureFilter.hpp"
+     * @brief This class defined the compiler of target predicates into classic BPF program and its interpreter.
+     *
+     * @note Program accepts the Ethernet frame if it matches any target. Target matches by the source or destination address and port.
+     * @note The same program is attached to the capture socket for filtering in kernel and is interpreted in user space for offline replay.
+     */
+    class CaptureFilter
+    {
+    private:
+        // Predicate of one target.
+        struct Target
+        {
+            // Family of address (AF_INET, AF_INET6 or AF_UNSPEC for any address).
+            int32_t family = AF_UNSPEC;
+            // Address of target in network byte order.
+            uint8_t address[16] = { };
+            // Port of target (zero - any port).
+            uint16_t port = 0;
+            // Transport protocol (IPPROTO_TCP, IPPROTO_UDP or zero for any protocol).
+            uint8_t protocol = 0;
+        };
+
+        // Predicates of targets.
+        std::vector<Target> targets = { };
+        // Compiled program.
+        std::vector<struct sock_filter> program = { };
+
+        // Add the block of instructions which checks the target in IPv4 or IPv6 packet.
+        void CompileTarget (const Target & /*target*/, int32_t /*family*/) noexcept;
+
+    public:
+        CaptureFilter(void) = default;
+        CaptureFilter (CaptureFilter &&) = default;
+        CaptureFilter (const CaptureFilter &) = default;
+        CaptureFilter & operator= (CaptureFilter &&) = default;
+        CaptureFilter & operator= (const CaptureFilter &) = default;
+
+        /**
+         * @fn bool CaptureFilter::AddTarget (std::string_view, uint16_t, uint8_t) noexcept;
+         * @brief Method that adds the predicate of target to the filter.
+         * @param [in] host - IPv4/IPv6 address or name of target (empty - any address).
+         * @param [in] port - Port of target (zero - any port).
+         * @param [in] protocol - Transport protocol (IPPROTO_TCP, IPPROTO_UDP or zero - any protocol). Default: 0.
+         * @return True - if target is added, otherwise - false.
+         *
+         * @note Name of target is resolved by ResolverCache, and all its addresses are added.
+         * @note Filter must be compiled again after the change of targets.
+         */
+        bool AddTarget (std::string_view /*host*/, uint16_t /*port*/, uint8_t /*protocol*/ = 0) noexcept;
+
+        /**
+         * @fn std::size_t CaptureFilter::LoadDefinition (std::string_view) noexcept;
+         * @brief Method that adds the targets from the protocol definition file.
+         * @param [in] path - Path to ProtocolDefinition.json file.
+         * @return Number of added targets (zero - if any target is not added).
+         *
+         * @note Targets are read from Protocol.NetworkSettings.Target (object or array), the protocol is read from Protocol.NetworkSettings.Global.Transport.
+         * @note Host and Transport may contain the alternatives separated by '/'. Target is added if any alternative of its host is added.
+         */
+        std::size_t LoadDefinition (std::string_view /*path*/) noexcept;
+
+        /**
+         * @fn bool CaptureFilter::Compile() noexcept;
+         * @brief Method that compiles the predicates of targets into classic BPF program.
+         * @return True - if program is compiled, otherwise - false.
+         *
+         * @note Filter without targets is not compiled because its program would accept all frames.
+         */
+        bool Compile(void) noexcept;
+
+        /**
+         * @fn bool CaptureFilter::Attach (int32_t) const noexcept;
+         * @brief Method that attaches the compiled program to the socket.
+         * @param [in] fd - Descriptor of socket.
+         * @return True - if program is attached, otherwise - false.
+         */
+        bool Attach (int32_t /*fd*/) const noexcept;
+
+        /**
+         * @fn uint32_t CaptureFilter::Run (const std::byte *, uint32_t) const noexcept;
+         * @brief Method that interprets the compiled program in user space.
+         * @param [in] packet - Captured frame.
+         * @param [in] length - Length of frame.
+         * @return Number of accepted bytes of frame (zero - frame is rejected).
+         *
+         * @note Interpreter follows the kernel semantics: loads out of frame and division by zero reject the frame.
+         */
+        uint32_t Run (const std::byte * /*packet*/, uint32_t /*length*/) const noexcept;
+
+        // Return the compiled program.
+        inline const std::vector<struct sock_filter> & GetProgram(void) const noexcept { return program; }
+        // Return the number of targets.
+        inline std::size_t Size(void) const noexcept { return targets.size(); }
+
+        // Remove all targets and the compiled program.
+        void Clear(void) noexcept;
+
+        ~CaptureFilter(void) = default;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_CAPTURE_FILTER_HPP
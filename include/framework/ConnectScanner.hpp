@@ -0,0 +1,191 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_CONNECT_SCANNER_HPP
+#define PROTOCOL_ANALYZER_CONNECT_SCANNER_HPP
+
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <string_view>
+#include <unordered_map>
+
+#include "Parser.hpp"
+#include "Socket.hpp"
+
+
+#define DEFAULT_SCAN_IN_FLIGHT      1024  // Maximum number of connection attempts at the same time.
+#define DEFAULT_SCAN_ATTEMPT_TIME   1500  // Time of one connection attempt (milli sec.).
+#define DEFAULT_SCAN_RATE           0     // Maximum number of connection attempts per second (zero is unlimited).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @enum PORT_STATE
+     * @brief The result of connection attempt to the port.
+     */
+    enum PORT_STATE : uint8_t
+    {
+        PORT_OPEN = 0,      // Connection is established.
+        PORT_CLOSED = 1,    // Connection is refused by external host.
+        PORT_FILTERED = 2,  // No any answer during the attempt or the host is unreachable.
+        PORT_ERROR = 3      // Local error of connection attempt.
+    };
+
+    /**
+     * @struct ScanResult   ConnectScanner.hpp   "include/framework/ConnectScanner.hpp"
+     * @brief Structure that contains the result of one connection attempt.
+     */
+    struct ScanResult
+    {
+        // Name or address of external host as it was added to scanner.
+        std::string_view host;
+        // Scanned port.
+        uint16_t port;
+        // Result of connection attempt.
+        PORT_STATE state;
+        // Error code of connection attempt (zero for open port).
+        int32_t error;
+        // Duration of connection attempt.
+        std::chrono::microseconds latency;
+    };
+
+    /**
+      * @typedef void (*ScanResultHandler) (const ScanResult &, void *) noexcept;
+      * @brief The type of the handler which obtains the results of scanning as soon as they are known.
+      */
+    using ScanResultHandler = void (*) (const ScanResult &, void *) noexcept;
+
+
+    /**
+     * @class ConnectScanner   ConnectScanner.hpp   "include/framework/ConnectScanner.hpp"
+     * @brief This class defined the engine which scans the ports of external hosts by non-blocking TCP connections.
+     *
+     * @note All connection attempts are driven by the reactor of the calling thread, so one thread keeps thousands of attempts in flight.
+     * @note Completion of the attempt is confirmed by SO_ERROR value after the socket becomes writable.
+     * @note The number of attempts in flight, the time of each attempt and the rate of new attempts are limited.
+     * @note Sockets are closed by RST, so the scanner does not leave connections in TIME_WAIT state.
+     */
+    class ConnectScanner
+    {
+        using clock = std::chrono::steady_clock;
+
+    private:
+        /**
+         * @struct Target
+         * @brief Structure that contains the external host and the ports which are not scanned yet.
+         */
+        struct Target
+        {
+            // Name or address of external host.
+            std::string host = { };
+            // Sequence of ports listed through a separator (it is used by ports parser).
+            std::string ports = { };
+            // Resolved address of external host.
+            SocketAddress address = { };
+            // Parser which returns the next port.
+            std::unique_ptr<parser::PortsParser> parser = nullptr;
+        };
+
+        /**
+         * @struct Attempt
+         * @brief Structure that contains the state of connection attempt in flight.
+         */
+        struct Attempt
+        {
+            // Index of target.
+            std::size_t target = 0;
+            // Scanned port.
+            uint16_t port = 0;
+            // Time when the attempt was started.
+            clock::time_point start = { };
+        };
+
+        // Maximum number of attempts in flight.
+        uint32_t maximumInFlight = DEFAULT_SCAN_IN_FLIGHT;
+        // Time of one attempt.
+        std::chrono::milliseconds attemptTime = std::chrono::milliseconds(DEFAULT_SCAN_ATTEMPT_TIME);
+        // Maximum number of new attempts per second.
+        uint32_t rate = DEFAULT_SCAN_RATE;
+        // Targets for scanning.
+        std::vector<std::unique_ptr<Target>> targets = { };
+        // Index of the target which gives the next port.
+        std::size_t currentTarget = 0;
+        // Attempts in flight by socket descriptors.
+        std::unordered_map<int32_t, Attempt> attempts = { };
+        // Socket descriptors in the order of start of attempts (the deadlines are in the same order).
+        std::deque<std::pair<int32_t, clock::time_point>> deadlines = { };
+        // Number of finished attempts.
+        std::size_t finished = 0;
+        // Flag that stops the scanning.
+        std::atomic<bool> stopped = false;
+
+        // Returns the next port for scanning or false if all ports are scanned.
+        bool NextPort (std::size_t & /*target*/, uint16_t & /*port*/) noexcept;
+        // Starts the connection attempt (returns false if the attempt should be repeated later).
+        bool Start (SocketStatePool & /*reactor*/, std::size_t /*target*/, uint16_t /*port*/, ScanResultHandler /*handler*/, void * /*context*/) noexcept;
+        // Finishes the connection attempt and reports its result.
+        void Finish (SocketStatePool & /*reactor*/, int32_t /*fd*/, int32_t /*error*/, ScanResultHandler /*handler*/, void * /*context*/) noexcept;
+
+    public:
+        ConnectScanner (ConnectScanner &&) = delete;
+        ConnectScanner (const ConnectScanner &) = delete;
+        ConnectScanner & operator= (ConnectScanner &&) = delete;
+        ConnectScanner & operator= (const ConnectScanner &) = delete;
+
+        /**
+         * @fn explicit ConnectScanner::ConnectScanner (uint32_t, uint32_t, uint32_t) noexcept;
+         * @brief Constructor of ConnectScanner class.
+         * @param [in] inFlight - Maximum number of attempts in flight. Default: DEFAULT_SCAN_IN_FLIGHT.
+         * @param [in] time - Time of one attempt in milliseconds. Default: DEFAULT_SCAN_ATTEMPT_TIME.
+         * @param [in] attemptsRate - Maximum number of new attempts per second (zero is unlimited). Default: DEFAULT_SCAN_RATE.
+         */
+        explicit ConnectScanner (uint32_t /*inFlight*/ = DEFAULT_SCAN_IN_FLIGHT,
+                                 uint32_t /*time*/ = DEFAULT_SCAN_ATTEMPT_TIME,
+                                 uint32_t /*attemptsRate*/ = DEFAULT_SCAN_RATE) noexcept;
+
+        /**
+         * @fn bool ConnectScanner::AddTarget (const char *, std::string_view, int32_t) noexcept;
+         * @brief Method that adds the external host and its ports for scanning.
+         * @param [in] host - Name or address of external host.
+         * @param [in] ports - Sequence of ports in the format of PortsParser (for example: 22,80,1000-2000).
+         * @param [in] family - Family of address (AF_INET, AF_INET6). Default: AF_INET.
+         * @return True - if the host is resolved, otherwise - false.
+         */
+        bool AddTarget (const char * /*host*/, std::string_view /*ports*/, int32_t /*family*/ = AF_INET) noexcept;
+
+        /**
+         * @fn std::size_t ConnectScanner::Run (ScanResultHandler, void *) noexcept;
+         * @brief Method that scans all added ports and reports each result by handler.
+         * @param [in] handler - Handler which obtains the results.
+         * @param [in] context - User context for handler. Default: nullptr.
+         * @return Number of scanned ports.
+         *
+         * @note Method blocks the calling thread until all ports are scanned or Stop method is called.
+         */
+        std::size_t Run (ScanResultHandler /*handler*/, void * /*context*/ = nullptr) noexcept;
+
+        /**
+         * @fn inline void ConnectScanner::Stop() noexcept;
+         * @brief Method that stops the scanning (attempts in flight are aborted without results).
+         *
+         * @note Method can be called from handler or from another thread.
+         */
+        inline void Stop(void) noexcept { stopped.store(true, std::memory_order_relaxed); }
+
+        // Return the number of attempts in flight.
+        inline std::size_t InFlight(void) const noexcept { return attempts.size(); }
+
+        ~ConnectScanner(void) noexcept;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_CONNECT_SCANNER_HPP
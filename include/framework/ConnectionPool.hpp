@@ -0,0 +1,204 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_CONNECTION_POOL_HPP
+#define PROTOCOL_ANALYZER_CONNECTION_POOL_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+
+#include "Mutex.hpp"
+#include "Socket.hpp"
+
+
+#define DEFAULT_POOL_CONNECTIONS   100  // Maximum number of connections in pool (Network.MaximumSocketConnections).
+#define DEFAULT_POOL_IDLE_TIME     30   // Lifetime of the idle connection in pool (sec.).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @struct ConnectionParameters   ConnectionPool.hpp   "include/framework/ConnectionPool.hpp"
+     * @brief Structure that describes the endpoint and TLS parameters of pooled connection.
+     *
+     * @note Connections are reused only for the same parameters.
+     */
+    struct ConnectionParameters
+    {
+        // Name or address of external host.
+        std::string host = { };
+        // Port of external host.
+        uint16_t port = DEFAULT_PORT;
+        // Flag that indicates that the connection uses TLS.
+        bool secure = false;
+        // TLS method (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+        uint16_t method = SSL_METHOD_TLS12;
+        // List of TLS ciphers (empty for the default list).
+        std::string ciphers = { };
+        // ALPN protocols in wire format (empty if ALPN is not used).
+        std::string protocols = { };
+    };
+
+
+    class ConnectionPool;
+
+    /**
+     * @class ConnectionLease   ConnectionPool.hpp   "include/framework/ConnectionPool.hpp"
+     * @brief This class defined the connection which is taken from the pool and returned back when the lease is destroyed.
+     *
+     * @note If the connection can not be reused (for example, the external host closes it after response), then call Discard method.
+     * @warning The lease MUST be destroyed before the pool.
+     */
+    class ConnectionLease
+    {
+        friend class ConnectionPool;
+
+    private:
+        // The pool to which the connection is returned.
+        ConnectionPool * pool = nullptr;
+        // Key of the connection parameters in the pool.
+        std::string key = { };
+        // Connected socket.
+        std::unique_ptr<Socket> socket = nullptr;
+        // Flag that indicates that the connection has been taken from idle connections.
+        bool reused = false;
+        // Flag that indicates that the connection is returned to idle connections.
+        bool reusable = true;
+
+        ConnectionLease (ConnectionPool * /*owner*/, std::string /*name*/, std::unique_ptr<Socket> && /*connection*/, bool /*idle*/) noexcept;
+
+    public:
+        ConnectionLease (ConnectionLease &&) = delete;
+        ConnectionLease (const ConnectionLease &) = delete;
+        ConnectionLease & operator= (ConnectionLease &&) = delete;
+        ConnectionLease & operator= (const ConnectionLease &) = delete;
+
+        // Constructor of the empty lease (the connection is not obtained).
+        ConnectionLease(void) = default;
+
+        // Return true if the connection is obtained.
+        inline explicit operator bool(void) const noexcept { return (socket != nullptr); }
+        // Return the connected socket (SocketSSL for TLS connections).
+        inline Socket * Get(void) const noexcept { return socket.get(); }
+        inline Socket * operator->(void) const noexcept { return socket.get(); }
+        // Return true if the connection was established by one of the previous leases.
+        inline bool IsReused(void) const noexcept { return reused; }
+        // Close the connection instead of returning it to the pool.
+        inline void Discard(void) noexcept { reusable = false; }
+
+        // Destructor that returns the connection to the pool.
+        ~ConnectionLease(void) noexcept;
+    };
+
+
+    /**
+     * @class ConnectionPool   ConnectionPool.hpp   "include/framework/ConnectionPool.hpp"
+     * @brief This class defined the thread-safe pool of the keep-alive connections to external hosts.
+     *
+     * @note Idle connection is checked by Socket::IsReusable method before it is returned by Acquire method.
+     * @note The total number of connections (idle and leased) is limited. If the limit is reached, then the oldest idle connection is closed.
+     * @note Idle connections are closed after the idle time expires.
+     * @note Idle connection is moved to the reactor of the thread which acquires it, so the connections may be reused by any thread.
+     */
+    class ConnectionPool
+    {
+        friend class ConnectionLease;
+        using clock = std::chrono::steady_clock;
+
+    private:
+        /**
+         * @struct IdleConnection
+         * @brief Structure that contains the connection which waits for the next lease.
+         */
+        struct IdleConnection
+        {
+            std::unique_ptr<Socket> socket = nullptr;
+            clock::time_point since = { };
+        };
+
+        // Mutex for all internal structures.
+        system::LocalMutex mutex = { };
+        // Idle connections by keys of connection parameters (the last released connection is at the end).
+        std::unordered_map<std::string, std::vector<IdleConnection>> idle = { };
+        // Number of idle and leased connections.
+        std::size_t total = 0;
+        // Maximum number of idle and leased connections.
+        std::size_t limit = DEFAULT_POOL_CONNECTIONS;
+        // Lifetime of the idle connection.
+        std::chrono::seconds idleTime = std::chrono::seconds(DEFAULT_POOL_IDLE_TIME);
+
+        // Returns the key of connection parameters.
+        static std::string MakeKey (const ConnectionParameters & /*parameters*/) noexcept;
+        // Creates and connects the new socket.
+        static std::unique_ptr<Socket> Connect (const ConnectionParameters & /*parameters*/) noexcept;
+        // Moves the expired idle connections (or the oldest one if force is set) to output (must be called under mutex).
+        void TakeExpired (std::vector<std::unique_ptr<Socket>> & /*output*/, bool /*force*/) noexcept;
+        // Returns the connection from the lease.
+        void Release (const std::string & /*key*/, std::unique_ptr<Socket> && /*socket*/, bool /*reusable*/) noexcept;
+
+    public:
+        ConnectionPool (ConnectionPool &&) = delete;
+        ConnectionPool (const ConnectionPool &) = delete;
+        ConnectionPool & operator= (ConnectionPool &&) = delete;
+        ConnectionPool & operator= (const ConnectionPool &) = delete;
+
+        /**
+         * @fn explicit ConnectionPool::ConnectionPool (std::size_t, std::chrono::seconds) noexcept;
+         * @brief Constructor of ConnectionPool class.
+         * @param [in] maximum - Maximum number of idle and leased connections. Default: DEFAULT_POOL_CONNECTIONS.
+         * @param [in] time - Lifetime of the idle connection. Default: DEFAULT_POOL_IDLE_TIME.
+         */
+        explicit ConnectionPool (std::size_t /*maximum*/ = DEFAULT_POOL_CONNECTIONS,
+                                 std::chrono::seconds /*time*/ = std::chrono::seconds(DEFAULT_POOL_IDLE_TIME)) noexcept;
+
+        /**
+         * @fn bool ConnectionPool::LoadSettings (std::string_view) noexcept;
+         * @brief Method that reads the limits of pool from the scanner settings file.
+         * @param [in] path - Path to ScannerSettings.json file.
+         * @return True - if the settings file is parsed, otherwise - false.
+         *
+         * @note Limits are read from Network.MaximumSocketConnections and Network.Timeouts.IdleConnection values.
+         */
+        bool LoadSettings (std::string_view /*path*/) noexcept;
+
+        /**
+         * @fn ConnectionLease ConnectionPool::Acquire (const ConnectionParameters &) noexcept;
+         * @brief Method that returns the live connection to the external host.
+         * @param [in] parameters - Endpoint and TLS parameters of the connection.
+         * @return Lease of the connection or empty lease if the connection is not established or the limit is reached.
+         *
+         * @note The most recently used idle connection is returned, otherwise the new connection is established.
+         */
+        ConnectionLease Acquire (const ConnectionParameters & /*parameters*/) noexcept;
+
+        /**
+         * @fn std::size_t ConnectionPool::EvictIdle() noexcept;
+         * @brief Method that closes the idle connections whose idle time has expired.
+         * @return Number of closed connections.
+         */
+        std::size_t EvictIdle(void) noexcept;
+
+        /**
+         * @fn void ConnectionPool::Clear() noexcept;
+         * @brief Method that closes all idle connections.
+         */
+        void Clear(void) noexcept;
+
+        // Return the number of idle connections.
+        std::size_t IdleCount(void) noexcept;
+        // Return the number of idle and leased connections.
+        std::size_t TotalCount(void) noexcept;
+
+        ~ConnectionPool(void) noexcept;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_CONNECTION_POOL_HPP
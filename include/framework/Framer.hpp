@@ -0,0 +1,187 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_FRAMER_HPP
+#define PROTOCOL_ANALYZER_FRAMER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+
+#define MAXIMUM_FRAME_HEADER   16  // Maximum size of header of length-prefixed frame (offset and length prefix).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @enum FRAME_STATE
+     * @brief The state of frame after the next part of received data.
+     */
+    enum FRAME_STATE : uint8_t
+    {
+        FRAME_NEED_MORE = 0,     // End of frame is not found yet.
+        FRAME_LENGTH_KNOWN = 1,  // Length of frame is known, but the frame is not received completely.
+        FRAME_COMPLETE = 2,      // Frame is received completely.
+        FRAME_ERROR = 3          // Received data does not match the format of frame.
+    };
+
+
+    /**
+     * @class Framer   Framer.hpp   "include/framework/Framer.hpp"
+     * @brief This class defined the interface of incremental detection of the end of message in stream.
+     *
+     * @note Framer obtains only the new part of data each time, so the received data is scanned once.
+     * @note Framer keeps the state of one frame until Reset method is called.
+     */
+    class Framer
+    {
+    protected:
+        // Number of bytes which are fed since reset.
+        std::size_t fed = 0;
+        // Total length of frame (zero if length is not known yet).
+        std::size_t frameLength = 0;
+
+    public:
+        Framer (Framer &&) = delete;
+        Framer (const Framer &) = delete;
+        Framer & operator= (Framer &&) = delete;
+        Framer & operator= (const Framer &) = delete;
+
+        Framer(void) = default;
+
+        /**
+         * @fn virtual FRAME_STATE Framer::Feed (const char *, std::size_t) noexcept;
+         * @brief Method that processes the next part of received data.
+         * @param [in] data - Pointer to the new part of data.
+         * @param [in] length - Length of the new part of data.
+         * @return The state of frame after this part of data.
+         */
+        virtual FRAME_STATE Feed (const char * /*data*/, std::size_t /*length*/) noexcept = 0;
+
+        /**
+         * @fn virtual std::size_t Framer::Expected() const noexcept;
+         * @brief Method that returns the number of bytes which must be received for the next step of framer.
+         * @return Number of bytes or zero if the number is not known (any amount of data can be received).
+         *
+         * @note Socket::Recv receives exactly this number of bytes, so the data of the next frame stays in the socket.
+         */
+        virtual std::size_t Expected(void) const noexcept { return (frameLength > fed) ? frameLength - fed : 0; }
+
+        // Prepare framer for the next frame.
+        virtual void Reset(void) noexcept { fed = 0; frameLength = 0; }
+        // Return the total length of frame (zero if length is not known yet).
+        inline std::size_t FrameLength(void) const noexcept { return frameLength; }
+
+        virtual ~Framer(void) = default;
+    };
+
+
+    /**
+     * @class DelimiterFramer   Framer.hpp   "include/framework/Framer.hpp"
+     * @brief This class defined the framer of message which ends with delimiter (for example: "\r\n\r\n").
+     *
+     * @note Delimiter which is split between the parts of data is found without rescanning of the previous data.
+     * @note The data after the delimiter may be received together with the frame (it belongs to the next frame).
+     */
+    class DelimiterFramer final : public Framer
+    {
+    private:
+        // Delimiter of frames.
+        std::string delimiter;
+        // Prefix function of delimiter (length of the longest proper prefix which is also suffix).
+        std::vector<std::size_t> prefix;
+        // Number of bytes of delimiter which are matched at the end of fed data.
+        std::size_t matched = 0;
+        // Maximum length of frame (zero is unlimited).
+        std::size_t maximum;
+
+    public:
+        /**
+         * @fn explicit DelimiterFramer::DelimiterFramer (std::string_view, std::size_t) noexcept;
+         * @brief Constructor of DelimiterFramer class.
+         * @param [in] end - Delimiter of frames.
+         * @param [in] limit - Maximum length of frame (zero is unlimited). Default: 0.
+         */
+        explicit DelimiterFramer (std::string_view /*end*/, std::size_t /*limit*/ = 0) noexcept;
+
+        FRAME_STATE Feed (const char * /*data*/, std::size_t /*length*/) noexcept final;
+        // Delimiter framer does not know the number of bytes.
+        std::size_t Expected(void) const noexcept final { return 0; }
+        void Reset(void) noexcept final { Framer::Reset(); matched = 0; }
+    };
+
+
+    /**
+     * @class LengthPrefixFramer   Framer.hpp   "include/framework/Framer.hpp"
+     * @brief This class defined the framer of message which starts with the length of message.
+     *
+     * @note Frame consists of offset bytes, length prefix and body (length of body is the prefix value plus adjustment).
+     */
+    class LengthPrefixFramer : public Framer
+    {
+    protected:
+        // Header of frame (offset bytes and length prefix).
+        uint8_t header[MAXIMUM_FRAME_HEADER] = { };
+        // Size of the bytes before length prefix.
+        std::size_t offset;
+        // Size of length prefix (1, 2, 4 or 8 bytes).
+        std::size_t prefixSize;
+        // Byte order of length prefix.
+        bool bigEndian;
+        // Value which is added to the prefix value to obtain the length of body.
+        int64_t adjustment;
+        // Maximum length of frame (zero is unlimited).
+        std::size_t maximum;
+
+        // Return the unsigned integer from header.
+        uint64_t ReadHeaderValue (std::size_t /*position*/, std::size_t /*size*/) const noexcept;
+
+    public:
+        /**
+         * @fn explicit LengthPrefixFramer::LengthPrefixFramer (std::size_t, bool, std::size_t, int64_t, std::size_t) noexcept;
+         * @brief Constructor of LengthPrefixFramer class.
+         * @param [in] size - Size of length prefix (1, 2, 4 or 8 bytes).
+         * @param [in] order - Big-endian byte order of length prefix if true, otherwise - little-endian. Default: true.
+         * @param [in] skip - Size of the bytes before length prefix. Default: 0.
+         * @param [in] correction - Value which is added to the prefix value to obtain the length of body. Default: 0.
+         * @param [in] limit - Maximum length of frame (zero is unlimited). Default: 0.
+         *
+         * @note If the prefix value includes the length of header, then correction is the negative size of header.
+         */
+        explicit LengthPrefixFramer (std::size_t /*size*/, bool /*order*/ = true, std::size_t /*skip*/ = 0,
+                                     int64_t /*correction*/ = 0, std::size_t /*limit*/ = 0) noexcept;
+
+        FRAME_STATE Feed (const char * /*data*/, std::size_t /*length*/) noexcept final;
+        std::size_t Expected(void) const noexcept final;
+    };
+
+
+    /**
+     * @class TlvFramer   Framer.hpp   "include/framework/Framer.hpp"
+     * @brief This class defined the framer of Type-Length-Value record.
+     */
+    class TlvFramer final : public LengthPrefixFramer
+    {
+    public:
+        /**
+         * @fn explicit TlvFramer::TlvFramer (std::size_t, std::size_t, bool, std::size_t) noexcept;
+         * @brief Constructor of TlvFramer class.
+         * @param [in] typeSize - Size of type field (up to 8 bytes).
+         * @param [in] lengthSize - Size of length field (1, 2, 4 or 8 bytes).
+         * @param [in] order - Big-endian byte order of fields if true, otherwise - little-endian. Default: true.
+         * @param [in] limit - Maximum length of record (zero is unlimited). Default: 0.
+         */
+        explicit TlvFramer (std::size_t /*typeSize*/, std::size_t /*lengthSize*/, bool /*order*/ = true, std::size_t /*limit*/ = 0) noexcept;
+
+        // Return the type of record (valid after the length of record is known).
+        inline uint64_t GetType(void) const noexcept { return ReadHeaderValue(0, offset); }
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_FRAMER_HPP
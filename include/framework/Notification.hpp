@@ -199,6 +199,30 @@ namespace analyzer::framework::task
             Notification<Type>::mutex.Lock();
         }
 
+        /**
+         * @fn inline void NotificationSubject::Post(void) noexcept;
+         * @brief Method that sends the event signal without waiting for the observer.
+         *
+         * @note The event signal stays set until the Rearm() method is called, so the observer may wait for it later.
+         * @attention MUST NOT call this method twice without calling the Rearm() method between them.
+         */
+        inline void Post(void) noexcept
+        {
+            Notification<Type>::mutex.ResetFlag();
+            static_cast<void>(Notification<Type>::mutex.Unlock());
+        }
+
+        /**
+         * @fn inline void NotificationSubject::Rearm(void) noexcept;
+         * @brief Method that withdraws the event signal sent by the Post() method for the next notification.
+         *
+         * @note If the observer is obtaining the value at the moment then method waits for it.
+         */
+        inline void Rearm(void) noexcept
+        {
+            static_cast<void>(Notification<Type>::mutex.Lock());
+        }
+
         virtual NotificationObserver<Type>* ToObserver(void) noexcept
         {
             auto base = static_cast<Notification<Type> *>(this);
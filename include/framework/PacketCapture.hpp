@@ -0,0 +1,380 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_PACKET_CAPTURE_HPP
+#define PROTOCOL_ANALYZER_PACKET_CAPTURE_HPP
+
+#include <ctime>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <string_view>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+
+#include "System.hpp"
+#include "CaptureFilter.hpp"
+#include "BinaryDataEngine.hpp"
+
+
+#define DEFAULT_CAPTURE_BLOCK_SIZE      (1U << 20)  // Size of one block of capture ring (multiple of page size).
+#define DEFAULT_CAPTURE_BLOCK_COUNT     64          // Number of blocks in capture ring.
+#define DEFAULT_CAPTURE_RETIRE_TIMEOUT  60          // Time after which the kernel retires the block which is not full (ms.).
+#define CAPTURE_FRAME_SIZE              2048        // Nominal size of frame which is required by PACKET_RX_RING.
+#define CAPTURE_WORKER_POLL_TIME        100         // Time after which the worker checks the stop flag if there is no traffic (ms.).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @struct CapturedFrame   PacketCapture.hpp   "include/framework/PacketCapture.hpp"
+     * @brief Structure that contains the captured frame and its metadata.
+     */
+    struct CapturedFrame
+    {
+        // Captured bytes of link-layer frame as the reference to the capture ring.
+        common::types::BinaryDataEngine data = common::types::BinaryDataEngine(common::types::DATA_MODE_DEFAULT, common::types::DATA_BIG_ENDIAN);
+        // Length of frame on the wire (may exceed the number of captured bytes).
+        uint32_t originalLength = 0;
+        // Time of capture.
+        struct timespec time = { };
+        // Index of network interface.
+        int32_t interface = 0;
+        // Link-layer protocol in host byte order (ETH_P_*).
+        uint16_t protocol = 0;
+        // Type of packet (PACKET_HOST, PACKET_OUTGOING, etc.).
+        uint8_t type = 0;
+    };
+
+    /**
+     * @struct CaptureStatistics   PacketCapture.hpp   "include/framework/PacketCapture.hpp"
+     * @brief Structure that contains the counters of capture socket since it was opened.
+     */
+    struct CaptureStatistics
+    {
+        // Number of frames which were passed to the capture ring.
+        uint64_t packets = 0;
+        // Number of frames which were dropped because the ring was full.
+        uint64_t drops = 0;
+        // Number of times when the ring was frozen because all blocks were owned by user.
+        uint64_t freezes = 0;
+    };
+
+
+    /**
+     * @class PacketCapture   PacketCapture.hpp   "include/framework/PacketCapture.hpp"
+     * @brief This class defined the capture engine over memory-mapped AF_PACKET ring in TPACKET_V3 block mode.
+     *
+     * @note Frames are read from the blocks which are retired by the kernel without any system call per frame.
+     *       The process waits in poll() only when there are no retired blocks.
+     * @note Capture requires CAP_NET_RAW capability.
+     */
+    class PacketCapture
+    {
+    private:
+        // Descriptor of AF_PACKET socket.
+        int32_t fd = -1;
+        // Memory-mapped capture ring.
+        std::byte * ring = nullptr;
+        // Size of one block.
+        uint32_t blockSize;
+        // Number of blocks.
+        uint32_t blockCount;
+        // Time after which the kernel retires the block which is not full.
+        uint32_t retireTimeout;
+        // Index of the block which is processed or expected next.
+        uint32_t currentBlock = 0;
+        // Block which is owned by user (nullptr if there is no such block).
+        struct tpacket_block_desc * block = nullptr;
+        // Next frame in the owned block.
+        struct tpacket3_hdr * nextFrame = nullptr;
+        // Number of frames in the owned block which are not read yet.
+        uint32_t remaining = 0;
+        // Counters which were read from the kernel.
+        CaptureStatistics statistics = { };
+        // Identifier of fanout group (-1 if socket is not in the group).
+        int32_t fanout = -1;
+
+        // Return the owned block to the kernel.
+        void ReleaseBlock(void) noexcept;
+
+    public:
+        PacketCapture (PacketCapture &&) = delete;
+        PacketCapture (const PacketCapture &) = delete;
+        PacketCapture & operator= (PacketCapture &&) = delete;
+        PacketCapture & operator= (const PacketCapture &) = delete;
+
+        /**
+         * @fn explicit PacketCapture::PacketCapture (uint32_t, uint32_t, uint32_t) noexcept;
+         * @brief Constructor of PacketCapture class.
+         * @param [in] size - Size of one block (multiple of page size). Default: DEFAULT_CAPTURE_BLOCK_SIZE.
+         * @param [in] count - Number of blocks. Default: DEFAULT_CAPTURE_BLOCK_COUNT.
+         * @param [in] retire - Time in milliseconds after which the block which is not full is retired. Default: DEFAULT_CAPTURE_RETIRE_TIMEOUT.
+         */
+        explicit PacketCapture (uint32_t /*size*/    = DEFAULT_CAPTURE_BLOCK_SIZE,
+                                uint32_t /*count*/   = DEFAULT_CAPTURE_BLOCK_COUNT,
+                                uint32_t /*retire*/  = DEFAULT_CAPTURE_RETIRE_TIMEOUT) noexcept;
+
+        /**
+         * @fn bool PacketCapture::Open (const char *, uint16_t, const CaptureFilter *) noexcept;
+         * @brief Method that creates the capture ring and binds it to the network interface.
+         * @param [in] interface - Name of network interface (nullptr - all interfaces).
+         * @param [in] protocol - Link-layer protocol in host byte order. Default: ETH_P_ALL.
+         * @param [in] filter - Compiled filter which drops the irrelevant frames in kernel (nullptr - all frames). Default: nullptr.
+         * @return True - if capture is started, otherwise - false.
+         */
+        bool Open (const char * /*interface*/, uint16_t /*protocol*/ = ETH_P_ALL, const CaptureFilter * /*filter*/ = nullptr) noexcept;
+
+        /**
+         * @fn bool PacketCapture::NextFrame (CapturedFrame &, int32_t) noexcept;
+         * @brief Method that returns the next captured frame without copying.
+         * @param [out] frame - Captured frame which refers to the memory of capture ring.
+         * @param [in] time - Waiting time in milliseconds if there are no retired blocks (negative value - infinite).
+         * @return True - if frame is obtained, otherwise - false (timeout expired or an error occurred).
+         *
+         * @note All frames of one block stay valid until NextFrame is called after the last frame of this block.
+         * @note Block is returned to the kernel when all its frames are read, so frames must be processed or copied in time.
+         */
+        bool NextFrame (CapturedFrame & /*frame*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn bool PacketCapture::GetStatistics (CaptureStatistics &) noexcept;
+         * @brief Method that returns the counters of capture socket since it was opened.
+         * @param [out] result - Counters of capture socket.
+         * @return True - if counters are obtained, otherwise - false.
+         */
+        bool GetStatistics (CaptureStatistics & /*result*/) noexcept;
+
+        /**
+         * @fn bool PacketCapture::JoinFanout (uint16_t, uint16_t, uint16_t) noexcept;
+         * @brief Method that adds the opened capture socket to the fanout group.
+         * @param [in] group - Identifier of fanout group which is shared by all sockets of group.
+         * @param [in] mode - Mode of frame distribution between the sockets of group (PACKET_FANOUT_*).
+         * @param [in] flags - Flags of fanout group (PACKET_FANOUT_FLAG_*). Default: 0.
+         * @return True - if socket is added to the group, otherwise - false.
+         *
+         * @note All sockets of group must be opened with the same interface and protocol.
+         * @note With PACKET_FANOUT_FLAG_UNIQUEID flag the group must be zero, and the kernel selects the unused identifier.
+         */
+        bool JoinFanout (uint16_t /*group*/, uint16_t /*mode*/, uint16_t /*flags*/ = 0) noexcept;
+
+        // Return the descriptor of capture socket.
+        inline int32_t GetFd(void) const noexcept { return fd; }
+        // Return the identifier of fanout group (-1 if socket is not in the group).
+        inline int32_t GetFanoutGroup(void) const noexcept { return fanout; }
+        // Return the size of capture ring.
+        inline std::size_t GetRingSize(void) const noexcept { return static_cast<std::size_t>(blockSize) * blockCount; }
+
+        // Stop capture and release the capture ring.
+        void Close(void) noexcept;
+
+        ~PacketCapture(void) noexcept;
+    };
+
+
+    /**
+     * @typedef void (*CaptureHandler) (const CapturedFrame &, void *) noexcept;
+     * @brief Function which processes the captured frame in the thread of capture worker.
+     *
+     * @note Handler is called with the captured frame and the analysis state of worker.
+     */
+    using CaptureHandler = void (*) (const CapturedFrame &, void *) noexcept;
+
+    /**
+     * @struct CaptureWorkerStatistics   PacketCapture.hpp   "include/framework/PacketCapture.hpp"
+     * @brief Structure that contains the counters of one capture worker since the session was started.
+     */
+    struct CaptureWorkerStatistics
+    {
+        // Counters of the capture ring of worker.
+        CaptureStatistics kernel = { };
+        // Number of frames which were processed by worker.
+        uint64_t frames = 0;
+        // Number of bytes on the wire of processed frames.
+        uint64_t bytes = 0;
+        // Average number of processed frames per second.
+        double framesPerSecond = 0;
+        // Average number of processed bytes per second.
+        double bytesPerSecond = 0;
+    };
+
+
+    /**
+     * @class CaptureSession   PacketCapture.hpp   "include/framework/PacketCapture.hpp"
+     * @brief This class defined the multi-core capture over the PACKET_FANOUT group of capture rings.
+     *
+     * @note Each worker thread owns its capture ring and its analysis state, so there are no locks on the path of frame.
+     * @note Counters of worker are written only by its thread and are read by other threads without locks.
+     */
+    class CaptureSession
+    {
+    private:
+        // Capture worker which is aligned by cache line to prevent false sharing of counters.
+        struct alignas(64) Worker
+        {
+            PacketCapture capture;
+            std::thread thread = { };
+            void * state = nullptr;
+            std::atomic<uint64_t> frames = 0;
+            std::atomic<uint64_t> bytes = 0;
+            std::atomic<uint64_t> packets = 0;
+            std::atomic<uint64_t> drops = 0;
+            std::atomic<uint64_t> freezes = 0;
+
+            explicit Worker (uint32_t size = DEFAULT_CAPTURE_BLOCK_SIZE, uint32_t count = DEFAULT_CAPTURE_BLOCK_COUNT, uint32_t retire = DEFAULT_CAPTURE_RETIRE_TIMEOUT) noexcept
+                : capture(size, count, retire)
+            { }
+        };
+
+        // Capture workers.
+        std::vector<std::unique_ptr<Worker>> workers = { };
+        // Function which processes the captured frames.
+        CaptureHandler handler = nullptr;
+        // Filter which is attached to the ring of each worker.
+        CaptureFilter filter = { };
+        // Flag that stops the capture workers.
+        std::atomic<bool> stopped = true;
+        // Time of session start.
+        std::chrono::steady_clock::time_point start = { };
+        // Time of session stop.
+        std::chrono::steady_clock::time_point finish = { };
+        // Size of one block of each ring.
+        uint32_t blockSize;
+        // Number of blocks of each ring.
+        uint32_t blockCount;
+        // Retire timeout of each ring.
+        uint32_t retireTimeout;
+
+        // Thread of capture worker.
+        void CaptureWorker (Worker & /*worker*/) noexcept;
+        // Publish the kernel counters of worker ring.
+        static void PublishStatistics (Worker & /*worker*/) noexcept;
+
+    public:
+        CaptureSession (CaptureSession &&) = delete;
+        CaptureSession (const CaptureSession &) = delete;
+        CaptureSession & operator= (CaptureSession &&) = delete;
+        CaptureSession & operator= (const CaptureSession &) = delete;
+
+        /**
+         * @fn explicit CaptureSession::CaptureSession (uint32_t, uint32_t, uint32_t) noexcept;
+         * @brief Constructor of CaptureSession class.
+         * @param [in] size - Size of one block of each ring. Default: DEFAULT_CAPTURE_BLOCK_SIZE.
+         * @param [in] count - Number of blocks of each ring. Default: DEFAULT_CAPTURE_BLOCK_COUNT.
+         * @param [in] retire - Retire timeout of each ring in milliseconds. Default: DEFAULT_CAPTURE_RETIRE_TIMEOUT.
+         */
+        explicit CaptureSession (uint32_t /*size*/    = DEFAULT_CAPTURE_BLOCK_SIZE,
+                                 uint32_t /*count*/   = DEFAULT_CAPTURE_BLOCK_COUNT,
+                                 uint32_t /*retire*/  = DEFAULT_CAPTURE_RETIRE_TIMEOUT) noexcept;
+
+        /**
+         * @fn bool CaptureSession::Start (const char *, const std::vector<void *> &, CaptureHandler, uint16_t, uint16_t, bool) noexcept;
+         * @brief Method that opens the ring for each worker, joins them into the fanout group and starts the worker threads.
+         * @param [in] interface - Name of network interface (nullptr - all interfaces).
+         * @param [in] states - Analysis states of workers (one worker per state).
+         * @param [in] function - Function which processes the captured frames.
+         * @param [in] mode - Mode of frame distribution (PACKET_FANOUT_HASH, PACKET_FANOUT_CPU, PACKET_FANOUT_LB, PACKET_FANOUT_ROLLOVER). Default: PACKET_FANOUT_HASH.
+         * @param [in] flags - Flags of fanout group (PACKET_FANOUT_FLAG_*). Default: 0.
+         * @param [in] pin - Flag that binds each worker to its own CPU. Default: true.
+         * @return True - if all workers are started, otherwise - false.
+         *
+         * @note In PACKET_FANOUT_HASH mode the frames of one flow are processed by one worker.
+         */
+        bool Start (const char * /*interface*/, const std::vector<void *> & /*states*/, CaptureHandler /*function*/,
+                    uint16_t /*mode*/ = PACKET_FANOUT_HASH, uint16_t /*flags*/ = 0, bool /*pin*/ = true) noexcept;
+
+        /**
+         * @fn bool CaptureSession::GetStatistics (std::size_t, CaptureWorkerStatistics &) const noexcept;
+         * @brief Method that returns the counters of capture worker.
+         * @param [in] index - Index of worker.
+         * @param [out] result - Counters of worker.
+         * @return True - if counters are obtained, otherwise - false.
+         *
+         * @note Kernel counters are updated by worker when there is no traffic and periodically during processing.
+         * @note Counters of the last session stay available after stop.
+         */
+        bool GetStatistics (std::size_t /*index*/, CaptureWorkerStatistics & /*result*/) const noexcept;
+
+        // Set the compiled filter for the rings of next session (empty filter - all frames).
+        inline void SetFilter (const CaptureFilter & other) noexcept { filter = other; }
+        // Return the number of capture workers.
+        inline std::size_t Size(void) const noexcept { return workers.size(); }
+
+        // Stop the capture workers and release their rings.
+        void Stop(void) noexcept;
+
+        ~CaptureSession(void) noexcept;
+    };
+
+
+
+    /**
+     * @class PcapReader   PacketCapture.hpp   "include/framework/PacketCapture.hpp"
+     * @brief This class defined the reader of frames from the pcap file for offline replay.
+     *
+     * @note Frames are filtered by the user-space interpreter of the same filter which is attached to the capture socket.
+     */
+    class PcapReader
+    {
+    private:
+        // Opened pcap file.
+        std::ifstream file = { };
+        // Flag that the byte order of file differs from the byte order of system.
+        bool swapped = false;
+        // Flag that the timestamps of file have nanosecond resolution.
+        bool nanoseconds = false;
+        // Type of link layer (LINKTYPE_*).
+        uint32_t linkType = 0;
+        // Buffer for the current frame.
+        std::unique_ptr<std::byte[]> buffer = nullptr;
+        // Size of buffer.
+        uint32_t capacity = 0;
+
+        // Return the value of header field in byte order of system.
+        inline uint32_t Field (uint32_t value) const noexcept { return (swapped == true) ? __builtin_bswap32(value) : value; }
+
+    public:
+        PcapReader(void) = default;
+        PcapReader (PcapReader &&) = delete;
+        PcapReader (const PcapReader &) = delete;
+        PcapReader & operator= (PcapReader &&) = delete;
+        PcapReader & operator= (const PcapReader &) = delete;
+
+        /**
+         * @fn bool PcapReader::Open (std::string_view) noexcept;
+         * @brief Method that opens the pcap file and reads its global header.
+         * @param [in] path - Path to pcap file.
+         * @return True - if file is opened, otherwise - false.
+         */
+        bool Open (std::string_view /*path*/) noexcept;
+
+        /**
+         * @fn bool PcapReader::NextFrame (CapturedFrame &, const CaptureFilter *) noexcept;
+         * @brief Method that reads the next frame which is accepted by filter.
+         * @param [out] frame - Frame which refers to the internal buffer of reader.
+         * @param [in] filter - Compiled filter (nullptr - all frames). Default: nullptr.
+         * @return True - if frame is obtained, otherwise - false (end of file or an error occurred).
+         *
+         * @note Frame stays valid until the next call of NextFrame.
+         * @note Filter is applied only to the file with Ethernet link type.
+         */
+        bool NextFrame (CapturedFrame & /*frame*/, const CaptureFilter * /*filter*/ = nullptr) noexcept;
+
+        // Return the type of link layer of file.
+        inline uint32_t GetLinkType(void) const noexcept { return linkType; }
+
+        // Close the pcap file.
+        void Close(void) noexcept;
+
+        ~PcapReader(void) = default;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_PACKET_CAPTURE_HPP
@@ -6,7 +6,9 @@
 #ifndef PROTOCOL_ANALYZER_PARSER_HPP
 #define PROTOCOL_ANALYZER_PARSER_HPP
 
+#include <string>
 #include <vector>
+#include <optional>
 #include <string_view>
 
 
@@ -86,6 +88,221 @@ namespace analyzer::framework::parser
         uint16_t GetNextPort(void) noexcept;
     };
 
+
+    /**
+     * @class JsonValue Parser.hpp "include/framework/Parser.hpp"
+     * @brief Class that contains one parsed JSON value and gives an interface to read it.
+     *
+     * @note The order of members in JSON object is preserved.
+     */
+    class JsonValue
+    {
+        friend class JsonParser;
+
+    public:
+        /**
+         * @enum JSON_TYPE
+         * @brief Type of the stored JSON value.
+         */
+        enum JSON_TYPE : uint8_t
+        {
+            JSON_NULL = 0x00,
+            JSON_BOOLEAN = 0x01,
+            JSON_NUMBER = 0x02,
+            JSON_STRING = 0x03,
+            JSON_ARRAY = 0x04,
+            JSON_OBJECT = 0x05
+        };
+
+    private:
+        /**
+         * @var JSON_TYPE type;
+         * @brief Type of the stored JSON value.
+         */
+        JSON_TYPE type = JSON_NULL;
+        /**
+         * @var bool boolean;
+         * @brief Stored value of JSON_BOOLEAN type.
+         */
+        bool boolean = false;
+        /**
+         * @var double number;
+         * @brief Stored value of JSON_NUMBER type.
+         */
+        double number = 0;
+        /**
+         * @var std::string string;
+         * @brief Stored value of JSON_STRING type.
+         */
+        std::string string = { };
+        /**
+         * @var std::vector<std::string> keys;
+         * @brief Names of the members of JSON_OBJECT type in the original order.
+         */
+        std::vector<std::string> keys = { };
+        /**
+         * @var std::vector<JsonValue> values;
+         * @brief Elements of JSON_ARRAY type or values of the members of JSON_OBJECT type.
+         */
+        std::vector<JsonValue> values = { };
+
+    public:
+        /**
+         * @fn JsonValue::JsonValue();
+         * @brief Default constructor of JsonValue class that creates JSON_NULL value.
+         */
+        JsonValue(void) = default;
+
+        /**
+         * @fn inline JSON_TYPE JsonValue::Type() const noexcept;
+         * @brief Method that returns the type of the stored JSON value.
+         * @return Type of the stored JSON value.
+         */
+        inline JSON_TYPE Type(void) const noexcept { return type; }
+
+        /**
+         * @fn inline bool JsonValue::IsNull() const noexcept;
+         * @brief Method that checks that the stored JSON value is null.
+         * @return True - if the stored JSON value is null, otherwise - false.
+         */
+        inline bool IsNull(void) const noexcept { return type == JSON_NULL; }
+
+        /**
+         * @fn std::optional<bool> JsonValue::AsBoolean() const noexcept;
+         * @brief Method that returns the stored value of JSON_BOOLEAN type.
+         * @return Stored boolean value or std::nullopt if the type of stored value is another.
+         */
+        std::optional<bool> AsBoolean(void) const noexcept;
+
+        /**
+         * @fn std::optional<double> JsonValue::AsNumber() const noexcept;
+         * @brief Method that returns the stored value of JSON_NUMBER type.
+         * @return Stored number value or std::nullopt if the type of stored value is another.
+         */
+        std::optional<double> AsNumber(void) const noexcept;
+
+        /**
+         * @fn std::optional<std::string_view> JsonValue::AsString() const noexcept;
+         * @brief Method that returns the stored value of JSON_STRING type.
+         * @return Stored string value or std::nullopt if the type of stored value is another.
+         */
+        std::optional<std::string_view> AsString(void) const noexcept;
+
+        /**
+         * @fn inline std::size_t JsonValue::Size() const noexcept;
+         * @brief Method that returns the number of elements of JSON array or the number of members of JSON object.
+         * @return Number of nested values.
+         */
+        inline std::size_t Size(void) const noexcept { return values.size(); }
+
+        /**
+         * @fn const JsonValue * JsonValue::At (std::size_t) const noexcept;
+         * @brief Method that returns the nested value under selected index of JSON array or JSON object.
+         * @param [in] index - Index of the nested value.
+         * @return Pointer to the nested value or nullptr if the index is out-of-range.
+         */
+        const JsonValue * At (std::size_t /*index*/) const noexcept;
+
+        /**
+         * @fn std::string_view JsonValue::KeyAt (std::size_t) const noexcept;
+         * @brief Method that returns the name of the member under selected index of JSON object.
+         * @param [in] index - Index of the member.
+         * @return Name of the member or empty string if the index is out-of-range.
+         */
+        std::string_view KeyAt (std::size_t /*index*/) const noexcept;
+
+        /**
+         * @fn const JsonValue * JsonValue::Find (std::string_view) const noexcept;
+         * @brief Method that returns the member of JSON object under selected name.
+         * @param [in] key - Name of the member.
+         * @return Pointer to the value of the member or nullptr if the member is not found.
+         */
+        const JsonValue * Find (std::string_view /*key*/) const noexcept;
+
+        /**
+         * @fn const JsonValue * JsonValue::FindByPath (std::string_view, char) const noexcept;
+         * @brief Method that returns the member of nested JSON objects under selected path.
+         * @param [in] path - Sequence of the names of members listed through a separator.
+         * @param [in] delimiter - The separator. Default: '.'.
+         * @return Pointer to the value of the member or nullptr if the member is not found.
+         *
+         * @note For example: Protocol.NetworkSettings.Target.Host.
+         */
+        const JsonValue * FindByPath (std::string_view /*path*/, char /*delimiter*/ = '.') const noexcept;
+    };
+
+
+    /**
+     * @class JsonParser Parser.hpp "include/framework/Parser.hpp"
+     * @brief Class that parses the JSON text (RFC 8259) into the tree of JsonValue classes.
+     */
+    class JsonParser
+    {
+    private:
+        /**
+         * @var static const std::size_t maximumDepth;
+         * @brief Maximum nesting depth of JSON arrays and objects.
+         */
+        static const std::size_t maximumDepth = 128;
+
+        /**
+         * @var std::string_view text;
+         * @brief Parsed JSON text.
+         */
+        std::string_view text;
+        /**
+         * @var std::size_t position;
+         * @brief Current position in parsed JSON text.
+         */
+        std::size_t position = 0;
+
+        /**
+         * @fn explicit JsonParser::JsonParser (std::string_view) noexcept;
+         * @brief Constructor of JsonParser class.
+         * @param [in] input - JSON text.
+         */
+        explicit JsonParser (std::string_view input) noexcept
+                : text(input)
+        { }
+
+        // Skip all whitespace characters from current position.
+        void SkipWhitespace(void) noexcept;
+        // Parse any JSON value from current position.
+        bool ParseValue (JsonValue & /*value*/, std::size_t /*depth*/) noexcept;
+        // Parse JSON object from current position.
+        bool ParseObject (JsonValue & /*value*/, std::size_t /*depth*/) noexcept;
+        // Parse JSON array from current position.
+        bool ParseArray (JsonValue & /*value*/, std::size_t /*depth*/) noexcept;
+        // Parse JSON string from current position.
+        bool ParseString (std::string & /*value*/) noexcept;
+        // Parse JSON number from current position.
+        bool ParseNumber (JsonValue & /*value*/) noexcept;
+        // Parse the literal (true, false, null) from current position.
+        bool ParseLiteral (std::string_view /*literal*/) noexcept;
+
+    public:
+        JsonParser (JsonParser &&) = delete;
+        JsonParser (const JsonParser &) = delete;
+        JsonParser & operator= (JsonParser &&) = delete;
+        JsonParser & operator= (const JsonParser &) = delete;
+
+        /**
+         * @fn static std::optional<JsonValue> JsonParser::Parse (std::string_view) noexcept;
+         * @brief Method that parses the JSON text.
+         * @param [in] input - JSON text.
+         * @return Root JSON value or std::nullopt if an error occurred.
+         */
+        static std::optional<JsonValue> Parse (std::string_view /*input*/) noexcept;
+
+        /**
+         * @fn static std::optional<JsonValue> JsonParser::ParseFile (std::string_view) noexcept;
+         * @brief Method that reads and parses the JSON file.
+         * @param [in] path - Path to JSON file.
+         * @return Root JSON value or std::nullopt if an error occurred.
+         */
+        static std::optional<JsonValue> ParseFile (std::string_view /*path*/) noexcept;
+    };
+
 }  // namespace parser.
 
 
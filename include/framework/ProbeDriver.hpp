@@ -0,0 +1,383 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_PROBE_DRIVER_HPP
+#define PROTOCOL_ANALYZER_PROBE_DRIVER_HPP
+
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unordered_map>
+
+#include "Socket.hpp"
+#include "System.hpp"
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @enum PROBE_CONNECT
+     * @brief The result of start of non-blocking connection of probe.
+     */
+    enum PROBE_CONNECT : uint8_t
+    {
+        CONNECT_STARTED = 0,  // Probe is in flight (the connection may be already failed, see the error).
+        CONNECT_DELAYED = 1,  // Local resources are exhausted, so the probe should be repeated after other probes are finished.
+        CONNECT_FAILED = 2    // Local error of probe.
+    };
+
+    /**
+     * @struct ProbeTarget   ProbeDriver.hpp   "include/framework/ProbeDriver.hpp"
+     * @brief Structure that contains the external host and the state of its connection.
+     */
+    struct ProbeTarget
+    {
+        /**
+         * @enum TARGET_STATE
+         * @brief The state of connection to external host.
+         */
+        enum TARGET_STATE : uint8_t
+        {
+            TARGET_NEW = 0,         // No any probe is started.
+            TARGET_CONNECTING = 1,  // The first probe is connecting.
+            TARGET_REACHABLE = 2,   // Connection is established by the first probe.
+            TARGET_UNREACHABLE = 3  // Connection is failed.
+        };
+
+        // Name or address of external host.
+        std::string host = { };
+        // Port of external host.
+        uint16_t port = 0;
+        // Resolved address of external host with port.
+        SocketAddress address = { };
+        // State of connection to external host.
+        TARGET_STATE state = TARGET_NEW;
+        // Flag that the host is the domain name and it is sent in SNI extension.
+        bool named = false;
+
+        // Return true if the probe of host can be started (the first probe of host checks the connection).
+        inline bool Admit(void) noexcept
+        {
+            if (state == TARGET_UNREACHABLE) { return false; }
+            if (state == TARGET_NEW) { state = TARGET_CONNECTING; }
+            return true;
+        }
+        // Return true if the connection of host is confirmed by this probe, so the other probes of host can be started.
+        inline bool Confirm(void) noexcept
+        {
+            if (state != TARGET_CONNECTING) { return false; }
+            state = TARGET_REACHABLE;
+            return true;
+        }
+        // Return true if the probe which checked the connection is failed locally, so the check is passed to the next probe of host.
+        inline bool Reopen(void) noexcept
+        {
+            if (state != TARGET_CONNECTING) { return false; }
+            state = TARGET_NEW;
+            return true;
+        }
+        // Return true if the host was waiting for the check of connection when it became unreachable.
+        inline bool Reject(void) noexcept
+        {
+            const bool connecting = (state == TARGET_CONNECTING);
+            state = TARGET_UNREACHABLE;
+            return connecting;
+        }
+    };
+
+    /**
+     * @struct ProbeAttempt   ProbeDriver.hpp   "include/framework/ProbeDriver.hpp"
+     * @brief Structure that contains the common state of probe in flight.
+     */
+    struct ProbeAttempt
+    {
+        // Time when the probe was started.
+        std::chrono::steady_clock::time_point start = { };
+        // Flag that the connection is established.
+        bool connected = false;
+    };
+
+
+    /**
+     * @class ProbeDriver   ProbeDriver.hpp   "include/framework/ProbeDriver.hpp"
+     * @brief This class defined the base of engines which keep many probes of external hosts in flight on the reactor of the calling thread.
+     *
+     * @tparam [in] Target - Type of external host (derived from ProbeTarget).
+     * @tparam [in] Attempt - Type of probe in flight (derived from ProbeAttempt).
+     *
+     * @note Driver owns the non-blocking connection of each probe, the deadline of probe and the loop of reactor.
+     *       Derived class selects and starts the probes, continues them after the events of sockets and finishes them by deadline.
+     * @note Sockets are closed by RST, so the probes do not leave connections in TIME_WAIT state.
+     */
+    template <typename Target, typename Attempt>
+    class ProbeDriver
+    {
+    protected:
+        using clock = std::chrono::steady_clock;
+
+        // Maximum number of probes in flight.
+        uint32_t maximumInFlight = 1;
+        // Time of one probe.
+        std::chrono::milliseconds probeTime = std::chrono::milliseconds(0);
+        // Targets for probing.
+        std::vector<std::unique_ptr<Target>> targets = { };
+        // Probes in flight by socket descriptors.
+        std::unordered_map<int32_t, Attempt> attempts = { };
+        // Socket descriptors in the order of start of probes (the deadlines are in the same order).
+        std::deque<std::pair<int32_t, clock::time_point>> deadlines = { };
+        // Number of finished probes.
+        std::size_t finished = 0;
+        // Flag that stops the probing.
+        std::atomic<bool> stopped = false;
+
+        ProbeDriver (const uint32_t inFlight, const uint32_t time) noexcept
+            : maximumInFlight((inFlight == 0) ? 1 : inFlight), probeTime(std::chrono::milliseconds(time))
+        { }
+
+        // Selects the next probe or returns false if no probe can be started now.
+        virtual bool NextProbe(void) noexcept = 0;
+        // Starts the selected probe (returns false if the probe should be repeated later).
+        virtual bool StartProbe (SocketStatePool & /*reactor*/) noexcept = 0;
+        // Continues the probe after the event of socket.
+        virtual void ContinueProbe (SocketStatePool & /*reactor*/, int32_t /*fd*/) noexcept = 0;
+        // Finishes the probe which is not completed in time.
+        virtual void ExpireProbe (SocketStatePool & /*reactor*/, int32_t /*fd*/, bool /*connected*/) noexcept = 0;
+
+        /**
+         * @fn bool ProbeDriver::ResolveTarget (const char *, uint16_t, int32_t) noexcept;
+         * @brief Method that resolves the external host and adds it to the targets.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @param [in] family - Family of address (AF_INET, AF_INET6).
+         * @return True - if the host is resolved, otherwise - false.
+         */
+        bool ResolveTarget (const char* host, const uint16_t port, const int32_t family) noexcept
+        {
+            std::vector<SocketAddress> addresses;
+            const int32_t status = ResolverCache::Instance().Resolve(host, port, family, SOCK_STREAM, addresses);
+            if (status != RESOLVER_SUCCESS || addresses.empty() == true) {
+                LOG_ERROR("ProbeDriver.ResolveTarget: Cannot resolve host '", (host != nullptr) ? host : "", "' - ", gai_strerror(status));
+                return false;
+            }
+
+            auto target = system::allocMemoryForObject<Target>();
+            if (target == nullptr) { return false; }
+            target->host = host;
+            target->port = port;
+            target->address = addresses.front();
+            // Addresses are not allowed in SNI extension.
+            struct in6_addr buffer = { };
+            target->named = (inet_pton(AF_INET, host, &buffer) != 1 && inet_pton(AF_INET6, host, &buffer) != 1);
+
+            targets.emplace_back(std::move(target));
+            return true;
+        }
+
+        /**
+         * @fn PROBE_CONNECT ProbeDriver::Connect (SocketStatePool &, const SocketAddress &, Attempt &&, int32_t &, int32_t &) noexcept;
+         * @brief Method that starts the non-blocking connection of probe and adds the probe to the probes in flight.
+         * @param [in] reactor - Reactor of the calling thread.
+         * @param [in] address - Address of external host.
+         * @param [in] attempt - State of probe.
+         * @param [out] fd - Descriptor of socket of probe.
+         * @param [out] error - Error code of connection or local error.
+         * @return PROBE_CONNECT value that indicates the result of start.
+         *
+         * @note If the probe is started with the error, then the connection is already failed and the probe must be finished.
+         */
+        PROBE_CONNECT Connect (SocketStatePool& reactor, const SocketAddress& address, Attempt&& attempt, int32_t& fd, int32_t& error) noexcept
+        {
+            fd = socket(address.storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+            if (fd == INVALID_SOCKET)
+            {
+                error = errno;
+                // Descriptors will be released by the probes in flight.
+                const bool exhausted = (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM);
+                if (exhausted == true && attempts.empty() == false) { return CONNECT_DELAYED; }
+
+                LOG_ERROR("ProbeDriver.Connect: In function 'socket' - ", GET_ERROR(error));
+                return CONNECT_FAILED;
+            }
+
+            // Connection is reset on close, so the local port is released immediately.
+            const struct linger option = { 1, 0 };
+            (void)setsockopt(fd, SOL_SOCKET, SO_LINGER, &option, sizeof(option));
+
+            if (reactor.RegisterSocket(fd, SocketStatePool::TEST_ALWAYS) == false)
+            {
+                close(fd);
+                if (attempts.empty() == false) { return CONNECT_DELAYED; }
+                error = ENOMEM;
+                return CONNECT_FAILED;
+            }
+
+            attempt.start = clock::now();
+            const int32_t status = connect(fd, reinterpret_cast<const struct sockaddr*>(&address.storage), address.length);
+            error = (status == SOCKET_SUCCESS) ? 0 : errno;
+            // Local ports are exhausted, so the probe is repeated after other probes are finished.
+            if (error == EAGAIN && attempts.empty() == false)
+            {
+                reactor.DeleteDescriptor(fd);
+                close(fd);
+                return CONNECT_DELAYED;
+            }
+
+            const clock::time_point start = attempt.start;
+            attempts.emplace(fd, std::move(attempt));
+            // Socket was registered before connection, so the result of connection is reported by the event of reactor.
+            if (error == EINPROGRESS) { error = 0; }
+            if (error == 0) { deadlines.emplace_back(fd, start); }
+            return CONNECT_STARTED;
+        }
+
+        /**
+         * @fn bool ProbeDriver::CheckConnection (SocketStatePool &, int32_t, Attempt &, int32_t &) noexcept;
+         * @brief Method that checks the result of non-blocking connection of probe after the event of socket.
+         * @param [in] reactor - Reactor of the calling thread.
+         * @param [in] fd - Descriptor of socket of probe.
+         * @param [in,out] attempt - State of probe (it is marked as connected).
+         * @param [out] error - Error code of connection.
+         * @return True - if the result of connection is known, otherwise - false.
+         */
+        static bool CheckConnection (SocketStatePool& reactor, const int32_t fd, Attempt& attempt, int32_t& error) noexcept
+        {
+            const uint16_t status = reactor.CheckSocketStatus(fd);
+            if ((status & (SocketStatePool::STATUS_WRITE | SocketStatePool::STATUS_ERROR | SocketStatePool::STATUS_CLOSED)) == 0) { return false; }
+
+            error = 0;
+            socklen_t size = sizeof(error);
+            if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != SOCKET_SUCCESS) { error = errno; }
+            if (error == 0 && (status & SocketStatePool::STATUS_WRITE) == 0) { error = ECONNRESET; }
+            attempt.connected = (error == 0);
+            return true;
+        }
+
+        /**
+         * @fn Attempt ProbeDriver::Release (SocketStatePool &, int32_t) noexcept;
+         * @brief Method that removes the probe from the probes in flight and closes its socket.
+         * @param [in] reactor - Reactor of the calling thread.
+         * @param [in] fd - Descriptor of socket of probe (it must be in flight).
+         * @return State of probe.
+         */
+        Attempt Release (SocketStatePool& reactor, const int32_t fd) noexcept
+        {
+            const auto it = attempts.find(fd);
+            Attempt attempt = std::move(it->second);
+            attempts.erase(it);
+            reactor.DeleteDescriptor(fd);
+            close(fd);
+            return attempt;
+        }
+
+        /**
+         * @fn bool ProbeDriver::Drive() noexcept;
+         * @brief Method that drives all probes by the reactor of the calling thread until they are finished or the probing is stopped.
+         * @return True - if all probes are finished, otherwise - false.
+         *
+         * @note Probes in flight are aborted after stop.
+         */
+        bool Drive(void) noexcept
+        {
+            SocketStatePool& reactor = SocketStatePool::Instance();
+            std::vector<int32_t> ready;
+            bool delayed = false;
+            bool completed = false;
+
+            while (stopped.load(std::memory_order_relaxed) == false)
+            {
+                // New probes are started within the limit of probes in flight.
+                while (attempts.size() < maximumInFlight)
+                {
+                    if (delayed == false)
+                    {
+                        if (NextProbe() == false) { break; }
+                        delayed = true;
+                    }
+                    if (StartProbe(reactor) == false) { break; }
+                    delayed = false;
+                }
+                // Targets which wait for the connection always have the probe in flight.
+                if (delayed == false && attempts.empty() == true)
+                {
+                    completed = true;
+                    break;
+                }
+
+                // Reactor is waited until the nearest deadline of probe.
+                clock::time_point now = clock::now();
+                clock::time_point wake = now + probeTime;
+                if (deadlines.empty() == false) { wake = std::min(wake, deadlines.front().second + probeTime); }
+                const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(wake - now).count() + 1;
+
+                ready.clear();
+                if (reactor.Poll(static_cast<int32_t>(std::max<decltype(wait)>(wait, 0)), ready) == SOCKET_ERROR) { break; }
+                for (const int32_t fd : ready)
+                {
+                    if (attempts.find(fd) != attempts.end()) { ContinueProbe(reactor, fd); }
+                }
+
+                // Probes without answer are finished by deadline (entries of the finished probes are skipped).
+                now = clock::now();
+                while (deadlines.empty() == false && deadlines.front().second + probeTime <= now)
+                {
+                    const auto [ fd, start ] = deadlines.front();
+                    deadlines.pop_front();
+                    const auto it = attempts.find(fd);
+                    if (it != attempts.end() && it->second.start == start) { ExpireProbe(reactor, fd, it->second.connected); }
+                }
+                // Entries of the finished probes are removed from the beginning of queue.
+                while (deadlines.empty() == false)
+                {
+                    const auto it = attempts.find(deadlines.front().first);
+                    if (it != attempts.end() && it->second.start == deadlines.front().second) { break; }
+                    deadlines.pop_front();
+                }
+            }
+
+            // Probes in flight are aborted after stop.
+            for (auto&& [ fd, attempt ] : attempts)
+            {
+                reactor.DeleteDescriptor(fd);
+                close(fd);
+            }
+            attempts.clear();
+            deadlines.clear();
+            return completed;
+        }
+
+    public:
+        ProbeDriver (ProbeDriver &&) = delete;
+        ProbeDriver (const ProbeDriver &) = delete;
+        ProbeDriver & operator= (ProbeDriver &&) = delete;
+        ProbeDriver & operator= (const ProbeDriver &) = delete;
+
+        /**
+         * @fn inline void ProbeDriver::Stop() noexcept;
+         * @brief Method that stops the probing (probes in flight are aborted without results).
+         *
+         * @note Method can be called from handler or from another thread.
+         */
+        inline void Stop(void) noexcept { stopped.store(true, std::memory_order_relaxed); }
+
+        // Return the number of probes in flight.
+        inline std::size_t InFlight(void) const noexcept { return attempts.size(); }
+
+        virtual ~ProbeDriver(void) noexcept
+        {
+            for (auto&& [ fd, attempt ] : attempts) { close(fd); }
+        }
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_PROBE_DRIVER_HPP
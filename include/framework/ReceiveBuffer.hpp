@@ -0,0 +1,159 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_RECEIVE_BUFFER_HPP
+#define PROTOCOL_ANALYZER_RECEIVE_BUFFER_HPP
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <string_view>
+#include <sys/uio.h>
+
+
+#define RECEIVE_CHUNK_SIZE      16384  // Size of one chunk of receive buffer.
+#define MAXIMUM_POOLED_CHUNKS   256    // Maximum number of free chunks in the pool of one thread.
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @class ChunkPool   ReceiveBuffer.hpp   "include/framework/ReceiveBuffer.hpp"
+     * @brief This class defined the per-thread pool of free chunks of receive buffers.
+     *
+     * @note Chunk is returned to the pool of the thread which releases it.
+     */
+    class ChunkPool
+    {
+    private:
+        // Free chunks.
+        std::vector<std::unique_ptr<char[]>> chunks = { };
+        // Number of chunks which are allocated by this pool.
+        std::size_t allocated = 0;
+
+        ChunkPool(void) = default;
+
+    public:
+        ChunkPool (ChunkPool &&) = delete;
+        ChunkPool (const ChunkPool &) = delete;
+        ChunkPool & operator= (ChunkPool &&) = delete;
+        ChunkPool & operator= (const ChunkPool &) = delete;
+
+        /**
+         * @fn static ChunkPool & ChunkPool::Instance() noexcept;
+         * @brief Method that returns the pool of the calling thread.
+         * @return The pool of the calling thread.
+         */
+        static ChunkPool & Instance(void) noexcept;
+
+        // Return the free chunk (nullptr if memory cannot be allocated).
+        std::unique_ptr<char[]> Acquire(void) noexcept;
+        // Return the chunk to the pool.
+        void Release (std::unique_ptr<char[]> && /*chunk*/) noexcept;
+
+        // Return the number of free chunks in the pool.
+        inline std::size_t Size(void) const noexcept { return chunks.size(); }
+        // Return the number of chunks which are allocated by this pool.
+        inline std::size_t Allocated(void) const noexcept { return allocated; }
+
+        ~ChunkPool(void) = default;
+    };
+
+
+    /**
+     * @class ReceiveBuffer   ReceiveBuffer.hpp   "include/framework/ReceiveBuffer.hpp"
+     * @brief This class defined the receive buffer which consists of the chain of fixed-size chunks.
+     *
+     * @note Buffer grows on demand by chunks from ChunkPool, so the steady-state receiving does not allocate memory.
+     * @note Received data is accessed by spans without copying and released by Consume method.
+     */
+    class ReceiveBuffer
+    {
+    private:
+        // Chain of chunks.
+        std::vector<std::unique_ptr<char[]>> chunks = { };
+        // Offset of the first readable byte in the first chunk.
+        std::size_t head = 0;
+        // Offset after the last written byte in the last chunk.
+        std::size_t tail = 0;
+        // Number of readable bytes.
+        std::size_t size = 0;
+
+        // Return the chunks from index to the end of chain to the pool.
+        void ReleaseChunks (std::size_t /*index*/) noexcept;
+
+    public:
+        ReceiveBuffer (ReceiveBuffer &&) = delete;
+        ReceiveBuffer (const ReceiveBuffer &) = delete;
+        ReceiveBuffer & operator= (ReceiveBuffer &&) = delete;
+        ReceiveBuffer & operator= (const ReceiveBuffer &) = delete;
+
+        ReceiveBuffer(void) = default;
+
+        /**
+         * @fn std::pair<char *, std::size_t> ReceiveBuffer::Prepare() noexcept;
+         * @brief Method that returns the free space at the end of buffer (new chunk is added if the last chunk is full).
+         * @return Pointer to the free space and its size (nullptr if memory cannot be allocated).
+         *
+         * @note Written data becomes readable after Commit method.
+         */
+        std::pair<char *, std::size_t> Prepare(void) noexcept;
+
+        // Make the written bytes readable.
+        void Commit (std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn std::size_t ReceiveBuffer::Spans (struct iovec *, std::size_t) const noexcept;
+         * @brief Method that returns the readable data without copying.
+         * @param [out] spans - Array of spans for readable data.
+         * @param [in] count - Number of spans in array.
+         * @return Number of filled spans.
+         */
+        std::size_t Spans (struct iovec * /*spans*/, std::size_t /*count*/) const noexcept;
+
+        /**
+         * @fn std::size_t ReceiveBuffer::Peek (char *, std::size_t, std::size_t) const noexcept;
+         * @brief Method that copies the readable data without consuming.
+         * @param [out] data - Pointer to data buffer.
+         * @param [in] length - Length of data buffer.
+         * @param [in] offset - Offset from the beginning of readable data. Default: 0.
+         * @return Number of copied bytes.
+         */
+        std::size_t Peek (char * /*data*/, std::size_t /*length*/, std::size_t /*offset*/ = 0) const noexcept;
+
+        /**
+         * @fn void ReceiveBuffer::Consume (std::size_t) noexcept;
+         * @brief Method that releases the processed data from the beginning of buffer.
+         * @param [in] length - Number of processed bytes.
+         *
+         * @note Chunks which are completely processed are returned to the pool.
+         */
+        void Consume (std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn void ReceiveBuffer::Compact() noexcept;
+         * @brief Method that moves the readable data to the beginning of the first chunk and returns the free chunks to the pool.
+         */
+        void Compact(void) noexcept;
+
+        // Release all data and chunks.
+        void Clear(void) noexcept;
+
+        // Return the first continuous part of readable data.
+        std::string_view Front(void) const noexcept;
+        // Return the number of readable bytes.
+        inline std::size_t Size(void) const noexcept { return size; }
+        // Return true if there is no readable data.
+        inline bool Empty(void) const noexcept { return (size == 0); }
+        // Return the size of all chunks of buffer.
+        inline std::size_t Capacity(void) const noexcept { return chunks.size() * RECEIVE_CHUNK_SIZE; }
+
+        ~ReceiveBuffer(void) noexcept;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_RECEIVE_BUFFER_HPP
@@ -0,0 +1,231 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_RESOLVER_HPP
+#define PROTOCOL_ANALYZER_RESOLVER_HPP
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <condition_variable>
+#include <netdb.h>
+#include <sys/socket.h>
+
+
+#define DEFAULT_RESOLVER_TTL            60    // Lifetime of the resolved address in cache (sec.).
+#define DEFAULT_RESOLVER_NEGATIVE_TTL   5     // Lifetime of the resolution error in cache (sec.).
+#define DEFAULT_RESOLVER_THREADS        2     // Number of threads for asynchronous resolution.
+#define MAXIMUM_RESOLVER_ENTRIES        4096  // Maximum number of entries in cache.
+
+#define RESOLVER_SUCCESS       0  // Host is resolved.
+#define RESOLVER_NOT_CACHED    1  // Host is not resolved yet (any other result is the error code of getaddrinfo).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @struct SocketAddress   Resolver.hpp   "include/framework/Resolver.hpp"
+     * @brief Structure that contains the pre-resolved address of external host.
+     *
+     * @note Address is resolved once by Socket::ResolveAddress method and then used by any number of send operations.
+     * @note Datagram structures are trivial, so they can be allocated by system::allocMemoryForArray and initialized by '= { }'.
+     */
+    struct SocketAddress
+    {
+        // Address of external host.
+        struct sockaddr_storage storage;
+        // Length of the address (zero if address is not set).
+        socklen_t length;
+    };
+
+    /**
+      * @typedef void (*ResolveHandler) (const char *, uint16_t, int32_t, void *) noexcept;
+      * @brief The type of the handler which is called after the asynchronous resolution.
+      *
+      * @note Handler is called with host, port, result of resolution and user context in the thread of resolver.
+      */
+    using ResolveHandler = void (*) (const char *, uint16_t, int32_t, void *) noexcept;
+
+
+    /**
+     * @class ResolverCache   Resolver.hpp   "include/framework/Resolver.hpp"
+     * @brief This class defined the thread-safe cache of resolved addresses of external hosts.
+     *
+     * @note Entries are keyed by host, port, family and socket type. Errors of resolution are cached with the separate lifetime.
+     * @note The entry of unspecified family (AF_UNSPEC) also serves the requests of AF_INET and AF_INET6 families.
+     * @note The system resolver does not return the TTL of DNS records, so the lifetime of entries is set by SetTimeToLive method.
+     * @note Only one thread resolves the same host at the same time, other threads wait for its result.
+     * @note Asynchronous resolution is performed by internal threads, so the reactor threads are never blocked by resolver.
+     */
+    class ResolverCache
+    {
+        using clock = std::chrono::steady_clock;
+
+    private:
+        /**
+         * @struct Entry
+         * @brief Structure that contains the result of resolution of one host.
+         */
+        struct Entry
+        {
+            // Resolved addresses in the order of getaddrinfo.
+            std::vector<SocketAddress> addresses = { };
+            // Result of resolution (RESOLVER_SUCCESS or error code of getaddrinfo).
+            int32_t status = RESOLVER_NOT_CACHED;
+            // Time after which the entry is not valid.
+            clock::time_point expiration = { };
+            // Flag that indicates that the host is resolving now.
+            bool pending = false;
+        };
+
+        /**
+         * @struct Request
+         * @brief Structure that contains the request for asynchronous resolution.
+         */
+        struct Request
+        {
+            std::string host = { };
+            uint16_t port = 0;
+            int32_t family = AF_UNSPEC;
+            int32_t type = 0;
+            ResolveHandler handler = nullptr;
+            void * context = nullptr;
+        };
+
+        // Mutex for all internal structures.
+        std::mutex mutex = { };
+        // Condition that is notified when the pending entry is resolved.
+        std::condition_variable resolved = { };
+        // Condition that is notified when the new request is added.
+        std::condition_variable requested = { };
+        // Cache of the resolved hosts.
+        std::unordered_map<std::string, Entry> entries = { };
+        // Queue of requests for asynchronous resolution.
+        std::deque<Request> requests = { };
+        // Threads for asynchronous resolution (are started on the first request).
+        std::vector<std::thread> workers = { };
+        // Lifetime of the resolved addresses.
+        std::chrono::seconds positiveTime = std::chrono::seconds(DEFAULT_RESOLVER_TTL);
+        // Lifetime of the resolution errors.
+        std::chrono::seconds negativeTime = std::chrono::seconds(DEFAULT_RESOLVER_NEGATIVE_TTL);
+        // Flag that stops the threads for asynchronous resolution.
+        bool stopped = false;
+
+        ResolverCache(void) = default;
+
+        // Returns the key of the entry in cache.
+        static std::string MakeKey (std::string_view /*host*/, uint16_t /*port*/, int32_t /*family*/, int32_t /*type*/) noexcept;
+        // Resolves the host by system resolver and saves the result in cache.
+        int32_t Update (const std::string & /*key*/, const char * /*host*/, uint16_t /*port*/, int32_t /*family*/, int32_t /*type*/) noexcept;
+        // Returns the addresses of selected family from the entry of unspecified family (must be called under mutex).
+        int32_t FindUnspecified (const char * /*host*/, uint16_t /*port*/, int32_t /*family*/, int32_t /*type*/, std::vector<SocketAddress> & /*addresses*/) noexcept;
+        // Removes the expired entries if the cache is full (must be called under mutex).
+        void Shrink (clock::time_point /*now*/) noexcept;
+        // Thread for asynchronous resolution.
+        void ResolveWorker(void) noexcept;
+
+    public:
+        ResolverCache (ResolverCache &&) = delete;
+        ResolverCache (const ResolverCache &) = delete;
+        ResolverCache & operator= (ResolverCache &&) = delete;
+        ResolverCache & operator= (const ResolverCache &) = delete;
+
+        /**
+         * @fn static ResolverCache & ResolverCache::Instance() noexcept;
+         * @brief Method that returns the instance of the resolver cache singleton class.
+         * @return The instance of singleton ResolverCache class.
+         */
+        static ResolverCache & Instance(void) noexcept;
+
+        /**
+         * @fn void ResolverCache::SetTimeToLive (std::chrono::seconds, std::chrono::seconds) noexcept;
+         * @brief Method that sets the lifetime of entries in cache.
+         * @param [in] positive - Lifetime of the resolved addresses.
+         * @param [in] negative - Lifetime of the resolution errors.
+         *
+         * @note New lifetime is applied to the entries which are resolved after this call.
+         */
+        void SetTimeToLive (std::chrono::seconds /*positive*/, std::chrono::seconds /*negative*/) noexcept;
+
+        /**
+         * @fn int32_t ResolverCache::Resolve (const char *, uint16_t, int32_t, int32_t, std::vector<SocketAddress> &) noexcept;
+         * @brief Method that returns the addresses of external host from cache or resolves them by system resolver.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @param [in] family - Family of addresses (AF_INET, AF_INET6, AF_UNSPEC).
+         * @param [in] type - Type of socket (SOCK_STREAM, SOCK_DGRAM).
+         * @param [out] addresses - Resolved addresses.
+         * @return RESOLVER_SUCCESS or error code of getaddrinfo which can be described by gai_strerror function.
+         *
+         * @warning This method blocks the thread if the host is not cached. Use ResolveAsync method in reactor threads.
+         */
+        int32_t Resolve (const char * /*host*/, uint16_t /*port*/, int32_t /*family*/, int32_t /*type*/, std::vector<SocketAddress> & /*addresses*/) noexcept;
+
+        /**
+         * @fn int32_t ResolverCache::Find (const char *, uint16_t, int32_t, int32_t, std::vector<SocketAddress> &) noexcept;
+         * @brief Method that returns the addresses of external host only from cache without blocking.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @param [in] family - Family of addresses (AF_INET, AF_INET6, AF_UNSPEC).
+         * @param [in] type - Type of socket (SOCK_STREAM, SOCK_DGRAM).
+         * @param [out] addresses - Resolved addresses.
+         * @return RESOLVER_SUCCESS, cached error code of getaddrinfo or RESOLVER_NOT_CACHED if host is not resolved yet.
+         */
+        int32_t Find (const char * /*host*/, uint16_t /*port*/, int32_t /*family*/, int32_t /*type*/, std::vector<SocketAddress> & /*addresses*/) noexcept;
+
+        /**
+         * @fn bool ResolverCache::ResolveAsync (const char *, uint16_t, int32_t, int32_t, ResolveHandler, void *) noexcept;
+         * @brief Method that resolves the external host in the background thread.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @param [in] family - Family of addresses (AF_INET, AF_INET6, AF_UNSPEC).
+         * @param [in] type - Type of socket (SOCK_STREAM, SOCK_DGRAM).
+         * @param [in] handler - Handler which is called after the resolution. Default: nullptr.
+         * @param [in] context - User context for handler. Default: nullptr.
+         * @return True - if the request is accepted, otherwise - false.
+         *
+         * @note If the host is already cached, then the handler is called immediately in the calling thread.
+         * @note The result is available by Find method after the resolution.
+         */
+        bool ResolveAsync (const char * /*host*/, uint16_t /*port*/, int32_t /*family*/, int32_t /*type*/,
+                           ResolveHandler /*handler*/ = nullptr, void * /*context*/ = nullptr) noexcept;
+
+        /**
+         * @fn std::size_t ResolverCache::Prewarm (std::string_view) noexcept;
+         * @brief Method that starts the asynchronous resolution of all targets from the scanner settings file.
+         * @param [in] path - Path to ScannerSettings.json file.
+         * @return Number of targets which are sent for resolution.
+         *
+         * @note Targets are read from Network.Targets array, the lifetime of entries is read from Network.Resolver object.
+         * @note Addresses of all families are resolved for each of the transport alternatives ("tcp/udp", "tls", "dtls").
+         * @note Targets with port outside the range 0-65535 or with unknown transport are skipped.
+         */
+        std::size_t Prewarm (std::string_view /*path*/) noexcept;
+
+        /**
+         * @fn void ResolverCache::Clear() noexcept;
+         * @brief Method that removes all resolved entries from cache.
+         */
+        void Clear(void) noexcept;
+
+        /**
+         * @fn std::size_t ResolverCache::Size() noexcept;
+         * @brief Method that returns the number of entries in cache.
+         * @return Number of entries in cache.
+         */
+        std::size_t Size(void) noexcept;
+
+        ~ResolverCache(void) noexcept;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_RESOLVER_HPP
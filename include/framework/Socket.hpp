@@ -8,8 +8,12 @@
 
 #include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
+#include <string_view>
+#include <unordered_map>
 #include <netdb.h>
+#include <sys/uio.h>
 #include <sys/epoll.h>
 
 #include <openssl/err.h>
@@ -19,7 +23,13 @@
 
 #include "Log.hpp"   // In this header file also defined "Common.hpp".
 #include "Http.hpp"
+#include "Mutex.hpp"
 #include "Notification.hpp"
+#include "Framer.hpp"
+#include "Resolver.hpp"
+#include "ReceiveBuffer.hpp"
+#include "TimingWheel.hpp"
+#include "SocketRing.hpp"
 
 
 #define TCPv4 1
@@ -30,18 +40,23 @@
 #define DEFAULT_PORT     80
 #define DEFAULT_PORT_TLS 443
 
-#define NUMBER_OF_CTX    3
+#define NUMBER_OF_CTX    4
 #define SSL_METHOD_TLS1  0  // 0x0301
 #define SSL_METHOD_TLS11 1  // 0x0302
 #define SSL_METHOD_TLS12 2  // 0x0303
-//#define SSL_METHOD_TLS13 3  // 0x0304
+#define SSL_METHOD_TLS13 3  // 0x0304
+
+#define MAXIMUM_SSL_SESSIONS   1024  // Maximum number of sessions in SSLSessionCache.
 
 #define SOCKET_ERROR     (-1)
 #define INVALID_SOCKET   (-1)
 #define SOCKET_SUCCESS   0
+#define SOCKET_WANT_READ    (-2)  // Non-blocking operation must be repeated after the socket becomes readable.
+#define SOCKET_WANT_WRITE   (-3)  // Non-blocking operation must be repeated after the socket becomes writable.
 
 #define DEFAULT_TIMEOUT       5    // sec.
 #define DEFAULT_TIMEOUT_SSL   7    // sec.
+#define DEFAULT_RECEIVE_IDLE_TIME   1500  // Time without any data after which the receiving of message is finished (milli sec.).
 
 #define DEFAULT_TIME_SIGWAIT   (-1)  // milli sec.
 #define MAXIMUM_SOCKET_DESCRIPTORS   1024  // Maximum descriptors for epoll_wait().
@@ -49,6 +64,13 @@
 
 #define DEFAULT_NO_CHUNK   0  // Chunk part for receive massage.
 
+#define MAXIMUM_DATAGRAMS_IN_BATCH   1024  // Maximum datagrams for one sendmmsg()/recvmmsg() call.
+#define MAXIMUM_SEGMENTS_IN_DATAGRAM   64  // Maximum segments in one UDP_SEGMENT datagram (UDP_MAX_SEGMENTS).
+#define MAXIMUM_UDP_PAYLOAD   65507  // Maximum payload of one UDP datagram over IPv4.
+
+#define ZEROCOPY_MINIMUM_LENGTH   16384  // Minimum payload for MSG_ZEROCOPY send (smaller payloads are copied faster).
+#define SENDFILE_CHUNK_LENGTH     65536  // Size of chunk for sending the file through user space.
+
 
 namespace analyzer::framework::net
 {
@@ -62,55 +84,52 @@ namespace analyzer::framework::net
 
 
     /**
-     * @class SocketStatePool   Socket.hpp   "include/framework/Socket.hpp"
-     * @brief This singleton class defined the interface of checking the status of socket descriptors.
-     *
-     * @note This singleton class is thread-safe.
+     * @struct OutgoingDatagram   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief Structure that describes one datagram of the batch for sending.
      */
-    class SocketStatePool
+    struct OutgoingDatagram
     {
-    private:
-        /**
-         * @var int32_t epoll_fd;
-         * @brief The Epoll descriptor.
-         *
-         * @note Epoll is thread-safe.
-         */
-        int32_t epoll_fd = INVALID_SOCKET;
-
-        /**
-         * @var struct epoll_event * events;
-         * @brief The Epoll event structures.
-         *
-         * @note The size of this structures defined as MAXIMUM_SOCKET_DESCRIPTORS.
-         */
-        std::unique_ptr<struct epoll_event[]> events = nullptr;
-
-        /**
-         * @var std::atomic<uint16_t> countOfDescriptors;
-         * @brief The number of all socket descriptors under observation in current time.
-         */
-        std::atomic<uint16_t> countOfDescriptors = 0;
+        // Pointer to data for sending.
+        const char * data;
+        // Length of sending data.
+        std::size_t length;
+        // Pre-resolved destination address (nullptr for the connected socket).
+        const SocketAddress * destination;
+    };
 
-    protected:
-        /**
-         * @fn SocketStatePool::SocketStatePool() noexcept;
-         * @brief Protect constructor.
-         */
-        SocketStatePool(void) noexcept;
+    /**
+     * @struct IncomingDatagram   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief Structure that describes one datagram of the batch for receiving.
+     */
+    struct IncomingDatagram
+    {
+        // Pointer to data buffer for receiving.
+        char * data;
+        // Length of data buffer.
+        std::size_t length;
+        // Number of received bytes.
+        std::size_t received;
+        // Source address of the received datagram.
+        SocketAddress source;
+        // Flag that indicates that the datagram was truncated because data buffer is too small.
+        bool truncated;
+        // Size of segments if the datagram was coalesced by UDP_GRO (equal to the number of received bytes otherwise).
+        std::size_t segment;
+    };
 
-        /**
-         * @fn SocketStatePool::~SocketStatePool();
-         * @brief Protect default destructor.
-         */
-        ~SocketStatePool(void) = default;
 
+    /**
+     * @class SocketStatePool   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief This class defined the interface of edge-triggered reactor that checks the status of socket descriptors.
+     *
+     * @note Each worker thread has own reactor with one epoll descriptor for all sockets that were created in this thread.
+     * @note The reactor caches the last readiness of each descriptor, so waiting on the ready socket does not require any system call.
+     * @note Public methods of this class are thread-safe, but only the thread that owns the reactor calls epoll_wait and advances its timing wheel.
+     * @note Other threads wait for the statuses of descriptor of the reactor by poll() on this descriptor, so they never steal the edge of epoll.
+     */
+    class SocketStatePool
+    {
     public:
-        SocketStatePool (SocketStatePool &&) = delete;
-        SocketStatePool (const SocketStatePool &) = delete;
-        SocketStatePool & operator= (SocketStatePool &&) = delete;
-        SocketStatePool & operator= (const SocketStatePool &) = delete;
-
         /**
          * @enum SOCKET_STATUS
          * @brief The socket statuses in event notification.
@@ -166,39 +185,204 @@ namespace analyzer::framework::net
          */
         enum TASK_TYPE : uint16_t
         {
-            TASK_TYPE_READ = 0x1,   // .
-            TASK_TYPE_WRITE = 0x2,  // .
-            TASK_TYPE_CLOSE = 0x4,  // .
+            TASK_TYPE_READ = 0x1,   // Notify when descriptor is available for read operations.
+            TASK_TYPE_WRITE = 0x2,  // Notify when descriptor is available for write operations.
+            TASK_TYPE_CLOSE = 0x4,  // Notify when connection is closed by peer.
             TASK_TYPE_ALL = 0x8     // Default task.
         };
 
+    private:
+        /**
+         * @struct DescriptorState
+         * @brief Structure that contains the state of the observed socket descriptor.
+         */
+        struct DescriptorState
+        {
+            // Type of socket descriptor.
+            uint16_t type = TEST_ON_REQUEST;
+            // Last task for socket descriptor.
+            uint16_t task = TASK_TYPE_ALL;
+            // Cached readiness of socket descriptor (zero if no any event was obtained).
+            uint16_t status = 0;
+            // Flag that indicates that the notification was ordered and has not been sent yet.
+            bool ordered = false;
+            // Flag that indicates that the notification was sent and has not been rearmed yet.
+            bool signaled = false;
+            // Flag that indicates that the socket descriptor is registered in epoll set.
+            bool registered = false;
+            // Flag that indicates that the live time of socket descriptor is limited.
+            bool limited = false;
+            // Timer of the live time after which socket descriptor will be deleted from epoll set.
+            WheelTimer timer = { };
+            // Notification for observer thread.
+            std::unique_ptr<task::NotificationInit<SOCKET_STATUS>> notification = nullptr;
+        };
+
+        /**
+         * @var int32_t epoll_fd;
+         * @brief The Epoll descriptor.
+         *
+         * @note Epoll is thread-safe.
+         */
+        int32_t epoll_fd = INVALID_SOCKET;
+
+        /**
+         * @var std::unordered_map<int32_t, DescriptorState> descriptors;
+         * @brief The states of all socket descriptors under observation.
+         */
+        std::unordered_map<int32_t, DescriptorState> descriptors = { };
+
+        /**
+         * @var system::LocalMutex mutex;
+         * @brief Mutex value for thread-safe access to states of socket descriptors.
+         */
+        system::LocalMutex mutex = { };
+
+        /**
+         * @var std::atomic<uint32_t> countOfDescriptors;
+         * @brief The number of all socket descriptors under observation in current time.
+         */
+        std::atomic<uint32_t> countOfDescriptors = 0;
+
+        /**
+         * @var TimingWheel wheel;
+         * @brief The timing wheel of deadlines of operations and live time of descriptors which is advanced by the owner thread.
+         */
+        TimingWheel wheel = { };
+
+        /**
+         * @var std::atomic<std::thread::id> owner;
+         * @brief The thread that drives the reactor (empty identifier if the reactor is not bound to any thread).
+         */
+        std::atomic<std::thread::id> owner = { };
+
+
+        /**
+         * @fn static uint16_t SocketStatePool::ConvertEvents (uint32_t) noexcept;
+         * @brief Method that converts epoll events to the socket statuses.
+         * @param [in] events - Epoll events.
+         * @return Socket statuses in SOCKET_STATUS format.
+         */
+        static uint16_t ConvertEvents (uint32_t /*events*/) noexcept;
+
+        /**
+         * @fn static uint16_t SocketStatePool::ConvertTask (uint16_t) noexcept;
+         * @brief Method that converts task type to the socket statuses which are expected by this task.
+         * @param [in] task - The task type in TASK_TYPE format.
+         * @return Socket statuses in SOCKET_STATUS format.
+         */
+        static uint16_t ConvertTask (uint16_t /*task*/) noexcept;
+
+        /**
+         * @fn void SocketStatePool::ProcessDescriptor (int32_t, DescriptorState &, uint16_t) noexcept;
+         * @brief Method that processes the obtained statuses of socket descriptor and sends notification if needed.
+         * @param [in] fd - Socket descriptor.
+         * @param [in,out] state - State of socket descriptor.
+         * @param [in] obtained - Obtained statuses of socket descriptor.
+         *
+         * @attention Mutex MUST be locked before calling this method.
+         */
+        void ProcessDescriptor (int32_t /*fd*/, DescriptorState & /*state*/, uint16_t /*obtained*/) noexcept;
+
+        /**
+         * @fn void SocketStatePool::Signal (DescriptorState &) noexcept;
+         * @brief Method that sends notification with the current status of socket descriptor.
+         * @param [in,out] state - State of socket descriptor.
+         *
+         * @attention Mutex MUST be locked before calling this method.
+         */
+        static void Signal (DescriptorState & /*state*/) noexcept;
+
+        /**
+         * @fn void SocketStatePool::RemoveExpiredDescriptor (int32_t) noexcept;
+         * @brief Method that deletes from epoll set the socket descriptor with expired live time.
+         * @param [in] fd - Socket descriptor.
+         */
+        void RemoveExpiredDescriptor (int32_t /*fd*/) noexcept;
+
+        /**
+         * @fn static void SocketStatePool::ExpireDescriptor (void *) noexcept;
+         * @brief Handler of the timer of live time which deletes the socket descriptor from the reactor of the calling thread.
+         * @param [in] context - Socket descriptor which is stored in the pointer.
+         *
+         * @note Timers of the reactor are advanced only by its owner thread, so the reactor of the calling thread is the reactor of timer.
+         */
+        static void ExpireDescriptor (void * /*context*/) noexcept;
+
+        /**
+         * @fn int32_t SocketStatePool::PollDescriptor (int32_t, uint16_t, int32_t) noexcept;
+         * @brief Method that waits the events of one socket descriptor by poll() and processes them.
+         * @param [in] fd - Socket descriptor.
+         * @param [in] statuses - Expected statuses in SOCKET_STATUS format.
+         * @param [in] time - Timeout in milliseconds (negative value means infinite waiting).
+         * @return Number of processed events or SOCKET_ERROR if an error occurred.
+         *
+         * @note This method is used by the threads that do not own the reactor instead of epoll_wait.
+         */
+        int32_t PollDescriptor (int32_t /*fd*/, uint16_t /*statuses*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn static SocketStatePool * SocketStatePool::Acquire() noexcept;
+         * @brief Method that returns the free reactor or creates new one.
+         * @return Pointer to the reactor or nullptr if an error occurred.
+         */
+        static SocketStatePool * Acquire(void) noexcept;
+
+        /**
+         * @fn static void SocketStatePool::Release (SocketStatePool *) noexcept;
+         * @brief Method that returns the reactor of the finished thread for reuse by other threads.
+         * @param [in] reactor - Pointer to the reactor.
+         */
+        static void Release (SocketStatePool * /*reactor*/) noexcept;
+
+    protected:
+        /**
+         * @fn SocketStatePool::SocketStatePool() noexcept;
+         * @brief Protect constructor.
+         */
+        SocketStatePool(void) noexcept;
+
+        /**
+         * @fn SocketStatePool::~SocketStatePool();
+         * @brief Protect default destructor.
+         */
+        ~SocketStatePool(void) = default;
+
+    public:
+        SocketStatePool (SocketStatePool &&) = delete;
+        SocketStatePool (const SocketStatePool &) = delete;
+        SocketStatePool & operator= (SocketStatePool &&) = delete;
+        SocketStatePool & operator= (const SocketStatePool &) = delete;
+
         /**
          * @fn static SocketsStatePool & SocketStatePool::Instance() noexcept;
-         * @brief Method that returns the instance of the singleton class.
-         * @return The instance of singleton SocketStatePool class.
+         * @brief Method that returns the reactor of the calling thread.
+         * @return The reactor of the calling thread.
+         *
+         * @note The reactor of the finished thread is not destroyed and will be used by the next new thread.
          */
         static SocketStatePool & Instance(void) noexcept;
 
         /**
-         * @fn bool SocketStatePool::RegisterSocket (int32_t, SOCKET_TYPE, uint32_t) noexcept;
+         * @fn bool SocketStatePool::RegisterSocket (int32_t, uint16_t, uint32_t) noexcept;
          * @brief Method that adds new socket descriptor to common set.
          * @param [in] fd - Socket descriptor.
-         * @param [in] type - Type of socket descriptor. Default: TEST_ON_REQUEST.
+         * @param [in] type - Type of socket descriptor in SOCKET_TYPE format. Default: TEST_ON_REQUEST.
          * @param [in] liveTime - Time (in seconds) during which the socket descriptor is registered. Default: UNLIMITED_LIVE_TIME.
          * @return Boolean value that indicates the adding status.
+         *
+         * @note Socket descriptor is registered in edge-triggered mode for all events only once.
          */
-        //bool RegisterSocket (int32_t /*fd*/, SOCKET_TYPE /*type*/ = TEST_ON_REQUEST, uint32_t /*liveTime*/ = UNLIMITED_LIVE_TIME) noexcept;
+        bool RegisterSocket (int32_t /*fd*/, uint16_t /*type*/ = TEST_ON_REQUEST, uint32_t /*liveTime*/ = UNLIMITED_LIVE_TIME) noexcept;
 
         /**
-         * @fn bool SocketStatePool::ChangeSocketType (int32_t, SOCKET_TYPE) noexcept;
+         * @fn bool SocketStatePool::ChangeSocketType (int32_t, uint16_t) noexcept;
          * @brief Method that change the type of socket descriptor in common set.
          * @param [in] fd - Socket descriptor.
-         * @param [in] type - Type of socket descriptor.
+         * @param [in] type - Type of socket descriptor in SOCKET_TYPE format.
          * @return Boolean value that indicates the changing status.
-         *
-         * @todo Need to implement adding TEST_ALWAYS with NOTIFY_ALWAYS option or other.
          */
-        //bool ChangeSocketType (int32_t /*fd*/, SOCKET_TYPE /*type*/) noexcept;
+        bool ChangeSocketType (int32_t /*fd*/, uint16_t /*type*/) noexcept;
 
         /**
          * @fn SOCKET_STATUS SocketStatePool::CheckSocketStatus (int32_t) noexcept;
@@ -209,15 +393,17 @@ namespace analyzer::framework::net
          * @note Method may returns the STATUS_UNKNOWN status if no any recent result.
          * @note Method may returns the STATUS_DELETE status if socket descriptor is not registered or has been deleted.
          */
-        //SOCKET_STATUS CheckSocketStatus (int32_t /*fd*/) noexcept;
+        SOCKET_STATUS CheckSocketStatus (int32_t /*fd*/) noexcept;
 
         /**
-         * @fn NotificationObserver<SOCKET_STATUS> * SocketStatePool::SetOrderNotification (int32_t) noexcept;
-         * @brief Method that checks socket status.
+         * @fn task::NotificationObserver<SOCKET_STATUS> * SocketStatePool::SetOrderNotification (int32_t) noexcept;
+         * @brief Method that orders the notification about the next status of socket descriptor with the last task type.
          * @param [in] fd - Socket descriptor.
          * @return NotificationObserver pointer that offers an interface for waiting and obtaining the result.
          *
          * @note Method may returns nullptr if an error occurred.
+         * @note If the saved status already satisfies the task then the notification is sent immediately.
+         * @note The pointer is valid until the socket descriptor is deleted or registered again.
          *
          * @warning Use this method only in following cases:
          * @warning 1) If CheckSocketStatus() method return STATUS_UNKNOWN status.
@@ -225,10 +411,10 @@ namespace analyzer::framework::net
          * @warning 3) If used NOTIFY_ALWAYS socket type option.
          * @warning 4) If ChangeSocketType() method is used.
          */
-        //NotificationObserver<SOCKET_STATUS> * SetOrderNotification (int32_t /*fd*/) noexcept;
+        task::NotificationObserver<SOCKET_STATUS> * SetOrderNotification (int32_t /*fd*/) noexcept;
 
         /**
-         * @fn NotificationObserver<SOCKET_STATUS> * SocketStatePool::RegisterTask (int32_t, TASK_TYPE) noexcept;
+         * @fn task::NotificationObserver<SOCKET_STATUS> * SocketStatePool::RegisterTask (int32_t, TASK_TYPE) noexcept;
          * @brief Method that set request for socket descriptor.
          * @param [in] fd - Socket descriptor.
          * @param [in] task - The task for current descriptor. Default: TASK_TYPE_ALL.
@@ -237,22 +423,93 @@ namespace analyzer::framework::net
          * @warning Method may returns nullptr if an error occurred.
          *
          * @attention This method replaces previous request.
-         * @attention MUST NOT use this method with TEST_ALWAYS socket type. First use the method ChangeSocketType().
          */
-        //NotificationObserver<SOCKET_STATUS> * RegisterTask (int32_t /*fd*/, TASK_TYPE /*task*/ = TASK_TYPE_ALL) noexcept;
+        task::NotificationObserver<SOCKET_STATUS> * RegisterTask (int32_t /*fd*/, TASK_TYPE /*task*/ = TASK_TYPE_ALL) noexcept;
+
+        /**
+         * @fn uint16_t SocketStatePool::WaitForStatus (int32_t, uint16_t, int32_t) noexcept;
+         * @brief Method that drives the reactor until the socket descriptor obtains any of the selected statuses.
+         * @param [in] fd - Socket descriptor.
+         * @param [in] statuses - Expected statuses in SOCKET_STATUS format.
+         * @param [in] time - Timeout in milliseconds (negative value means infinite waiting). Default: DEFAULT_TIME_SIGWAIT.
+         * @return All saved statuses of socket descriptor or zero if timeout expired.
+         *
+         * @note Method also returns if the socket descriptor obtains STATUS_ERROR or STATUS_CLOSED status.
+         * @note Events of all other socket descriptors of the reactor are processed during the waiting by the owner thread.
+         * @note Other threads wait only for the selected socket descriptor by poll() without epoll_wait on the shared reactor.
+         * @note Timeout is armed in the timing wheel of the calling thread, so the waiting also advances the timers of this thread.
+         */
+        uint16_t WaitForStatus (int32_t /*fd*/, uint16_t /*statuses*/, int32_t /*time*/ = DEFAULT_TIME_SIGWAIT) noexcept;
+
+        /**
+         * @fn void SocketStatePool::ClearStatus (int32_t, uint16_t) noexcept;
+         * @brief Method that resets the saved statuses of socket descriptor.
+         * @param [in] fd - Socket descriptor.
+         * @param [in] statuses - Reset statuses in SOCKET_STATUS format.
+         *
+         * @attention In edge-triggered mode the status MUST be reset when the operation returns EAGAIN error, otherwise the reactor reports stale readiness.
+         */
+        void ClearStatus (int32_t /*fd*/, uint16_t /*statuses*/) noexcept;
+
+        /**
+         * @fn int32_t SocketStatePool::Poll (int32_t) noexcept;
+         * @brief Method that waits events of all socket descriptors of the reactor and processes them.
+         * @param [in] time - Timeout in milliseconds (negative value means infinite waiting).
+         * @return Number of processed events or SOCKET_ERROR if an error occurred.
+         *
+         * @attention Only the thread that owns the reactor may call this method.
+         */
+        int32_t Poll (int32_t /*time*/) noexcept;
+
+        /**
+         * @fn int32_t SocketStatePool::Poll (int32_t, std::vector<int32_t> &) noexcept;
+         * @brief Method that waits events of all socket descriptors of the reactor, processes them and returns the ready descriptors.
+         * @param [in] time - Timeout in milliseconds (negative value means infinite waiting).
+         * @param [out] ready - Socket descriptors which obtained any event (they are appended to the vector).
+         * @return Number of processed events or SOCKET_ERROR if an error occurred.
+         *
+         * @note This method is intended for engines which drive thousands of socket descriptors by one thread.
+         * @note Waiting time is limited by the nearest deadline of timing wheel and the expired timers are processed after the events.
+         *
+         * @attention Only the thread that owns the reactor may call this method, otherwise SOCKET_ERROR is returned.
+         */
+        int32_t Poll (int32_t /*time*/, std::vector<int32_t> & /*ready*/) noexcept;
+
+        /**
+         * @fn inline TimingWheel & SocketStatePool::GetTimingWheel() noexcept;
+         * @brief Method that returns the timing wheel of the reactor for the deadlines of operations and sessions.
+         * @return The timing wheel of the reactor.
+         *
+         * @note Timers expire only while the owner thread calls Poll or WaitForStatus methods (blocking operations of Socket wait by them).
+         * @note Timing wheel is locked internally, so other threads may arm and cancel timers, but handlers are called by the owner thread.
+         */
+        inline TimingWheel & GetTimingWheel(void) noexcept { return wheel; }
+
+        /**
+         * @fn inline bool SocketStatePool::IsOwnedByCurrentThread() const noexcept;
+         * @brief Method that checks whether the calling thread drives the reactor.
+         * @return True - if the reactor belongs to the calling thread, otherwise - false.
+         */
+        inline bool IsOwnedByCurrentThread(void) const noexcept { return (owner.load(std::memory_order_acquire) == std::this_thread::get_id()); }
 
         /**
          * @fn void SocketStatePool::DeleteDescriptor (int32_t);
          * @brief Method that removes socket descriptor from epoll set.
          * @param [in] fd - Socket descriptor.
-         * @return Boolean value that indicates the removal status.
          *
-         * @note If parameter 'liveTime' was used when socket descriptor was registered, then no need to call this method.
+         * @note If parameter 'liveTime' was used when socket descriptor was registered, then socket descriptor will be removed from epoll set automatically.
          * @note Socket class delete descriptor from pool in destructor.
          *
          * @attention Socket descriptor MUST be deleted if it is no longer needed.
          */
-        //void DeleteDescriptor (int32_t /*fd*/) noexcept;
+        void DeleteDescriptor (int32_t /*fd*/) noexcept;
+
+        /**
+         * @fn inline uint32_t SocketStatePool::DescriptorsCount() const noexcept;
+         * @brief Method that returns the number of all socket descriptors under observation.
+         * @return The number of socket descriptors.
+         */
+        inline uint32_t DescriptorsCount(void) const noexcept { return countOfDescriptors.load(std::memory_order_relaxed); }
     };
 
 
@@ -268,10 +525,26 @@ namespace analyzer::framework::net
         int32_t ipProtocol;
         // Connection timeout.
         uint32_t timeout;
-        // The Epoll descriptor.
-        int32_t epfd = INVALID_SOCKET;
-        // The Epoll events.
-        struct epoll_event event = { };
+        // The reactor in which the socket descriptor is registered.
+        SocketStatePool * pool = nullptr;
+        // The io_uring backend in which the socket descriptor is registered (nullptr if epoll backend is used).
+        SocketRing * ring = nullptr;
+        // Index of the socket descriptor in the table of registered files of the io_uring backend.
+        int32_t ringFile = INVALID_SOCKET;
+        // Flag that indicates that the kernel accepts UDP_SEGMENT (it is reset after the first rejection).
+        bool segmentation = true;
+        // Flag that indicates that UDP_GRO is enabled for the socket.
+        bool coalescing = false;
+        // Flag that indicates that the large payloads are sent with MSG_ZEROCOPY.
+        bool zerocopy = false;
+        // Number of MSG_ZEROCOPY sends (the kernel numbers them from zero).
+        uint32_t zerocopyRequests = 0;
+        // Number of MSG_ZEROCOPY sends whose buffers are released by the kernel.
+        uint32_t zerocopyCompletions = 0;
+        // Receive buffer which grows on demand.
+        ReceiveBuffer input;
+        // Deadline of the current blocking operation in the timing wheel of the calling thread.
+        WheelTimer deadline;
 
         // Set Socket to Non-Blocking state.
         bool SetSocketToNonBlock(void) noexcept;
@@ -285,14 +558,24 @@ namespace analyzer::framework::net
         std::string exHost;
 
 
-        // Checks availability socket on write.
+        // Waits availability socket on write after the operation would block.
         bool IsReadyForSend (int32_t /*time*/ = DEFAULT_TIME_SIGWAIT) noexcept;
-        // Checks availability socket on read.
+        // Waits availability socket on read after the operation would block.
         bool IsReadyForRecv (int32_t /*time*/ = DEFAULT_TIME_SIGWAIT) noexcept;
         // Checks availability socket on read/write.
         uint16_t CheckSocketState (int32_t /*time*/ = DEFAULT_TIME_SIGWAIT) const noexcept;
         // Close after error. MUST NOT use virtual methods in constructors so it is not a virtual method.
         void CloseAfterError(void);
+        // Sends the part of file by chunks through user space with Send method.
+        bool SendFileByCopy (int32_t /*file*/, off_t /*offset*/, std::size_t /*length*/) noexcept;
+        // Arms the deadline of the blocking operation by the timeout of socket in the timing wheel of the calling thread.
+        void StartOperation(void) noexcept;
+        // Returns true if the deadline of the blocking operation has expired (the wheel is advanced while the operation waits).
+        inline bool IsOperationExpired(void) const noexcept { return (deadline.IsArmed() == false); }
+        // Returns the waiting time (in milliseconds) of one wait of the operation which does not exceed its deadline.
+        inline int32_t GetWaitingTime(void) const noexcept { return deadline.GetTimeLeft(); }
+        // Returns the waiting time of one receive operation which does not exceed the deadline and DEFAULT_RECEIVE_IDLE_TIME.
+        int32_t GetReceiveWaitingTime(void) const noexcept;
 
 
     public:
@@ -311,10 +594,37 @@ namespace analyzer::framework::net
 
         // Return Socket descriptor.
         inline int32_t GetFd(void) const noexcept { return fd; }
+        // Return Socket family.
+        inline int32_t GetFamily(void) const noexcept { return socketFamily; }
+        // Return Socket type.
+        inline int32_t GetType(void) const noexcept { return socketType; }
         // Return Timeout of connection.
         inline std::chrono::seconds GetTimeout(void) const noexcept { return std::chrono::seconds(timeout); }
         // Return Socket connection state.
         inline bool IsAlive(void) const noexcept { return (CheckSocketState(3000) != 0); }
+        // Return true if the io_uring backend is used for Connect/Send/Recv/RecvToEnd methods.
+        inline bool IsRingBackendEnabled(void) const noexcept { return (ring != nullptr); }
+
+        /**
+         * @fn bool Socket::EnableRingBackend() noexcept;
+         * @brief Method that switches the socket to the io_uring backend of the calling thread.
+         * @return True - if the io_uring backend is enabled, otherwise - false and the socket keeps using the epoll backend.
+         *
+         * @note In io_uring backend the waiting of each operation is performed by the kernel with the linked timeout.
+         * @note Connect() method waits until connection is established or connection timeout is expired.
+         * @note Operations of all sockets which are registered in the same ring are serialized by the ring.
+         */
+        bool EnableRingBackend(void) noexcept;
+
+        /**
+         * @fn bool Socket::RebindReactor() noexcept;
+         * @brief Method that moves the socket to the reactor (and the io_uring ring) of the calling thread.
+         * @return True - if the socket is observed by the reactor of the calling thread, otherwise - false.
+         *
+         * @note Method must be called when the socket that was created in one thread is used by another thread.
+         * @note Cached status of the socket is reset and the current state of the socket is obtained again by the new reactor.
+         */
+        bool RebindReactor(void) noexcept;
 
 
         // Associates a local address with a socket.
@@ -327,8 +637,73 @@ namespace analyzer::framework::net
         virtual bool Send (const char * /*data*/, std::size_t /*length*/) noexcept;
         // Receiving the message from external host over TCP protocol.
         virtual int32_t Recv (char * /*data*/, std::size_t /*length*/, bool /*noWait*/ = false);
+
+        /**
+         * @fn virtual bool Socket::SendV (const struct iovec *, std::size_t) noexcept;
+         * @brief Method that sends the message which consists of several pieces over TCP protocol without joining them.
+         * @param [in] vector - Array of pieces of the message.
+         * @param [in] count - Number of pieces in array.
+         * @return True - if sending data is successful, otherwise - false.
+         *
+         * @note The SocketCallbackFunctorBeforeSend functor is called for each piece before sending.
+         * @note If MSG_ZEROCOPY is enabled, then the message of ZEROCOPY_MINIMUM_LENGTH bytes and more is sent without copying.
+         */
+        virtual bool SendV (const struct iovec * /*vector*/, std::size_t /*count*/) noexcept;
+
+        /**
+         * @fn virtual bool Socket::SendFile (int32_t, off_t, std::size_t) noexcept;
+         * @brief Method that sends the part of file over TCP protocol by sendfile or splice system calls.
+         * @param [in] file - Descriptor of regular file or pipe.
+         * @param [in] offset - Offset of data in the file (it is ignored for the pipe).
+         * @param [in] length - Length of sending data.
+         * @return True - if sending data is successful, otherwise - false.
+         *
+         * @note The data is read to user space and sent by Send method if the SocketCallbackFunctorBeforeSend functor is set,
+         *       if the io_uring backend is used or if the kernel cannot send the file directly.
+         */
+        virtual bool SendFile (int32_t /*file*/, off_t /*offset*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn bool Socket::EnableZeroCopy() noexcept;
+         * @brief Method that enables MSG_ZEROCOPY mode for the large payloads of Send and SendV methods.
+         * @return True - if SO_ZEROCOPY is enabled, otherwise - false and the payloads are copied to the kernel.
+         *
+         * @note Kernel reports the completion of each send in the error queue of the socket (they are obtained by ReapZeroCopy method).
+         * @note MSG_ZEROCOPY is not used by the io_uring backend.
+         * @warning The buffer of payload must not be changed or released until the send is completed.
+         */
+        bool EnableZeroCopy(void) noexcept;
+
+        /**
+         * @fn int32_t Socket::ReapZeroCopy (int32_t) noexcept;
+         * @brief Method that obtains the completions of MSG_ZEROCOPY sends from the error queue.
+         * @param [in] time - Timeout of waiting for the completion in milliseconds (zero means no waiting). Default: 0.
+         * @return Number of completed sends or error code (error code is less than zero).
+         */
+        int32_t ReapZeroCopy (int32_t /*time*/ = 0) noexcept;
+
+        // Return true if the large payloads are sent with MSG_ZEROCOPY.
+        inline bool IsZeroCopyEnabled(void) const noexcept { return zerocopy; }
+        // Return the number of MSG_ZEROCOPY sends whose buffers are still used by the kernel.
+        inline uint32_t ZeroCopyPending(void) const noexcept { return zerocopyRequests - zerocopyCompletions; }
         // Receiving the message from external host over TCP protocol until the functor returns false value.
         bool Recv (char * /*data*/, std::size_t /*length*/, std::size_t & /*obtainLength*/, CompleteFunctor /*functor*/, std::size_t /*chunkLength*/ = DEFAULT_NO_CHUNK);
+
+        /**
+         * @fn bool Socket::Recv (char *, std::size_t, std::size_t &, Framer &, std::size_t);
+         * @brief Method that receives one frame from external host over TCP protocol.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @param [out] obtainLength - Number of received bytes.
+         * @param [in,out] framer - Framer which detects the end of frame (it is reset before receiving).
+         * @param [in] chunkLength - Maximum length of one receiving if the framer does not know the number of bytes. Default: DEFAULT_NO_CHUNK.
+         * @return True - if the frame is received completely, otherwise - false.
+         *
+         * @note Framer obtains only the new bytes, so the received data is scanned once.
+         * @note If the framer knows the number of bytes, then exactly this number is received (the next frame stays in the socket).
+         * @note The length of frame is returned by Framer::FrameLength method (obtainLength may be greater for delimiter framer).
+         */
+        bool Recv (char * /*data*/, std::size_t /*length*/, std::size_t & /*obtainLength*/, Framer & /*framer*/, std::size_t /*chunkLength*/ = DEFAULT_NO_CHUNK);
         // Receiving the message from external host until reach the end over TCP protocol.
         // 1. The socket is no data to read.
         // 2. Has expired connection timeout.
@@ -336,6 +711,60 @@ namespace analyzer::framework::net
         // 4. The socket has not been informed for reading signal.
         virtual int32_t RecvToEnd (char * /*data*/, std::size_t /*length*/) noexcept;
 
+        /**
+         * @fn int32_t Socket::RecvToBuffer (std::size_t) noexcept;
+         * @brief Method that receives the message until reach the end into the receive buffer of socket.
+         * @param [in] maximum - Maximum number of bytes (zero is unlimited). Default: 0.
+         * @return Number of received bytes or -1 if error occurred.
+         *
+         * @note Buffer grows on demand, so the message is not truncated by the lack of space.
+         * @note Data is received by RecvToEnd method chunk by chunk, so TLS and io_uring backends are supported.
+         * @note Received data is appended to the buffer and stays there until it is consumed.
+         */
+        int32_t RecvToBuffer (std::size_t /*maximum*/ = 0) noexcept;
+
+        // Return the receive buffer of socket.
+        inline ReceiveBuffer & GetReceiveBuffer(void) noexcept { return input; }
+
+        /**
+         * @fn int32_t Socket::StartConnect (const SocketAddress &, const char *) noexcept;
+         * @brief Method that starts the connection to the pre-resolved address without waiting.
+         * @param [in] address - Pre-resolved address of external host.
+         * @param [in] host - Name or IPv4/IPv6 address of external host.
+         * @return SOCKET_SUCCESS if connection is established, SOCKET_WANT_WRITE if connection is in progress, otherwise - SOCKET_ERROR.
+         *
+         * @note Connection in progress is completed by FinishConnect method after the socket becomes writable.
+         */
+        int32_t StartConnect (const SocketAddress & /*address*/, const char * /*host*/) noexcept;
+
+        // Return the result of connection which was in progress (SOCKET_SUCCESS or SOCKET_ERROR).
+        int32_t FinishConnect(void) noexcept;
+
+        /**
+         * @fn virtual int32_t Socket::TrySend (const char *, std::size_t) noexcept;
+         * @brief Method that sends the part of message over TCP protocol without waiting.
+         * @param [in] data - Pointer to data for sending.
+         * @param [in] length - Length of sending data.
+         * @return Number of sent bytes, SOCKET_WANT_READ, SOCKET_WANT_WRITE or SOCKET_ERROR (socket is closed after error).
+         *
+         * @note The SocketCallbackFunctorBeforeSend functor is not called by this method.
+         */
+        virtual int32_t TrySend (const char * /*data*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn virtual int32_t Socket::TryRecv (char *, std::size_t) noexcept;
+         * @brief Method that receives the available data over TCP protocol without waiting.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @return Number of received bytes (zero if connection is closed), SOCKET_WANT_READ, SOCKET_WANT_WRITE or SOCKET_ERROR.
+         *
+         * @note The SocketCallbackFunctorAfterReceive functor is not called by this method.
+         */
+        virtual int32_t TryRecv (char * /*data*/, std::size_t /*length*/) noexcept;
+
+        // Continue the handshake without waiting (SOCKET_SUCCESS, SOCKET_WANT_READ, SOCKET_WANT_WRITE or SOCKET_ERROR).
+        virtual int32_t TryHandshake(void) noexcept { return SOCKET_SUCCESS; }
+
         /**
          * @fn bool Socket::SendTo (const char *, uint16_t, const char *, std::size_t) noexcept;
          * @brief Method that sends message to external host over UDP protocol.
@@ -350,14 +779,102 @@ namespace analyzer::framework::net
         /**
          * @fn int32_t Socket::RecvFrom (const char *, uint16_t, const char *, std::size_t) noexcept;
          * @brief Method that receives message from external host over UDP protocol.
-         * @param [in] host - Name or IPv4/IPv6 address of external host.
-         * @param [in] port - Destination port number.
+         * @param [in] host - Name or IPv4/IPv6 address of external host (nullptr means any host).
+         * @param [in] port - Source port number of external host (zero means any port).
          * @param [in] data - Pointer to data buffer for receiving.
          * @param [in] length - Length of data for receiving.
-         * @return Number of received bytes or error code (error code is less than zero).
+         * @return Number of received bytes (zero if timeout expired) or error code (error code is less than zero).
+         *
+         * @note Datagrams from other hosts which are obtained during the waiting are skipped.
          */
         virtual int32_t RecvFrom (const char * /*host*/, uint16_t /*port*/, char * /*data*/, std::size_t /*length*/) noexcept;
 
+        /**
+         * @fn bool Socket::ResolveAddress (const char *, uint16_t, SocketAddress &) const noexcept;
+         * @brief Method that resolves the address of external host once for the following send operations.
+         * @param [in] host - Name or IPv4/IPv6 address of external host.
+         * @param [in] port - Destination port number.
+         * @param [out] address - Resolved address of external host.
+         * @return True - if address is resolved, otherwise - false.
+         *
+         * @note Connect, SendTo and this method obtain addresses from ResolverCache, so the host is resolved once within its lifetime.
+         */
+        bool ResolveAddress (const char * /*host*/, uint16_t /*port*/, SocketAddress & /*address*/) const noexcept;
+
+        /**
+         * @fn bool Socket::SendTo (const SocketAddress &, const char *, std::size_t) noexcept;
+         * @brief Method that sends message to the pre-resolved address over UDP protocol.
+         * @param [in] destination - Pre-resolved address of external host.
+         * @param [in] data - Pointer to data for sending.
+         * @param [in] length - Length of sending data.
+         * @return True - if sending data is successful, otherwise - false.
+         */
+        bool SendTo (const SocketAddress & /*destination*/, const char * /*data*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn int32_t Socket::SendBatch (const OutgoingDatagram *, std::size_t) noexcept;
+         * @brief Method that sends the batch of datagrams by sendmmsg system calls.
+         * @param [in] datagrams - Array of datagrams for sending.
+         * @param [in] count - Number of datagrams in array.
+         * @return Number of sent datagrams or error code if no any datagram was sent (error code is less than zero).
+         *
+         * @note The SocketCallbackFunctorBeforeSend functor is called for each datagram.
+         * @note Socket is not closed after error because errors of datagram sockets relate to the single destination.
+         */
+        int32_t SendBatch (const OutgoingDatagram * /*datagrams*/, std::size_t /*count*/) noexcept;
+
+        /**
+         * @fn int32_t Socket::RecvBatch (IncomingDatagram *, std::size_t, int32_t) noexcept;
+         * @brief Method that receives the batch of datagrams by recvmmsg system calls.
+         * @param [in,out] datagrams - Array of data buffers for receiving.
+         * @param [in] count - Number of data buffers in array.
+         * @param [in] time - Timeout of waiting for the first datagram in milliseconds. Default: DEFAULT_TIME_SIGWAIT.
+         * @return Number of received datagrams (zero if timeout expired) or error code (error code is less than zero).
+         *
+         * @note Method returns the datagrams which are already available without waiting for filling all data buffers.
+         * @note The SocketCallbackFunctorAfterReceive functor is called for each datagram.
+         */
+        int32_t RecvBatch (IncomingDatagram * /*datagrams*/, std::size_t /*count*/, int32_t /*time*/ = DEFAULT_TIME_SIGWAIT) noexcept;
+
+        // Return true if the equal-sized datagrams are sent by UDP_SEGMENT offload.
+        inline bool IsSegmentationEnabled(void) const noexcept { return segmentation; }
+        // Return true if the received datagrams are coalesced by UDP_GRO offload.
+        inline bool IsCoalescingEnabled(void) const noexcept { return coalescing; }
+
+        /**
+         * @fn int32_t Socket::SendSegmented (const char *, std::size_t, std::size_t, const SocketAddress *) noexcept;
+         * @brief Method that sends the sequence of equal-sized datagrams by UDP_SEGMENT offload.
+         * @param [in] data - Pointer to the continuous data of all datagrams.
+         * @param [in] segmentSize - Size of each datagram.
+         * @param [in] count - Number of datagrams in data.
+         * @param [in] destination - Pre-resolved destination address (nullptr for the connected socket). Default: nullptr.
+         * @return Number of sent datagrams or error code if no any datagram was sent (error code is less than zero).
+         *
+         * @note Kernel splits one large send into up to MAXIMUM_SEGMENTS_IN_DATAGRAM datagrams of segmentSize bytes.
+         * @note If the kernel rejects UDP_SEGMENT, then the datagrams are sent by SendBatch method and offload is not used anymore.
+         * @note If the SocketCallbackFunctorBeforeSend functor is set, then the datagrams are sent by SendBatch method.
+         */
+        int32_t SendSegmented (const char * /*data*/, std::size_t /*segmentSize*/, std::size_t /*count*/, const SocketAddress * /*destination*/ = nullptr) noexcept;
+
+        /**
+         * @fn bool Socket::EnableReceiveCoalescing() noexcept;
+         * @brief Method that enables UDP_GRO offload which coalesces the received equal-sized datagrams.
+         * @return True - if UDP_GRO is enabled, otherwise - false and the datagrams are received one by one.
+         *
+         * @note Coalesced datagram is returned by RecvBatch method as one data buffer with the size of segments.
+         * @warning Data buffers must have MAXIMUM_UDP_PAYLOAD bytes, otherwise the coalesced datagrams are truncated.
+         */
+        bool EnableReceiveCoalescing(void) noexcept;
+
+        /**
+         * @fn virtual bool Socket::IsReusable() noexcept;
+         * @brief Method that checks that the idle connection can be used for the next request.
+         * @return True - if the connection is alive and there is no unread data, otherwise - false.
+         *
+         * @note Closed connection and the rest of the previous response are detected without blocking.
+         */
+        virtual bool IsReusable(void) noexcept;
+
         // Shutdown the connection (SHUT_RD, SHUT_WR, SHUT_RDWR).
         virtual void Shutdown (int32_t /*how*/ = SHUT_RDWR) const;
         // Close the connection.
@@ -368,6 +885,192 @@ namespace analyzer::framework::net
 
 
 
+    /**
+     * @struct SSLSessionStatistics   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief Structure that contains the counters of SSL session cache.
+     */
+    struct SSLSessionStatistics
+    {
+        // Number of connections for which the cached session was offered.
+        uint64_t hits = 0;
+        // Number of connections without cached session (full handshake).
+        uint64_t misses = 0;
+        // Number of offered sessions which were accepted by server (abbreviated handshake).
+        uint64_t resumed = 0;
+        // Number of offered sessions which were rejected by server.
+        uint64_t rejected = 0;
+        // Number of sessions and tickets which were saved after handshake.
+        uint64_t stored = 0;
+    };
+
+    /**
+     * @class SSLSessionCache   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief This class defined the thread-safe cache of client SSL sessions for the resumption of handshake.
+     *
+     * @note Sessions are keyed by host, port, server name and method, so the session is offered only to the server which issued it.
+     * @note Sessions and tickets are saved by OpenSSL callback after handshake and are resumed by SSL_set_session before the next handshake.
+     */
+    class SSLSessionCache
+    {
+    private:
+        // Mutex for all internal structures.
+        system::LocalMutex mutex = { };
+        // Cached sessions (each session holds one reference).
+        std::unordered_map<std::string, SSL_SESSION *> sessions = { };
+        // Counters of cache.
+        SSLSessionStatistics statistics = { };
+
+        SSLSessionCache(void) = default;
+
+        // Removes the expired sessions if the cache is full (must be called under mutex).
+        void Shrink(void) noexcept;
+
+    public:
+        SSLSessionCache (SSLSessionCache &&) = delete;
+        SSLSessionCache (const SSLSessionCache &) = delete;
+        SSLSessionCache & operator= (SSLSessionCache &&) = delete;
+        SSLSessionCache & operator= (const SSLSessionCache &) = delete;
+
+        /**
+         * @fn static SSLSessionCache & SSLSessionCache::Instance() noexcept;
+         * @brief Method that returns the instance of the SSL session cache singleton class.
+         * @return The instance of singleton SSLSessionCache class.
+         */
+        static SSLSessionCache & Instance(void) noexcept;
+
+        // Returns the key of session in cache (profile is the key of SSLContextCache, so the sessions are not shared by different profiles).
+        static std::string MakeKey (std::string_view /*host*/, uint16_t /*port*/, std::string_view /*serverName*/, std::string_view /*profile*/) noexcept;
+        // Returns the key of session in cache for the default profile of method.
+        static std::string MakeKey (std::string_view /*host*/, uint16_t /*port*/, std::string_view /*serverName*/, uint16_t /*method*/) noexcept;
+
+        /**
+         * @fn SSL_SESSION * SSLSessionCache::Find (const std::string &) noexcept;
+         * @brief Method that returns the resumable session from cache.
+         * @param [in] key - Key of session.
+         * @return Session with the additional reference which must be released by SSL_SESSION_free, or nullptr.
+         *
+         * @note Expired sessions are removed from cache. Method updates the hit and miss counters.
+         * @note TLS 1.3 tickets are single-use, so they are removed from cache when they are returned.
+         */
+        SSL_SESSION * Find (const std::string & /*key*/) noexcept;
+
+        /**
+         * @fn void SSLSessionCache::Store (const std::string &, SSL_SESSION *) noexcept;
+         * @brief Method that saves the session in cache instead of previous session of the same key.
+         * @param [in] key - Key of session.
+         * @param [in] session - Session which reference is owned by cache after the call.
+         */
+        void Store (const std::string & /*key*/, SSL_SESSION * /*session*/) noexcept;
+
+        // Update the counters by the result of handshake with the offered session.
+        void Complete (bool /*reused*/) noexcept;
+        // Remove the session of key.
+        void Remove (const std::string & /*key*/) noexcept;
+        // Return the counters of cache.
+        SSLSessionStatistics GetStatistics(void) noexcept;
+        // Return the number of sessions in cache.
+        std::size_t Size(void) noexcept;
+        // Remove all sessions from cache.
+        void Clear(void) noexcept;
+
+        ~SSLSessionCache(void) noexcept;
+    };
+
+
+
+    /**
+     * @struct SSLContextProfile   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief Structure that describes the parameters of client SSL context.
+     *
+     * @note Connections with the same profile share one SSL context from SSLContextCache.
+     */
+    struct SSLContextProfile
+    {
+        // Minimum version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+        uint16_t minimum = SSL_METHOD_TLS12;
+        // Maximum version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+        uint16_t maximum = SSL_METHOD_TLS12;
+        // List of TLS 1.2 and older ciphers in OpenSSL format (empty for the default list).
+        std::string ciphers = { };
+        // ALPN protocols in wire format (empty if ALPN is not used).
+        std::string protocols = { };
+        // Flag that the certificate of server is verified by the default trusted store.
+        bool verify = false;
+        // Path to PEM file with client certificate and its private key (empty if client certificate is not used).
+        std::string certificate = { };
+
+        /**
+         * @fn bool SSLContextProfile::LoadDefinition (std::string_view) noexcept;
+         * @brief Method that reads the profile from the protocol definition file.
+         * @param [in] path - Path to ProtocolDefinition.json file.
+         * @return True - if SSL options are read, otherwise - false.
+         *
+         * @note Options are read from Protocol.NetworkSettings.Global.SSLOptions: Version, SSLClientCertificatePath and exclusions by mask
+         *       (CipherExclusionsByMask, HashExclusionsByMask, PKIExclusionsByMask) which are removed from the default list of ciphers.
+         */
+        bool LoadDefinition (std::string_view /*path*/) noexcept;
+    };
+
+    /**
+     * @class SSLContextCache   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief This class defined the thread-safe cache of client SSL contexts which are shared by all connections with the same profile.
+     *
+     * @note Cipher list, ALPN list and client certificate are parsed and loaded once per profile instead of once per connection.
+     * @note Contexts are reference-counted by OpenSSL: each SSL object holds the reference of its context.
+     */
+    class SSLContextCache
+    {
+    private:
+        // Mutex for all internal structures.
+        system::LocalMutex mutex = { };
+        // Cached contexts (each context holds one reference).
+        std::unordered_map<std::string, SSL_CTX *> contexts = { };
+
+        SSLContextCache(void) = default;
+
+        // Creates the context of profile.
+        static SSL_CTX * Create (const SSLContextProfile & /*profile*/) noexcept;
+
+    public:
+        SSLContextCache (SSLContextCache &&) = delete;
+        SSLContextCache (const SSLContextCache &) = delete;
+        SSLContextCache & operator= (SSLContextCache &&) = delete;
+        SSLContextCache & operator= (const SSLContextCache &) = delete;
+
+        /**
+         * @fn static SSLContextCache & SSLContextCache::Instance() noexcept;
+         * @brief Method that returns the instance of the SSL context cache singleton class.
+         * @return The instance of singleton SSLContextCache class.
+         */
+        static SSLContextCache & Instance(void) noexcept;
+
+        // Returns the key of profile in cache.
+        static std::string MakeKey (const SSLContextProfile & /*profile*/) noexcept;
+
+        /**
+         * @fn SSL_CTX * SSLContextCache::Acquire (const SSLContextProfile &) noexcept;
+         * @brief Method that returns the shared context of profile (context is created by the first call).
+         * @param [in] profile - Parameters of context.
+         * @return Context with the additional reference which must be released by SSL_CTX_free, or nullptr if profile is invalid.
+         */
+        SSL_CTX * Acquire (const SSLContextProfile & /*profile*/) noexcept;
+
+        // Return the number of contexts in cache.
+        std::size_t Size(void) noexcept;
+        // Release the references of cache (context is freed when its last connection is closed).
+        void Clear(void) noexcept;
+
+        ~SSLContextCache(void) noexcept;
+    };
+
+
+
+    /**
+     * @class SSLContext   Socket.hpp   "include/framework/Socket.hpp"
+     * @brief This class defined the client SSL contexts of all supported methods.
+     *
+     * @note Contexts are taken from SSLContextCache and are pinned to one version of protocol.
+     */
     class SSLContext
     {
     private:
@@ -396,12 +1099,34 @@ namespace analyzer::framework::net
 
         static SSLContext context;
 
+        friend class SSLContext;
+        friend class SSLContextCache;
+        // Method of SSL context.
+        uint16_t method = SSL_METHOD_TLS12;
+        // Key of context profile in SSLContextCache which is a part of the session key.
+        std::string profileKey = { };
+        // Key of session in SSLSessionCache (empty if session is not cached).
+        std::string sessionKey = { };
+        // Flag that the cached session is offered in handshake.
+        bool sessionOffered = false;
+
+        // Saves the new session or ticket in SSLSessionCache.
+        static int32_t StoreSession (SSL * /*ssl*/, SSL_SESSION * /*session*/) noexcept;
+        // Updates the counters of SSLSessionCache after handshake.
+        void CompleteSession(void) noexcept;
+        // Sends the data in the first flight of handshake (returns the number of sent bytes or -1 on error).
+        int32_t WriteEarlyData (const char * /*data*/, std::size_t /*length*/) noexcept;
+
         // Returns true when the handshake is complete.
         bool IsHandshakeReady(void) const;
         // Provide handshake between hosts.
         bool DoHandshakeSSL(void);
+        // Creates the SSL object of context with socket BIO.
+        void Initialize (SSL_CTX * /*ctx*/) noexcept;
         // Close after error.
         void SSLCloseAfterError(void);
+        // Send close_notify alert and free the SSL object.
+        void CloseSSL(void) noexcept;
 
     public:
         SocketSSL (SocketSSL &&) = delete;
@@ -415,10 +1140,28 @@ namespace analyzer::framework::net
                             const char * /*ciphers*/ = nullptr,
                             uint32_t     /*timeout*/ = DEFAULT_TIMEOUT_SSL) noexcept;
 
+        /**
+         * @fn explicit SocketSSL::SocketSSL (const SSLContextProfile &, uint32_t) noexcept;
+         * @brief Constructor of socket with the shared context of profile.
+         * @param [in] profile - Parameters of SSL context.
+         * @param [in] timeout - Connection timeout. Default: DEFAULT_TIMEOUT_SSL.
+         */
+        explicit SocketSSL (const SSLContextProfile & /*profile*/, uint32_t /*timeout*/ = DEFAULT_TIMEOUT_SSL) noexcept;
+
         // Connecting to external host.
         bool Connect (const char * /*host*/, uint16_t /*port*/ = DEFAULT_PORT_TLS) final;
         // Sending the message to external host.
         bool Send (const char * /*data*/, std::size_t /*length*/) noexcept final;
+        // Sending the message which consists of several pieces (pieces are joined into TLS records).
+        bool SendV (const struct iovec * /*vector*/, std::size_t /*count*/) noexcept final;
+        // Sending the part of file through user space.
+        bool SendFile (int32_t /*file*/, off_t /*offset*/, std::size_t /*length*/) noexcept final;
+        // Sending the part of message without waiting.
+        int32_t TrySend (const char * /*data*/, std::size_t /*length*/) noexcept final;
+        // Receiving the available data without waiting.
+        int32_t TryRecv (char * /*data*/, std::size_t /*length*/) noexcept final;
+        // Continue the handshake without waiting.
+        int32_t TryHandshake(void) noexcept final;
         // Receiving the message from external host.
         int32_t Recv (char * /*data*/, std::size_t /*length*/, bool /*noWait*/ = false) final;
         // Receiving the message from external host until reach the end.
@@ -430,10 +1173,60 @@ namespace analyzer::framework::net
 
         // Return the SSL object.
         inline SSL * GetSSL(void) const noexcept { return ssl; }
+        // Return the client SSL context of method (nullptr if method is unknown).
+        static inline SSL_CTX * GetContextSSL (const uint16_t method) noexcept { return context.Get(method); }
         // Return the SSL object.
         inline SSL_SESSION * GetSessionSSL(void) const noexcept { return SSL_get_session(ssl); }
         // Set Server Name Indication to TLS extension.
         bool SetServerNameIndication (const std::string & /*serverName*/) const noexcept;
+
+        /**
+         * @fn bool SocketSSL::ResumeSession (const char *, uint16_t) noexcept;
+         * @brief Method that offers the cached session of server in the next handshake and saves the new session after it.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @return True - if the cached session is offered, otherwise - false (full handshake).
+         *
+         * @note Method is called by Connect method after setting SNI. It must be called before the handshake.
+         */
+        bool ResumeSession (const char * /*host*/, uint16_t /*port*/) noexcept;
+
+        // Return true if the session is resumed by the abbreviated handshake.
+        inline bool IsSessionReused(void) const noexcept { return (ssl != nullptr && SSL_session_reused(ssl) == 1); }
+
+        /**
+         * @fn bool SocketSSL::ConnectWithEarlyData (const char *, uint16_t, const char *, std::size_t);
+         * @brief Method that connects to external host and sends the request as TLS 1.3 early data (0-RTT) in the first flight of handshake.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @param [in] data - Request to external host.
+         * @param [in] length - Length of request.
+         * @return True - if the connection is established and the request is delivered, otherwise - false.
+         *
+         * @note Early data is sent only if the cached session of server allows it and the request fits into its limit of early data.
+         * @note If early data is not sent or is rejected by server, the request is sent again after the handshake.
+         * @warning Early data can be replayed by attacker, so only idempotent requests must be sent by this method.
+         */
+        bool ConnectWithEarlyData (const char * /*host*/, uint16_t /*port*/, const char * /*data*/, std::size_t /*length*/);
+
+        // Return true if the early data is accepted by server.
+        inline bool IsEarlyDataAccepted(void) const noexcept { return (ssl != nullptr && SSL_get_early_data_status(ssl) == SSL_EARLY_DATA_ACCEPTED); }
+
+        /**
+         * @fn bool SocketSSL::EnableKernelTLS() noexcept;
+         * @brief Method that requests the kernel TLS (kTLS) offload of records after the handshake.
+         * @return True - if the offload is requested, otherwise - false (OpenSSL is built without kTLS).
+         *
+         * @note Method must be called before Connect method. Keys are installed by OpenSSL after the handshake for the supported ciphers.
+         * @note If the kernel module is missing or the cipher is not supported, the records are silently encrypted in user space.
+         * @note When sending is offloaded, Send, SendV, TrySend and SendFile use the plain socket path (SendFile uses sendfile or splice).
+         * @note Received records are read by SSL_read which only receives the decrypted data from the kernel, because the control records
+         *       (alerts and TLS 1.3 tickets) must be processed by OpenSSL.
+         */
+        bool EnableKernelTLS(void) noexcept;
+
+        // Return true if the sent records are encrypted by the kernel.
+        bool IsKernelSendEnabled(void) const noexcept;
         // Get all available clients ciphers.
         std::vector<std::string> GetCiphersList(void) const noexcept;
         // Use only security ciphers in connection.
@@ -456,6 +1249,8 @@ namespace analyzer::framework::net
 
         // Get current timeout of the SSL session.
         std::size_t GetSessionTimeout(void) const noexcept;
+        // Check that the idle connection is alive and there is no unread application data.
+        bool IsReusable(void) noexcept final;
         // Get selected cipher name in ssl connection.
         std::string GetSelectedCipherName(void) const noexcept;
         // Shutdown the connection. (SHUT_RD, SHUT_WR, SHUT_RDWR).
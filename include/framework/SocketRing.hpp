@@ -0,0 +1,505 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_SOCKET_RING_HPP
+#define PROTOCOL_ANALYZER_SOCKET_RING_HPP
+
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include <sys/socket.h>
+
+#include "Mutex.hpp"
+
+
+// Kernel structures of the submission and completion queue entries (defined in <linux/io_uring.h>).
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+#define RING_QUEUE_ENTRIES        256    // Number of entries in the submission queue of the ring.
+#define RING_REGISTERED_FILES     1024   // Number of slots in the table of registered socket descriptors.
+#define RING_REGISTERED_BUFFERS   8      // Number of registered buffers for the fixed operations.
+#define RING_PROVIDED_BUFFERS     16     // Number of provided buffers for the multishot receive (MUST be a power of two).
+#define RING_BUFFER_SIZE          16384  // Size of each registered and provided buffer in bytes.
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @class SocketRing   SocketRing.hpp   "include/framework/SocketRing.hpp"
+     * @brief This class defined the interface of io_uring I/O backend for non-blocking sockets.
+     *
+     * @note The ring is set up via raw system calls, so liburing is not required. Availability is detected at runtime.
+     * @note Each worker thread has own ring in which the socket descriptors are registered in the table of fixed files.
+     * @note Every operation is linked with the timeout, so the kernel completes or cancels it without any polling by application.
+     * @note Operations can be queued and then submitted together by one system call.
+     *
+     * @attention All results of operations are returned in the form of 'negative errno' in case of error.
+     * @attention Operation which has been cancelled by the linked timeout returns -ETIMEDOUT.
+     */
+    class SocketRing
+    {
+    private:
+        /**
+         * @struct MultishotEvent
+         * @brief Structure that contains the completion of the multishot receive operation.
+         */
+        struct MultishotEvent
+        {
+            // Result of the operation.
+            int32_t result;
+            // Flags of the completion queue entry.
+            uint32_t flags;
+        };
+
+        /**
+         * @struct RingTimeout
+         * @brief Structure that has the layout of the kernel timespec for the linked timeouts.
+         */
+        struct RingTimeout
+        {
+            int64_t seconds;
+            int64_t nanoseconds;
+        };
+
+        /**
+         * @var int32_t ringFd;
+         * @brief The io_uring descriptor.
+         */
+        int32_t ringFd = -1;
+
+        // Mapped memory of the submission queue ring.
+        void * sqRing = nullptr;
+        // Size of the mapped memory of the submission queue ring.
+        std::size_t sqRingSize = 0;
+        // Mapped memory of the completion queue ring (may be the same as submission queue ring).
+        void * cqRing = nullptr;
+        // Size of the mapped memory of the completion queue ring.
+        std::size_t cqRingSize = 0;
+        // Mapped array of the submission queue entries.
+        io_uring_sqe * sqes = nullptr;
+        // Array of the completion queue entries.
+        io_uring_cqe * cqes = nullptr;
+
+        // Pointers to the shared indexes of the submission queue.
+        uint32_t * sqHead = nullptr;
+        uint32_t * sqTail = nullptr;
+        // Pointers to the shared indexes of the completion queue.
+        uint32_t * cqHead = nullptr;
+        uint32_t * cqTail = nullptr;
+        // Masks and sizes of queues.
+        uint32_t sqMask = 0;
+        uint32_t sqEntries = 0;
+        uint32_t cqMask = 0;
+        uint32_t cqEntries = 0;
+
+        /**
+         * @var uint32_t localTail;
+         * @brief The tail of the submission queue including the queued entries which are not published yet.
+         */
+        uint32_t localTail = 0;
+        /**
+         * @var uint32_t queued;
+         * @brief Number of queued entries which are not consumed by the kernel yet.
+         */
+        uint32_t queued = 0;
+        /**
+         * @var uint64_t nextTag;
+         * @brief The tag of the next operation.
+         */
+        uint64_t nextTag = 1;
+
+        /**
+         * @var std::unique_ptr<RingTimeout[]> timeouts;
+         * @brief The timeouts of the linked timeout entries (one for each submission queue entry).
+         *
+         * @note The kernel reads the timeout when the entry is submitted, so storage is reused in cycle.
+         */
+        std::unique_ptr<RingTimeout[]> timeouts = nullptr;
+
+        /**
+         * @var std::unordered_map<uint64_t, int32_t> completions;
+         * @brief Results of the completed operations which have not been obtained yet.
+         *
+         * @note Number of results is bounded by the size of completion queue, the oldest results of the operations which are never waited for are discarded.
+         */
+        std::unordered_map<uint64_t, int32_t> completions = { };
+        /**
+         * @var uint64_t discardedTag;
+         * @brief The tag of the last discarded result of the operation.
+         */
+        uint64_t discardedTag = 0;
+
+        /**
+         * @var std::unique_ptr<int32_t[]> files;
+         * @brief The table of registered socket descriptors (INVALID_SOCKET for free slot).
+         */
+        std::unique_ptr<int32_t[]> files = nullptr;
+        /**
+         * @var uint32_t filesHint;
+         * @brief The slot from which the search of the free slot will start.
+         */
+        uint32_t filesHint = 0;
+
+        // Mapped memory of all registered and provided buffers.
+        std::byte * buffers = nullptr;
+        // Number of registered buffers (zero if buffers could not be registered).
+        uint16_t registeredBuffers = 0;
+
+        // Length of each provided buffer that is owned by the kernel now (zero if buffer is owned by application).
+        uint32_t providedLengths[RING_PROVIDED_BUFFERS] = { };
+        // Total length of all provided buffers that are owned by the kernel now.
+        std::size_t providedTotal = 0;
+
+        /**
+         * @var bool multishotSupported;
+         * @brief Flag that indicates that the kernel supports the multishot receive with the provided buffers.
+         */
+        bool multishotSupported = false;
+        /**
+         * @var uint64_t multishotTag;
+         * @brief The tag of the current multishot receive operation (zero if no any).
+         */
+        uint64_t multishotTag = 0;
+        /**
+         * @var std::unique_ptr<MultishotEvent[]> multishotEvents;
+         * @brief The obtained completions of the current multishot receive operation.
+         */
+        std::unique_ptr<MultishotEvent[]> multishotEvents = nullptr;
+        /**
+         * @var uint32_t multishotEventsCount;
+         * @brief Number of the obtained completions of the current multishot receive operation.
+         */
+        uint32_t multishotEventsCount = 0;
+
+        /**
+         * @var system::LocalMutex mutex;
+         * @brief Mutex value for thread-safe access to the ring.
+         */
+        system::LocalMutex mutex = { };
+
+
+        /**
+         * @fn bool SocketRing::Initialize() noexcept;
+         * @brief Method that sets up the ring, checks the supported operations and registers files and buffers.
+         * @return True - if the ring is ready to use, otherwise - false.
+         */
+        bool Initialize(void) noexcept;
+
+        /**
+         * @fn io_uring_sqe * SocketRing::GetEntry() noexcept;
+         * @brief Method that returns the next free entry of the submission queue.
+         * @return Pointer to the cleared entry or nullptr if the submission queue is full.
+         */
+        io_uring_sqe * GetEntry(void) noexcept;
+
+        /**
+         * @fn bool SocketRing::Reserve (uint32_t) noexcept;
+         * @brief Method that submits the queued entries if the submission queue has no space for the selected number of entries.
+         * @param [in] count - Number of required entries.
+         * @return True - if the required entries are available, otherwise - false.
+         */
+        bool Reserve (uint32_t /*count*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::Enter (uint32_t, uint32_t, int32_t) noexcept;
+         * @brief Method that publishes the queued entries, submits them and waits for the completions.
+         * @param [in] complete - Number of completions to wait for.
+         * @param [in] flags - Flags of io_uring_enter system call.
+         * @param [in] time - Timeout of waiting in milliseconds (negative value means infinite waiting).
+         * @return Number of submitted entries or negative errno if an error occurred.
+         */
+        int32_t Enter (uint32_t /*complete*/, uint32_t /*flags*/, int32_t /*time*/ = -1) noexcept;
+
+        /**
+         * @fn void SocketRing::Reap() noexcept;
+         * @brief Method that moves all entries of the completion queue into the results of the completed operations.
+         */
+        void Reap(void) noexcept;
+
+        /**
+         * @fn void SocketRing::DiscardCompletions() noexcept;
+         * @brief Method that discards the oldest results of the completed operations which are never waited for.
+         */
+        void DiscardCompletions(void) noexcept;
+
+        /**
+         * @fn uint64_t SocketRing::QueueOperation (uint8_t, int32_t, const void *, uint32_t, uint64_t, uint16_t, int32_t) noexcept;
+         * @brief Method that queues the operation over the registered socket descriptor with the linked timeout.
+         * @param [in] opcode - Operation code.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] address - Address field of the operation.
+         * @param [in] length - Length field of the operation.
+         * @param [in] offset - Offset field of the operation.
+         * @param [in] buffer - Index of the registered buffer.
+         * @param [in] time - Timeout of the operation in milliseconds (negative value means no timeout).
+         * @return The tag of the operation or zero if an error occurred.
+         *
+         * @attention Mutex MUST be locked before calling this method.
+         */
+        uint64_t QueueOperation (uint8_t /*opcode*/, int32_t /*file*/, const void * /*address*/, uint32_t /*length*/,
+                                 uint64_t /*offset*/, uint16_t /*buffer*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn bool SocketRing::WaitOperation (uint64_t, int32_t &) noexcept;
+         * @brief Method that waits for the completion of the operation.
+         * @param [in] tag - The tag of the operation.
+         * @param [out] result - The result of the operation.
+         * @return True - if the result is obtained, otherwise - false.
+         *
+         * @attention Mutex MUST be locked before calling this method.
+         */
+        bool WaitOperation (uint64_t /*tag*/, int32_t & /*result*/) noexcept;
+
+        /**
+         * @fn void SocketRing::ProvideBuffers (std::size_t) noexcept;
+         * @brief Method that queues the free buffers for the kernel within the selected budget.
+         * @param [in] budget - The maximum total length of all buffers which are owned by the kernel.
+         */
+        void ProvideBuffers (std::size_t /*budget*/) noexcept;
+
+        /**
+         * @fn void SocketRing::RemoveBuffers() noexcept;
+         * @brief Method that queues the removal of all buffers which are owned by the kernel.
+         */
+        void RemoveBuffers(void) noexcept;
+
+        /**
+         * @fn bool SocketRing::ArmMultishot (int32_t) noexcept;
+         * @brief Method that queues the multishot receive operation.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @return True - if operation is queued, otherwise - false.
+         */
+        bool ArmMultishot (int32_t /*file*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::ConsumeMultishot (char *, std::size_t &, bool &) noexcept;
+         * @brief Method that copies data of the obtained multishot completions and returns their buffers to application.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in,out] idx - Number of bytes in data buffer.
+         * @param [out] active - Flag that is reset if the multishot operation is finished by the kernel.
+         * @return Positive value if receiving may continue, zero if connection is closed or negative errno if an error occurred.
+         */
+        int32_t ConsumeMultishot (char * /*data*/, std::size_t & /*idx*/, bool & /*active*/) noexcept;
+
+        /**
+         * @fn static SocketRing * SocketRing::Acquire() noexcept;
+         * @brief Method that returns the free ring or creates new one.
+         * @return Pointer to the ring or nullptr if io_uring is not supported.
+         */
+        static SocketRing * Acquire(void) noexcept;
+
+        /**
+         * @fn static void SocketRing::Release (SocketRing *) noexcept;
+         * @brief Method that returns the ring of the finished thread for reuse by other threads.
+         * @param [in] ring - Pointer to the ring.
+         */
+        static void Release (SocketRing * /*ring*/) noexcept;
+
+    protected:
+        /**
+         * @fn SocketRing::SocketRing() noexcept;
+         * @brief Protect default constructor.
+         */
+        SocketRing(void) = default;
+
+        /**
+         * @fn SocketRing::~SocketRing() noexcept;
+         * @brief Protect destructor.
+         */
+        ~SocketRing(void) noexcept;
+
+    public:
+        SocketRing (SocketRing &&) = delete;
+        SocketRing (const SocketRing &) = delete;
+        SocketRing & operator= (SocketRing &&) = delete;
+        SocketRing & operator= (const SocketRing &) = delete;
+
+        /**
+         * @fn static bool SocketRing::IsSupported() noexcept;
+         * @brief Method that checks whether the kernel supports all required io_uring operations.
+         * @return True - if io_uring backend can be used, otherwise - false.
+         *
+         * @note The check is performed once per process.
+         */
+        static bool IsSupported(void) noexcept;
+
+        /**
+         * @fn static SocketRing * SocketRing::Instance() noexcept;
+         * @brief Method that returns the ring of the calling thread.
+         * @return Pointer to the ring or nullptr if io_uring is not supported.
+         *
+         * @note The ring of the finished thread is not destroyed and will be used by the next new thread.
+         */
+        static SocketRing * Instance(void) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::RegisterFile (int32_t) noexcept;
+         * @brief Method that registers the socket descriptor in the table of fixed files of the ring.
+         * @param [in] fd - Socket descriptor.
+         * @return Index of the registered socket descriptor or INVALID_SOCKET if an error occurred.
+         *
+         * @attention The registered socket descriptor MUST be unregistered before it is closed.
+         */
+        int32_t RegisterFile (int32_t /*fd*/) noexcept;
+
+        /**
+         * @fn void SocketRing::UnregisterFile (int32_t) noexcept;
+         * @brief Method that removes the socket descriptor from the table of fixed files of the ring.
+         * @param [in] file - Index of the registered socket descriptor.
+         */
+        void UnregisterFile (int32_t /*file*/) noexcept;
+
+        /**
+         * @fn uint64_t SocketRing::QueueConnect (int32_t, const struct sockaddr *, socklen_t, int32_t) noexcept;
+         * @brief Method that queues the connection of the registered socket descriptor.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] addr - Address of the external host.
+         * @param [in] size - Size of the address.
+         * @param [in] time - Timeout of the operation in milliseconds (negative value means no timeout).
+         * @return The tag of the operation or zero if an error occurred.
+         *
+         * @attention The address MUST be valid until the operation is completed.
+         */
+        uint64_t QueueConnect (int32_t /*file*/, const struct sockaddr * /*addr*/, socklen_t /*size*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn uint64_t SocketRing::QueueSend (int32_t, const char *, std::size_t, int32_t) noexcept;
+         * @brief Method that queues the sending of data over the registered socket descriptor.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] data - Pointer to data for sending.
+         * @param [in] length - Length of sending data.
+         * @param [in] time - Timeout of the operation in milliseconds (negative value means no timeout).
+         * @return The tag of the operation or zero if an error occurred.
+         */
+        uint64_t QueueSend (int32_t /*file*/, const char * /*data*/, std::size_t /*length*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn uint64_t SocketRing::QueueRecv (int32_t, char *, std::size_t, int32_t) noexcept;
+         * @brief Method that queues the receiving of data over the registered socket descriptor.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @param [in] time - Timeout of the operation in milliseconds (negative value means no timeout).
+         * @return The tag of the operation or zero if an error occurred.
+         */
+        uint64_t QueueRecv (int32_t /*file*/, char * /*data*/, std::size_t /*length*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn uint64_t SocketRing::QueueSendFixed (int32_t, uint16_t, std::size_t, int32_t) noexcept;
+         * @brief Method that queues the sending of data from the registered buffer.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] buffer - Index of the registered buffer.
+         * @param [in] length - Length of sending data.
+         * @param [in] time - Timeout of the operation in milliseconds (negative value means no timeout).
+         * @return The tag of the operation or zero if an error occurred.
+         */
+        uint64_t QueueSendFixed (int32_t /*file*/, uint16_t /*buffer*/, std::size_t /*length*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn uint64_t SocketRing::QueueRecvFixed (int32_t, uint16_t, std::size_t, int32_t) noexcept;
+         * @brief Method that queues the receiving of data into the registered buffer.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] buffer - Index of the registered buffer.
+         * @param [in] length - Length of data for receiving.
+         * @param [in] time - Timeout of the operation in milliseconds (negative value means no timeout).
+         * @return The tag of the operation or zero if an error occurred.
+         */
+        uint64_t QueueRecvFixed (int32_t /*file*/, uint16_t /*buffer*/, std::size_t /*length*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::Submit() noexcept;
+         * @brief Method that submits all queued operations by one system call.
+         * @return Number of submitted entries or negative errno if an error occurred.
+         */
+        int32_t Submit(void) noexcept;
+
+        /**
+         * @fn bool SocketRing::WaitCompletion (uint64_t, int32_t &) noexcept;
+         * @brief Method that submits all queued operations and waits for the completion of the selected operation.
+         * @param [in] tag - The tag of the operation.
+         * @param [out] result - The result of the operation.
+         * @return True - if the result is obtained, otherwise - false.
+         *
+         * @note The ring keeps no more results than the size of completion queue, so the operation must be waited for before the newer operations overflow it.
+         */
+        bool WaitCompletion (uint64_t /*tag*/, int32_t & /*result*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::Connect (int32_t, const struct sockaddr *, socklen_t, int32_t) noexcept;
+         * @brief Method that connects the registered socket descriptor to the external host.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] addr - Address of the external host.
+         * @param [in] size - Size of the address.
+         * @param [in] time - Timeout of the operation in milliseconds.
+         * @return Zero if connection is established or negative errno if an error occurred.
+         */
+        int32_t Connect (int32_t /*file*/, const struct sockaddr * /*addr*/, socklen_t /*size*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::Send (int32_t, const char *, std::size_t, int32_t) noexcept;
+         * @brief Method that sends data over the registered socket descriptor.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [in] data - Pointer to data for sending.
+         * @param [in] length - Length of sending data.
+         * @param [in] time - Timeout of the operation in milliseconds.
+         * @return Number of sent bytes or negative errno if an error occurred.
+         */
+        int32_t Send (int32_t /*file*/, const char * /*data*/, std::size_t /*length*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::Recv (int32_t, char *, std::size_t, int32_t) noexcept;
+         * @brief Method that receives data over the registered socket descriptor.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @param [in] time - Timeout of the operation in milliseconds.
+         * @return Number of received bytes (zero if connection is closed) or negative errno if an error occurred.
+         */
+        int32_t Recv (int32_t /*file*/, char * /*data*/, std::size_t /*length*/, int32_t /*time*/) noexcept;
+
+        /**
+         * @fn int32_t SocketRing::RecvMultishot (int32_t, char *, std::size_t, int32_t, int32_t) noexcept;
+         * @brief Method that receives data by one multishot operation until reach the end.
+         * @param [in] file - Index of the registered socket descriptor.
+         * @param [out] data - Pointer to data buffer for receiving.
+         * @param [in] length - Length of data buffer.
+         * @param [in] idleTime - Time in milliseconds without any data after which the receiving is finished.
+         * @param [in] totalTime - Time in milliseconds after which the receiving is finished.
+         * @return Number of received bytes or negative errno if an error occurred.
+         *
+         * @note Kernel never obtains more buffers than the free space of data buffer, so no any data is lost after finish.
+         * @note Method returns -EOPNOTSUPP if the multishot receive is not supported by the kernel.
+         */
+        int32_t RecvMultishot (int32_t /*file*/, char * /*data*/, std::size_t /*length*/, int32_t /*idleTime*/, int32_t /*totalTime*/) noexcept;
+
+        /**
+         * @fn char * SocketRing::GetBuffer (uint16_t) const noexcept;
+         * @brief Method that returns the registered buffer.
+         * @param [in] buffer - Index of the registered buffer.
+         * @return Pointer to the registered buffer of RING_BUFFER_SIZE bytes or nullptr if index is invalid.
+         */
+        char * GetBuffer (uint16_t /*buffer*/) const noexcept;
+
+        /**
+         * @fn inline uint16_t SocketRing::BuffersCount() const noexcept;
+         * @brief Method that returns the number of the registered buffers.
+         * @return Number of the registered buffers.
+         */
+        inline uint16_t BuffersCount(void) const noexcept { return registeredBuffers; }
+
+        /**
+         * @fn inline bool SocketRing::IsMultishotSupported() const noexcept;
+         * @brief Method that checks whether the multishot receive can be used.
+         * @return True - if the multishot receive is supported, otherwise - false.
+         */
+        inline bool IsMultishotSupported(void) const noexcept { return multishotSupported; }
+    };
+
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_SOCKET_RING_HPP
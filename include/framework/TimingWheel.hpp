@@ -0,0 +1,170 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_TIMING_WHEEL_HPP
+#define PROTOCOL_ANALYZER_TIMING_WHEEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include "Mutex.hpp"
+
+
+#define TIMING_WHEEL_LEVELS      4    // Number of levels of timing wheel (the range of deadlines is 2^32 ms).
+#define TIMING_WHEEL_SLOT_BITS   8    // Number of bits of slot index on each level.
+#define TIMING_WHEEL_SLOTS       (1U << TIMING_WHEEL_SLOT_BITS)  // Number of slots on each level.
+
+
+namespace analyzer::framework::net
+{
+    class TimingWheel;
+
+    /**
+     * @typedef void (*TimerHandler) (void *) noexcept;
+     * @brief Function which is called when the deadline of timer expires.
+     */
+    using TimerHandler = void (*) (void *) noexcept;
+
+
+    /**
+     * @class WheelTimer   TimingWheel.hpp   "include/framework/TimingWheel.hpp"
+     * @brief This class defined the deadline which is stored in the slot of timing wheel without memory allocation.
+     *
+     * @note Timer is cancelled automatically in destructor, so it can be a member of session or operation.
+     */
+    class WheelTimer
+    {
+        friend class TimingWheel;
+
+    private:
+        // Neighbours of timer in the list of slot.
+        WheelTimer * prev = nullptr;
+        WheelTimer * next = nullptr;
+        // Wheel where the timer is armed (nullptr if timer is not armed).
+        std::atomic<TimingWheel *> wheel = nullptr;
+        // Tick of expiration.
+        uint64_t expiry = 0;
+        // Index of slot in the wheel (level * TIMING_WHEEL_SLOTS + index on level).
+        std::size_t slot = 0;
+        // Function which is called at expiration.
+        TimerHandler handler = nullptr;
+        // Argument of handler.
+        void * context = nullptr;
+
+    public:
+        WheelTimer (WheelTimer &&) = delete;
+        WheelTimer (const WheelTimer &) = delete;
+        WheelTimer & operator= (WheelTimer &&) = delete;
+        WheelTimer & operator= (const WheelTimer &) = delete;
+
+        explicit WheelTimer (TimerHandler function = nullptr, void * argument = nullptr) noexcept
+            : handler(function), context(argument)
+        { }
+
+        // Set the function which is called at expiration.
+        inline void SetHandler (TimerHandler function, void * argument) noexcept { handler = function; context = argument; }
+        // Return true if timer is armed.
+        inline bool IsArmed(void) const noexcept { return (wheel.load(std::memory_order_acquire) != nullptr); }
+
+        // Cancel the timer if it is armed.
+        void Cancel(void) noexcept;
+        // Return the time in milliseconds until expiration (zero if timer is not armed).
+        int32_t GetTimeLeft(void) const noexcept;
+
+        ~WheelTimer(void) noexcept { Cancel(); }
+    };
+
+
+    /**
+     * @class TimingWheel   TimingWheel.hpp   "include/framework/TimingWheel.hpp"
+     * @brief This class defined the hierarchical timing wheel with millisecond ticks on the monotonic clock.
+     *
+     * @note Arm and Cancel methods take constant time. Timers of upper levels are moved to lower levels once per slot rotation.
+     * @note All methods lock the wheel, so timers may be armed and cancelled by any thread, but the wheel is advanced by the thread of reactor which owns it.
+     * @note Wheel of the reactor is advanced only by the thread which owns it (SocketStatePool::Poll and SocketStatePool::WaitForStatus).
+     *       It holds the deadlines of blocking Socket operations (also the timeouts of their io_uring operations), the live time
+     *       of registered descriptors and the timers of engines and the coroutine loop which drive the reactor.
+     */
+    class TimingWheel
+    {
+    private:
+        // Mutex for the slots and the current tick of the wheel.
+        mutable system::LocalMutex mutex = { };
+        // Lists of timers in the slots of all levels.
+        WheelTimer * slots[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOTS] = { };
+        // Bitmaps of non-empty slots of all levels.
+        uint64_t occupied[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOTS / 64] = { };
+        // Number of armed timers on each level.
+        std::size_t levels[TIMING_WHEEL_LEVELS] = { };
+        // The last processed tick.
+        uint64_t current = 0;
+        // Time point of zero tick.
+        const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+        // Add the timer to the slot which corresponds to its expiration.
+        void Insert (WheelTimer & /*timer*/) noexcept;
+        // Remove the timer from its slot.
+        void Remove (WheelTimer & /*timer*/) noexcept;
+        // Return the nearest tick after the current tick when any slot must be processed (zero if there are no timers).
+        uint64_t GetNextTick(void) const noexcept;
+        // Return the index of the first non-empty slot of level starting from the index (TIMING_WHEEL_SLOTS if all slots are empty).
+        std::size_t FindSlot (std::size_t /*level*/, std::size_t /*index*/) const noexcept;
+
+    public:
+        TimingWheel (TimingWheel &&) = delete;
+        TimingWheel (const TimingWheel &) = delete;
+        TimingWheel & operator= (TimingWheel &&) = delete;
+        TimingWheel & operator= (const TimingWheel &) = delete;
+
+        TimingWheel(void) = default;
+
+        /**
+         * @fn void TimingWheel::Arm (WheelTimer &, std::chrono::milliseconds) noexcept;
+         * @brief Method that arms or re-arms the timer.
+         * @param [in,out] timer - Timer which is stored in the wheel until expiration or cancellation.
+         * @param [in] delay - Time until expiration.
+         *
+         * @note Timer never expires before the delay, and expires not later than one tick after it.
+         */
+        void Arm (WheelTimer & /*timer*/, std::chrono::milliseconds /*delay*/) noexcept;
+
+        // Cancel the timer if it is armed in this wheel.
+        void Cancel (WheelTimer & /*timer*/) noexcept;
+
+        /**
+         * @fn std::size_t TimingWheel::Advance() noexcept;
+         * @brief Method that moves the wheel to the current time and calls the handlers of expired timers.
+         * @return Number of expired timers.
+         *
+         * @note Handlers are called without lock, so they may arm and cancel any timers of the wheel.
+         * @warning Timer which is cancelled by another thread during Advance may still be reported to its handler.
+         */
+        std::size_t Advance(void) noexcept;
+
+        /**
+         * @fn int32_t TimingWheel::GetWaitingTime (int32_t) const noexcept;
+         * @brief Method that limits the waiting time of reactor by the nearest expiration.
+         * @param [in] time - Waiting time in milliseconds (negative value - infinite).
+         * @return Waiting time which does not exceed the time until the nearest expiration.
+         */
+        int32_t GetWaitingTime (int32_t /*time*/) const noexcept;
+
+        // Return the time in milliseconds until expiration of the timer (zero if timer is not armed in this wheel).
+        int32_t GetTimeLeft (const WheelTimer & /*timer*/) const noexcept;
+
+        // Return the current tick of the monotonic clock.
+        uint64_t GetTick(void) const noexcept;
+        // Return the number of armed timers.
+        std::size_t Size(void) const noexcept;
+
+        ~TimingWheel(void) noexcept;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_TIMING_WHEEL_HPP
@@ -0,0 +1,160 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_TLS_ENGINE_HPP
+#define PROTOCOL_ANALYZER_TLS_ENGINE_HPP
+
+#include "Socket.hpp"
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @class TlsEngine   TlsEngine.hpp   "include/framework/TlsEngine.hpp"
+     * @brief This class defined the TLS state machine which is decoupled from the socket descriptor by the pair of memory BIOs.
+     *
+     * @note Encrypted bytes are fed into the engine by Feed methods and are taken from the output buffer, so the engine can be driven
+     *       by any reactor, by io_uring or by the other engine in the same process.
+     * @note Records which are written between two transmissions are accumulated in the output buffer and are sent together.
+     * @note Methods return the codes of non-blocking socket operations: SOCKET_WANT_READ means that the engine waits for encrypted input.
+     */
+    class TlsEngine
+    {
+    private:
+        // SSL object.
+        SSL * ssl = nullptr;
+        // Memory BIO of encrypted input (owned by SSL object).
+        BIO * input = nullptr;
+        // Memory BIO of encrypted output (owned by SSL object).
+        BIO * output = nullptr;
+        // Encrypted output which is not transmitted yet.
+        ReceiveBuffer pending;
+        // Method of SSL context (NUMBER_OF_CTX for the external context).
+        uint16_t method = NUMBER_OF_CTX;
+        // Key of session in SSLSessionCache (empty if session is not cached).
+        std::string sessionKey = { };
+        // Flag that the cached session is offered in handshake.
+        bool sessionOffered = false;
+
+        // Creates the SSL object with the pair of memory BIOs.
+        void Initialize (SSL_CTX * /*ctx*/, bool /*server*/) noexcept;
+        // Returns the result of SSL operation as the result of non-blocking socket operation.
+        int32_t GetResult (int32_t /*result*/, const char * /*function*/) noexcept;
+
+    public:
+        TlsEngine (TlsEngine &&) = delete;
+        TlsEngine (const TlsEngine &) = delete;
+        TlsEngine & operator= (TlsEngine &&) = delete;
+        TlsEngine & operator= (const TlsEngine &) = delete;
+
+        // Constructor of client engine with the context of SocketSSL.
+        explicit TlsEngine (uint16_t /*method*/ = SSL_METHOD_TLS12) noexcept;
+
+        /**
+         * @fn TlsEngine::TlsEngine (SSL_CTX *, bool) noexcept;
+         * @brief Constructor of engine with the external context.
+         * @param [in] ctx - SSL context (the engine holds its reference).
+         * @param [in] server - Flag that the engine accepts the handshake of client.
+         */
+        TlsEngine (SSL_CTX * /*ctx*/, bool /*server*/) noexcept;
+
+        // Return true if the engine is created successfully.
+        inline bool IsValid(void) const noexcept { return (ssl != nullptr); }
+        // Return the SSL object.
+        inline SSL * GetSSL(void) const noexcept { return ssl; }
+        // Return true when the handshake is complete.
+        inline bool IsHandshakeReady(void) const noexcept { return (ssl != nullptr && SSL_is_init_finished(ssl) == 1); }
+        // Return true if the session is resumed by the abbreviated handshake.
+        inline bool IsSessionReused(void) const noexcept { return (ssl != nullptr && SSL_session_reused(ssl) == 1); }
+
+        // Set Server Name Indication to TLS extension.
+        bool SetServerNameIndication (const std::string & /*serverName*/) const noexcept;
+
+        /**
+         * @fn bool TlsEngine::ResumeSession (const char *, uint16_t) noexcept;
+         * @brief Method that offers the cached session of server in the next handshake and saves the new session after it.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host.
+         * @return True - if the cached session is offered, otherwise - false (full handshake).
+         *
+         * @note Sessions are shared with SocketSSL through SSLSessionCache. Method must be called after setting SNI and before the handshake.
+         */
+        bool ResumeSession (const char * /*host*/, uint16_t /*port*/) noexcept;
+
+        /**
+         * @fn int32_t TlsEngine::Handshake() noexcept;
+         * @brief Method that continues the handshake with the fed encrypted input.
+         * @return SOCKET_SUCCESS if handshake is complete, SOCKET_WANT_READ if more input is needed, otherwise - SOCKET_ERROR.
+         *
+         * @note Handshake messages are appended to the encrypted output which must be transmitted to the peer.
+         */
+        int32_t Handshake(void) noexcept;
+
+        /**
+         * @fn int32_t TlsEngine::Write (const char *, std::size_t) noexcept;
+         * @brief Method that encrypts the data into the records of encrypted output.
+         * @param [in] data - Pointer to data.
+         * @param [in] length - Length of data.
+         * @return Number of encrypted bytes, SOCKET_WANT_READ if handshake is not complete, otherwise - SOCKET_ERROR.
+         */
+        int32_t Write (const char * /*data*/, std::size_t /*length*/) noexcept;
+
+        /**
+         * @fn int32_t TlsEngine::Read (char *, std::size_t) noexcept;
+         * @brief Method that decrypts the fed records.
+         * @param [out] data - Pointer to data buffer.
+         * @param [in] length - Length of data buffer.
+         * @return Number of decrypted bytes, zero if peer closed TLS connection, SOCKET_WANT_READ if more input is needed, otherwise - SOCKET_ERROR.
+         *
+         * @note Post-handshake messages (for example: TLS 1.3 tickets) are processed by this method.
+         */
+        int32_t Read (char * /*data*/, std::size_t /*length*/) noexcept;
+
+        // Decrypt all available records into the buffer (returns the result of the last Read).
+        int32_t Read (ReceiveBuffer & /*buffer*/) noexcept;
+
+        // Append the encrypted input which is received from the peer.
+        bool Feed (const char * /*data*/, std::size_t /*length*/) noexcept;
+        // Append and consume all encrypted input of the buffer.
+        bool Feed (ReceiveBuffer & /*buffer*/) noexcept;
+
+        /**
+         * @fn ReceiveBuffer & TlsEngine::GetOutput() noexcept;
+         * @brief Method that moves the encrypted records into the output buffer and returns it.
+         * @return Output buffer whose transmitted bytes must be released by Consume method.
+         *
+         * @note Buffer is read by Spans method, so all accumulated records can be sent by one vectored operation.
+         */
+        ReceiveBuffer & GetOutput(void) noexcept;
+
+        // Return the number of bytes of encrypted output.
+        std::size_t PendingOutput(void) const noexcept;
+
+        /**
+         * @fn int32_t TlsEngine::Transmit (Socket &) noexcept;
+         * @brief Method that sends the encrypted output to non-blocking socket without waiting.
+         * @param [in] socket - Connected socket without TLS.
+         * @return Number of sent bytes, SOCKET_WANT_WRITE if the rest of output must be sent when socket becomes writable, otherwise - SOCKET_ERROR.
+         */
+        int32_t Transmit (Socket & /*socket*/) noexcept;
+
+        /**
+         * @fn int32_t TlsEngine::Receive (Socket &) noexcept;
+         * @brief Method that feeds the available data of non-blocking socket to the engine without waiting.
+         * @param [in] socket - Connected socket without TLS.
+         * @return Number of fed bytes, zero if connection is closed, SOCKET_WANT_READ if there is no data, otherwise - SOCKET_ERROR.
+         */
+        int32_t Receive (Socket & /*socket*/) noexcept;
+
+        // Append close_notify alert to the encrypted output.
+        bool Shutdown(void) noexcept;
+
+        ~TlsEngine(void) noexcept;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_TLS_ENGINE_HPP
@@ -0,0 +1,302 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_TLS_HELLO_PROBER_HPP
+#define PROTOCOL_ANALYZER_TLS_HELLO_PROBER_HPP
+
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <string_view>
+#include <unordered_map>
+
+#include "Socket.hpp"
+#include "ProbeDriver.hpp"
+#include "BinaryStructuredDataEngine.hpp"
+
+
+#define DEFAULT_HELLO_PROBE_IN_FLIGHT   512   // Maximum number of ClientHello probes at the same time.
+#define DEFAULT_HELLO_PROBE_TIME        3000  // Time of one ClientHello probe: connection and answer of server (milli sec.).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @enum HELLO_STATE
+     * @brief The result of ClientHello probe.
+     */
+    enum HELLO_STATE : uint8_t
+    {
+        HELLO_ACCEPTED = 0,     // Server answered ServerHello or HelloRetryRequest with the selected cipher suite.
+        HELLO_REJECTED = 1,     // Server answered alert, closed connection or selected another version: no more offered cipher suites are accepted.
+        HELLO_UNREACHABLE = 2,  // Connection is not established (the other probes of the host are skipped).
+        HELLO_SKIPPED = 3,      // Probe is not started because the host is unreachable.
+        HELLO_ERROR = 4         // Answer is malformed or is not received in time, or local error of probe.
+    };
+
+    /**
+     * @enum SERVER_ANSWER
+     * @brief The result of parsing of the answer to ClientHello.
+     */
+    enum SERVER_ANSWER : int8_t
+    {
+        ANSWER_MALFORMED = -1,  // Answer is not TLS handshake.
+        ANSWER_INCOMPLETE = 0,  // More data is needed.
+        ANSWER_HELLO = 1,       // ServerHello or HelloRetryRequest is parsed.
+        ANSWER_ALERT = 2        // Alert is parsed.
+    };
+
+    /**
+     * @struct ClientHelloOptions   TlsHelloProber.hpp   "include/framework/TlsHelloProber.hpp"
+     * @brief Structure that describes the content of crafted ClientHello.
+     */
+    struct ClientHelloOptions
+    {
+        // Offered version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+        uint16_t version = SSL_METHOD_TLS12;
+        // Offered cipher suites by IANA identifiers.
+        std::vector<uint16_t> ciphers = { };
+        // Name of server for SNI extension (empty if extension is not sent).
+        std::string serverName = { };
+        // Names of ALPN protocols (empty if extension is not sent).
+        std::vector<std::string> protocols = { };
+    };
+
+    /**
+     * @struct ServerHelloInfo   TlsHelloProber.hpp   "include/framework/TlsHelloProber.hpp"
+     * @brief Structure that contains the fields of the answer to ClientHello.
+     */
+    struct ServerHelloInfo
+    {
+        // Negotiated version of protocol in wire format (for example: 0x0303 for TLS 1.2).
+        uint16_t version = 0;
+        // Selected cipher suite by IANA identifier.
+        uint16_t cipher = 0;
+        // Flag that the answer is HelloRetryRequest of TLS 1.3.
+        bool retry = false;
+        // Selected ALPN protocol (empty if server does not select any protocol or if it is encrypted in TLS 1.3).
+        std::string protocol = { };
+        // Types of extensions of the answer.
+        std::vector<uint16_t> extensions = { };
+        // Description of alert (zero if the answer is not alert).
+        uint8_t alert = 0;
+    };
+
+    /**
+     * @struct HelloProbeResult   TlsHelloProber.hpp   "include/framework/TlsHelloProber.hpp"
+     * @brief Structure that contains the result of one ClientHello probe.
+     *
+     * @note String views are valid only during the call of handler.
+     */
+    struct HelloProbeResult
+    {
+        // Name or address of external host as it was added to prober.
+        std::string_view host;
+        // Scanned port.
+        uint16_t port;
+        // Offered version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+        uint16_t version;
+        // Result of probe.
+        HELLO_STATE state;
+        // Accepted cipher suite by IANA identifier (zero if the probe is not accepted).
+        uint16_t cipher;
+        // Name of accepted cipher suite in OpenSSL format (empty if it is unknown).
+        std::string_view name;
+        // Selected ALPN protocol (empty if server does not select any protocol).
+        std::string_view selected;
+        // Description of alert of server (zero if server does not answer alert).
+        uint8_t alert;
+        // Error code of probe (zero for accepted probe).
+        int32_t error;
+        // Duration of probe.
+        std::chrono::microseconds latency;
+    };
+
+    /**
+      * @typedef void (*HelloProbeHandler) (const HelloProbeResult &, void *) noexcept;
+      * @brief The type of the handler which obtains the results of ClientHello probes as soon as they are known.
+      */
+    using HelloProbeHandler = void (*) (const HelloProbeResult &, void *) noexcept;
+
+
+    /**
+     * @struct HelloProbeAttempt   TlsHelloProber.hpp   "include/framework/TlsHelloProber.hpp"
+     * @brief Structure that contains the state of ClientHello probe in flight.
+     */
+    struct HelloProbeAttempt : public ProbeAttempt
+    {
+        // Index of task.
+        std::size_t task = 0;
+        // Part of ClientHello which is not sent yet.
+        std::string output = { };
+        // Received records of server.
+        std::string input = { };
+    };
+
+
+    /**
+     * @class TlsHelloProber   TlsHelloProber.hpp   "include/framework/TlsHelloProber.hpp"
+     * @brief This class defined the engine which enumerates the cipher suites of many hosts by crafted ClientHello without handshake.
+     *
+     * @note Each probe sends one ClientHello, parses ServerHello or alert and resets the connection, so a probe takes one round trip
+     *       and no key exchange is computed on both sides. TLS 1.3 probes send empty key share and obtain HelloRetryRequest.
+     * @note Cipher suites are enumerated for each added version: the suite selected by server is removed from the next offer
+     *       until the server rejects the rest of them. Probes of different hosts and versions are in flight at the same time.
+     * @note Each host is resolved once, and its first probe checks the connection: other probes of the host are started only after
+     *       the connection is established and are skipped if it is failed.
+     */
+    class TlsHelloProber final : public ProbeDriver<ProbeTarget, HelloProbeAttempt>
+    {
+    private:
+        /**
+         * @struct Task
+         * @brief Structure that contains the cipher suites of the version which are not checked yet.
+         */
+        struct Task
+        {
+            // Index of target.
+            std::size_t target = 0;
+            // Version of protocol.
+            uint16_t version = SSL_METHOD_TLS12;
+            // Cipher suites for the next offer.
+            std::vector<uint16_t> ciphers = { };
+        };
+
+        // Versions of protocol for probes.
+        std::vector<uint16_t> versions = { };
+        // Names of ALPN protocols for probes.
+        std::vector<std::string> protocols = { };
+        // Tasks of all targets (tasks of one target are neighbors, the first task checks the connection).
+        std::vector<Task> tasks = { };
+        // Indexes of tasks which can start the next probe (in round-robin order).
+        std::deque<std::size_t> queue = { };
+        // Index of the selected task.
+        std::size_t nextTask = 0;
+        // Handler and its context of the current probing.
+        HelloProbeHandler resultHandler = nullptr;
+        void * resultContext = nullptr;
+
+        // Creates the tasks of all targets and versions.
+        void PrepareTasks(void) noexcept;
+        // Selects the next task or returns false if no probe can be started now.
+        bool NextProbe(void) noexcept final;
+        // Starts the probe of selected task (returns false if the probe should be repeated later).
+        bool StartProbe (SocketStatePool & /*reactor*/) noexcept final;
+        // Continues the connection and the exchange of probe after the event of socket.
+        void ContinueProbe (SocketStatePool & /*reactor*/, int32_t /*fd*/) noexcept final;
+        // Finishes the probe which is not completed in time.
+        void ExpireProbe (SocketStatePool & /*reactor*/, int32_t /*fd*/, bool /*connected*/) noexcept final;
+        // Reports the result of probe.
+        void Report (std::size_t /*task*/, HELLO_STATE /*state*/, int32_t /*error*/, clock::time_point /*start*/, const ServerHelloInfo * /*info*/) noexcept;
+        // Reports the local error of probe (the task which checks the connection passes the check to the next task of the host).
+        void ReportError (std::size_t /*task*/, int32_t /*error*/) noexcept;
+        // Marks the host as unreachable and reports the tasks which are not started yet.
+        void SkipTarget (std::size_t /*target*/, std::size_t /*task*/) noexcept;
+        // Sends the rest of ClientHello and parses the received records.
+        void Exchange (SocketStatePool & /*reactor*/, int32_t /*fd*/, HelloProbeAttempt & /*attempt*/) noexcept;
+        // Finishes the probe, reports its result and schedules the next probe of task.
+        void Finish (SocketStatePool & /*reactor*/, int32_t /*fd*/, HELLO_STATE /*state*/, int32_t /*error*/, const ServerHelloInfo * /*info*/) noexcept;
+
+    public:
+        TlsHelloProber (TlsHelloProber &&) = delete;
+        TlsHelloProber (const TlsHelloProber &) = delete;
+        TlsHelloProber & operator= (TlsHelloProber &&) = delete;
+        TlsHelloProber & operator= (const TlsHelloProber &) = delete;
+
+        /**
+         * @fn explicit TlsHelloProber::TlsHelloProber (uint32_t, uint32_t) noexcept;
+         * @brief Constructor of TlsHelloProber class.
+         * @param [in] inFlight - Maximum number of probes in flight. Default: DEFAULT_HELLO_PROBE_IN_FLIGHT.
+         * @param [in] time - Time of one probe in milliseconds. Default: DEFAULT_HELLO_PROBE_TIME.
+         */
+        explicit TlsHelloProber (uint32_t /*inFlight*/ = DEFAULT_HELLO_PROBE_IN_FLIGHT, uint32_t /*time*/ = DEFAULT_HELLO_PROBE_TIME) noexcept;
+
+        /**
+         * @fn static bool TlsHelloProber::CreateClientHello (const ClientHelloOptions &, common::types::BinaryStructuredDataEngine &) noexcept;
+         * @brief Method that crafts the TLS record with ClientHello.
+         * @param [in] options - Content of ClientHello.
+         * @param [out] hello - Structured data of record: one field for each header, length, list and extension.
+         * @return True - if the record is created, otherwise - false.
+         *
+         * @note TLS 1.3 ClientHello contains empty key share, so the server answers HelloRetryRequest without key exchange.
+         */
+        static bool CreateClientHello (const ClientHelloOptions & /*options*/, common::types::BinaryStructuredDataEngine & /*hello*/) noexcept;
+
+        /**
+         * @fn static SERVER_ANSWER TlsHelloProber::ParseServerHello (const char *, std::size_t, ServerHelloInfo &) noexcept;
+         * @brief Method that parses the first handshake message or alert of server.
+         * @param [in] data - Received records of server.
+         * @param [in] length - Length of received records.
+         * @param [out] info - Fields of the answer.
+         * @return SERVER_ANSWER value that indicates the result of parsing.
+         */
+        static SERVER_ANSWER ParseServerHello (const char * /*data*/, std::size_t /*length*/, ServerHelloInfo & /*info*/) noexcept;
+
+        /**
+         * @fn static std::string_view TlsHelloProber::GetCipherName (uint16_t) noexcept;
+         * @brief Method that returns the name of cipher suite in OpenSSL format.
+         * @param [in] cipher - Cipher suite by IANA identifier.
+         * @return Name of cipher suite or empty string if it is unknown for OpenSSL.
+         */
+        static std::string_view GetCipherName (uint16_t /*cipher*/) noexcept;
+
+        /**
+         * @fn static const std::vector<uint16_t> & TlsHelloProber::GetKnownCiphers (uint16_t) noexcept;
+         * @brief Method that returns all cipher suites of the version which are known for OpenSSL (including the insecure suites).
+         * @param [in] version - Version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+         * @return Cipher suites by IANA identifiers.
+         */
+        static const std::vector<uint16_t> & GetKnownCiphers (uint16_t /*version*/) noexcept;
+
+        /**
+         * @fn bool TlsHelloProber::AddVersion (uint16_t) noexcept;
+         * @brief Method that adds the version of protocol for probes.
+         * @param [in] version - Version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+         * @return True - if the version is valid, otherwise - false.
+         */
+        bool AddVersion (uint16_t /*version*/) noexcept;
+
+        /**
+         * @fn bool TlsHelloProber::AddProtocol (std::string_view) noexcept;
+         * @brief Method that adds the ALPN protocol which is offered in all probes.
+         * @param [in] protocol - Name of ALPN protocol (for example: h2, http/1.1).
+         * @return True - if the name is valid, otherwise - false.
+         *
+         * @note Selected protocol is reported only for TLS 1.2 and older versions, because TLS 1.3 sends it in encrypted extensions.
+         */
+        bool AddProtocol (std::string_view /*protocol*/) noexcept;
+
+        /**
+         * @fn bool TlsHelloProber::AddTarget (const char *, uint16_t, int32_t) noexcept;
+         * @brief Method that adds the external host for probing.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host. Default: 443.
+         * @param [in] family - Family of address (AF_INET, AF_INET6). Default: AF_INET.
+         * @return True - if the host is resolved, otherwise - false.
+         */
+        bool AddTarget (const char * /*host*/, uint16_t /*port*/ = 443, int32_t /*family*/ = AF_INET) noexcept;
+
+        /**
+         * @fn std::size_t TlsHelloProber::Run (HelloProbeHandler, void *) noexcept;
+         * @brief Method that enumerates the cipher suites of all added hosts and versions and reports the result of each probe by handler.
+         * @param [in] handler - Handler which obtains the results.
+         * @param [in] context - User context for handler. Default: nullptr.
+         * @return Number of reported probes.
+         *
+         * @note Method blocks the calling thread until all probes are finished or Stop method is called.
+         * @note If no any version is added, then TLS 1.2 is probed.
+         */
+        std::size_t Run (HelloProbeHandler /*handler*/, void * /*context*/ = nullptr) noexcept;
+
+        ~TlsHelloProber(void) noexcept final = default;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_TLS_HELLO_PROBER_HPP
@@ -0,0 +1,213 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_TLS_SCANNER_HPP
+#define PROTOCOL_ANALYZER_TLS_SCANNER_HPP
+
+#include <deque>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <string_view>
+#include <unordered_map>
+
+#include "Socket.hpp"
+#include "TlsEngine.hpp"
+#include "ProbeDriver.hpp"
+
+
+#define DEFAULT_TLS_SCAN_IN_FLIGHT      256   // Maximum number of TLS probes at the same time.
+#define DEFAULT_TLS_SCAN_PROBE_TIME     5000  // Time of one TLS probe: connection and handshake (milli sec.).
+
+
+namespace analyzer::framework::net
+{
+    /**
+     * @enum PROBE_STATE
+     * @brief The result of TLS probe with the selected version and ALPN protocol.
+     */
+    enum PROBE_STATE : uint8_t
+    {
+        PROBE_SUPPORTED = 0,    // Handshake is complete.
+        PROBE_REJECTED = 1,     // Connection is established, but the handshake is failed or is not finished in time.
+        PROBE_UNREACHABLE = 2,  // Connection is not established (the other probes of the host are skipped).
+        PROBE_SKIPPED = 3,      // Probe is not started because the host is unreachable.
+        PROBE_ERROR = 4         // Local error of probe.
+    };
+
+    /**
+     * @struct TlsProbeResult   TlsScanner.hpp   "include/framework/TlsScanner.hpp"
+     * @brief Structure that contains the result of one TLS probe.
+     *
+     * @note String views are valid only during the call of handler.
+     */
+    struct TlsProbeResult
+    {
+        // Name or address of external host as it was added to scanner.
+        std::string_view host;
+        // Scanned port.
+        uint16_t port;
+        // Version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+        uint16_t version;
+        // Offered ALPN protocol (empty if ALPN is not offered).
+        std::string_view protocol;
+        // ALPN protocol which is selected by server (empty if server does not select any protocol).
+        std::string_view selected;
+        // Result of probe.
+        PROBE_STATE state;
+        // Error code of connection or handshake (zero for supported probe).
+        int32_t error;
+        // Duration of probe.
+        std::chrono::microseconds latency;
+    };
+
+    /**
+      * @typedef void (*TlsProbeHandler) (const TlsProbeResult &, void *) noexcept;
+      * @brief The type of the handler which obtains the results of TLS probes as soon as they are known.
+      */
+    using TlsProbeHandler = void (*) (const TlsProbeResult &, void *) noexcept;
+
+
+    /**
+     * @struct TlsScanTarget   TlsScanner.hpp   "include/framework/TlsScanner.hpp"
+     * @brief Structure that contains the external host and the index of its next probe.
+     */
+    struct TlsScanTarget : public ProbeTarget
+    {
+        // Index of the next probe (version is index / number of ALPN protocols).
+        std::size_t next = 0;
+    };
+
+    /**
+     * @struct TlsScanAttempt   TlsScanner.hpp   "include/framework/TlsScanner.hpp"
+     * @brief Structure that contains the state of TLS probe in flight.
+     */
+    struct TlsScanAttempt : public ProbeAttempt
+    {
+        // Index of target.
+        std::size_t target = 0;
+        // Index of probe.
+        std::size_t probe = 0;
+        // TLS state machine of probe.
+        std::unique_ptr<TlsEngine> engine = nullptr;
+    };
+
+
+    /**
+     * @class TlsScanner   TlsScanner.hpp   "include/framework/TlsScanner.hpp"
+     * @brief This class defined the engine which checks supported TLS versions and ALPN protocols of many hosts at the same time.
+     *
+     * @note Each host is probed with all combinations of added versions and ALPN protocols (host x version x ALPN).
+     * @note All probes are driven by the reactor of the calling thread with non-blocking sockets and TlsEngine, so no thread waits for handshake.
+     * @note Each host is resolved once, and its first probe checks the connection: other probes of the host are started only after
+     *       the connection is established and are skipped if it is failed.
+     * @note Contexts of probes are shared through SSLContextCache, so cipher and ALPN lists are parsed once per combination.
+     */
+    class TlsScanner final : public ProbeDriver<TlsScanTarget, TlsScanAttempt>
+    {
+    private:
+        // Versions of protocol for probes.
+        std::vector<uint16_t> versions = { };
+        // Names of ALPN protocols for probes.
+        std::vector<std::string> protocols = { };
+        // Shared contexts of all combinations of version and ALPN protocol (each context holds one reference).
+        std::vector<SSL_CTX *> contexts = { };
+        // Indexes of targets which can start the next probe (in round-robin order).
+        std::deque<std::size_t> queue = { };
+        // Target and index of the selected probe.
+        std::size_t nextTarget = 0, nextProbe = 0;
+        // Handler and its context of the current scanning.
+        TlsProbeHandler resultHandler = nullptr;
+        void * resultContext = nullptr;
+
+        // Return the number of probes of each host.
+        inline std::size_t ProbesPerTarget(void) const noexcept { return versions.size() * std::max<std::size_t>(protocols.size(), 1); }
+
+        // Creates the shared contexts for all combinations of version and ALPN protocol.
+        bool PrepareContexts(void) noexcept;
+        // Selects the next probe or returns false if no probe can be started now.
+        bool NextProbe(void) noexcept final;
+        // Starts the selected probe (returns false if the probe should be repeated later).
+        bool StartProbe (SocketStatePool & /*reactor*/) noexcept final;
+        // Continues the connection and the handshake of probe after the event of socket.
+        void ContinueProbe (SocketStatePool & /*reactor*/, int32_t /*fd*/) noexcept final;
+        // Finishes the probe which is not completed in time.
+        void ExpireProbe (SocketStatePool & /*reactor*/, int32_t /*fd*/, bool /*connected*/) noexcept final;
+        // Reports the result of probe.
+        void Report (std::size_t /*target*/, std::size_t /*probe*/, PROBE_STATE /*state*/, int32_t /*error*/, clock::time_point /*start*/,
+                     std::string_view /*selected*/) noexcept;
+        // Reports the local error of probe (the first probe is passed to the next probe of the host).
+        void ReportError (std::size_t /*target*/, std::size_t /*probe*/, int32_t /*error*/) noexcept;
+        // Marks the host as unreachable and reports the probes which are not started yet.
+        void SkipTarget (std::size_t /*target*/) noexcept;
+        // Moves the handshake forward while there is data to send or to receive.
+        void Handshake (SocketStatePool & /*reactor*/, int32_t /*fd*/, TlsScanAttempt & /*attempt*/) noexcept;
+        // Finishes the probe and reports its result.
+        void Finish (SocketStatePool & /*reactor*/, int32_t /*fd*/, PROBE_STATE /*state*/, int32_t /*error*/) noexcept;
+
+    public:
+        TlsScanner (TlsScanner &&) = delete;
+        TlsScanner (const TlsScanner &) = delete;
+        TlsScanner & operator= (TlsScanner &&) = delete;
+        TlsScanner & operator= (const TlsScanner &) = delete;
+
+        /**
+         * @fn explicit TlsScanner::TlsScanner (uint32_t, uint32_t) noexcept;
+         * @brief Constructor of TlsScanner class.
+         * @param [in] inFlight - Maximum number of probes in flight. Default: DEFAULT_TLS_SCAN_IN_FLIGHT.
+         * @param [in] time - Time of one probe in milliseconds. Default: DEFAULT_TLS_SCAN_PROBE_TIME.
+         */
+        explicit TlsScanner (uint32_t /*inFlight*/ = DEFAULT_TLS_SCAN_IN_FLIGHT, uint32_t /*time*/ = DEFAULT_TLS_SCAN_PROBE_TIME) noexcept;
+
+        /**
+         * @fn bool TlsScanner::AddVersion (uint16_t) noexcept;
+         * @brief Method that adds the version of protocol for probes.
+         * @param [in] version - Version of protocol (SSL_METHOD_TLS1, SSL_METHOD_TLS11, SSL_METHOD_TLS12, SSL_METHOD_TLS13).
+         * @return True - if the version is valid, otherwise - false.
+         */
+        bool AddVersion (uint16_t /*version*/) noexcept;
+
+        /**
+         * @fn bool TlsScanner::AddProtocol (std::string_view) noexcept;
+         * @brief Method that adds the ALPN protocol for probes.
+         * @param [in] protocol - Name of ALPN protocol (for example: h2, http/1.1).
+         * @return True - if the name is valid, otherwise - false.
+         *
+         * @note If no any protocol is added, then probes are sent without ALPN extension.
+         */
+        bool AddProtocol (std::string_view /*protocol*/) noexcept;
+
+        /**
+         * @fn bool TlsScanner::AddTarget (const char *, uint16_t, int32_t) noexcept;
+         * @brief Method that adds the external host for scanning.
+         * @param [in] host - Name or address of external host.
+         * @param [in] port - Port of external host. Default: 443.
+         * @param [in] family - Family of address (AF_INET, AF_INET6). Default: AF_INET.
+         * @return True - if the host is resolved, otherwise - false.
+         */
+        bool AddTarget (const char * /*host*/, uint16_t /*port*/ = 443, int32_t /*family*/ = AF_INET) noexcept;
+
+        /**
+         * @fn std::size_t TlsScanner::Run (TlsProbeHandler, void *) noexcept;
+         * @brief Method that runs all probes of added hosts and reports each result by handler.
+         * @param [in] handler - Handler which obtains the results.
+         * @param [in] context - User context for handler. Default: nullptr.
+         * @return Number of reported probes.
+         *
+         * @note Method blocks the calling thread until all probes are finished or Stop method is called.
+         * @note If no any version is added, then TLS 1.2 is probed.
+         */
+        std::size_t Run (TlsProbeHandler /*handler*/, void * /*context*/ = nullptr) noexcept;
+
+        ~TlsScanner(void) noexcept final;
+    };
+
+}  // namespace net.
+
+
+#endif  // PROTOCOL_ANALYZER_TLS_SCANNER_HPP
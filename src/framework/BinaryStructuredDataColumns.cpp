@@ -0,0 +1,312 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+
+#include "../../include/framework/BinaryStructuredDataColumns.hpp"
+#include "../../include/framework/Log.hpp"
+
+
+namespace analyzer::framework::common::types
+{
+    // Function that reverses the byte order of the unsigned integer.
+    template <typename Type>
+    static inline Type ByteSwap (const Type value) noexcept
+    {
+        if constexpr (sizeof(Type) == sizeof(uint16_t)) { return __builtin_bswap16(value); }
+        else if constexpr (sizeof(Type) == sizeof(uint32_t)) { return __builtin_bswap32(value); }
+        else if constexpr (sizeof(Type) == sizeof(uint64_t)) { return __builtin_bswap64(value); }
+        else { return value; }
+    }
+
+    // Function that copies the byte-aligned native-width field of each record into the column with fixed stride.
+    // It is a plain scalar loop (memcpy and byte swap) which is left to the compiler for auto-vectorization.
+    template <typename Type, bool Swap, typename Address>
+    static void GatherAlignedField (Type* const column, Address& address, const std::size_t count, const std::size_t byteOffset) noexcept
+    {
+        for (std::size_t row = 0; row < count; ++row)
+        {
+            const std::byte* const record = address(row);
+            Type value = 0;
+            if (record != nullptr) {
+                memcpy(&value, record + byteOffset, sizeof(Type));
+            }
+            if constexpr (Swap == true) { value = ByteSwap(value); }
+            column[row] = value;
+        }
+    }
+
+    // Function that reads the field of any bit length (up to 64 bits) of each record into the column.
+    template <typename Type, typename Address>
+    static void GatherGenericField (Type* const column, Address& address, const std::size_t count,
+                                    const std::size_t offset, const std::size_t length, const bool littleEndian) noexcept
+    {
+        const std::size_t first = offset / 8;
+        const std::size_t last = (offset + length - 1) / 8;
+        const std::size_t tail = 7 - (offset + length - 1) % 8;  // Count of unused low-order bits in the last byte.
+        const uint64_t headMask = 0xFFU >> (offset % 8);
+
+        for (std::size_t row = 0; row < count; ++row)
+        {
+            const std::byte* const record = address(row);
+            uint64_t result = 0;
+            if (record != nullptr)
+            {
+                if (littleEndian == true)
+                {
+                    for (std::size_t idx = last + 1; idx > first; --idx) {
+                        result = (result << 8) | std::to_integer<uint64_t>(record[idx - 1]);
+                    }
+                }
+                else
+                {
+                    result = std::to_integer<uint64_t>(record[first]) & headMask;
+                    if (first == last) {
+                        result >>= tail;
+                    }
+                    else
+                    {
+                        for (std::size_t idx = first + 1; idx < last; ++idx) {
+                            result = (result << 8) | std::to_integer<uint64_t>(record[idx]);
+                        }
+                        result = (result << (8 - tail)) | (std::to_integer<uint64_t>(record[last]) >> tail);
+                    }
+                }
+            }
+            column[row] = static_cast<Type>(result);
+        }
+    }
+
+    // Function that decodes one field of the block of records into the column of selected type.
+    template <typename Type, typename Address>
+    static void GatherField (Type* const column, Address& address, const std::size_t count,
+                             const std::size_t offset, const std::size_t length, const bool littleEndian) noexcept
+    {
+        if (offset % 8 == 0 && length == sizeof(Type) * 8)
+        {
+            if (littleEndian == (BinaryDataEngine::system_endian == DATA_LITTLE_ENDIAN)) {
+                GatherAlignedField<Type, false>(column, address, count, offset / 8);
+            }
+            else {
+                GatherAlignedField<Type, true>(column, address, count, offset / 8);
+            }
+            return;
+        }
+        GatherGenericField<Type>(column, address, count, offset, length, littleEndian);
+    }
+
+    // Function that reads the value of column element of the selected width.
+    static inline uint64_t ReadColumnValue (const std::byte* const column, const uint8_t width, const std::size_t row) noexcept
+    {
+        switch (width)
+        {
+            case sizeof(uint8_t):  return reinterpret_cast<const uint8_t*>(column)[row];
+            case sizeof(uint16_t): return reinterpret_cast<const uint16_t*>(column)[row];
+            case sizeof(uint32_t): return reinterpret_cast<const uint32_t*>(column)[row];
+            default:               return reinterpret_cast<const uint64_t*>(column)[row];
+        }
+    }
+
+
+    // Method that sets the layout of decoded records and removes all decoded rows.
+    bool BinaryStructuredDataColumns::CreateLayout (const uint16_t* const pattern, const uint16_t size, const DATA_PATTERN_TYPE type, const DATA_ENDIAN_TYPE endian) noexcept
+    {
+        fieldsCount = 0;
+        recordSize = rowsCount = rowsCapacity = 0;
+        columns.reset(nullptr);
+        validRows.reset(nullptr);
+
+        if (pattern == nullptr || size == 0 || (type != PATTERN_BITS && type != PATTERN_BYTES)) {
+            LOG_ERROR("BinaryStructuredDataColumns.CreateLayout: Incorrect input pattern.");
+            return false;
+        }
+
+        fieldOffsets = system::allocMemoryForArray<std::size_t>(static_cast<std::size_t>(size) + 1);
+        columnWidths = system::allocMemoryForArray<uint8_t>(size);
+        columns.reset(new (std::nothrow) std::unique_ptr<std::byte[]>[size]);
+        if (fieldOffsets == nullptr || columnWidths == nullptr || columns == nullptr) {
+            LOG_ERROR("BinaryStructuredDataColumns.CreateLayout: Memory allocation fail.");
+            return false;
+        }
+
+        fieldOffsets[0] = 0;
+        for (uint16_t idx = 0; idx < size; ++idx)
+        {
+            const std::size_t length = static_cast<std::size_t>(pattern[idx]) * type;
+            fieldOffsets[idx + 1] = fieldOffsets[idx] + length;
+
+            if (length == 0 || length > 64) { columnWidths[idx] = 0; }
+            else if (length <= 8)  { columnWidths[idx] = sizeof(uint8_t);  }
+            else if (length <= 16) { columnWidths[idx] = sizeof(uint16_t); }
+            else if (length <= 32) { columnWidths[idx] = sizeof(uint32_t); }
+            else { columnWidths[idx] = sizeof(uint64_t); }
+        }
+
+        fieldsCount = size;
+        patternType = type;
+        recordSize = (fieldOffsets[size] + 7) / 8;
+        // Packed bit-pattern is always read in network bit order.
+        if (type == PATTERN_BITS) { dataEndianType = DATA_BIG_ENDIAN; }
+        else { dataEndianType = (endian == DATA_SYSTEM_ENDIAN) ? BinaryDataEngine::system_endian : endian; }
+        return true;
+    }
+
+    // Method that sets the layout of decoded records as in the selected structured data and removes all decoded rows.
+    bool BinaryStructuredDataColumns::CreateLayout (const BinaryStructuredDataEngine& engine) noexcept
+    {
+        const auto [size, pattern] = engine.GetPattern();
+        return CreateLayout(pattern, size, engine.PatternType(), engine.DataEndianType());
+    }
+
+    // Method that allocates the memory of all columns for the selected count of rows.
+    bool BinaryStructuredDataColumns::Reserve (const std::size_t rows) noexcept
+    {
+        if (rows <= rowsCapacity) { return true; }
+
+        std::size_t capacity = (rowsCapacity == 0) ? blockRows : rowsCapacity;
+        while (capacity < rows) { capacity *= 2; }
+
+        auto states = system::allocMemoryForArray<uint8_t>(capacity, validRows.get(), rowsCount);
+        if (states == nullptr) { return false; }
+        validRows = std::move(states);
+
+        // If allocation of any column fails then the already grown columns stay valid with the previous rows.
+        for (uint16_t idx = 0; idx < fieldsCount; ++idx)
+        {
+            if (columnWidths[idx] == 0) { continue; }
+            auto column = system::allocMemoryForArray<std::byte>(capacity * columnWidths[idx], columns[idx].get(), rowsCount * columnWidths[idx]);
+            if (column == nullptr) { return false; }
+            columns[idx] = std::move(column);
+        }
+
+        rowsCapacity = capacity;
+        return true;
+    }
+
+    // Method that decodes the selected count of records into columns after the last decoded row.
+    template <typename Address>
+    void BinaryStructuredDataColumns::DecodeRows (Address address, const std::size_t count) noexcept
+    {
+        const bool littleEndian = (dataEndianType == DATA_LITTLE_ENDIAN);
+        for (std::size_t block = 0; block < count; block += blockRows)
+        {
+            const std::size_t rows = std::min(blockRows, count - block);
+            auto blockAddress = [&address, block] (const std::size_t row) noexcept { return address(block + row); };
+
+            // Decode field by field so that each inner loop works with only one column and one fixed offset.
+            for (uint16_t field = 0; field < fieldsCount; ++field)
+            {
+                const std::size_t offset = fieldOffsets[field];
+                const std::size_t length = fieldOffsets[field + 1] - offset;
+                std::byte* const column = columns[field].get();
+                const std::size_t first = rowsCount + block;
+
+                switch (columnWidths[field])
+                {
+                    case sizeof(uint8_t):
+                        GatherField(reinterpret_cast<uint8_t*>(column) + first, blockAddress, rows, offset, length, littleEndian);
+                        break;
+                    case sizeof(uint16_t):
+                        GatherField(reinterpret_cast<uint16_t*>(column) + first, blockAddress, rows, offset, length, littleEndian);
+                        break;
+                    case sizeof(uint32_t):
+                        GatherField(reinterpret_cast<uint32_t*>(column) + first, blockAddress, rows, offset, length, littleEndian);
+                        break;
+                    case sizeof(uint64_t):
+                        GatherField(reinterpret_cast<uint64_t*>(column) + first, blockAddress, rows, offset, length, littleEndian);
+                        break;
+                    default:  // Field is not decoded into column.
+                        break;
+                }
+            }
+
+            for (std::size_t row = 0; row < rows; ++row) {
+                validRows[rowsCount + block + row] = (address(block + row) != nullptr) ? 1 : 0;
+            }
+        }
+        rowsCount += count;
+    }
+
+    // Method that decodes the concatenated stream of records and appends them to the columns.
+    std::size_t BinaryStructuredDataColumns::DecodeStream (const std::byte* const stream, const std::size_t length) noexcept
+    {
+        if (fieldsCount == 0 || recordSize == 0 || stream == nullptr) { return 0; }
+
+        const std::size_t count = length / recordSize;
+        if (count == 0) { return 0; }
+        if (Reserve(rowsCount + count) == false) {
+            LOG_ERROR("BinaryStructuredDataColumns.DecodeStream: Memory allocation fail.");
+            return 0;
+        }
+
+        const std::size_t stride = recordSize;
+        DecodeRows([stream, stride] (const std::size_t row) noexcept { return stream + row * stride; }, count);
+        return count;
+    }
+
+    // Method that decodes the array of separate records and appends them to the columns.
+    std::size_t BinaryStructuredDataColumns::DecodeRecords (const std::byte* const* const records, const std::size_t* const lengths, const std::size_t count) noexcept
+    {
+        if (fieldsCount == 0 || recordSize == 0 || records == nullptr || lengths == nullptr || count == 0) { return 0; }
+
+        if (Reserve(rowsCount + count) == false) {
+            LOG_ERROR("BinaryStructuredDataColumns.DecodeRecords: Memory allocation fail.");
+            return 0;
+        }
+
+        const std::size_t size = recordSize;
+        DecodeRows([records, lengths, size] (const std::size_t row) noexcept -> const std::byte* {
+            return (lengths[row] < size) ? nullptr : records[row];
+        }, count);
+
+        std::size_t valid = 0;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            valid += (records[idx] != nullptr && lengths[idx] >= size) ? 1 : 0;
+        }
+        return valid;
+    }
+
+    // Method that counts the valid rows in which the value of the selected field is out of the range.
+    std::size_t BinaryStructuredDataColumns::CountOutOfRange (const uint16_t fieldIndex, const uint64_t minimum, const uint64_t maximum) const noexcept
+    {
+        const uint8_t width = static_cast<uint8_t>(GetColumnWidth(fieldIndex));
+        if (width == 0) { return 0; }
+
+        const std::byte* const column = columns[fieldIndex].get();
+        std::size_t count = 0;
+        for (std::size_t row = 0; row < rowsCount; ++row)
+        {
+            const uint64_t value = ReadColumnValue(column, width, row);
+            count += static_cast<std::size_t>((value < minimum) | (value > maximum)) & validRows[row];
+        }
+        return count;
+    }
+
+    // Method that calculates the statistics of the selected field over all valid rows.
+    ColumnStatistics BinaryStructuredDataColumns::GetColumnStatistics (const uint16_t fieldIndex) const noexcept
+    {
+        ColumnStatistics statistics;
+        const uint8_t width = static_cast<uint8_t>(GetColumnWidth(fieldIndex));
+        if (width == 0) { return statistics; }
+
+        const std::byte* const column = columns[fieldIndex].get();
+        statistics.minimum = UINT64_MAX;
+        for (std::size_t row = 0; row < rowsCount; ++row)
+        {
+            if (validRows[row] == 0) { continue; }
+
+            const uint64_t value = ReadColumnValue(column, width, row);
+            statistics.minimum = std::min(statistics.minimum, value);
+            statistics.maximum = std::max(statistics.maximum, value);
+            statistics.sum += value;
+            ++statistics.count;
+        }
+        if (statistics.count == 0) { statistics.minimum = 0; }
+        return statistics;
+    }
+
+}  // namespace types.
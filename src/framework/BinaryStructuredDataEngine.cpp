@@ -13,14 +13,13 @@
 namespace analyzer::framework::common::types
 {
     // Constructor of BinaryStructuredDataEngine class with prepared structured data.
-    BinaryStructuredDataEngine::BinaryStructuredDataEngine (BinaryDataEngine& input, const uint16_t* pattern, const uint16_t size, const DATA_ENDIAN_TYPE endian) noexcept
+    BinaryStructuredDataEngine::BinaryStructuredDataEngine (BinaryDataEngine& input, const uint16_t* pattern, const uint16_t size, const DATA_ENDIAN_TYPE endian, const DATA_PATTERN_TYPE type) noexcept
             : data(std::move(input)), dataEndianType(endian)
     {
         if (size != 0)
         {
-            dataPattern = system::allocMemoryForArray<uint16_t>(size, pattern, size * sizeof(uint16_t));
-            if (dataPattern == nullptr) { Clear(); }
-            fieldsCount = size;
+            if (AssignPattern(pattern, size, type) == false) { Clear(); }
+            if (type == PATTERN_BITS) { dataEndianType = DATA_BIG_ENDIAN; }
         }
     }
 
@@ -32,8 +31,7 @@ namespace analyzer::framework::common::types
             data = other.data;
             if (data == true)
             {
-                fieldsCount = other.fieldsCount;
-                dataPattern = system::allocMemoryForArray<uint16_t>(fieldsCount, other.dataPattern.get(), fieldsCount * sizeof(uint16_t));
+                if (AssignPattern(other.dataPattern.get(), other.fieldsCount, other.patternType) == false) { Clear(); }
                 dataEndianType = other.dataEndianType;
             }
         }
@@ -47,33 +45,52 @@ namespace analyzer::framework::common::types
             data = std::move(other.data);
             fieldsCount = other.fieldsCount;
             dataPattern = std::move(other.dataPattern);
+            fieldOffsets = std::move(other.fieldOffsets);
+            patternType = other.patternType;
             dataEndianType = other.dataEndianType;
             other.Clear();
         }
     }
 
+    // Method that saves the pattern of structured data and calculates the bit offsets of all fields.
+    bool BinaryStructuredDataEngine::AssignPattern (const uint16_t* const pattern, const uint16_t size, const DATA_PATTERN_TYPE type) noexcept
+    {
+        dataPattern = system::allocMemoryForArray<uint16_t>(size, pattern, size * sizeof(uint16_t));
+        fieldOffsets = system::allocMemoryForArray<std::size_t>(static_cast<std::size_t>(size) + 1);
+        if (dataPattern == nullptr || fieldOffsets == nullptr) { return false; }
+
+        fieldOffsets[0] = 0;
+        for (uint16_t idx = 0; idx < size; ++idx) {
+            fieldOffsets[idx + 1] = fieldOffsets[idx] + static_cast<std::size_t>(pattern[idx]) * type;
+        }
+        fieldsCount = size;
+        patternType = type;
+        return true;
+    }
+
     // Method that creates empty structured data template.
-    bool BinaryStructuredDataEngine::CreateTemplate (const uint16_t* const pattern, const uint16_t size) noexcept
+    bool BinaryStructuredDataEngine::CreateTemplate (const uint16_t* const pattern, const uint16_t size, const DATA_PATTERN_TYPE type) noexcept
     {
-        const std::size_t bytes = static_cast<std::size_t>(std::accumulate(pattern, pattern + size, 0));
+        // Packed bit-pattern may contain several unused low-order bits in the last byte.
+        const std::size_t bytes = (GetPatternBitLength(pattern, size, type) + 7) / 8;
         if (bytes == 0) { return false; }
 
         data = BinaryDataEngine(bytes, STRUCTURED_DATA_HANDLING_MODE, DATA_BIG_ENDIAN);
         if (data == false) { return false; }
 
-        dataPattern = system::allocMemoryForArray<uint16_t>(size, pattern, size * sizeof(uint16_t));
-        if (dataPattern == nullptr) {
+        if (AssignPattern(pattern, size, type) == false) {
             Clear();
             return false;
         }
-        fieldsCount = size;
+        if (type == PATTERN_BITS) { dataEndianType = DATA_BIG_ENDIAN; }
         return true;
     }
 
     // Method that changes endian type of stored data in BinaryStructuredDataEngine class.
     void BinaryStructuredDataEngine::SetDataEndianType (const DATA_ENDIAN_TYPE endian) noexcept
     {
-        if (dataEndianType == endian) { return; }
+        // Packed structured data with bit-pattern is always stored in network bit order.
+        if (dataEndianType == endian || patternType == PATTERN_BITS) { return; }
         dataEndianType = endian;
 
         std::size_t block = 0;
@@ -97,11 +114,11 @@ namespace analyzer::framework::common::types
     // Method that returns field value of structured data under selected index by reference.
     BinaryDataEngine BinaryStructuredDataEngine::GetFieldByReference (const uint16_t fieldIndex) const noexcept
     {
-        if (fieldIndex < fieldsCount)
+        if (fieldIndex < fieldsCount && IsByteAlignedField(fieldIndex) == true)
         {
             // Get index of first byte of selected field (Not consider the type of endian in which data are presented).
-            const std::size_t byteIndex = static_cast<std::size_t>(std::accumulate(dataPattern.get(), dataPattern.get() + fieldIndex, 0));
-            BinaryDataEngine result(data.GetAt(byteIndex), dataPattern[fieldIndex], dataEndianType);
+            const std::size_t byteIndex = fieldOffsets[fieldIndex] / 8;
+            BinaryDataEngine result(data.GetAt(byteIndex), GetFieldBitLength(fieldIndex) / 8, dataEndianType);
             return result;
         }
         return BinaryDataEngine(DATA_MODE_DEFAULT, dataEndianType);
@@ -131,24 +148,19 @@ namespace analyzer::framework::common::types
                 offset += pattern[field];
             }
         }
-        else if (dataPattern != nullptr)  // In this case the internal byte-pattern is used.
+        else if (dataPattern != nullptr)  // In this case the internal pattern is used.
         {
-            if (start != 0) {
-                offset = static_cast<std::size_t>(std::accumulate(dataPattern.get(), dataPattern.get() + start, 0) * 8);
-            }
-
             for (uint16_t field = start; field < fieldsCount; ++field)
             {
-                if (data.BitsTransform().Any(offset, offset + dataPattern[field] * 8 - 1) == true) {
+                if (GetFieldBitLength(field) != 0 && data.BitsTransform().Any(fieldOffsets[field], fieldOffsets[field + 1] - 1) == true) {
                     return field;
                 }
-                offset += dataPattern[field] * 8;
             }
         }
         return std::numeric_limits<uint16_t>::max();
     }
 
-    // Method that returns the internal byte-pattern with length from the specified position.
+    // Method that returns the internal pattern with length from the specified position.
     std::pair<uint16_t, const uint16_t*> BinaryStructuredDataEngine::GetPattern (const uint16_t fieldIndex) const noexcept
     {
         if (fieldIndex < fieldsCount) {
@@ -163,6 +175,8 @@ namespace analyzer::framework::common::types
         data.Clear();
         fieldsCount = 0;
         dataPattern.reset(nullptr);
+        fieldOffsets.reset(nullptr);
+        patternType = PATTERN_BYTES;
     }
 
     // Method that resets the internal state of BinaryStructuredDataEngine class to default state.
@@ -171,6 +185,8 @@ namespace analyzer::framework::common::types
         data.Reset();
         fieldsCount = 0;
         dataPattern.reset(nullptr);
+        fieldOffsets.reset(nullptr);
+        patternType = PATTERN_BYTES;
         dataEndianType = BinaryDataEngine::system_endian;
     }
 
@@ -191,7 +207,7 @@ namespace analyzer::framework::common::types
                 {
                     if (idx % 8 == 0 && blockBitCount != 0) { result << ' '; }
                     result << data.BitsTransform().GetBitValue(idx);
-                    if (++blockBitCount == dataPattern[patternBlock] * 8) {
+                    if (++blockBitCount == GetFieldBitLength(patternBlock)) {
                         if (++patternBlock == fieldsCount) { break; }
                         result << "\nField " << patternBlock + 1 << ":   ";
                         blockBitCount = 0;
@@ -239,8 +255,7 @@ namespace analyzer::framework::common::types
             data = other.data;
             if (data == true)
             {
-                fieldsCount = other.fieldsCount;
-                dataPattern = system::allocMemoryForArray<uint16_t>(fieldsCount, other.dataPattern.get(), fieldsCount * sizeof(uint16_t));
+                if (AssignPattern(other.dataPattern.get(), other.fieldsCount, other.patternType) == false) { Clear(); }
                 dataEndianType = other.dataEndianType;
             }
         }
@@ -255,6 +270,8 @@ namespace analyzer::framework::common::types
             data = std::move(other.data);
             fieldsCount = other.fieldsCount;
             dataPattern = std::move(other.dataPattern);
+            fieldOffsets = std::move(other.fieldOffsets);
+            patternType = other.patternType;
             dataEndianType = other.dataEndianType;
             other.Clear();
         }
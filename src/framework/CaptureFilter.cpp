@@ -0,0 +1,403 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <string>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <linux/if_ether.h>
+
+#include "../../include/framework/Log.hpp"
+#include "../../include/framework/Common.hpp"
+#include "../../include/framework/Parser.hpp"
+#include "../../include/framework/Resolver.hpp"
+#include "../../include/framework/CaptureFilter.hpp"
+
+
+namespace analyzer::framework::net
+{
+    // Labels of jumps inside the block of one target.
+    enum FILTER_LABEL : uint8_t
+    {
+        LABEL_NEXT = 0,
+        LABEL_MATCH = 1,
+        LABEL_FAIL = 2,
+        LABEL_HOST = 3,
+        LABEL_DESTINATION = 4,
+        LABEL_TRANSPORT = 5,
+        LABEL_COUNT = 6
+    };
+
+    // Offsets of fields in Ethernet frame.
+    static constexpr uint32_t ETHERNET_TYPE_OFFSET = 12;
+    static constexpr uint32_t IPV4_FRAGMENT_OFFSET = ETH_HLEN + 6;
+    static constexpr uint32_t IPV4_PROTOCOL_OFFSET = ETH_HLEN + 9;
+    static constexpr uint32_t IPV4_SOURCE_OFFSET = ETH_HLEN + 12;
+    static constexpr uint32_t IPV4_DESTINATION_OFFSET = ETH_HLEN + 16;
+    static constexpr uint32_t IPV6_NEXT_HEADER_OFFSET = ETH_HLEN + 6;
+    static constexpr uint32_t IPV6_SOURCE_OFFSET = ETH_HLEN + 8;
+    static constexpr uint32_t IPV6_DESTINATION_OFFSET = ETH_HLEN + 24;
+    static constexpr uint32_t IPV6_PAYLOAD_OFFSET = ETH_HLEN + 40;
+
+
+    // Add the block of instructions which checks the target in IPv4 or IPv6 packet.
+    void CaptureFilter::CompileTarget (const Target& target, const int32_t family) noexcept
+    {
+        // Jumps of block refer to labels, and they are resolved when the block is completed.
+        struct Instruction { uint16_t code; uint32_t k; uint8_t jt; uint8_t jf; };
+        std::vector<Instruction> block;
+        std::size_t labels[LABEL_COUNT] = { };
+        const auto emit = [&block] (uint16_t code, uint32_t k, uint8_t jt = LABEL_NEXT, uint8_t jf = LABEL_NEXT) { block.push_back({ code, k, jt, jf }); };
+        const auto bind = [&block, &labels] (uint8_t label) { labels[label] = block.size(); };
+        // Word of address in host byte order as it is loaded by BPF_LD|BPF_W.
+        const auto word = [&target] (std::size_t index) {
+            return static_cast<uint32_t>(target.address[index * 4]) << 24 | static_cast<uint32_t>(target.address[index * 4 + 1]) << 16 |
+                   static_cast<uint32_t>(target.address[index * 4 + 2]) << 8 | static_cast<uint32_t>(target.address[index * 4 + 3]);
+        };
+
+        const bool ipv4 = (family == AF_INET);
+        emit(BPF_LD | BPF_H | BPF_ABS, ETHERNET_TYPE_OFFSET);
+        emit(BPF_JMP | BPF_JEQ | BPF_K, ipv4 ? ETH_P_IP : ETH_P_IPV6, LABEL_NEXT, LABEL_FAIL);
+
+        // Address matches the source or the destination of packet.
+        if (target.family != AF_UNSPEC)
+        {
+            const std::size_t words = ipv4 ? 1 : 4;
+            const uint32_t source = ipv4 ? IPV4_SOURCE_OFFSET : IPV6_SOURCE_OFFSET;
+            const uint32_t destination = ipv4 ? IPV4_DESTINATION_OFFSET : IPV6_DESTINATION_OFFSET;
+            for (std::size_t idx = 0; idx < words; ++idx)
+            {
+                emit(BPF_LD | BPF_W | BPF_ABS, source + static_cast<uint32_t>(idx * 4));
+                emit(BPF_JMP | BPF_JEQ | BPF_K, word(idx), (idx + 1 == words) ? LABEL_HOST : LABEL_NEXT, LABEL_DESTINATION);
+            }
+            bind(LABEL_DESTINATION);
+            for (std::size_t idx = 0; idx < words; ++idx)
+            {
+                emit(BPF_LD | BPF_W | BPF_ABS, destination + static_cast<uint32_t>(idx * 4));
+                emit(BPF_JMP | BPF_JEQ | BPF_K, word(idx), LABEL_NEXT, LABEL_FAIL);
+            }
+            bind(LABEL_HOST);
+        }
+
+        // Port is checked only in TCP and UDP packets.
+        if (target.protocol != 0 || target.port != 0)
+        {
+            emit(BPF_LD | BPF_B | BPF_ABS, ipv4 ? IPV4_PROTOCOL_OFFSET : IPV6_NEXT_HEADER_OFFSET);
+            if (target.protocol != 0) {
+                emit(BPF_JMP | BPF_JEQ | BPF_K, target.protocol, LABEL_NEXT, LABEL_FAIL);
+            }
+            else
+            {
+                emit(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_TCP, LABEL_TRANSPORT, LABEL_NEXT);
+                emit(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, LABEL_NEXT, LABEL_FAIL);
+            }
+            bind(LABEL_TRANSPORT);
+        }
+
+        if (target.port != 0)
+        {
+            if (ipv4 == true)
+            {
+                // Fragments except the first one do not contain the transport header.
+                emit(BPF_LD | BPF_H | BPF_ABS, IPV4_FRAGMENT_OFFSET);
+                emit(BPF_JMP | BPF_JSET | BPF_K, 0x1FFF, LABEL_FAIL, LABEL_NEXT);
+                emit(BPF_LDX | BPF_B | BPF_MSH, ETH_HLEN);
+                emit(BPF_LD | BPF_H | BPF_IND, ETH_HLEN);
+                emit(BPF_JMP | BPF_JEQ | BPF_K, target.port, LABEL_MATCH, LABEL_NEXT);
+                emit(BPF_LD | BPF_H | BPF_IND, ETH_HLEN + 2);
+                emit(BPF_JMP | BPF_JEQ | BPF_K, target.port, LABEL_NEXT, LABEL_FAIL);
+            }
+            else
+            {
+                // Transport header is expected directly after the fixed header of IPv6 packet.
+                emit(BPF_LD | BPF_H | BPF_ABS, IPV6_PAYLOAD_OFFSET);
+                emit(BPF_JMP | BPF_JEQ | BPF_K, target.port, LABEL_MATCH, LABEL_NEXT);
+                emit(BPF_LD | BPF_H | BPF_ABS, IPV6_PAYLOAD_OFFSET + 2);
+                emit(BPF_JMP | BPF_JEQ | BPF_K, target.port, LABEL_NEXT, LABEL_FAIL);
+            }
+        }
+
+        bind(LABEL_MATCH);
+        emit(BPF_RET | BPF_K, CAPTURE_FILTER_SNAPLEN);
+        // Rejected packet is checked by the block of the next target.
+        bind(LABEL_FAIL);
+
+        for (std::size_t idx = 0; idx < block.size(); ++idx)
+        {
+            const Instruction& instruction = block[idx];
+            const auto offset = [&] (uint8_t label) { return static_cast<uint8_t>((label == LABEL_NEXT) ? 0 : labels[label] - idx - 1); };
+            if (BPF_CLASS(instruction.code) == BPF_JMP && BPF_OP(instruction.code) != BPF_JA) {
+                program.push_back(BPF_JUMP(instruction.code, instruction.k, offset(instruction.jt), offset(instruction.jf)));
+            }
+            else { program.push_back(BPF_STMT(instruction.code, instruction.k)); }
+        }
+    }
+
+    bool CaptureFilter::AddTarget (std::string_view host, const uint16_t port, const uint8_t protocol) noexcept
+    {
+        if (protocol != 0 && protocol != IPPROTO_TCP && protocol != IPPROTO_UDP) {
+            LOG_ERROR("CaptureFilter.AddTarget: Unsupported transport protocol: ", static_cast<uint16_t>(protocol), '.');
+            return false;
+        }
+
+        Target target;
+        target.port = port;
+        target.protocol = protocol;
+        if (host.empty() == true)
+        {
+            targets.push_back(target);
+            return true;
+        }
+
+        const std::string name(host);
+        if (inet_pton(AF_INET, name.c_str(), target.address) == 1) { target.family = AF_INET; }
+        else if (inet_pton(AF_INET6, name.c_str(), target.address) == 1) { target.family = AF_INET6; }
+        if (target.family != AF_UNSPEC)
+        {
+            targets.push_back(target);
+            return true;
+        }
+
+        // Name of target may have several addresses.
+        std::vector<SocketAddress> addresses;
+        const int32_t result = ResolverCache::Instance().Resolve(name.c_str(), port, AF_UNSPEC, (protocol == IPPROTO_UDP) ? SOCK_DGRAM : SOCK_STREAM, addresses);
+        if (result != RESOLVER_SUCCESS || addresses.empty() == true) {
+            LOG_ERROR("CaptureFilter.AddTarget: Host '", name, "' is not resolved.");
+            return false;
+        }
+        for (const SocketAddress& address : addresses)
+        {
+            target.family = address.storage.ss_family;
+            if (target.family == AF_INET) {
+                memcpy(target.address, &reinterpret_cast<const struct sockaddr_in*>(&address.storage)->sin_addr, 4);
+            }
+            else if (target.family == AF_INET6) {
+                memcpy(target.address, &reinterpret_cast<const struct sockaddr_in6*>(&address.storage)->sin6_addr, 16);
+            }
+            else { continue; }
+            targets.push_back(target);
+        }
+        return true;
+    }
+
+    std::size_t CaptureFilter::LoadDefinition (std::string_view path) noexcept
+    {
+        using parser::JsonValue;
+        using parser::JsonParser;
+
+        const auto definition = JsonParser::ParseFile(path);
+        if (definition.has_value() == false) {
+            LOG_ERROR("CaptureFilter.LoadDefinition: Cannot parse the protocol definition file '", path, "'.");
+            return 0;
+        }
+
+        const JsonValue* const network = definition->FindByPath("Protocol.NetworkSettings");
+        const JsonValue* const target = (network != nullptr) ? network->Find("Target") : nullptr;
+        if (target == nullptr) {
+            LOG_WARNING("CaptureFilter.LoadDefinition: There are no targets in the protocol definition file '", path, "'.");
+            return 0;
+        }
+
+        // Transport contains the alternatives separated by '/' (for example, "tcp/udp"), and the protocol is fixed only if all of them agree.
+        uint8_t protocol = 0;
+        const JsonValue* const transport = network->FindByPath("Global.Transport");
+        if (transport != nullptr && transport->AsString().has_value() == true)
+        {
+            bool tcp = false, udp = false, other = false;
+            for (const std::string_view name : common::text::splitInPlace(*transport->AsString(), '/'))
+            {
+                if (name == "tcp" || name == "tls") { tcp = true; }
+                else if (name == "udp" || name == "dtls") { udp = true; }
+                else if (name.empty() == false) { other = true; }
+            }
+            if (other == false && tcp != udp) { protocol = (tcp == true) ? IPPROTO_TCP : IPPROTO_UDP; }
+        }
+
+        // Targets are added entirely or not at all.
+        const std::size_t previous = targets.size();
+        std::size_t count = 0;
+        const std::size_t size = (target->Type() == JsonValue::JSON_ARRAY) ? target->Size() : 1;
+        for (std::size_t idx = 0; idx < size; ++idx)
+        {
+            const JsonValue* const entry = (target->Type() == JsonValue::JSON_ARRAY) ? target->At(idx) : target;
+            const JsonValue* const host = entry->Find("Host");
+            const JsonValue* const port = entry->Find("Port");
+            const std::string_view name = (host != nullptr && host->AsString().has_value() == true) ? *host->AsString() : std::string_view();
+            const auto number = (port != nullptr) ? port->AsNumber() : std::nullopt;
+            if (name.empty() == true && number.has_value() == false) {
+                LOG_WARNING("CaptureFilter.LoadDefinition: Target ", idx, " is skipped because it does not contain Host or Port.");
+                continue;
+            }
+            if (number.has_value() == true && (*number < 0 || *number > UINT16_MAX)) {
+                LOG_ERROR("CaptureFilter.LoadDefinition: Port of target ", idx, " is out of range: ", *number, '.');
+                targets.resize(previous);
+                return 0;
+            }
+
+            // Host contains the alternatives separated by '/' (for example, address and name of the same host).
+            bool added = false;
+            const uint16_t value = static_cast<uint16_t>(number.value_or(0));
+            if (name.empty() == true) { added = AddTarget(name, value, protocol); }
+            for (const std::string_view alternative : common::text::splitInPlace(name, '/'))
+            {
+                if (AddTarget(alternative, value, protocol) == true) { added = true; }
+                else { LOG_WARNING("CaptureFilter.LoadDefinition: Host '", alternative, "' of target ", idx, " is not added."); }
+            }
+            if (added == false) {
+                LOG_ERROR("CaptureFilter.LoadDefinition: Target ", idx, " of the protocol definition file '", path, "' is not added.");
+                targets.resize(previous);
+                return 0;
+            }
+            count++;
+        }
+
+        LOG_INFO("CaptureFilter.LoadDefinition: ", count, " targets are added from '", path, "'.");
+        return count;
+    }
+
+    bool CaptureFilter::Compile (void) noexcept
+    {
+        program.clear();
+        // Program without targets would accept all frames.
+        if (targets.empty() == true) {
+            LOG_ERROR("CaptureFilter.Compile: There are no targets.");
+            return false;
+        }
+
+        for (const Target& target : targets)
+        {
+            if (target.family != AF_INET6) { CompileTarget(target, AF_INET); }
+            if (target.family != AF_INET) { CompileTarget(target, AF_INET6); }
+        }
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+
+        if (program.size() > MAXIMUM_FILTER_INSTRUCTIONS) {
+            LOG_ERROR("CaptureFilter.Compile: Program of ", targets.size(), " targets is too long: ", program.size(), " instructions.");
+            program.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool CaptureFilter::Attach (const int32_t fd) const noexcept
+    {
+        if (program.empty() == true) {
+            LOG_ERROR("CaptureFilter.Attach [", fd, "]: Filter is not compiled.");
+            return false;
+        }
+
+        struct sock_fprog filter = { static_cast<uint16_t>(program.size()), const_cast<struct sock_filter*>(program.data()) };
+        if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) != 0) {
+            LOG_ERROR("CaptureFilter.Attach [", fd, "]: In function 'setsockopt' with SO_ATTACH_FILTER - ", GET_ERROR(errno));
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t CaptureFilter::Run (const std::byte* packet, const uint32_t length) const noexcept
+    {
+        uint32_t A = 0, X = 0;
+        uint32_t memory[BPF_MEMWORDS] = { };
+        // Load of bytes in network byte order (false if bytes are out of frame).
+        const auto load = [packet, length] (uint64_t offset, uint32_t size, uint32_t& value) {
+            if (offset + size > length) { return false; }
+            value = 0;
+            for (uint32_t idx = 0; idx < size; ++idx) { value = value << 8 | std::to_integer<uint32_t>(packet[offset + idx]); }
+            return true;
+        };
+
+        for (std::size_t pc = 0; pc < program.size(); ++pc)
+        {
+            const struct sock_filter& instruction = program[pc];
+            const uint32_t size = (BPF_SIZE(instruction.code) == BPF_W) ? 4 : (BPF_SIZE(instruction.code) == BPF_H) ? 2 : 1;
+            const uint32_t operand = (BPF_SRC(instruction.code) == BPF_X) ? X : instruction.k;
+            switch (BPF_CLASS(instruction.code))
+            {
+                case BPF_LD:
+                    switch (BPF_MODE(instruction.code))
+                    {
+                        case BPF_ABS: if (load(instruction.k, size, A) == false) { return 0; } break;
+                        case BPF_IND: if (load(static_cast<uint64_t>(X) + instruction.k, size, A) == false) { return 0; } break;
+                        case BPF_LEN: A = length; break;
+                        case BPF_IMM: A = instruction.k; break;
+                        case BPF_MEM: if (instruction.k >= BPF_MEMWORDS) { return 0; } A = memory[instruction.k]; break;
+                        default: return 0;
+                    }
+                    break;
+                case BPF_LDX:
+                    switch (BPF_MODE(instruction.code))
+                    {
+                        case BPF_IMM: X = instruction.k; break;
+                        case BPF_LEN: X = length; break;
+                        case BPF_MEM: if (instruction.k >= BPF_MEMWORDS) { return 0; } X = memory[instruction.k]; break;
+                        case BPF_MSH: if (load(instruction.k, 1, X) == false) { return 0; } X = (X & 0x0F) * 4; break;
+                        default: return 0;
+                    }
+                    break;
+                case BPF_ST:
+                    if (instruction.k >= BPF_MEMWORDS) { return 0; }
+                    memory[instruction.k] = A;
+                    break;
+                case BPF_STX:
+                    if (instruction.k >= BPF_MEMWORDS) { return 0; }
+                    memory[instruction.k] = X;
+                    break;
+                case BPF_ALU:
+                    switch (BPF_OP(instruction.code))
+                    {
+                        case BPF_ADD: A += operand; break;
+                        case BPF_SUB: A -= operand; break;
+                        case BPF_MUL: A *= operand; break;
+                        case BPF_DIV: if (operand == 0) { return 0; } A /= operand; break;
+                        case BPF_MOD: if (operand == 0) { return 0; } A %= operand; break;
+                        case BPF_OR: A |= operand; break;
+                        case BPF_AND: A &= operand; break;
+                        case BPF_XOR: A ^= operand; break;
+                        case BPF_LSH: A = (operand < 32) ? A << operand : 0; break;
+                        case BPF_RSH: A = (operand < 32) ? A >> operand : 0; break;
+                        case BPF_NEG: A = 0 - A; break;
+                        default: return 0;
+                    }
+                    break;
+                case BPF_JMP:
+                {
+                    bool condition;
+                    switch (BPF_OP(instruction.code))
+                    {
+                        case BPF_JA: pc += instruction.k; continue;
+                        case BPF_JEQ: condition = (A == operand); break;
+                        case BPF_JGT: condition = (A > operand); break;
+                        case BPF_JGE: condition = (A >= operand); break;
+                        case BPF_JSET: condition = ((A & operand) != 0); break;
+                        default: return 0;
+                    }
+                    pc += (condition == true) ? instruction.jt : instruction.jf;
+                    break;
+                }
+                case BPF_RET:
+                    return (BPF_RVAL(instruction.code) == BPF_A) ? A : instruction.k;
+                case BPF_MISC:
+                    if (BPF_MISCOP(instruction.code) == BPF_TAX) { X = A; }
+                    else { A = X; }
+                    break;
+                default:
+                    return 0;
+            }
+        }
+        // Program without return rejects the frame.
+        return 0;
+    }
+
+    // Remove all targets and the compiled program.
+    void CaptureFilter::Clear (void) noexcept
+    {
+        targets.clear();
+        program.clear();
+    }
+
+}  // namespace net.
@@ -0,0 +1,260 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <unistd.h>
+#include <netinet/in.h>
+
+#include "../../include/framework/System.hpp"
+#include "../../include/framework/ConnectScanner.hpp"
+
+
+namespace analyzer::framework::net
+{
+    // Returns the state of port by the error code of connection attempt.
+    static PORT_STATE GetPortState (const int32_t error) noexcept
+    {
+        switch (error)
+        {
+            case 0:
+                return PORT_OPEN;
+            case ECONNREFUSED:
+                return PORT_CLOSED;
+            case ETIMEDOUT:
+            case EHOSTUNREACH:
+            case ENETUNREACH:
+            case EHOSTDOWN:
+                return PORT_FILTERED;
+            default:
+                return PORT_ERROR;
+        }
+    }
+
+
+    ConnectScanner::ConnectScanner (const uint32_t inFlight, const uint32_t time, const uint32_t attemptsRate) noexcept
+            : maximumInFlight((inFlight == 0) ? 1 : inFlight), attemptTime(std::chrono::milliseconds(time)), rate(attemptsRate)
+    { }
+
+    // Method that adds the external host and its ports for scanning.
+    bool ConnectScanner::AddTarget (const char* host, std::string_view ports, const int32_t family) noexcept
+    {
+        std::vector<SocketAddress> addresses;
+        const int32_t status = ResolverCache::Instance().Resolve(host, 0, family, SOCK_STREAM, addresses);
+        if (status != RESOLVER_SUCCESS || addresses.empty() == true) {
+            LOG_ERROR("ConnectScanner.AddTarget: Cannot resolve host '", (host != nullptr) ? host : "", "' - ", gai_strerror(status));
+            return false;
+        }
+
+        auto target = system::allocMemoryForObject<Target>();
+        if (target == nullptr) { return false; }
+        target->host = host;
+        target->ports = ports;
+        target->address = addresses.front();
+        // Parser refers to the string of target, so it is created after the string is saved.
+        target->parser = system::allocMemoryForObject<parser::PortsParser>(target->ports);
+        if (target->parser == nullptr) { return false; }
+
+        targets.emplace_back(std::move(target));
+        return true;
+    }
+
+    // Returns the next port for scanning or false if all ports are scanned.
+    bool ConnectScanner::NextPort (std::size_t& target, uint16_t& port) noexcept
+    {
+        // Ports of all targets are interleaved, so each host obtains a part of the rate.
+        for (std::size_t count = 0; count < targets.size(); ++count)
+        {
+            const std::size_t idx = (currentTarget + count) % targets.size();
+            if (targets[idx]->parser == nullptr) { continue; }
+
+            port = targets[idx]->parser->GetNextPort();
+            if (port == parser::PortsParser::end)
+            {
+                targets[idx]->parser.reset();
+                continue;
+            }
+            target = idx;
+            currentTarget = idx + 1;
+            return true;
+        }
+        return false;
+    }
+
+    // Starts the connection attempt (returns false if the attempt should be repeated later).
+    bool ConnectScanner::Start (SocketStatePool& reactor, const std::size_t target, const uint16_t port, ScanResultHandler handler, void* context) noexcept
+    {
+        SocketAddress address = targets[target]->address;
+        if (address.storage.ss_family == AF_INET6) { reinterpret_cast<sockaddr_in6&>(address.storage).sin6_port = htons(port); }
+        else { reinterpret_cast<sockaddr_in&>(address.storage).sin_port = htons(port); }
+
+        const int32_t fd = socket(address.storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+        if (fd == INVALID_SOCKET)
+        {
+            // Descriptors will be released by the attempts in flight.
+            const bool exhausted = (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM);
+            if (exhausted == true && attempts.empty() == false) { return false; }
+
+            LOG_ERROR("ConnectScanner.Start: In function 'socket' - ", GET_ERROR(errno));
+            const ScanResult result = { targets[target]->host, port, PORT_ERROR, errno, std::chrono::microseconds(0) };
+            finished++;
+            handler(result, context);
+            return true;
+        }
+
+        // Connection is reset on close, so the local port is released immediately.
+        const struct linger option = { 1, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, &option, sizeof(option));
+
+        if (reactor.RegisterSocket(fd, SocketStatePool::TEST_ALWAYS) == false)
+        {
+            close(fd);
+            if (attempts.empty() == false) { return false; }
+            const ScanResult result = { targets[target]->host, port, PORT_ERROR, ENOMEM, std::chrono::microseconds(0) };
+            finished++;
+            handler(result, context);
+            return true;
+        }
+
+        Attempt attempt;
+        attempt.target = target;
+        attempt.port = port;
+        attempt.start = clock::now();
+
+        const int32_t status = connect(fd, reinterpret_cast<const struct sockaddr*>(&address.storage), address.length);
+        const int32_t error = (status == SOCKET_SUCCESS) ? 0 : errno;
+        // Local ports are exhausted, so the attempt is repeated after other attempts are finished.
+        if (error == EAGAIN && attempts.empty() == false)
+        {
+            reactor.DeleteDescriptor(fd);
+            close(fd);
+            return false;
+        }
+
+        attempts[fd] = attempt;
+        if (error == EINPROGRESS) { deadlines.emplace_back(fd, attempt.start); }
+        else { Finish(reactor, fd, error, handler, context); }
+        return true;
+    }
+
+    // Finishes the connection attempt and reports its result.
+    void ConnectScanner::Finish (SocketStatePool& reactor, const int32_t fd, const int32_t error, ScanResultHandler handler, void* context) noexcept
+    {
+        const auto it = attempts.find(fd);
+        if (it == attempts.end()) { return; }
+
+        const Attempt attempt = it->second;
+        attempts.erase(it);
+        reactor.DeleteDescriptor(fd);
+        close(fd);
+
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - attempt.start);
+        const ScanResult result = { targets[attempt.target]->host, attempt.port, GetPortState(error), error, latency };
+        finished++;
+        handler(result, context);
+    }
+
+    // Method that scans all added ports and reports each result by handler.
+    std::size_t ConnectScanner::Run (ScanResultHandler handler, void* context) noexcept
+    {
+        if (handler == nullptr) {
+            LOG_ERROR("ConnectScanner.Run: Handler is not set.");
+            return 0;
+        }
+
+        SocketStatePool& reactor = SocketStatePool::Instance();
+        std::vector<int32_t> ready;
+        const std::size_t before = finished;
+        const clock::time_point begin = clock::now();
+        uint64_t launched = 0;
+        bool exhausted = false;
+        bool delayed = false;
+        std::size_t target = 0;
+        uint16_t port = 0;
+
+        LOG_INFO("ConnectScanner.Run: Scanning of ", targets.size(), " targets is started.");
+        while (stopped.load(std::memory_order_relaxed) == false)
+        {
+            // New attempts are started within the limits of in flight attempts and rate.
+            clock::time_point now = clock::now();
+            clock::time_point slot = now;
+            while (exhausted == false && attempts.size() < maximumInFlight)
+            {
+                if (rate != 0)
+                {
+                    slot = begin + std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(std::chrono::seconds(launched)) / rate);
+                    if (now < slot) { break; }
+                }
+                if (delayed == false)
+                {
+                    if (NextPort(target, port) == false) { exhausted = true; break; }
+                    delayed = true;
+                }
+                if (Start(reactor, target, port, handler, context) == false) { break; }
+                delayed = false;
+                launched++;
+            }
+            if (exhausted == true && attempts.empty() == true) { break; }
+
+            // Reactor is waited until the nearest deadline of attempt or the next slot of rate.
+            clock::time_point wake = now + attemptTime;
+            if (deadlines.empty() == false) { wake = std::min(wake, deadlines.front().second + attemptTime); }
+            if (rate != 0 && exhausted == false && attempts.size() < maximumInFlight) { wake = std::min(wake, slot); }
+            const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(wake - clock::now()).count() + 1;
+
+            ready.clear();
+            if (reactor.Poll(static_cast<int32_t>(std::max<decltype(wait)>(wait, 0)), ready) == SOCKET_ERROR) { break; }
+            for (const int32_t fd : ready)
+            {
+                if (attempts.find(fd) == attempts.end()) { continue; }
+
+                const uint16_t status = reactor.CheckSocketStatus(fd);
+                if ((status & (SocketStatePool::STATUS_WRITE | SocketStatePool::STATUS_ERROR | SocketStatePool::STATUS_CLOSED)) == 0) { continue; }
+
+                int32_t error = 0;
+                socklen_t size = sizeof(error);
+                if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != SOCKET_SUCCESS) { error = errno; }
+                if (error == 0 && (status & SocketStatePool::STATUS_WRITE) == 0) { error = ECONNRESET; }
+                Finish(reactor, fd, error, handler, context);
+            }
+
+            // Attempts without answer are finished by deadline (entries of the finished attempts are skipped).
+            now = clock::now();
+            while (deadlines.empty() == false && deadlines.front().second + attemptTime <= now)
+            {
+                const auto [ fd, start ] = deadlines.front();
+                deadlines.pop_front();
+                const auto it = attempts.find(fd);
+                if (it != attempts.end() && it->second.start == start) { Finish(reactor, fd, ETIMEDOUT, handler, context); }
+            }
+            // Entries of the finished attempts are removed from the beginning of queue.
+            while (deadlines.empty() == false)
+            {
+                const auto it = attempts.find(deadlines.front().first);
+                if (it != attempts.end() && it->second.start == deadlines.front().second) { break; }
+                deadlines.pop_front();
+            }
+        }
+
+        // Attempts in flight are aborted after stop.
+        for (auto&& [ fd, attempt ] : attempts)
+        {
+            reactor.DeleteDescriptor(fd);
+            close(fd);
+        }
+        attempts.clear();
+        deadlines.clear();
+
+        LOG_INFO("ConnectScanner.Run: Scanning is finished: ", finished - before, " ports.");
+        return finished - before;
+    }
+
+    ConnectScanner::~ConnectScanner (void) noexcept
+    {
+        for (auto&& [ fd, attempt ] : attempts) { close(fd); }
+    }
+
+}  // namespace net.
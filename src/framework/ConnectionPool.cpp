@@ -0,0 +1,247 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include "../../include/framework/Parser.hpp"
+#include "../../include/framework/System.hpp"
+#include "../../include/framework/ConnectionPool.hpp"
+
+
+namespace analyzer::framework::net
+{
+    ConnectionLease::ConnectionLease (ConnectionPool* owner, std::string name, std::unique_ptr<Socket>&& connection, const bool idle) noexcept
+            : pool(owner), key(std::move(name)), socket(std::move(connection)), reused(idle)
+    { }
+
+    // Destructor that returns the connection to the pool.
+    ConnectionLease::~ConnectionLease (void) noexcept
+    {
+        if (pool != nullptr && socket != nullptr) {
+            pool->Release(key, std::move(socket), reusable);
+        }
+    }
+
+
+    ConnectionPool::ConnectionPool (const std::size_t maximum, const std::chrono::seconds time) noexcept
+            : limit(maximum), idleTime(time)
+    { }
+
+    // Returns the key of connection parameters.
+    std::string ConnectionPool::MakeKey (const ConnectionParameters& parameters) noexcept
+    {
+        std::string key = parameters.host;
+        key.push_back('\0');
+        key.append(std::to_string(parameters.port)).push_back('/');
+        if (parameters.secure == true)
+        {
+            key.append(std::to_string(parameters.method)).push_back('/');
+            key.append(parameters.ciphers).push_back('/');
+            key.append(parameters.protocols);
+        }
+        return key;
+    }
+
+    // Creates and connects the new socket.
+    std::unique_ptr<Socket> ConnectionPool::Connect (const ConnectionParameters& parameters) noexcept
+    {
+        std::unique_ptr<Socket> socket = nullptr;
+        if (parameters.secure == true)
+        {
+            // Ciphers and ALPN protocols are applied once by the shared context of profile.
+            SSLContextProfile profile;
+            profile.minimum = profile.maximum = parameters.method;
+            profile.ciphers = parameters.ciphers;
+            profile.protocols = parameters.protocols;
+            socket = system::allocMemoryForObject<SocketSSL>(profile);
+        }
+        else { socket = system::allocMemoryForObject<Socket>(); }
+
+        if (socket == nullptr || socket->Connect(parameters.host.c_str(), parameters.port) == false) {
+            LOG_ERROR("ConnectionPool.Connect: Cannot connect to '", parameters.host, "' on port '", parameters.port, "'.");
+            return nullptr;
+        }
+        return socket;
+    }
+
+    // Moves the expired idle connections (or the oldest one if force is set) to output (must be called under mutex).
+    void ConnectionPool::TakeExpired (std::vector<std::unique_ptr<Socket>>& output, const bool force) noexcept
+    {
+        const clock::time_point now = clock::now();
+        const std::size_t before = output.size();
+        std::vector<IdleConnection>* oldestList = nullptr;
+        std::size_t oldestIndex = 0;
+
+        for (auto it = idle.begin(); it != idle.end(); )
+        {
+            auto& connections = it->second;
+            for (std::size_t idx = 0; idx < connections.size(); )
+            {
+                if (now - connections[idx].since >= idleTime)
+                {
+                    output.emplace_back(std::move(connections[idx].socket));
+                    connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(idx));
+                    total--;
+                    continue;
+                }
+                if (oldestList == nullptr || connections[idx].since < (*oldestList)[oldestIndex].since)
+                {
+                    oldestList = &connections;
+                    oldestIndex = idx;
+                }
+                ++idx;
+            }
+            if (connections.empty() == true)
+            {
+                if (oldestList == &connections) { oldestList = nullptr; }
+                it = idle.erase(it);
+            }
+            else { ++it; }
+        }
+
+        // The oldest connection is closed only if no any connection has expired.
+        if (force == true && output.size() == before && oldestList != nullptr)
+        {
+            output.emplace_back(std::move((*oldestList)[oldestIndex].socket));
+            oldestList->erase(oldestList->begin() + static_cast<std::ptrdiff_t>(oldestIndex));
+            total--;
+        }
+    }
+
+    // Method that reads the limits of pool from the scanner settings file.
+    bool ConnectionPool::LoadSettings (std::string_view path) noexcept
+    {
+        const auto settings = parser::JsonParser::ParseFile(path);
+        if (settings.has_value() == false) {
+            LOG_ERROR("ConnectionPool.LoadSettings: Cannot parse the settings file '", path, "'.");
+            return false;
+        }
+
+        system::LockGuard lock(mutex);
+        const parser::JsonValue* const maximum = settings->FindByPath("Network.MaximumSocketConnections");
+        if (maximum != nullptr && maximum->AsNumber().has_value() == true && *maximum->AsNumber() > 0) {
+            limit = static_cast<std::size_t>(*maximum->AsNumber());
+        }
+        const parser::JsonValue* const time = settings->FindByPath("Network.Timeouts.IdleConnection");
+        if (time != nullptr && time->AsNumber().has_value() == true && *time->AsNumber() >= 0) {
+            idleTime = std::chrono::seconds(static_cast<int64_t>(*time->AsNumber()));
+        }
+        LOG_INFO("ConnectionPool.LoadSettings: Maximum connections: ", limit, ", idle time: ", idleTime.count(), " sec.");
+        return true;
+    }
+
+    // Method that returns the live connection to the external host.
+    ConnectionLease ConnectionPool::Acquire (const ConnectionParameters& parameters) noexcept
+    {
+        const std::string key = MakeKey(parameters);
+        std::vector<std::unique_ptr<Socket>> closed;
+
+        while (true)
+        {
+            std::unique_ptr<Socket> socket = nullptr;
+            {
+                system::LockGuard lock(mutex);
+                TakeExpired(closed, false);
+                auto it = idle.find(key);
+                if (it != idle.end() && it->second.empty() == false)
+                {
+                    socket = std::move(it->second.back().socket);
+                    it->second.pop_back();
+                    if (it->second.empty() == true) { idle.erase(it); }
+                }
+                else
+                {
+                    if (total >= limit) { TakeExpired(closed, true); }
+                    if (total >= limit) {
+                        LOG_ERROR("ConnectionPool.Acquire: Limit of connections is reached: ", limit, '.');
+                        return ConnectionLease();
+                    }
+                    total++;  // The place for the new connection is reserved.
+                    break;
+                }
+            }
+
+            // Idle connection may be released by another thread, so it is moved to the reactor of the calling thread.
+            if (socket->RebindReactor() == true && socket->IsReusable() == true) {
+                LOG_TRACE("ConnectionPool.Acquire: Idle connection to '", parameters.host, "' is reused.");
+                return ConnectionLease(this, key, std::move(socket), true);
+            }
+            closed.emplace_back(std::move(socket));
+            system::LockGuard lock(mutex);
+            total--;
+        }
+
+        closed.clear();
+        std::unique_ptr<Socket> socket = Connect(parameters);
+        if (socket == nullptr)
+        {
+            system::LockGuard lock(mutex);
+            total--;
+            return ConnectionLease();
+        }
+        return ConnectionLease(this, key, std::move(socket), false);
+    }
+
+    // Returns the connection from the lease.
+    void ConnectionPool::Release (const std::string& key, std::unique_ptr<Socket>&& socket, const bool reusable) noexcept
+    {
+        std::unique_ptr<Socket> closed = nullptr;
+        system::LockGuard lock(mutex);
+        if (reusable == true && socket->GetFd() != INVALID_SOCKET && idleTime.count() > 0)
+        {
+            IdleConnection connection;
+            connection.socket = std::move(socket);
+            connection.since = clock::now();
+            idle[key].emplace_back(std::move(connection));
+            return;
+        }
+        closed = std::move(socket);
+        total--;
+    }
+
+    // Method that closes the idle connections whose idle time has expired.
+    std::size_t ConnectionPool::EvictIdle (void) noexcept
+    {
+        std::vector<std::unique_ptr<Socket>> closed;
+        {
+            system::LockGuard lock(mutex);
+            TakeExpired(closed, false);
+        }
+        if (closed.empty() == false) { LOG_TRACE("ConnectionPool.EvictIdle: ", closed.size(), " idle connections are closed."); }
+        return closed.size();
+    }
+
+    // Method that closes all idle connections.
+    void ConnectionPool::Clear (void) noexcept
+    {
+        std::unordered_map<std::string, std::vector<IdleConnection>> closed;
+        system::LockGuard lock(mutex);
+        for (auto&& [ key, connections ] : idle) { total -= connections.size(); }
+        closed.swap(idle);
+    }
+
+    // Return the number of idle connections.
+    std::size_t ConnectionPool::IdleCount (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        std::size_t count = 0;
+        for (auto&& [ key, connections ] : idle) { count += connections.size(); }
+        return count;
+    }
+
+    // Return the number of idle and leased connections.
+    std::size_t ConnectionPool::TotalCount (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return total;
+    }
+
+    ConnectionPool::~ConnectionPool (void) noexcept
+    {
+        Clear();
+    }
+
+}  // namespace net.
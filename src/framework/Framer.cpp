@@ -0,0 +1,121 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <cstring>
+#include <algorithm>
+
+#include "../../include/framework/Log.hpp"
+#include "../../include/framework/Framer.hpp"
+
+
+namespace analyzer::framework::net
+{
+    DelimiterFramer::DelimiterFramer (std::string_view end, const std::size_t limit) noexcept
+            : delimiter(end), prefix(end.size(), 0), maximum(limit)
+    {
+        for (std::size_t idx = 1, length = 0; idx < delimiter.size(); ++idx)
+        {
+            while (length != 0 && delimiter[idx] != delimiter[length]) { length = prefix[length - 1]; }
+            if (delimiter[idx] == delimiter[length]) { ++length; }
+            prefix[idx] = length;
+        }
+    }
+
+    FRAME_STATE DelimiterFramer::Feed (const char* data, const std::size_t length) noexcept
+    {
+        if (frameLength != 0) { return FRAME_COMPLETE; }
+        if (delimiter.empty() == true) { return FRAME_ERROR; }
+
+        std::size_t idx = 0;
+        while (idx < length)
+        {
+            // Bytes before the first symbol of delimiter are skipped by memchr.
+            if (matched == 0)
+            {
+                const void* first = memchr(data + idx, delimiter[0], length - idx);
+                if (first == nullptr) { idx = length; break; }
+                idx = static_cast<std::size_t>(static_cast<const char*>(first) - data);
+            }
+
+            while (matched != 0 && data[idx] != delimiter[matched]) { matched = prefix[matched - 1]; }
+            if (data[idx] == delimiter[matched]) { ++matched; }
+            ++idx;
+
+            if (matched == delimiter.size())
+            {
+                frameLength = fed + idx;
+                fed = frameLength;
+                return FRAME_COMPLETE;
+            }
+        }
+
+        fed += length;
+        if (maximum != 0 && fed >= maximum) {
+            LOG_ERROR("DelimiterFramer.Feed: Delimiter is not found within ", maximum, " bytes.");
+            return FRAME_ERROR;
+        }
+        return FRAME_NEED_MORE;
+    }
+
+
+    LengthPrefixFramer::LengthPrefixFramer (const std::size_t size, const bool order, const std::size_t skip, const int64_t correction, const std::size_t limit) noexcept
+            : offset(skip), prefixSize(size), bigEndian(order), adjustment(correction), maximum(limit)
+    { }
+
+    // Return the unsigned integer from header.
+    uint64_t LengthPrefixFramer::ReadHeaderValue (const std::size_t position, const std::size_t size) const noexcept
+    {
+        uint64_t value = 0;
+        for (std::size_t idx = 0; idx < size; ++idx) {
+            const std::size_t byte = (bigEndian == true) ? position + idx : position + size - 1 - idx;
+            value = (value << 8U) | header[byte];
+        }
+        return value;
+    }
+
+    FRAME_STATE LengthPrefixFramer::Feed (const char* data, const std::size_t length) noexcept
+    {
+        const std::size_t headerSize = offset + prefixSize;
+        if (frameLength == 0)
+        {
+            if ((prefixSize != 1 && prefixSize != 2 && prefixSize != 4 && prefixSize != 8) || offset > MAXIMUM_FRAME_HEADER - prefixSize) {
+                LOG_ERROR("LengthPrefixFramer.Feed: Incorrect size of header: ", offset, " + ", prefixSize, " bytes.");
+                return FRAME_ERROR;
+            }
+
+            const std::size_t part = std::min(length, headerSize - fed);
+            memcpy(header + fed, data, part);
+            fed += part;
+            if (fed < headerSize) { return FRAME_NEED_MORE; }
+
+            const auto body = static_cast<int64_t>(ReadHeaderValue(offset, prefixSize)) + adjustment;
+            if (body < 0 || (maximum != 0 && static_cast<uint64_t>(body) > maximum - std::min(maximum, headerSize))) {
+                LOG_ERROR("LengthPrefixFramer.Feed: Incorrect length of frame body: ", body, '.');
+                return FRAME_ERROR;
+            }
+            frameLength = headerSize + static_cast<std::size_t>(body);
+            fed += length - part;
+        }
+        else { fed += length; }
+
+        return (fed >= frameLength) ? FRAME_COMPLETE : FRAME_LENGTH_KNOWN;
+    }
+
+    std::size_t LengthPrefixFramer::Expected (void) const noexcept
+    {
+        // Header is received exactly, so the body of frame is not mixed with the next frame.
+        if (frameLength == 0) { return offset + prefixSize - std::min(fed, offset + prefixSize); }
+        return (frameLength > fed) ? frameLength - fed : 0;
+    }
+
+
+    TlvFramer::TlvFramer (const std::size_t typeSize, const std::size_t lengthSize, const bool order, const std::size_t limit) noexcept
+            : LengthPrefixFramer(lengthSize, order, typeSize, 0, limit)
+    { }
+
+}  // namespace net.
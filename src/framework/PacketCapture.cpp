@@ -0,0 +1,485 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <poll.h>
+#include <algorithm>
+#include <sched.h>
+#include <pthread.h>
+#include <net/if.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "../../include/framework/Log.hpp"
+#include "../../include/framework/PacketCapture.hpp"
+
+
+namespace analyzer::framework::net
+{
+    PacketCapture::PacketCapture (const uint32_t size, const uint32_t count, const uint32_t retire) noexcept
+            : blockSize(size), blockCount(count), retireTimeout(retire)
+    { }
+
+    bool PacketCapture::Open (const char* interface, const uint16_t protocol, const CaptureFilter* filter) noexcept
+    {
+        Close();
+        const auto page = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+        if (blockSize < CAPTURE_FRAME_SIZE || blockSize % page != 0 || blockCount == 0) {
+            LOG_ERROR("PacketCapture.Open: Incorrect size of capture ring: ", blockCount, " blocks of ", blockSize, " bytes.");
+            return false;
+        }
+
+        // Socket is created without protocol, so no frame is received until the socket is bound to the interface.
+        fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+        if (fd == -1) {
+            LOG_ERROR("PacketCapture.Open: In function 'socket' - ", GET_ERROR(errno));
+            return false;
+        }
+
+        // Filter is attached before the ring is created, so irrelevant frames never reach the ring.
+        if (filter != nullptr && filter->Attach(fd) == false)
+        {
+            Close();
+            return false;
+        }
+
+        int32_t version = TPACKET_V3;
+        if (setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+            LOG_ERROR("PacketCapture.Open [", fd, "]: In function 'setsockopt' with PACKET_VERSION - ", GET_ERROR(errno));
+            Close();
+            return false;
+        }
+
+        struct tpacket_req3 request = { };
+        request.tp_block_size = blockSize;
+        request.tp_block_nr = blockCount;
+        request.tp_frame_size = CAPTURE_FRAME_SIZE;
+        request.tp_frame_nr = (blockSize / CAPTURE_FRAME_SIZE) * blockCount;
+        request.tp_retire_blk_tov = retireTimeout;
+        request.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+        if (setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) != 0) {
+            LOG_ERROR("PacketCapture.Open [", fd, "]: In function 'setsockopt' with PACKET_RX_RING - ", GET_ERROR(errno));
+            Close();
+            return false;
+        }
+
+        void* memory = mmap(nullptr, GetRingSize(), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        if (memory == MAP_FAILED) {
+            LOG_ERROR("PacketCapture.Open [", fd, "]: In function 'mmap' - ", GET_ERROR(errno));
+            Close();
+            return false;
+        }
+        ring = static_cast<std::byte*>(memory);
+
+        // Protocol is set only by binding, so the ring receives the frames of the selected interface only.
+        struct sockaddr_ll address = { };
+        address.sll_family = AF_PACKET;
+        address.sll_protocol = htons(protocol);
+        if (interface != nullptr && (address.sll_ifindex = static_cast<int32_t>(if_nametoindex(interface))) == 0) {
+            LOG_ERROR("PacketCapture.Open [", fd, "]: Network interface '", interface, "' is not found.");
+            Close();
+            return false;
+        }
+        if (bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+            LOG_ERROR("PacketCapture.Open [", fd, "]: In function 'bind' - ", GET_ERROR(errno));
+            Close();
+            return false;
+        }
+
+        LOG_INFO("PacketCapture.Open [", fd, "]: Capture on '", (interface != nullptr) ? interface : "any", "' is started: ", blockCount, " blocks of ", blockSize, " bytes.");
+        return true;
+    }
+
+    // Return the owned block to the kernel.
+    void PacketCapture::ReleaseBlock (void) noexcept
+    {
+        if (block == nullptr) { return; }
+        // Kernel reads the status after all frames of block are processed.
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        block = nullptr;
+        nextFrame = nullptr;
+        remaining = 0;
+        currentBlock = (currentBlock + 1) % blockCount;
+    }
+
+    bool PacketCapture::NextFrame (CapturedFrame& frame, const int32_t time) noexcept
+    {
+        if (ring == nullptr) {
+            LOG_ERROR("PacketCapture.NextFrame: Capture is not started.");
+            return false;
+        }
+
+        if (block != nullptr && remaining == 0) { ReleaseBlock(); }
+        if (block == nullptr)
+        {
+            auto* descriptor = reinterpret_cast<struct tpacket_block_desc*>(ring + static_cast<std::size_t>(currentBlock) * blockSize);
+            if ((__atomic_load_n(&descriptor->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+            {
+                // Socket becomes readable when the kernel retires the block.
+                struct pollfd request = { fd, POLLIN | POLLERR, 0 };
+                const int32_t result = poll(&request, 1, time);
+                if (result == -1 && errno != EINTR) {
+                    LOG_ERROR("PacketCapture.NextFrame [", fd, "]: In function 'poll' - ", GET_ERROR(errno));
+                    return false;
+                }
+                if ((__atomic_load_n(&descriptor->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) { return false; }
+            }
+
+            block = descriptor;
+            remaining = block->hdr.bh1.num_pkts;
+            nextFrame = reinterpret_cast<struct tpacket3_hdr*>(reinterpret_cast<std::byte*>(block) + block->hdr.bh1.offset_to_first_pkt);
+            // Block without frames is retired only by timeout.
+            if (remaining == 0)
+            {
+                ReleaseBlock();
+                return false;
+            }
+        }
+
+        struct tpacket3_hdr* header = nextFrame;
+        const auto* link = reinterpret_cast<const struct sockaddr_ll*>(reinterpret_cast<std::byte*>(header) + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+        frame.data.Reset();
+        frame.data.SetDataEndianType(common::types::DATA_BIG_ENDIAN, false);
+        frame.data.AssignReference(reinterpret_cast<std::byte*>(header) + header->tp_mac, header->tp_snaplen);
+        frame.originalLength = header->tp_len;
+        frame.time.tv_sec = static_cast<time_t>(header->tp_sec);
+        frame.time.tv_nsec = static_cast<long>(header->tp_nsec);
+        frame.interface = link->sll_ifindex;
+        frame.protocol = ntohs(link->sll_protocol);
+        frame.type = link->sll_pkttype;
+
+        remaining--;
+        nextFrame = (remaining != 0) ? reinterpret_cast<struct tpacket3_hdr*>(reinterpret_cast<std::byte*>(header) + header->tp_next_offset) : nullptr;
+        return true;
+    }
+
+    bool PacketCapture::GetStatistics (CaptureStatistics& result) noexcept
+    {
+        if (fd == -1) {
+            LOG_ERROR("PacketCapture.GetStatistics: Capture is not started.");
+            return false;
+        }
+
+        // Kernel resets the counters after each reading, so they are accumulated.
+        struct tpacket_stats_v3 counters = { };
+        socklen_t length = sizeof(counters);
+        if (getsockopt(fd, SOL_PACKET, PACKET_STATISTICS, &counters, &length) != 0) {
+            LOG_ERROR("PacketCapture.GetStatistics [", fd, "]: In function 'getsockopt' - ", GET_ERROR(errno));
+            return false;
+        }
+        statistics.packets += counters.tp_packets;
+        statistics.drops += counters.tp_drops;
+        statistics.freezes += counters.tp_freeze_q_cnt;
+        result = statistics;
+        return true;
+    }
+
+    bool PacketCapture::JoinFanout (const uint16_t group, const uint16_t mode, const uint16_t flags) noexcept
+    {
+        if (fd == -1) {
+            LOG_ERROR("PacketCapture.JoinFanout: Capture is not started.");
+            return false;
+        }
+
+        // Socket must be bound before joining the group.
+        uint32_t argument = static_cast<uint32_t>(group) | (static_cast<uint32_t>(mode | flags) << 16);
+        if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &argument, sizeof(argument)) != 0) {
+            LOG_ERROR("PacketCapture.JoinFanout [", fd, "]: In function 'setsockopt' with PACKET_FANOUT - ", GET_ERROR(errno));
+            return false;
+        }
+        // Identifier may be selected by the kernel.
+        socklen_t length = sizeof(argument);
+        if (getsockopt(fd, SOL_PACKET, PACKET_FANOUT, &argument, &length) != 0) {
+            LOG_ERROR("PacketCapture.JoinFanout [", fd, "]: In function 'getsockopt' with PACKET_FANOUT - ", GET_ERROR(errno));
+            return false;
+        }
+        fanout = static_cast<int32_t>(argument & 0xFFFF);
+        return true;
+    }
+
+    // Stop capture and release the capture ring.
+    void PacketCapture::Close (void) noexcept
+    {
+        if (ring != nullptr)
+        {
+            munmap(ring, GetRingSize());
+            ring = nullptr;
+        }
+        if (fd != -1)
+        {
+            close(fd);
+            fd = -1;
+        }
+        block = nullptr;
+        nextFrame = nullptr;
+        remaining = 0;
+        currentBlock = 0;
+        statistics = { };
+        fanout = -1;
+    }
+
+    PacketCapture::~PacketCapture (void) noexcept
+    {
+        Close();
+    }
+
+
+    CaptureSession::CaptureSession (const uint32_t size, const uint32_t count, const uint32_t retire) noexcept
+            : blockSize(size), blockCount(count), retireTimeout(retire)
+    { }
+
+    // Publish the kernel counters of worker ring.
+    void CaptureSession::PublishStatistics (Worker& worker) noexcept
+    {
+        CaptureStatistics kernel = { };
+        if (worker.capture.GetStatistics(kernel) == true)
+        {
+            worker.packets.store(kernel.packets, std::memory_order_relaxed);
+            worker.drops.store(kernel.drops, std::memory_order_relaxed);
+            worker.freezes.store(kernel.freezes, std::memory_order_relaxed);
+        }
+    }
+
+    // Thread of capture worker.
+    void CaptureSession::CaptureWorker (Worker& worker) noexcept
+    {
+        // Frame and counters are local, so the atomic counters are only published by plain stores.
+        CapturedFrame frame;
+        uint64_t frames = 0, bytes = 0;
+        while (stopped.load(std::memory_order_relaxed) == false)
+        {
+            const bool received = worker.capture.NextFrame(frame, CAPTURE_WORKER_POLL_TIME);
+            if (received == true)
+            {
+                handler(frame, worker.state);
+                frames++;
+                bytes += frame.originalLength;
+                worker.frames.store(frames, std::memory_order_relaxed);
+                worker.bytes.store(bytes, std::memory_order_relaxed);
+            }
+
+            // Kernel counters are read when the worker is idle and once per 64K frames.
+            if (received == false || (frames & 0xFFFF) == 0) { PublishStatistics(worker); }
+        }
+        PublishStatistics(worker);
+    }
+
+    bool CaptureSession::Start (const char* interface, const std::vector<void*>& states, CaptureHandler function,
+                                const uint16_t mode, const uint16_t flags, const bool pin) noexcept
+    {
+        Stop();
+        workers.clear();
+        if (states.empty() == true || function == nullptr) {
+            LOG_ERROR("CaptureSession.Start: Incorrect input parameters.");
+            return false;
+        }
+
+        // All rings join the group before the threads are started, so the distribution of frames does not change later.
+        handler = function;
+        int32_t group = -1;
+        for (void* state : states)
+        {
+            auto worker = system::allocMemoryForObject<Worker>(blockSize, blockCount, retireTimeout);
+            if (worker == nullptr) {
+                LOG_ERROR("CaptureSession.Start: Memory allocation failed.");
+                workers.clear();
+                return false;
+            }
+            worker->state = state;
+
+            // The first ring creates the group with the unique identifier.
+            bool result = worker->capture.Open(interface, ETH_P_ALL, (filter.GetProgram().empty() == true) ? nullptr : &filter);
+            if (result == true) {
+                result = (group == -1) ? worker->capture.JoinFanout(0, mode, flags | PACKET_FANOUT_FLAG_UNIQUEID)
+                                       : worker->capture.JoinFanout(static_cast<uint16_t>(group), mode, flags);
+            }
+            if (result == false)
+            {
+                LOG_ERROR("CaptureSession.Start: Capture worker ", workers.size(), " is not started.");
+                workers.clear();
+                return false;
+            }
+            group = worker->capture.GetFanoutGroup();
+            workers.emplace_back(std::move(worker));
+        }
+
+        stopped.store(false, std::memory_order_relaxed);
+        start = std::chrono::steady_clock::now();
+        const std::size_t processors = std::max(std::thread::hardware_concurrency(), 1U);
+        for (std::size_t idx = 0; idx < workers.size(); ++idx)
+        {
+            Worker& worker = *workers[idx];
+            try { worker.thread = std::thread(&CaptureSession::CaptureWorker, this, std::ref(worker)); }
+            catch (const std::system_error& err)
+            {
+                LOG_ERROR("CaptureSession.Start: Thread of capture worker ", idx, " is not started - ", err.what());
+                Stop();
+                return false;
+            }
+
+            if (pin == true)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(idx % processors, &set);
+                const int32_t result = pthread_setaffinity_np(worker.thread.native_handle(), sizeof(set), &set);
+                if (result != 0) {
+                    LOG_WARNING("CaptureSession.Start: Capture worker ", idx, " is not bound to CPU - ", GET_ERROR(result));
+                }
+            }
+        }
+
+        LOG_INFO("CaptureSession.Start: Capture session with ", workers.size(), " workers in fanout group ", group, " is started.");
+        return true;
+    }
+
+    bool CaptureSession::GetStatistics (const std::size_t index, CaptureWorkerStatistics& result) const noexcept
+    {
+        if (index >= workers.size()) {
+            LOG_ERROR("CaptureSession.GetStatistics: Incorrect index of capture worker: ", index, '.');
+            return false;
+        }
+
+        const Worker& worker = *workers[index];
+        result.kernel.packets = worker.packets.load(std::memory_order_relaxed);
+        result.kernel.drops = worker.drops.load(std::memory_order_relaxed);
+        result.kernel.freezes = worker.freezes.load(std::memory_order_relaxed);
+        result.frames = worker.frames.load(std::memory_order_relaxed);
+        result.bytes = worker.bytes.load(std::memory_order_relaxed);
+
+        const auto end = (stopped.load(std::memory_order_relaxed) == true) ? finish : std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed = end - start;
+        result.framesPerSecond = (elapsed.count() > 0) ? static_cast<double>(result.frames) / elapsed.count() : 0;
+        result.bytesPerSecond = (elapsed.count() > 0) ? static_cast<double>(result.bytes) / elapsed.count() : 0;
+        return true;
+    }
+
+    // Stop the capture workers and release their rings.
+    void CaptureSession::Stop (void) noexcept
+    {
+        if (stopped.exchange(true) == true) { return; }
+        finish = std::chrono::steady_clock::now();
+        for (auto&& worker : workers)
+        {
+            if (worker->thread.joinable() == true) { worker->thread.join(); }
+            worker->capture.Close();
+        }
+    }
+
+    CaptureSession::~CaptureSession (void) noexcept
+    {
+        Stop();
+    }
+
+
+    // Magic numbers of pcap file with microsecond and nanosecond timestamps.
+    static constexpr uint32_t PCAP_MAGIC_MICROSECONDS = 0xA1B2C3D4;
+    static constexpr uint32_t PCAP_MAGIC_NANOSECONDS = 0xA1B23C4D;
+    // Maximum size of frame in pcap file.
+    static constexpr uint32_t PCAP_MAXIMUM_FRAME = 1U << 26;
+    // Type of link layer of Ethernet frames.
+    static constexpr uint32_t PCAP_LINKTYPE_ETHERNET = 1;
+
+    bool PcapReader::Open (std::string_view path) noexcept
+    {
+        Close();
+        file.open(path.data(), std::ios_base::binary);
+        if (file.is_open() == false) {
+            LOG_ERROR("PcapReader.Open: Cannot open the file '", path, "'.");
+            return false;
+        }
+
+        // Global header: magic, version (2 + 2), timezone, accuracy, snapshot length, link type.
+        uint32_t header[6] = { };
+        if (file.read(reinterpret_cast<char*>(header), sizeof(header)).good() == false) {
+            LOG_ERROR("PcapReader.Open: File '", path, "' is too short.");
+            Close();
+            return false;
+        }
+
+        const uint32_t magic = header[0];
+        swapped = (magic == __builtin_bswap32(PCAP_MAGIC_MICROSECONDS) || magic == __builtin_bswap32(PCAP_MAGIC_NANOSECONDS));
+        nanoseconds = (Field(magic) == PCAP_MAGIC_NANOSECONDS);
+        if (Field(magic) != PCAP_MAGIC_MICROSECONDS && nanoseconds == false) {
+            LOG_ERROR("PcapReader.Open: File '", path, "' is not in pcap format.");
+            Close();
+            return false;
+        }
+        linkType = Field(header[5]) & 0xFFFF;
+        if (linkType != PCAP_LINKTYPE_ETHERNET) {
+            LOG_WARNING("PcapReader.Open: Link type of file '", path, "' is not Ethernet: ", linkType, '.');
+        }
+        return true;
+    }
+
+    bool PcapReader::NextFrame (CapturedFrame& frame, const CaptureFilter* filter) noexcept
+    {
+        if (file.is_open() == false) {
+            LOG_ERROR("PcapReader.NextFrame: File is not opened.");
+            return false;
+        }
+        // Program of filter contains the offsets of fields in Ethernet frame.
+        if (filter != nullptr && linkType != PCAP_LINKTYPE_ETHERNET) {
+            LOG_ERROR("PcapReader.NextFrame: Filter cannot be applied to the frames of link type ", linkType, '.');
+            return false;
+        }
+
+        while (true)
+        {
+            // Record header: seconds, microseconds or nanoseconds, captured length, original length.
+            uint32_t header[4] = { };
+            if (file.read(reinterpret_cast<char*>(header), sizeof(header)).good() == false) { return false; }
+            const uint32_t length = Field(header[2]);
+            if (length > PCAP_MAXIMUM_FRAME) {
+                LOG_ERROR("PcapReader.NextFrame: Incorrect length of frame: ", length, '.');
+                return false;
+            }
+
+            if (length > capacity)
+            {
+                buffer = system::allocMemoryForArray<std::byte>(length);
+                if (buffer == nullptr) {
+                    LOG_ERROR("PcapReader.NextFrame: Memory allocation failed.");
+                    capacity = 0;
+                    return false;
+                }
+                capacity = length;
+            }
+            if (length != 0 && file.read(reinterpret_cast<char*>(buffer.get()), length).good() == false) {
+                LOG_ERROR("PcapReader.NextFrame: Frame is truncated.");
+                return false;
+            }
+
+            const uint32_t accepted = (filter != nullptr) ? std::min(filter->Run(buffer.get(), length), length) : length;
+            if (accepted == 0) { continue; }
+
+            frame.data.Reset();
+            frame.data.SetDataEndianType(common::types::DATA_BIG_ENDIAN, false);
+            frame.data.AssignReference(buffer.get(), accepted);
+            frame.originalLength = Field(header[3]);
+            frame.time.tv_sec = static_cast<time_t>(Field(header[0]));
+            frame.time.tv_nsec = static_cast<long>(Field(header[1])) * ((nanoseconds == true) ? 1 : 1000);
+            frame.interface = 0;
+            frame.protocol = (linkType == PCAP_LINKTYPE_ETHERNET && accepted >= ETH_HLEN) ?
+                             static_cast<uint16_t>(std::to_integer<uint16_t>(buffer[12]) << 8 | std::to_integer<uint16_t>(buffer[13])) : 0;
+            frame.type = PACKET_HOST;
+            return true;
+        }
+    }
+
+    // Close the pcap file.
+    void PcapReader::Close (void) noexcept
+    {
+        if (file.is_open() == true) { file.close(); }
+        file.clear();
+        swapped = nanoseconds = false;
+        linkType = 0;
+    }
+
+}  // namespace net.
@@ -76,4 +76,304 @@ namespace analyzer::framework::parser
         return rangeState;
     }
 
+
+
+    std::optional<bool> JsonValue::AsBoolean(void) const noexcept
+    {
+        if (type == JSON_BOOLEAN) { return boolean; }
+        return std::nullopt;
+    }
+
+    std::optional<double> JsonValue::AsNumber(void) const noexcept
+    {
+        if (type == JSON_NUMBER) { return number; }
+        return std::nullopt;
+    }
+
+    std::optional<std::string_view> JsonValue::AsString(void) const noexcept
+    {
+        if (type == JSON_STRING) { return std::string_view(string); }
+        return std::nullopt;
+    }
+
+    const JsonValue* JsonValue::At (const std::size_t index) const noexcept
+    {
+        if (index < values.size()) { return &values[index]; }
+        return nullptr;
+    }
+
+    std::string_view JsonValue::KeyAt (const std::size_t index) const noexcept
+    {
+        if (type == JSON_OBJECT && index < keys.size()) { return keys[index]; }
+        return { };
+    }
+
+    const JsonValue* JsonValue::Find (std::string_view key) const noexcept
+    {
+        if (type != JSON_OBJECT) { return nullptr; }
+
+        for (std::size_t idx = 0; idx < keys.size(); ++idx)
+        {
+            if (keys[idx] == key) { return &values[idx]; }
+        }
+        return nullptr;
+    }
+
+    const JsonValue* JsonValue::FindByPath (std::string_view path, const char delimiter) const noexcept
+    {
+        const JsonValue* current = this;
+        for (const std::string_view& key : common::text::splitInPlace(path, delimiter))
+        {
+            current = current->Find(key);
+            if (current == nullptr) { return nullptr; }
+        }
+        return current;
+    }
+
+
+    void JsonParser::SkipWhitespace(void) noexcept
+    {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r')) {
+            ++position;
+        }
+    }
+
+    bool JsonParser::ParseValue (JsonValue& value, const std::size_t depth) noexcept
+    {
+        SkipWhitespace();
+        if (position == text.size()) { return false; }
+
+        switch (text[position])
+        {
+            case '{':
+                return ParseObject(value, depth + 1);
+            case '[':
+                return ParseArray(value, depth + 1);
+            case '"':
+                value.type = JsonValue::JSON_STRING;
+                return ParseString(value.string);
+            case 't':
+                value.type = JsonValue::JSON_BOOLEAN;
+                value.boolean = true;
+                return ParseLiteral("true");
+            case 'f':
+                value.type = JsonValue::JSON_BOOLEAN;
+                value.boolean = false;
+                return ParseLiteral("false");
+            case 'n':
+                value.type = JsonValue::JSON_NULL;
+                return ParseLiteral("null");
+            default:
+                return ParseNumber(value);
+        }
+    }
+
+    bool JsonParser::ParseObject (JsonValue& value, const std::size_t depth) noexcept
+    {
+        if (depth > maximumDepth) { return false; }
+        value.type = JsonValue::JSON_OBJECT;
+        ++position;  // Skip '{' character.
+
+        SkipWhitespace();
+        if (position < text.size() && text[position] == '}') {
+            ++position;
+            return true;
+        }
+
+        try
+        {
+            while (position < text.size())
+            {
+                SkipWhitespace();
+                std::string key;
+                if (position == text.size() || text[position] != '"' || ParseString(key) == false) { return false; }
+
+                SkipWhitespace();
+                if (position == text.size() || text[position++] != ':') { return false; }
+
+                JsonValue member;
+                if (ParseValue(member, depth) == false) { return false; }
+                value.keys.emplace_back(std::move(key));
+                value.values.emplace_back(std::move(member));
+
+                SkipWhitespace();
+                if (position == text.size()) { return false; }
+                const char symbol = text[position++];
+                if (symbol == '}') { return true; }
+                if (symbol != ',') { return false; }
+            }
+        }
+        catch (const std::exception& /*err*/) { }
+        return false;
+    }
+
+    bool JsonParser::ParseArray (JsonValue& value, const std::size_t depth) noexcept
+    {
+        if (depth > maximumDepth) { return false; }
+        value.type = JsonValue::JSON_ARRAY;
+        ++position;  // Skip '[' character.
+
+        SkipWhitespace();
+        if (position < text.size() && text[position] == ']') {
+            ++position;
+            return true;
+        }
+
+        try
+        {
+            while (position < text.size())
+            {
+                JsonValue element;
+                if (ParseValue(element, depth) == false) { return false; }
+                value.values.emplace_back(std::move(element));
+
+                SkipWhitespace();
+                if (position == text.size()) { return false; }
+                const char symbol = text[position++];
+                if (symbol == ']') { return true; }
+                if (symbol != ',') { return false; }
+            }
+        }
+        catch (const std::exception& /*err*/) { }
+        return false;
+    }
+
+    bool JsonParser::ParseString (std::string& value) noexcept
+    {
+        ++position;  // Skip '"' character.
+        try
+        {
+            while (position < text.size())
+            {
+                const char symbol = text[position++];
+                if (symbol == '"') { return true; }
+                if (static_cast<unsigned char>(symbol) < 0x20) { return false; }
+                if (symbol != '\\') {
+                    value.push_back(symbol);
+                    continue;
+                }
+
+                if (position == text.size()) { return false; }
+                switch (text[position++])
+                {
+                    case '"':  value.push_back('"');  break;
+                    case '\\': value.push_back('\\'); break;
+                    case '/':  value.push_back('/');  break;
+                    case 'b':  value.push_back('\b'); break;
+                    case 'f':  value.push_back('\f'); break;
+                    case 'n':  value.push_back('\n'); break;
+                    case 'r':  value.push_back('\r'); break;
+                    case 't':  value.push_back('\t'); break;
+                    case 'u':
+                    {
+                        // Read four hex digits of the code point.
+                        const auto readCodeUnit = [this] (uint32_t& unit) noexcept -> bool
+                        {
+                            if (position + 4 > text.size()) { return false; }
+                            unit = 0;
+                            for (std::size_t idx = 0; idx < 4; ++idx)
+                            {
+                                const char digit = text[position++];
+                                unit <<= 4;
+                                if (digit >= '0' && digit <= '9') { unit |= static_cast<uint32_t>(digit - '0'); }
+                                else if (digit >= 'a' && digit <= 'f') { unit |= static_cast<uint32_t>(digit - 'a' + 10); }
+                                else if (digit >= 'A' && digit <= 'F') { unit |= static_cast<uint32_t>(digit - 'A' + 10); }
+                                else { return false; }
+                            }
+                            return true;
+                        };
+
+                        uint32_t code = 0;
+                        if (readCodeUnit(code) == false) { return false; }
+                        // Combine the surrogate pair into one code point.
+                        if (code >= 0xD800 && code <= 0xDBFF)
+                        {
+                            uint32_t low = 0;
+                            if (text.substr(position, 2) != "\\u") { return false; }
+                            position += 2;
+                            if (readCodeUnit(low) == false || low < 0xDC00 || low > 0xDFFF) { return false; }
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+
+                        // Encode the code point in UTF-8.
+                        if (code < 0x80) {
+                            value.push_back(static_cast<char>(code));
+                        }
+                        else if (code < 0x800) {
+                            value.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                            value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                        }
+                        else if (code < 0x10000) {
+                            value.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                            value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                            value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                        }
+                        else {
+                            value.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                            value.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                            value.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                            value.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                        }
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+        }
+        catch (const std::exception& /*err*/) { }
+        return false;
+    }
+
+    bool JsonParser::ParseNumber (JsonValue& value) noexcept
+    {
+        const std::size_t start = position;
+        while (position < text.size() && (common::text::isNumber(text[position]) == true ||
+               text[position] == '-' || text[position] == '+' || text[position] == '.' || text[position] == 'e' || text[position] == 'E')) {
+            ++position;
+        }
+        if (start == position) { return false; }
+
+        try
+        {
+            std::size_t length = 0;
+            const std::string number(text.substr(start, position - start));
+            value.number = std::stod(number, &length);
+            value.type = JsonValue::JSON_NUMBER;
+            return length == number.size();
+        }
+        catch (const std::exception& /*err*/) { }
+        return false;
+    }
+
+    bool JsonParser::ParseLiteral (std::string_view literal) noexcept
+    {
+        if (text.substr(position, literal.size()) != literal) { return false; }
+        position += literal.size();
+        return true;
+    }
+
+    std::optional<JsonValue> JsonParser::Parse (std::string_view input) noexcept
+    {
+        JsonParser parser(input);
+        JsonValue root;
+        if (parser.ParseValue(root, 0) == true)
+        {
+            parser.SkipWhitespace();
+            if (parser.position == input.size()) { return root; }
+        }
+        LOG_ERROR("JsonParser.Parse: Invalid JSON text at position ", parser.position, '.');
+        return std::nullopt;
+    }
+
+    std::optional<JsonValue> JsonParser::ParseFile (std::string_view path) noexcept
+    {
+        std::string content;
+        if (common::file::readFileToEnd(path, content) == false) {
+            LOG_ERROR("JsonParser.ParseFile: Cannot read file '", path, "'.");
+            return std::nullopt;
+        }
+        return Parse(content);
+    }
+
 }  // namespace parser.
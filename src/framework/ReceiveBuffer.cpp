@@ -0,0 +1,201 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <cstring>
+#include <algorithm>
+
+#include "../../include/framework/System.hpp"
+#include "../../include/framework/ReceiveBuffer.hpp"
+
+
+namespace analyzer::framework::net
+{
+    ChunkPool& ChunkPool::Instance (void) noexcept
+    {
+        thread_local ChunkPool pool;
+        return pool;
+    }
+
+    // Return the free chunk (nullptr if memory cannot be allocated).
+    std::unique_ptr<char[]> ChunkPool::Acquire (void) noexcept
+    {
+        if (chunks.empty() == false)
+        {
+            std::unique_ptr<char[]> chunk = std::move(chunks.back());
+            chunks.pop_back();
+            return chunk;
+        }
+
+        auto chunk = system::allocMemoryForArray<char>(RECEIVE_CHUNK_SIZE);
+        if (chunk != nullptr) { allocated++; }
+        return chunk;
+    }
+
+    // Return the chunk to the pool.
+    void ChunkPool::Release (std::unique_ptr<char[]>&& chunk) noexcept
+    {
+        if (chunk == nullptr || chunks.size() >= MAXIMUM_POOLED_CHUNKS) { return; }
+        try { chunks.emplace_back(std::move(chunk)); }
+        catch (const std::exception& /*err*/) { }
+    }
+
+
+    // Return the chunks from index to the end of chain to the pool.
+    void ReceiveBuffer::ReleaseChunks (const std::size_t index) noexcept
+    {
+        ChunkPool& pool = ChunkPool::Instance();
+        for (std::size_t idx = index; idx < chunks.size(); ++idx) { pool.Release(std::move(chunks[idx])); }
+        chunks.resize(std::min(index, chunks.size()));
+    }
+
+    std::pair<char*, std::size_t> ReceiveBuffer::Prepare (void) noexcept
+    {
+        if (chunks.empty() == true || tail == RECEIVE_CHUNK_SIZE)
+        {
+            std::unique_ptr<char[]> chunk = ChunkPool::Instance().Acquire();
+            if (chunk == nullptr) { return { nullptr, 0 }; }
+            try { chunks.emplace_back(std::move(chunk)); }
+            catch (const std::exception& /*err*/) { return { nullptr, 0 }; }
+            if (chunks.size() == 1) { head = 0; }
+            tail = 0;
+        }
+        return { chunks.back().get() + tail, RECEIVE_CHUNK_SIZE - tail };
+    }
+
+    // Make the written bytes readable.
+    void ReceiveBuffer::Commit (const std::size_t length) noexcept
+    {
+        if (chunks.empty() == true) { return; }
+        const std::size_t part = std::min(length, RECEIVE_CHUNK_SIZE - tail);
+        tail += part;
+        size += part;
+    }
+
+    std::size_t ReceiveBuffer::Spans (struct iovec* spans, const std::size_t count) const noexcept
+    {
+        std::size_t filled = 0;
+        std::size_t left = size;
+        for (std::size_t idx = 0; idx < chunks.size() && filled < count && left != 0; ++idx)
+        {
+            const std::size_t begin = (idx == 0) ? head : 0;
+            const std::size_t end = (idx == chunks.size() - 1) ? tail : RECEIVE_CHUNK_SIZE;
+            spans[filled].iov_base = chunks[idx].get() + begin;
+            spans[filled].iov_len = end - begin;
+            left -= spans[filled].iov_len;
+            filled++;
+        }
+        return filled;
+    }
+
+    std::size_t ReceiveBuffer::Peek (char* data, const std::size_t length, std::size_t offset) const noexcept
+    {
+        std::size_t copied = 0;
+        for (std::size_t idx = 0; idx < chunks.size() && copied < length; ++idx)
+        {
+            const std::size_t begin = (idx == 0) ? head : 0;
+            const std::size_t end = (idx == chunks.size() - 1) ? tail : RECEIVE_CHUNK_SIZE;
+            if (offset >= end - begin) {
+                offset -= end - begin;
+                continue;
+            }
+
+            const std::size_t part = std::min(end - begin - offset, length - copied);
+            memcpy(data + copied, chunks[idx].get() + begin + offset, part);
+            copied += part;
+            offset = 0;
+        }
+        return copied;
+    }
+
+    void ReceiveBuffer::Consume (std::size_t length) noexcept
+    {
+        length = std::min(length, size);
+        size -= length;
+        if (size == 0)
+        {
+            Clear();
+            return;
+        }
+
+        // Completely processed chunks are removed from the beginning of chain.
+        std::size_t processed = 0;
+        while (length != 0)
+        {
+            const std::size_t available = RECEIVE_CHUNK_SIZE - head;
+            if (length < available || processed + 1 == chunks.size())
+            {
+                head += length;
+                break;
+            }
+            length -= available;
+            head = 0;
+            processed++;
+        }
+
+        if (processed != 0)
+        {
+            ChunkPool& pool = ChunkPool::Instance();
+            for (std::size_t idx = 0; idx < processed; ++idx) { pool.Release(std::move(chunks[idx])); }
+            chunks.erase(chunks.begin(), chunks.begin() + static_cast<std::ptrdiff_t>(processed));
+        }
+    }
+
+    void ReceiveBuffer::Compact (void) noexcept
+    {
+        if (size == 0 || head == 0) { return; }
+
+        // Data is moved backward, so the source is never overwritten before it is copied.
+        std::size_t readChunk = 0, readOffset = head;
+        std::size_t writeChunk = 0, writeOffset = 0;
+        std::size_t left = size;
+        while (left != 0)
+        {
+            const std::size_t readEnd = (readChunk == chunks.size() - 1) ? tail : RECEIVE_CHUNK_SIZE;
+            const std::size_t part = std::min({ readEnd - readOffset, RECEIVE_CHUNK_SIZE - writeOffset, left });
+            memmove(chunks[writeChunk].get() + writeOffset, chunks[readChunk].get() + readOffset, part);
+            readOffset += part;
+            writeOffset += part;
+            left -= part;
+            if (readOffset == readEnd) { readChunk++; readOffset = 0; }
+            if (writeOffset == RECEIVE_CHUNK_SIZE) { writeChunk++; writeOffset = 0; }
+        }
+
+        head = 0;
+        if (writeOffset == 0)
+        {
+            tail = RECEIVE_CHUNK_SIZE;
+            ReleaseChunks(writeChunk);
+        }
+        else
+        {
+            tail = writeOffset;
+            ReleaseChunks(writeChunk + 1);
+        }
+    }
+
+    // Release all data and chunks.
+    void ReceiveBuffer::Clear (void) noexcept
+    {
+        ReleaseChunks(0);
+        head = tail = size = 0;
+    }
+
+    // Return the first continuous part of readable data.
+    std::string_view ReceiveBuffer::Front (void) const noexcept
+    {
+        if (size == 0) { return std::string_view(); }
+        const std::size_t end = (chunks.size() == 1) ? tail : RECEIVE_CHUNK_SIZE;
+        return std::string_view(chunks.front().get() + head, end - head);
+    }
+
+    ReceiveBuffer::~ReceiveBuffer (void) noexcept
+    {
+        Clear();
+    }
+
+}  // namespace net.
@@ -0,0 +1,349 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <limits>
+#include <cstring>
+
+#include "../../include/framework/Log.hpp"
+#include "../../include/framework/Common.hpp"
+#include "../../include/framework/Parser.hpp"
+#include "../../include/framework/Resolver.hpp"
+
+
+namespace analyzer::framework::net
+{
+    // Method that returns the instance of the resolver cache singleton class.
+    ResolverCache& ResolverCache::Instance (void) noexcept
+    {
+        static ResolverCache instance;
+        return instance;
+    }
+
+    // Returns the key of the entry in cache.
+    std::string ResolverCache::MakeKey (std::string_view host, const uint16_t port, const int32_t family, const int32_t type) noexcept
+    {
+        std::string key(host);
+        key.push_back('\0');
+        key.append(std::to_string(port)).push_back('/');
+        key.append(std::to_string(family)).push_back('/');
+        key.append(std::to_string(type));
+        return key;
+    }
+
+    // Method that sets the lifetime of entries in cache.
+    void ResolverCache::SetTimeToLive (const std::chrono::seconds positive, const std::chrono::seconds negative) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        positiveTime = positive;
+        negativeTime = negative;
+    }
+
+    // Removes the expired entries if the cache is full (must be called under mutex).
+    void ResolverCache::Shrink (const clock::time_point now) noexcept
+    {
+        if (entries.size() < MAXIMUM_RESOLVER_ENTRIES) { return; }
+
+        for (auto it = entries.begin(); it != entries.end(); )
+        {
+            if (it->second.pending == false && it->second.expiration <= now) { it = entries.erase(it); }
+            else { ++it; }
+        }
+        // All entries are valid, so the cache is started from the beginning.
+        if (entries.size() >= MAXIMUM_RESOLVER_ENTRIES)
+        {
+            for (auto it = entries.begin(); it != entries.end(); )
+            {
+                if (it->second.pending == false) { it = entries.erase(it); }
+                else { ++it; }
+            }
+        }
+    }
+
+    // Returns the addresses of selected family from the entry of unspecified family (must be called under mutex).
+    int32_t ResolverCache::FindUnspecified (const char* host, const uint16_t port, const int32_t family, const int32_t type, std::vector<SocketAddress>& addresses) noexcept
+    {
+        if (family == AF_UNSPEC) { return RESOLVER_NOT_CACHED; }
+
+        auto it = entries.find(MakeKey(host, port, AF_UNSPEC, type));
+        if (it == entries.end() || it->second.pending == true || it->second.expiration <= clock::now()) {
+            return RESOLVER_NOT_CACHED;
+        }
+        if (it->second.status != RESOLVER_SUCCESS) { return it->second.status; }
+
+        std::vector<SocketAddress> result;
+        for (const SocketAddress& address : it->second.addresses)
+        {
+            if (address.storage.ss_family == family) { result.push_back(address); }
+        }
+        // The host has no addresses of selected family in this entry, so it is resolved separately.
+        if (result.empty() == true) { return RESOLVER_NOT_CACHED; }
+        addresses = std::move(result);
+        return RESOLVER_SUCCESS;
+    }
+
+    // Resolves the host by system resolver and saves the result in cache.
+    int32_t ResolverCache::Update (const std::string& key, const char* host, const uint16_t port, const int32_t family, const int32_t type) noexcept
+    {
+        struct addrinfo hints = { };
+        struct addrinfo* server = nullptr;
+        hints.ai_family = family;
+        hints.ai_socktype = type;
+        hints.ai_flags = AI_NUMERICSERV;
+
+        std::vector<SocketAddress> addresses;
+        const int32_t status = getaddrinfo(host, std::to_string(port).c_str(), &hints, &server);
+        if (status == RESOLVER_SUCCESS)
+        {
+            for (auto curr = server; curr != nullptr; curr = curr->ai_next)
+            {
+                SocketAddress address = { };
+                memcpy(&address.storage, curr->ai_addr, curr->ai_addrlen);
+                address.length = curr->ai_addrlen;
+                addresses.push_back(address);
+            }
+            freeaddrinfo(server);
+            LOG_TRACE("ResolverCache.Update: Host '", host, "' is resolved: ", addresses.size(), " addresses.");
+        }
+        else { LOG_ERROR("ResolverCache.Update: In function 'getaddrinfo' for host '", host, "' - ", gai_strerror(status)); }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries[key];
+        entry.addresses = std::move(addresses);
+        entry.status = status;
+        entry.expiration = clock::now() + ((status == RESOLVER_SUCCESS) ? positiveTime : negativeTime);
+        entry.pending = false;
+        resolved.notify_all();
+        return status;
+    }
+
+    // Method that returns the addresses of external host from cache or resolves them by system resolver.
+    int32_t ResolverCache::Resolve (const char* host, const uint16_t port, const int32_t family, const int32_t type, std::vector<SocketAddress>& addresses) noexcept
+    {
+        if (host == nullptr) { return EAI_NONAME; }
+
+        const std::string key = MakeKey(host, port, family, type);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                auto it = entries.find(key);
+                if (it == entries.end())
+                {
+                    const int32_t status = FindUnspecified(host, port, family, type, addresses);
+                    if (status != RESOLVER_NOT_CACHED) { return status; }
+                    break;
+                }
+                if (it->second.pending == true) {
+                    resolved.wait(lock);
+                    continue;
+                }
+                if (it->second.expiration > clock::now())
+                {
+                    addresses = it->second.addresses;
+                    return it->second.status;
+                }
+                break;
+            }
+
+            // Other threads wait for the result of this thread.
+            Shrink(clock::now());
+            entries[key].pending = true;
+        }
+
+        const int32_t status = Update(key, host, port, family, type);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) { addresses = it->second.addresses; }
+        return status;
+    }
+
+    // Method that returns the addresses of external host only from cache without blocking.
+    int32_t ResolverCache::Find (const char* host, const uint16_t port, const int32_t family, const int32_t type, std::vector<SocketAddress>& addresses) noexcept
+    {
+        if (host == nullptr) { return EAI_NONAME; }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(MakeKey(host, port, family, type));
+        if (it == entries.end()) {
+            return FindUnspecified(host, port, family, type, addresses);
+        }
+        if (it->second.pending == true || it->second.expiration <= clock::now()) {
+            return RESOLVER_NOT_CACHED;
+        }
+        addresses = it->second.addresses;
+        return it->second.status;
+    }
+
+    // Thread for asynchronous resolution.
+    void ResolverCache::ResolveWorker (void) noexcept
+    {
+        while (true)
+        {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                requested.wait(lock, [this] () { return (stopped == true || requests.empty() == false); });
+                if (stopped == true) { return; }
+                request = std::move(requests.front());
+                requests.pop_front();
+            }
+
+            std::vector<SocketAddress> addresses;
+            const int32_t status = Resolve(request.host.c_str(), request.port, request.family, request.type, addresses);
+            if (request.handler != nullptr) {
+                request.handler(request.host.c_str(), request.port, status, request.context);
+            }
+        }
+    }
+
+    // Method that resolves the external host in the background thread.
+    bool ResolverCache::ResolveAsync (const char* host, const uint16_t port, const int32_t family, const int32_t type,
+                                      ResolveHandler handler, void* context) noexcept
+    {
+        if (host == nullptr) { return false; }
+
+        std::vector<SocketAddress> addresses;
+        const int32_t status = Find(host, port, family, type, addresses);
+        if (status != RESOLVER_NOT_CACHED)
+        {
+            if (handler != nullptr) { handler(host, port, status, context); }
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopped == true) { return false; }
+        if (workers.empty() == true)
+        {
+            try {
+                for (uint32_t idx = 0; idx < DEFAULT_RESOLVER_THREADS; ++idx) {
+                    workers.emplace_back(&ResolverCache::ResolveWorker, this);
+                }
+            }
+            catch (const std::system_error& err) {
+                LOG_ERROR("ResolverCache.ResolveAsync: Cannot start the resolver thread - ", err.what());
+                if (workers.empty() == true) { return false; }
+            }
+        }
+
+        Request request;
+        request.host = host;
+        request.port = port;
+        request.family = family;
+        request.type = type;
+        request.handler = handler;
+        request.context = context;
+        requests.push_back(std::move(request));
+        requested.notify_one();
+        return true;
+    }
+
+    // Method that starts the asynchronous resolution of all targets from the scanner settings file.
+    std::size_t ResolverCache::Prewarm (std::string_view path) noexcept
+    {
+        using parser::JsonValue;
+        using parser::JsonParser;
+
+        const auto settings = JsonParser::ParseFile(path);
+        if (settings.has_value() == false) {
+            LOG_ERROR("ResolverCache.Prewarm: Cannot parse the settings file '", path, "'.");
+            return 0;
+        }
+
+        const JsonValue* const resolver = settings->FindByPath("Network.Resolver");
+        if (resolver != nullptr)
+        {
+            const JsonValue* const positive = resolver->Find("TimeToLive");
+            const JsonValue* const negative = resolver->Find("NegativeTimeToLive");
+            if (positive != nullptr && positive->AsNumber().has_value() == true && negative != nullptr && negative->AsNumber().has_value() == true) {
+                SetTimeToLive(std::chrono::seconds(static_cast<int64_t>(*positive->AsNumber())), std::chrono::seconds(static_cast<int64_t>(*negative->AsNumber())));
+            }
+        }
+
+        const JsonValue* const targets = settings->FindByPath("Network.Targets");
+        if (targets == nullptr || targets->Type() != JsonValue::JSON_ARRAY) {
+            LOG_WARNING("ResolverCache.Prewarm: There are no targets in the settings file '", path, "'.");
+            return 0;
+        }
+
+        std::size_t count = 0;
+        for (std::size_t idx = 0; idx < targets->Size(); ++idx)
+        {
+            const JsonValue* const target = targets->At(idx);
+            const JsonValue* const host = target->Find("Host");
+            const JsonValue* const port = target->Find("Port");
+            if (host == nullptr || host->AsString().has_value() == false || port == nullptr || port->AsNumber().has_value() == false) {
+                LOG_WARNING("ResolverCache.Prewarm: Target ", idx, " is skipped because it does not contain Host or Port.");
+                continue;
+            }
+            const double number = *port->AsNumber();
+            if (number < 0 || number > std::numeric_limits<uint16_t>::max() || number != static_cast<double>(static_cast<uint16_t>(number))) {
+                LOG_WARNING("ResolverCache.Prewarm: Target ", idx, " is skipped because port ", number, " is out of range 0-65535.");
+                continue;
+            }
+
+            // Format: "Transport": "tcp/udp". Stream socket is used by default.
+            bool stream = false, datagram = false;
+            const JsonValue* const transport = target->Find("Transport");
+            if (transport != nullptr && transport->AsString().has_value() == true)
+            {
+                for (const std::string_view alternative : common::text::splitInPlace(*transport->AsString(), '/'))
+                {
+                    if (alternative == "tcp" || alternative == "tls") { stream = true; }
+                    else if (alternative == "udp" || alternative == "dtls") { datagram = true; }
+                    else { LOG_WARNING("ResolverCache.Prewarm: Unknown transport '", alternative, "' of target ", idx, " is ignored."); }
+                }
+                if (stream == false && datagram == false) {
+                    LOG_WARNING("ResolverCache.Prewarm: Target ", idx, " is skipped because it does not contain known transport.");
+                    continue;
+                }
+            }
+            else { stream = true; }
+
+            const std::string name(*host->AsString());
+            bool accepted = false;
+            if (stream == true && ResolveAsync(name.c_str(), static_cast<uint16_t>(number), AF_UNSPEC, SOCK_STREAM) == true) { accepted = true; }
+            if (datagram == true && ResolveAsync(name.c_str(), static_cast<uint16_t>(number), AF_UNSPEC, SOCK_DGRAM) == true) { accepted = true; }
+            if (accepted == true) { count++; }
+        }
+
+        LOG_INFO("ResolverCache.Prewarm: ", count, " targets are sent for resolution.");
+        return count;
+    }
+
+    // Method that removes all resolved entries from cache.
+    void ResolverCache::Clear (void) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end(); )
+        {
+            if (it->second.pending == false) { it = entries.erase(it); }
+            else { ++it; }
+        }
+    }
+
+    // Method that returns the number of entries in cache.
+    std::size_t ResolverCache::Size (void) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    ResolverCache::~ResolverCache (void) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            requested.notify_all();
+        }
+        for (auto&& worker : workers)
+        {
+            if (worker.joinable() == true) { worker.join(); }
+        }
+    }
+
+}  // namespace net.
@@ -6,9 +6,17 @@
 // This file is part of ProtocolAnalyzer open source project under MIT License.
 // ============================================================================
 
+#include <poll.h>
 #include <fcntl.h>
 #include <csignal>
+#include <climits>
+#include <limits>
+#include <utility>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <netinet/udp.h>
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
 
 #include "../../include/framework/System.hpp"
 #include "../../include/framework/Socket.hpp"
@@ -17,6 +25,40 @@
 
 namespace analyzer::framework::net
 {
+    // Compares the addresses of hosts (ports are compared if needed).
+    static bool IsSameAddress (const SocketAddress& first, const SocketAddress& second, const bool anyPort) noexcept
+    {
+        if (first.storage.ss_family != second.storage.ss_family) { return false; }
+        if (first.storage.ss_family == AF_INET)
+        {
+            const auto& left = reinterpret_cast<const sockaddr_in&>(first.storage);
+            const auto& right = reinterpret_cast<const sockaddr_in&>(second.storage);
+            return (left.sin_addr.s_addr == right.sin_addr.s_addr && (anyPort == true || left.sin_port == right.sin_port));
+        }
+        if (first.storage.ss_family == AF_INET6)
+        {
+            const auto& left = reinterpret_cast<const sockaddr_in6&>(first.storage);
+            const auto& right = reinterpret_cast<const sockaddr_in6&>(second.storage);
+            return (memcmp(&left.sin6_addr, &right.sin6_addr, sizeof(struct in6_addr)) == 0 && (anyPort == true || left.sin6_port == right.sin6_port));
+        }
+        return (first.length == second.length && memcmp(&first.storage, &second.storage, first.length) == 0);
+    }
+
+    // Arms the deadline of the blocking operation by the timeout of socket in the timing wheel of the calling thread.
+    void Socket::StartOperation (void) noexcept
+    {
+        // Timer is re-armed by each operation, so the expired or cancelled deadline of the previous operation is not relevant.
+        SocketStatePool::Instance().GetTimingWheel().Arm(deadline, GetTimeout());
+    }
+
+    // Returns the waiting time of one receive operation which does not exceed the deadline and the idle time.
+    int32_t Socket::GetReceiveWaitingTime (void) const noexcept
+    {
+        // Silence of the idle time means the end of message, so the peer of keep-alive connection does not block the receiving until timeout.
+        return std::min(GetWaitingTime(), DEFAULT_RECEIVE_IDLE_TIME);
+    }
+
+
     // Constructor.
     Socket::Socket (const int32_t family, const int32_t type, const int32_t protocol, const uint32_t time) noexcept
             : socketFamily(family), socketType(type), ipProtocol(protocol), timeout(time)
@@ -40,20 +82,12 @@ namespace analyzer::framework::net
         }
         LOG_INFO("Socket.Socket [", fd, "]: Socket was created.");
 
-        epfd = epoll_create1(0);
-        if (epfd == INVALID_SOCKET)
-        {
-            LOG_ERROR("Socket.Socket [", fd, "]: In function 'epoll_create1' - ", GET_ERROR(errno));
-            close(fd); fd = INVALID_SOCKET;
-            return;
-        }
-
-        event.data.fd = fd;
-        if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event) == SOCKET_ERROR)
+        // Socket descriptor is observed by the reactor of the current thread.
+        pool = &SocketStatePool::Instance();
+        if (pool->RegisterSocket(fd, SocketStatePool::TEST_ALWAYS) == false)
         {
-            LOG_ERROR("Socket.Socket [", fd, "]: In function 'epoll_ctl' - ", GET_ERROR(errno));
+            LOG_ERROR("Socket.Socket [", fd, "]: Registration in socket state pool failed.");
             close(fd); fd = INVALID_SOCKET;
-            close(epfd); epfd = INVALID_SOCKET;
             return;
         }
 
@@ -134,33 +168,55 @@ namespace analyzer::framework::net
         }
 
         exHost = host;
-        struct addrinfo hints = { };
-        struct addrinfo* server = nullptr;
-        hints.ai_family = socketFamily;
-        hints.ai_socktype = socketType;
-
-        const int32_t status = getaddrinfo(host, std::to_string(port).c_str(), &hints, &server);
-        if (status != SOCKET_SUCCESS) {
+        std::vector<SocketAddress> addresses;
+        const int32_t status = ResolverCache::Instance().Resolve(host, port, socketFamily, socketType, addresses);
+        if (status != RESOLVER_SUCCESS) {
             LOG_ERROR("Socket.Connect [", fd, "]: In function 'getaddrinfo' - ", gai_strerror(status));
             CloseAfterError();
             return false;
         }
 
         LOG_TRACE("Socket.Connect [", fd, "]: Connecting to '", host, "'...");
-        for (auto&& curr = server; curr != nullptr; curr = curr->ai_next)
+        for (auto&& curr : addresses)
         {
-            const int32_t result = connect(fd, curr->ai_addr, curr->ai_addrlen);
-            if (result != SOCKET_ERROR || errno == EINPROGRESS)
+            // Each address is connected within the connection timeout.
+            StartOperation();
+            const auto address = reinterpret_cast<const struct sockaddr*>(&curr.storage);
+            int32_t result = SOCKET_ERROR;
+            if (ring != nullptr)
+            {
+                // The kernel waits for the connection within the connection timeout.
+                const int32_t status = ring->Connect(ringFile, address, curr.length, GetWaitingTime());
+                if (status < 0) { errno = -status; }
+                else { result = SOCKET_SUCCESS; }
+            }
+            else { result = connect(fd, address, curr.length); }
+
+            // Statuses that were obtained before connection are not relevant anymore.
+            pool->ClearStatus(fd, SocketStatePool::STATUS_READ | SocketStatePool::STATUS_WRITE | SocketStatePool::STATUS_CLOSED);
+            if (result == SOCKET_ERROR && ring == nullptr && errno == EINPROGRESS)
+            {
+                // Connection is completed when the socket becomes writable, then the result is obtained from SO_ERROR.
+                const uint16_t expected = SocketStatePool::STATUS_WRITE | SocketStatePool::STATUS_ERROR | SocketStatePool::STATUS_CLOSED;
+                int32_t error = ETIMEDOUT;
+                socklen_t size = sizeof(error);
+                if (pool->WaitForStatus(fd, expected, GetWaitingTime()) != 0 &&
+                    getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != SOCKET_SUCCESS) {
+                    error = errno;
+                }
+                if (error == 0) { result = SOCKET_SUCCESS; }
+                else { errno = error; }
+            }
+
+            if (result != SOCKET_ERROR)
             {
                 LOG_INFO("Socket.Connect [", fd, "]: Connecting to '", exHost, "' on port '", port, "' is success.");
-                freeaddrinfo(server);
                 return true;
             }
             LOG_ERROR("Socket.Connect [", fd, "]: In function 'connect' - ", GET_ERROR(errno));
         }
 
         LOG_ERROR("Socket.Connect [", fd, "]: Connecting to '", exHost, "' on port '", port, "' failed.");
-        freeaddrinfo(server);
         CloseAfterError();
         return false;
     }
@@ -184,24 +240,44 @@ namespace analyzer::framework::net
             callback->operator()(const_cast<char*>(data), const_cast<std::size_t*>(&length));
         }
         
+        StartOperation();
         std::size_t idx = 0;
+        bool copy = false;
         while (idx != length)
         {
-            const ssize_t result = send(fd, &data[idx], length - idx, 0);
+            if (ring != nullptr)
+            {
+                // Operation is cancelled by the kernel if the socket is not available for write within the waiting time.
+                const int32_t sent = ring->Send(ringFile, &data[idx], length - idx, GetWaitingTime());
+                if (sent < 0) {
+                    LOG_ERROR("Socket.Send [", fd, "]: In io_uring operation 'send' - ", GET_ERROR(-sent));
+                    CloseAfterError();
+                    return false;
+                }
+                idx += static_cast<std::size_t>(sent);
+                continue;
+            }
+
+            const int32_t flags = (zerocopy == true && copy == false && length - idx >= ZEROCOPY_MINIMUM_LENGTH) ? MSG_ZEROCOPY : 0;
+            const ssize_t result = send(fd, &data[idx], length - idx, flags);
             if (result == SOCKET_ERROR)
             {
                 // The socket is marked non-blocking and the requested operation would block.
                 if (errno == EWOULDBLOCK || errno == EAGAIN) {
-                    if (IsReadyForSend(1500) == false) { CloseAfterError(); return false; }
+                    if (IsReadyForSend(GetWaitingTime()) == false) { CloseAfterError(); return false; }
                     continue;
                 }
                 // A signal occurred before any data was transmitted.
                 if (errno == EINTR) { continue; }
+                // The limit of pinned pages is reached, so the data is copied until the kernel releases them.
+                if (errno == ENOBUFS && flags != 0) { ReapZeroCopy(); copy = true; continue; }
 
                 LOG_ERROR("Socket.Send [", fd, "]: In function 'send' - ", GET_ERROR(errno));
                 CloseAfterError();
                 return false;
             }
+            if (flags != 0) { zerocopyRequests++; }
+            copy = false;
             idx += static_cast<std::size_t>(result);
         }
 
@@ -210,28 +286,308 @@ namespace analyzer::framework::net
     }
 
 
+    // Method that sends the message which consists of several pieces over TCP protocol without joining them.
+    bool Socket::SendV (const struct iovec* const vector, const std::size_t count) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.SendV: Socket is invalid.");
+            return false;
+        }
+        LOG_TRACE("Socket.SendV [", fd, "]: Sending ", count, " pieces of data to '", exHost, "' by TCP socket...");
+
+        // Pieces are copied because the functor may change their length and the partial send moves their beginning.
+        thread_local std::vector<struct iovec> pieces;
+        pieces.assign(vector, vector + count);
+
+        using functor = callbacks::SocketCallbackFunctorBeforeSend;
+        auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP);
+        std::size_t length = 0;
+        for (auto&& piece : pieces)
+        {
+            if (callback != nullptr) { callback->operator()(static_cast<char*>(piece.iov_base), &piece.iov_len); }
+            length += piece.iov_len;
+        }
+
+        StartOperation();
+        // The io_uring backend sends the pieces one by one.
+        if (ring != nullptr)
+        {
+            for (auto&& piece : pieces)
+            {
+                for (std::size_t idx = 0; idx != piece.iov_len; )
+                {
+                    const int32_t sent = ring->Send(ringFile, static_cast<const char*>(piece.iov_base) + idx, piece.iov_len - idx, GetWaitingTime());
+                    if (sent < 0) {
+                        LOG_ERROR("Socket.SendV [", fd, "]: In io_uring operation 'send' - ", GET_ERROR(-sent));
+                        CloseAfterError();
+                        return false;
+                    }
+                    idx += static_cast<std::size_t>(sent);
+                }
+            }
+            LOG_TRACE("Socket.SendV [", fd, "]: Sending data to '", exHost, "' is success: ", length, " bytes.");
+            return true;
+        }
+
+        std::size_t idx = 0;
+        std::size_t first = 0;
+        bool copy = false;
+        while (idx != length)
+        {
+            if (pieces[first].iov_len == 0) { ++first; continue; }
+
+            struct msghdr message = { };
+            message.msg_iov = &pieces[first];
+            message.msg_iovlen = std::min<std::size_t>(pieces.size() - first, IOV_MAX);
+            const int32_t flags = (zerocopy == true && copy == false && length - idx >= ZEROCOPY_MINIMUM_LENGTH) ? MSG_ZEROCOPY : 0;
+            const ssize_t result = sendmsg(fd, &message, flags);
+            if (result == SOCKET_ERROR)
+            {
+                // The socket is marked non-blocking and the requested operation would block.
+                if (errno == EWOULDBLOCK || errno == EAGAIN) {
+                    if (IsReadyForSend(GetWaitingTime()) == false) { CloseAfterError(); return false; }
+                    continue;
+                }
+                // A signal occurred before any data was transmitted.
+                if (errno == EINTR) { continue; }
+                // The limit of pinned pages is reached, so the data is copied until the kernel releases them.
+                if (errno == ENOBUFS && flags != 0) { ReapZeroCopy(); copy = true; continue; }
+
+                LOG_ERROR("Socket.SendV [", fd, "]: In function 'sendmsg' - ", GET_ERROR(errno));
+                CloseAfterError();
+                return false;
+            }
+            if (flags != 0) { zerocopyRequests++; }
+            copy = false;
+            idx += static_cast<std::size_t>(result);
+
+            // The sent pieces are skipped and the beginning of the partially sent piece is moved.
+            auto rest = static_cast<std::size_t>(result);
+            while (rest != 0)
+            {
+                if (rest < pieces[first].iov_len)
+                {
+                    pieces[first].iov_base = static_cast<char*>(pieces[first].iov_base) + rest;
+                    pieces[first].iov_len -= rest;
+                    break;
+                }
+                rest -= pieces[first].iov_len;
+                ++first;
+            }
+        }
+
+        LOG_TRACE("Socket.SendV [", fd, "]: Sending data to '", exHost, "' is success: ", idx, " bytes.");
+        return true;
+    }
+
+
+    // Method that sends the part of file over TCP protocol by sendfile or splice system calls.
+    bool Socket::SendFile (const int32_t file, off_t offset, const std::size_t length) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.SendFile: Socket is invalid.");
+            return false;
+        }
+        LOG_TRACE("Socket.SendFile [", fd, "]: Sending ", length, " bytes of file to '", exHost, "' by TCP socket...");
+
+        // The functor and the io_uring backend need the data in user space.
+        using functor = callbacks::SocketCallbackFunctorBeforeSend;
+        if (ring != nullptr || storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP) != nullptr) {
+            return SendFileByCopy(file, offset, length);
+        }
+
+        struct stat info = { };
+        if (fstat(file, &info) == SOCKET_ERROR) {
+            LOG_ERROR("Socket.SendFile [", fd, "]: In function 'fstat' - ", GET_ERROR(errno));
+            return false;
+        }
+        const bool pipe = S_ISFIFO(info.st_mode);
+
+        StartOperation();
+        std::size_t idx = 0;
+        while (idx != length)
+        {
+            const ssize_t result = (pipe == true) ? splice(file, nullptr, fd, nullptr, length - idx, SPLICE_F_MOVE | SPLICE_F_MORE)
+                                                  : sendfile(fd, file, &offset, length - idx);
+            if (result == SOCKET_ERROR)
+            {
+                // The socket is marked non-blocking and the requested operation would block.
+                if (errno == EWOULDBLOCK || errno == EAGAIN) {
+                    if (IsReadyForSend(GetWaitingTime()) == false) { CloseAfterError(); return false; }
+                    continue;
+                }
+                // A signal occurred before any data was transmitted.
+                if (errno == EINTR) { continue; }
+                // The file does not support the mapping to the kernel pages.
+                if ((errno == EINVAL || errno == ENOSYS) && idx == 0) { return SendFileByCopy(file, offset, length); }
+
+                LOG_ERROR("Socket.SendFile [", fd, "]: In function '", (pipe == true) ? "splice" : "sendfile", "' - ", GET_ERROR(errno));
+                CloseAfterError();
+                return false;
+            }
+            if (result == 0) {
+                LOG_ERROR("Socket.SendFile [", fd, "]: End of file is reached after ", idx, " bytes.");
+                return false;
+            }
+            idx += static_cast<std::size_t>(result);
+        }
+
+        LOG_TRACE("Socket.SendFile [", fd, "]: Sending data to '", exHost, "' is success: ", idx, " bytes.");
+        return true;
+    }
+
+
+    // Sends the part of file by chunks through user space with Send method.
+    bool Socket::SendFileByCopy (const int32_t file, off_t offset, const std::size_t length) noexcept
+    {
+        thread_local auto buffer = system::allocMemoryForArray<char>(SENDFILE_CHUNK_LENGTH);
+        if (buffer == nullptr) { return false; }
+
+        // Buffer is overwritten by the next chunk before the kernel releases it, so MSG_ZEROCOPY is not used for the chunks.
+        const bool mode = std::exchange(zerocopy, false);
+        bool stream = false, success = true;
+        std::size_t idx = 0;
+        while (idx != length)
+        {
+            const std::size_t size = std::min<std::size_t>(length - idx, SENDFILE_CHUNK_LENGTH);
+            const ssize_t result = (stream == true) ? read(file, buffer.get(), size) : pread(file, buffer.get(), size, offset);
+            if (result == SOCKET_ERROR)
+            {
+                if (errno == EINTR) { continue; }
+                // Pipe does not support the offset, so it is read sequentially.
+                if (errno == ESPIPE && stream == false) { stream = true; continue; }
+
+                LOG_ERROR("Socket.SendFileByCopy [", fd, "]: In function 'read' - ", GET_ERROR(errno));
+                success = false;
+                break;
+            }
+            if (result == 0) {
+                LOG_ERROR("Socket.SendFileByCopy [", fd, "]: End of file is reached after ", idx, " bytes.");
+                success = false;
+                break;
+            }
+            // Each chunk is passed to the functor by Send method.
+            if (Send(buffer.get(), static_cast<std::size_t>(result)) == false) {
+                success = false;
+                break;
+            }
+            offset += result;
+            idx += static_cast<std::size_t>(result);
+        }
+        zerocopy = mode;
+        return success;
+    }
+
+
+    // Method that enables MSG_ZEROCOPY mode for the large payloads of Send and SendV methods.
+    bool Socket::EnableZeroCopy (void) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.EnableZeroCopy: Socket is invalid.");
+            return false;
+        }
+
+        const int32_t option = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &option, sizeof(option)) == SOCKET_ERROR) {
+            LOG_ERROR("Socket.EnableZeroCopy [", fd, "]: In function 'setsockopt' - ", GET_ERROR(errno));
+            return false;
+        }
+        zerocopy = true;
+        return true;
+    }
+
+
+    // Method that obtains the completions of MSG_ZEROCOPY sends from the error queue.
+    int32_t Socket::ReapZeroCopy (const int32_t time) noexcept
+    {
+        if (fd == INVALID_SOCKET || zerocopy == false || ZeroCopyPending() == 0) { return 0; }
+
+        // Notifications in the error queue are reported as POLLERR event.
+        if (time != 0)
+        {
+            struct pollfd descriptor = { fd, 0, 0 };
+            poll(&descriptor, 1, time);
+        }
+
+        int32_t completed = 0;
+        while (ZeroCopyPending() != 0)
+        {
+            char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))] = { };
+            struct msghdr message = { };
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            if (recvmsg(fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) == SOCKET_ERROR)
+            {
+                if (errno == EINTR) { continue; }
+                if (errno == EWOULDBLOCK || errno == EAGAIN) { break; }
+                LOG_ERROR("Socket.ReapZeroCopy [", fd, "]: In function 'recvmsg' - ", GET_ERROR(errno));
+                return (completed != 0) ? completed : -errno;
+            }
+
+            for (struct cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+            {
+                if ((header->cmsg_level != SOL_IP || header->cmsg_type != IP_RECVERR) &&
+                    (header->cmsg_level != SOL_IPV6 || header->cmsg_type != IPV6_RECVERR)) { continue; }
+
+                struct sock_extended_err error = { };
+                memcpy(&error, CMSG_DATA(header), sizeof(error));
+                if (error.ee_origin != SO_EE_ORIGIN_ZEROCOPY || error.ee_errno != 0) { continue; }
+
+                // Notification contains the range of numbers of the completed sends.
+                const uint32_t number = error.ee_data - error.ee_info + 1;
+                zerocopyCompletions += number;
+                completed += static_cast<int32_t>(number);
+                if ((error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0) {
+                    LOG_TRACE("Socket.ReapZeroCopy [", fd, "]: Kernel has copied the data of ", number, " sends.");
+                }
+            }
+        }
+
+        // The error status of reactor is caused by the notifications, so it does not mean the error of connection.
+        if (completed != 0 && pool != nullptr) { pool->ClearStatus(fd, SocketStatePool::STATUS_ERROR); }
+        return completed;
+    }
+
+
     // Receiving the message from external host.
     int32_t Socket::Recv (char* data, const std::size_t length, const bool noWait)
     {
-        using std::chrono::system_clock;
-
         if (fd == INVALID_SOCKET) {
             LOG_ERROR("Socket.Recv: Socket is invalid.");
             return -1;
         }
         LOG_TRACE("Socket.Recv [", fd, "]: Receiving data from '", exHost, "'...");
-        const system_clock::time_point limit = system_clock::now() + GetTimeout();
+        StartOperation();
 
         std::size_t idx = 0;
-        while (idx != length && system_clock::now() < limit)
+        while (idx != length && IsOperationExpired() == false)
         {
+            if (ring != nullptr)
+            {
+                const int32_t received = ring->Recv(ringFile, &data[idx], length - idx, GetReceiveWaitingTime());
+                if (received == -ETIMEDOUT) {
+                    if (idx == 0) { CloseAfterError(); return -1; }
+                    break;  // In this case no any error because we have any data.
+                }
+                if (received < 0) {
+                    LOG_ERROR("Socket.Recv [", fd, "]: In io_uring operation 'recv' - ", GET_ERROR(-received));
+                    CloseAfterError();
+                    return -1;
+                }
+                if (received == 0) { break; }
+
+                idx += static_cast<std::size_t>(received);
+                if (noWait == true) { break; }
+                continue;
+            }
+
             const ssize_t result = recv(fd, &data[idx], length - idx, 0);
             if (result == SOCKET_ERROR)
             {
                 // The socket is marked non-blocking and the requested operation would block.
                 if (errno == EWOULDBLOCK || errno == EAGAIN)
                 {
-                    if (IsReadyForRecv(1500) == false) {
+                    if (IsReadyForRecv(GetReceiveWaitingTime()) == false) {
                         if (idx == 0) { CloseAfterError(); return -1; }
                         break; // In this case no any error because we have any data.
                     }
@@ -266,8 +622,6 @@ namespace analyzer::framework::net
     // Receiving the message from external host over TCP until the functor returns false value.
     bool Socket::Recv (char* data, const std::size_t length, std::size_t& obtainLength, CompleteFunctor functor, std::size_t chunkLength)
     {
-        using std::chrono::system_clock;
-
         if (fd == INVALID_SOCKET) {
             LOG_ERROR("Socket.Recv: Socket is invalid.");
             return false;
@@ -281,18 +635,29 @@ namespace analyzer::framework::net
             chunkLength = length;
         }
 
-        const system_clock::time_point limit = system_clock::now() + GetTimeout();
+        StartOperation();
         bool successFunctor = false;
         std::size_t idx = 0;
         do
         {
-            const ssize_t result = recv(fd, &data[idx], chunkLength, 0);
+            ssize_t result = SOCKET_ERROR;
+            if (ring != nullptr)
+            {
+                result = ring->Recv(ringFile, &data[idx], chunkLength, GetReceiveWaitingTime());
+                if (result == -ETIMEDOUT) {
+                    if (idx == 0) { CloseAfterError(); return false; }
+                    break;  // In this case no any error because we have any data.
+                }
+                if (result < 0) { errno = static_cast<int32_t>(-result); result = SOCKET_ERROR; }
+            }
+            else { result = recv(fd, &data[idx], chunkLength, 0); }
+
             if (result == SOCKET_ERROR)
             {
                 // The socket is marked non-blocking and the requested operation would block.
                 if (errno == EWOULDBLOCK || errno == EAGAIN)
                 {
-                    if (IsReadyForRecv(1500) == false) {
+                    if (IsReadyForRecv(GetReceiveWaitingTime()) == false) {
                         if (idx == 0) { CloseAfterError(); return false; }
                         break;  // In this case no any error because we have any data.
                     }
@@ -311,7 +676,7 @@ namespace analyzer::framework::net
             if (withoutChunk == true) { chunkLength = length - idx; }
             else if (chunkLength > length - idx) { chunkLength = length - idx; }
 
-        } while (idx != length && system_clock::now() < limit && (successFunctor = functor(data, idx)) == false);
+        } while (idx != length && IsOperationExpired() == false && (successFunctor = functor(data, idx)) == false);
 
         // Check callback functor.
         using func = callbacks::SocketCallbackFunctorAfterReceive;
@@ -327,24 +692,134 @@ namespace analyzer::framework::net
         return successFunctor;
     }
 
+    // Method that receives one frame from external host over TCP protocol.
+    bool Socket::Recv (char* data, const std::size_t length, std::size_t& obtainLength, Framer& framer, const std::size_t chunkLength)
+    {
+        obtainLength = 0;
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.Recv: Socket is invalid.");
+            return false;
+        }
+
+        framer.Reset();
+        StartOperation();
+        FRAME_STATE state = FRAME_NEED_MORE;
+        std::size_t idx = 0;
+        while (idx != length && IsOperationExpired() == false)
+        {
+            // Number of bytes is limited by framer, so the data of the next frame is not received.
+            const std::size_t expected = framer.Expected();
+            std::size_t size = (expected != 0) ? expected : chunkLength;
+            if (size == DEFAULT_NO_CHUNK || size > length - idx) { size = length - idx; }
+
+            ssize_t result = SOCKET_ERROR;
+            if (ring != nullptr)
+            {
+                result = ring->Recv(ringFile, &data[idx], size, GetReceiveWaitingTime());
+                if (result == -ETIMEDOUT) {
+                    if (idx == 0) { CloseAfterError(); return false; }
+                    break;
+                }
+                if (result < 0) { errno = static_cast<int32_t>(-result); result = SOCKET_ERROR; }
+            }
+            else { result = recv(fd, &data[idx], size, 0); }
+
+            if (result == SOCKET_ERROR)
+            {
+                // The socket is marked non-blocking and the requested operation would block.
+                if (errno == EWOULDBLOCK || errno == EAGAIN)
+                {
+                    if (IsReadyForRecv(GetReceiveWaitingTime()) == false) {
+                        if (idx == 0) { CloseAfterError(); return false; }
+                        break;
+                    }
+                    continue;
+                }
+                // A signal occurred before any data was transmitted.
+                if (errno == EINTR) { continue; }
+
+                LOG_ERROR("Socket.Recv [", fd, "]: In function 'recv' - ", GET_ERROR(errno));
+                CloseAfterError();
+                return false;
+            }
+            if (result == 0) { break; }
+
+            state = framer.Feed(&data[idx], static_cast<std::size_t>(result));
+            idx += static_cast<std::size_t>(result);
+            if (state == FRAME_COMPLETE) { break; }
+            // Stream position of the next frame is unknown after the format error.
+            if (state == FRAME_ERROR) {
+                LOG_ERROR("Socket.Recv [", fd, "]: Received data does not match the format of frame.");
+                CloseAfterError();
+                return false;
+            }
+        }
+
+        // Check callback functor.
+        using func = callbacks::SocketCallbackFunctorAfterReceive;
+        auto callback = storage::GI.GetCallback<func>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_AFTER_RECEIVE_TCP);
+        if (callback != nullptr)
+        {
+            LOG_TRACE("Socket.Recv [", fd, "]: Calling the SocketCallbackFunctorAfterReceive functor...");
+            callback->operator()(data, idx);
+        }
+
+        obtainLength = idx;
+        LOG_TRACE("Socket.Recv [", fd, "]: Receiving frame from '", exHost, "': ", idx, " bytes, frame length: ", framer.FrameLength(), '.');
+        return (state == FRAME_COMPLETE);
+    }
+
     // Receiving the message from external host until reach the end.
     int32_t Socket::RecvToEnd (char* data, const std::size_t length) noexcept
     {
-        using std::chrono::system_clock;
-
         if (fd == INVALID_SOCKET) {
             LOG_ERROR("Socket.RecvToEnd: Socket is invalid.");
             return -1;
         }
         LOG_TRACE("Socket.RecvToEnd [", fd, "]: Receiving data from '", exHost, "'...");
-        const system_clock::time_point limit = system_clock::now() + GetTimeout();
+        StartOperation();
 
         std::size_t idx = 0;
-        while (idx != length && IsReadyForRecv(1500) == true && system_clock::now() < limit)
+        bool received = false;
+        if (ring != nullptr && ring->IsMultishotSupported() == true)
+        {
+            // One multishot operation receives all data until the socket has no data within the waiting time.
+            const int32_t result = ring->RecvMultishot(ringFile, data, length, DEFAULT_RECEIVE_IDLE_TIME, GetWaitingTime());
+            if (result < 0 && result != -EOPNOTSUPP) {
+                LOG_ERROR("Socket.RecvToEnd [", fd, "]: In io_uring operation 'recv' - ", GET_ERROR(-result));
+                CloseAfterError();
+                return -1;
+            }
+            if (result >= 0) {
+                idx = static_cast<std::size_t>(result);
+                received = true;
+            }
+        }
+
+        while (received == false && idx != length && IsOperationExpired() == false)
         {
+            if (ring != nullptr)
+            {
+                const int32_t result = ring->Recv(ringFile, &data[idx], length - idx, GetReceiveWaitingTime());
+                if (result == -ETIMEDOUT || result == 0) { break; }
+                if (result < 0) {
+                    LOG_ERROR("Socket.RecvToEnd [", fd, "]: In io_uring operation 'recv' - ", GET_ERROR(-result));
+                    CloseAfterError();
+                    return -1;
+                }
+                idx += static_cast<std::size_t>(result);
+                continue;
+            }
+
             const ssize_t result = recv(fd, &data[idx], length - idx, 0);
             if (result == SOCKET_ERROR)
             {
+                // The socket is marked non-blocking and no data was received within the waiting time.
+                if (errno == EWOULDBLOCK || errno == EAGAIN)
+                {
+                    if (IsReadyForRecv(GetReceiveWaitingTime()) == false) { break; }
+                    continue;
+                }
                 // A signal occurred before any data was transmitted.
                 if (errno == EINTR) { continue; }
 
@@ -370,29 +845,120 @@ namespace analyzer::framework::net
         return static_cast<int32_t>(idx);
     }
 
-    // Method that sends message to external host over UDP protocol.
-    bool Socket::SendTo (const char* host, const uint16_t port, const char* const data, const std::size_t length) noexcept
+    // Method that receives the message until reach the end into the receive buffer of socket.
+    int32_t Socket::RecvToBuffer (const std::size_t maximum) noexcept
     {
-        if (fd == INVALID_SOCKET) {
-            LOG_ERROR("Socket.SendTo: Socket is invalid.");
-            return false;
+        std::size_t received = 0;
+        while (maximum == 0 || received < maximum)
+        {
+            auto [ space, size ] = input.Prepare();
+            if (space == nullptr) {
+                LOG_ERROR("Socket.RecvToBuffer [", fd, "]: Cannot allocate the chunk of receive buffer.");
+                return -1;
+            }
+            if (maximum != 0) { size = std::min(size, maximum - received); }
+
+            const int32_t result = RecvToEnd(space, size);
+            if (result < 0) { return -1; }
+            input.Commit(static_cast<std::size_t>(result));
+            received += static_cast<std::size_t>(result);
+            // Chunk is not filled, so there is no more data.
+            if (static_cast<std::size_t>(result) < size) { break; }
         }
+        return static_cast<int32_t>(received);
+    }
 
-        exHost = host;
-        struct addrinfo hints = { };
-        struct addrinfo* server = nullptr;
-        hints.ai_family = socketFamily;
-        hints.ai_socktype = socketType;
 
-        const int32_t status = getaddrinfo(host, std::to_string(port).c_str(), &hints, &server);
-        if (status != SOCKET_SUCCESS)
-        {
-            LOG_ERROR("Socket.SendTo [", fd, "]: In function 'getaddrinfo' - ", gai_strerror(status));
-            CloseAfterError();
-            return -1;
+    // Method that starts the connection to the pre-resolved address without waiting.
+    int32_t Socket::StartConnect (const SocketAddress& address, const char* host) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.StartConnect: Socket is invalid.");
+            return SOCKET_ERROR;
         }
 
-        // Check callback functor.
+        exHost = (host != nullptr) ? host : "";
+        int32_t result = SOCKET_ERROR;
+        do { result = connect(fd, reinterpret_cast<const struct sockaddr*>(&address.storage), address.length); }
+        while (result == SOCKET_ERROR && errno == EINTR);
+
+        // Statuses that were obtained before connection are not relevant anymore.
+        pool->ClearStatus(fd, SocketStatePool::STATUS_READ | SocketStatePool::STATUS_WRITE | SocketStatePool::STATUS_CLOSED);
+        if (result == SOCKET_SUCCESS) { return SOCKET_SUCCESS; }
+        if (errno == EINPROGRESS) { return SOCKET_WANT_WRITE; }
+
+        LOG_ERROR("Socket.StartConnect [", fd, "]: In function 'connect' - ", GET_ERROR(errno));
+        return SOCKET_ERROR;
+    }
+
+    // Return the result of connection which was in progress (SOCKET_SUCCESS or SOCKET_ERROR).
+    int32_t Socket::FinishConnect (void) noexcept
+    {
+        int32_t error = 0;
+        socklen_t size = sizeof(error);
+        if (fd == INVALID_SOCKET || getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != SOCKET_SUCCESS) { error = errno; }
+        if (error != 0) {
+            LOG_ERROR("Socket.FinishConnect [", fd, "]: Connecting to '", exHost, "' failed - ", GET_ERROR(error));
+            return SOCKET_ERROR;
+        }
+        LOG_INFO("Socket.FinishConnect [", fd, "]: Connecting to '", exHost, "' is success.");
+        return SOCKET_SUCCESS;
+    }
+
+    // Method that sends the part of message over TCP protocol without waiting.
+    int32_t Socket::TrySend (const char* const data, const std::size_t length) noexcept
+    {
+        if (fd == INVALID_SOCKET) { return SOCKET_ERROR; }
+        while (true)
+        {
+            const ssize_t result = send(fd, data, length, 0);
+            if (result != SOCKET_ERROR) { return static_cast<int32_t>(result); }
+            if (errno == EWOULDBLOCK || errno == EAGAIN) { return SOCKET_WANT_WRITE; }
+            if (errno == EINTR) { continue; }
+
+            LOG_ERROR("Socket.TrySend [", fd, "]: In function 'send' - ", GET_ERROR(errno));
+            CloseAfterError();
+            return SOCKET_ERROR;
+        }
+    }
+
+    // Method that receives the available data over TCP protocol without waiting.
+    int32_t Socket::TryRecv (char* data, const std::size_t length) noexcept
+    {
+        if (fd == INVALID_SOCKET) { return SOCKET_ERROR; }
+        while (true)
+        {
+            const ssize_t result = recv(fd, data, length, 0);
+            if (result != SOCKET_ERROR) { return static_cast<int32_t>(result); }
+            if (errno == EWOULDBLOCK || errno == EAGAIN) { return SOCKET_WANT_READ; }
+            if (errno == EINTR) { continue; }
+
+            LOG_ERROR("Socket.TryRecv [", fd, "]: In function 'recv' - ", GET_ERROR(errno));
+            CloseAfterError();
+            return SOCKET_ERROR;
+        }
+    }
+
+
+    // Method that sends message to external host over UDP protocol.
+    bool Socket::SendTo (const char* host, const uint16_t port, const char* const data, const std::size_t length) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.SendTo: Socket is invalid.");
+            return false;
+        }
+
+        exHost = host;
+        std::vector<SocketAddress> addresses;
+        const int32_t status = ResolverCache::Instance().Resolve(host, port, socketFamily, socketType, addresses);
+        if (status != RESOLVER_SUCCESS)
+        {
+            LOG_ERROR("Socket.SendTo [", fd, "]: In function 'getaddrinfo' - ", gai_strerror(status));
+            CloseAfterError();
+            return false;
+        }
+
+        // Check callback functor.
         using functor = callbacks::SocketCallbackFunctorBeforeSend;
         auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_UDP);
         if (callback != nullptr)
@@ -402,17 +968,18 @@ namespace analyzer::framework::net
         }
 
         LOG_TRACE("Socket.SendTo [", fd, "]: Sending data to '", exHost, "' by UDP socket...");
-        for (auto&& curr = server; curr != nullptr; curr = curr->ai_next)
+        StartOperation();
+        for (auto&& curr : addresses)
         {
             std::size_t idx = 0;
             while (idx != length)
             {
-                const ssize_t result = sendto(fd, &data[idx], length - idx, 0, curr->ai_addr, curr->ai_addrlen);
+                const ssize_t result = sendto(fd, &data[idx], length - idx, 0, reinterpret_cast<const struct sockaddr*>(&curr.storage), curr.length);
                 if (result == SOCKET_ERROR)
                 {
                     // The socket is marked non-blocking and the requested operation would block.
                     if (errno == EWOULDBLOCK || errno == EAGAIN) {
-                        if (IsReadyForSend(1500) == false) { break; }
+                        if (IsReadyForSend(GetWaitingTime()) == false) { break; }
                         continue;
                     }
                     // A signal occurred before any data was transmitted.
@@ -426,7 +993,6 @@ namespace analyzer::framework::net
             if (idx == length)
             {
                 LOG_INFO("Socket.SendTo [", fd, "]: Sending data to '", exHost, "' on port '", port, "' is success.");
-                freeaddrinfo(server);
                 return true;
             }
         }
@@ -443,92 +1009,436 @@ namespace analyzer::framework::net
             LOG_ERROR("Socket.RecvFrom: Socket is invalid.");
             return -1;
         }
+
+        SocketAddress expected = { };
+        if (host != nullptr && ResolveAddress(host, port, expected) == false) { return -1; }
+
+        LOG_TRACE("Socket.RecvFrom [", fd, "]: Receiving data from '", (host != nullptr) ? host : "any host", "'...");
+        StartOperation();
+        while (IsOperationExpired() == false)
+        {
+            const int32_t left = GetWaitingTime();
+            if (left <= 0) { break; }
+
+            IncomingDatagram datagram = { };
+            datagram.data = data;
+            datagram.length = length;
+            const int32_t result = RecvBatch(&datagram, 1, left);
+            if (result < 0) { return -1; }
+            if (result == 0) { break; }
+
+            if (host == nullptr || IsSameAddress(expected, datagram.source, port == 0) == true)
+            {
+                LOG_TRACE("Socket.RecvFrom [", fd, "]: Receiving data is success: ", datagram.received, " bytes.");
+                return static_cast<int32_t>(datagram.received);
+            }
+            LOG_TRACE("Socket.RecvFrom [", fd, "]: Datagram from another host is skipped.");
+        }
+
+        LOG_ERROR("Socket.RecvFrom [", fd, "]: Waiting of the datagram - Timeout expired.");
         return 0;
     }
 
+    // Method that resolves the address of external host once for the following send operations.
+    bool Socket::ResolveAddress (const char* host, const uint16_t port, SocketAddress& address) const noexcept
+    {
+        std::vector<SocketAddress> addresses;
+        const int32_t status = ResolverCache::Instance().Resolve(host, port, socketFamily, socketType, addresses);
+        if (status != RESOLVER_SUCCESS || addresses.empty() == true) {
+            LOG_ERROR("Socket.ResolveAddress [", fd, "]: In function 'getaddrinfo' - ", gai_strerror(status));
+            return false;
+        }
 
-    // Checks availability socket on read/write.
-    uint16_t Socket::CheckSocketState (const int32_t time) const noexcept
+        address = addresses.front();
+        return true;
+    }
+
+    // Method that sends message to the pre-resolved address over UDP protocol.
+    bool Socket::SendTo (const SocketAddress& destination, const char* const data, const std::size_t length) noexcept
     {
-        struct epoll_event ev = { };
-        ev.events = EPOLLIN | EPOLLOUT;
-        if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) == SOCKET_ERROR) {
-            LOG_ERROR("Socket.CheckSocketState [", fd, "]: In function 'epoll_ctl' - ", GET_ERROR(errno));
-            return 0;
+        OutgoingDatagram datagram = { };
+        datagram.data = data;
+        datagram.length = length;
+        datagram.destination = &destination;
+        return (SendBatch(&datagram, 1) == 1);
+    }
+
+    // Method that sends the batch of datagrams by sendmmsg system calls.
+    int32_t Socket::SendBatch (const OutgoingDatagram* datagrams, const std::size_t count) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.SendBatch: Socket is invalid.");
+            return -1;
+        }
+
+        // Message headers are owned by thread, so batches are prepared without memory allocation.
+        thread_local auto messages = system::allocMemoryForArray<struct mmsghdr>(MAXIMUM_DATAGRAMS_IN_BATCH);
+        thread_local auto vectors = system::allocMemoryForArray<struct iovec>(MAXIMUM_DATAGRAMS_IN_BATCH);
+        if (messages == nullptr || vectors == nullptr) {
+            LOG_ERROR("Socket.SendBatch [", fd, "]: In function 'alloc_memory'.");
+            return -1;
         }
 
-        struct epoll_event events = { };
-        const int32_t wfd = epoll_wait(epfd, &events, 1, time);
-        if (wfd == 1)
+        // Check callback functor.
+        using functor = callbacks::SocketCallbackFunctorBeforeSend;
+        auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_UDP);
+
+        LOG_TRACE("Socket.SendBatch [", fd, "]: Sending ", count, " datagrams by UDP socket...");
+        StartOperation();
+        std::size_t sent = 0;
+        while (sent != count)
         {
-            if ((events.events & EPOLLIN) != 0U && (events.events & EPOLLOUT) != 0U) {
-                return 3;
-            }
-            if ((events.events & EPOLLIN) != 0U) { return 1; }
-            if ((events.events & EPOLLOUT) != 0U) { return 2; }
-            if (((events.events & EPOLLERR) != 0U) || ((events.events & EPOLLHUP) != 0U)) {
-                LOG_ERROR("Socket.CheckSocketState [", fd, "]: Function 'epoll_wait' return error event: ", uint32_t(events.events), '.');
+            const std::size_t batch = std::min<std::size_t>(count - sent, MAXIMUM_DATAGRAMS_IN_BATCH);
+            for (std::size_t idx = 0; idx < batch; ++idx)
+            {
+                const OutgoingDatagram& datagram = datagrams[sent + idx];
+                std::size_t length = datagram.length;
+                if (callback != nullptr) { callback->operator()(const_cast<char*>(datagram.data), &length); }
+
+                vectors[idx].iov_base = const_cast<char*>(datagram.data);
+                vectors[idx].iov_len = length;
+                messages[idx].msg_hdr = { };
+                messages[idx].msg_hdr.msg_iov = &vectors[idx];
+                messages[idx].msg_hdr.msg_iovlen = 1;
+                if (datagram.destination != nullptr)
+                {
+                    messages[idx].msg_hdr.msg_name = const_cast<sockaddr_storage*>(&datagram.destination->storage);
+                    messages[idx].msg_hdr.msg_namelen = datagram.destination->length;
+                }
             }
-            else {
-                LOG_ERROR("Socket.CheckSocketState [", fd, "]: Function 'epoll_wait' return unknown event: ", uint32_t(events.events), '.');
+
+            std::size_t offset = 0;
+            while (offset != batch)
+            {
+                const int32_t result = sendmmsg(fd, &messages[offset], static_cast<uint32_t>(batch - offset), 0);
+                if (result == SOCKET_ERROR)
+                {
+                    // The socket is marked non-blocking and the requested operation would block.
+                    if (errno == EWOULDBLOCK || errno == EAGAIN) {
+                        if (IsReadyForSend(GetWaitingTime()) == true) { continue; }
+                    }
+                    // A signal occurred before any data was transmitted.
+                    else if (errno == EINTR) { continue; }
+                    else { LOG_ERROR("Socket.SendBatch [", fd, "]: In function 'sendmmsg' - ", GET_ERROR(errno)); }
+
+                    sent += offset;
+                    return (sent == 0) ? -1 : static_cast<int32_t>(sent);
+                }
+                offset += static_cast<std::size_t>(result);
             }
+            sent += batch;
         }
-        else if (wfd == 0) { LOG_ERROR("Socket.CheckSocketState [", fd, "]: In function 'epoll_wait' - Timeout expired."); }
-        else { LOG_ERROR("Socket.CheckSocketState [", fd, "]: In function 'epoll_wait' - ", GET_ERROR(errno)); }
-        return 0;
+
+        LOG_TRACE("Socket.SendBatch [", fd, "]: Sending datagrams is success: ", sent, " datagrams.");
+        return static_cast<int32_t>(sent);
     }
 
+    // Method that sends the sequence of equal-sized datagrams by UDP_SEGMENT offload.
+    int32_t Socket::SendSegmented (const char* data, const std::size_t segmentSize, const std::size_t count, const SocketAddress* destination) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.SendSegmented: Socket is invalid.");
+            return -1;
+        }
+        if (segmentSize == 0 || segmentSize > MAXIMUM_UDP_PAYLOAD) {
+            LOG_ERROR("Socket.SendSegmented [", fd, "]: Incorrect size of segment - ", segmentSize, " bytes.");
+            return -1;
+        }
 
-    // Checks availability socket on write.
-    bool Socket::IsReadyForSend (const int32_t time) noexcept
+        // Functor can change the length of each datagram, so the datagrams are sent one by one.
+        using functor = callbacks::SocketCallbackFunctorBeforeSend;
+        auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_UDP);
+
+        const std::size_t segmentsInDatagram = std::min<std::size_t>(MAXIMUM_SEGMENTS_IN_DATAGRAM, MAXIMUM_UDP_PAYLOAD / segmentSize);
+        StartOperation();
+        std::size_t sent = 0;
+        while (sent != count && segmentation == true && callback == nullptr)
+        {
+            const std::size_t segments = std::min<std::size_t>(count - sent, segmentsInDatagram);
+            struct iovec vector = { const_cast<char*>(data + sent * segmentSize), segments * segmentSize };
+            char control[CMSG_SPACE(sizeof(uint16_t))] = { };
+            struct msghdr message = { };
+            message.msg_iov = &vector;
+            message.msg_iovlen = 1;
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            if (destination != nullptr)
+            {
+                message.msg_name = const_cast<sockaddr_storage*>(&destination->storage);
+                message.msg_namelen = destination->length;
+            }
+
+            struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+            header->cmsg_level = SOL_UDP;
+            header->cmsg_type = UDP_SEGMENT;
+            header->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            const auto size = static_cast<uint16_t>(segmentSize);
+            memcpy(CMSG_DATA(header), &size, sizeof(size));
+
+            const ssize_t result = sendmsg(fd, &message, 0);
+            if (result == SOCKET_ERROR)
+            {
+                // The socket is marked non-blocking and the requested operation would block.
+                if (errno == EWOULDBLOCK || errno == EAGAIN) {
+                    if (IsReadyForSend(GetWaitingTime()) == true) { continue; }
+                }
+                // A signal occurred before any data was transmitted.
+                else if (errno == EINTR) { continue; }
+                // Kernel or network device does not support the segmentation offload.
+                else if (errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP || errno == EIO)
+                {
+                    LOG_WARNING("Socket.SendSegmented [", fd, "]: UDP_SEGMENT is rejected - ", GET_ERROR(errno), ". Sending by batch...");
+                    segmentation = false;
+                    break;
+                }
+                else { LOG_ERROR("Socket.SendSegmented [", fd, "]: In function 'sendmsg' - ", GET_ERROR(errno)); }
+                return (sent == 0) ? -1 : static_cast<int32_t>(sent);
+            }
+            sent += segments;
+        }
+
+        // Fallback: the datagrams are sent by sendmmsg system calls.
+        OutgoingDatagram datagrams[MAXIMUM_SEGMENTS_IN_DATAGRAM] = { };
+        while (sent != count)
+        {
+            const std::size_t segments = std::min<std::size_t>(count - sent, MAXIMUM_SEGMENTS_IN_DATAGRAM);
+            for (std::size_t idx = 0; idx < segments; ++idx)
+            {
+                datagrams[idx].data = data + (sent + idx) * segmentSize;
+                datagrams[idx].length = segmentSize;
+                datagrams[idx].destination = destination;
+            }
+
+            const int32_t result = SendBatch(datagrams, segments);
+            if (result <= 0) { return (sent == 0) ? -1 : static_cast<int32_t>(sent); }
+            sent += static_cast<std::size_t>(result);
+            if (static_cast<std::size_t>(result) != segments) { break; }
+        }
+
+        LOG_TRACE("Socket.SendSegmented [", fd, "]: Sending datagrams is success: ", sent, " datagrams.");
+        return static_cast<int32_t>(sent);
+    }
+
+    // Method that enables UDP_GRO offload which coalesces the received equal-sized datagrams.
+    bool Socket::EnableReceiveCoalescing (void) noexcept
     {
-        event.events = EPOLLOUT;
-        if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &event) == SOCKET_ERROR) {
-            LOG_ERROR("Socket.IsReadyForSend [", fd, "]: In function 'epoll_ctl (s)' - ", GET_ERROR(errno));
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.EnableReceiveCoalescing: Socket is invalid.");
+            return false;
+        }
+
+        const int32_t enable = 1;
+        if (setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) != SOCKET_SUCCESS) {
+            LOG_WARNING("Socket.EnableReceiveCoalescing [", fd, "]: UDP_GRO is not supported - ", GET_ERROR(errno));
             return false;
         }
+        coalescing = true;
+        return true;
+    }
 
-        struct epoll_event events = { };
-        const int32_t wfd = epoll_wait(epfd, &events, 1, time);
-        if (wfd == 1)
+    // Method that receives the batch of datagrams by recvmmsg system calls.
+    int32_t Socket::RecvBatch (IncomingDatagram* datagrams, const std::size_t count, const int32_t time) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.RecvBatch: Socket is invalid.");
+            return -1;
+        }
+
+        thread_local auto messages = system::allocMemoryForArray<struct mmsghdr>(MAXIMUM_DATAGRAMS_IN_BATCH);
+        thread_local auto vectors = system::allocMemoryForArray<struct iovec>(MAXIMUM_DATAGRAMS_IN_BATCH);
+        // Control messages contain the size of segments of the coalesced datagrams.
+        constexpr std::size_t controlSize = CMSG_SPACE(sizeof(int32_t));
+        thread_local auto controls = system::allocMemoryForArray<char>(MAXIMUM_DATAGRAMS_IN_BATCH * controlSize);
+        if (messages == nullptr || vectors == nullptr || controls == nullptr) {
+            LOG_ERROR("Socket.RecvBatch [", fd, "]: In function 'alloc_memory'.");
+            return -1;
+        }
+
+        std::size_t received = 0;
+        while (received != count)
         {
-            if ((events.events & EPOLLOUT) != 0U) { return true; }
-            if (((events.events & EPOLLERR) != 0U) || ((events.events & EPOLLHUP) != 0U)) {
-                LOG_ERROR("Socket.IsReadyForSend [", fd, "]: Function 'epoll_wait (s)' return error event: ", uint32_t(events.events), '.');
+            const std::size_t batch = std::min<std::size_t>(count - received, MAXIMUM_DATAGRAMS_IN_BATCH);
+            for (std::size_t idx = 0; idx < batch; ++idx)
+            {
+                IncomingDatagram& datagram = datagrams[received + idx];
+                vectors[idx].iov_base = datagram.data;
+                vectors[idx].iov_len = datagram.length;
+                messages[idx].msg_hdr = { };
+                messages[idx].msg_hdr.msg_iov = &vectors[idx];
+                messages[idx].msg_hdr.msg_iovlen = 1;
+                messages[idx].msg_hdr.msg_name = &datagram.source.storage;
+                messages[idx].msg_hdr.msg_namelen = sizeof(datagram.source.storage);
+                if (coalescing == true)
+                {
+                    messages[idx].msg_hdr.msg_control = controls.get() + idx * controlSize;
+                    messages[idx].msg_hdr.msg_controllen = controlSize;
+                }
             }
-            else {
-                LOG_ERROR("Socket.IsReadyForSend [", fd, "]: Function 'epoll_wait (s)' return unknown event: ", uint32_t(events.events), '.');
+
+            const int32_t result = recvmmsg(fd, messages.get(), static_cast<uint32_t>(batch), 0, nullptr);
+            if (result == SOCKET_ERROR)
+            {
+                // The socket is marked non-blocking and there are no datagrams.
+                if (errno == EWOULDBLOCK || errno == EAGAIN)
+                {
+                    // Only the first datagram is waited for, the next datagrams are returned if they are already available.
+                    if (received != 0) { break; }
+                    pool->ClearStatus(fd, SocketStatePool::STATUS_READ);
+                    if ((pool->WaitForStatus(fd, SocketStatePool::STATUS_READ, time) & SocketStatePool::STATUS_READ) == 0) { return 0; }
+                    continue;
+                }
+                // A signal occurred before any data was transmitted.
+                if (errno == EINTR) { continue; }
+
+                LOG_ERROR("Socket.RecvBatch [", fd, "]: In function 'recvmmsg' - ", GET_ERROR(errno));
+                return (received == 0) ? -1 : static_cast<int32_t>(received);
             }
+
+            for (int32_t idx = 0; idx < result; ++idx)
+            {
+                IncomingDatagram& datagram = datagrams[received + static_cast<std::size_t>(idx)];
+                datagram.received = messages[idx].msg_len;
+                datagram.source.length = messages[idx].msg_hdr.msg_namelen;
+                datagram.truncated = (messages[idx].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+                datagram.segment = datagram.received;
+
+                for (struct cmsghdr* control = CMSG_FIRSTHDR(&messages[idx].msg_hdr); control != nullptr; control = CMSG_NXTHDR(&messages[idx].msg_hdr, control))
+                {
+                    if (control->cmsg_level == SOL_UDP && control->cmsg_type == UDP_GRO)
+                    {
+                        int32_t segment = 0;
+                        memcpy(&segment, CMSG_DATA(control), sizeof(segment));
+                        if (segment > 0) { datagram.segment = static_cast<std::size_t>(segment); }
+                    }
+                }
+            }
+            received += static_cast<std::size_t>(result);
+            if (static_cast<std::size_t>(result) != batch) { break; }
         }
-        else if (wfd == 0) { LOG_ERROR("Socket.IsReadyForSend [", fd, "]: In function 'epoll_wait (s)' - Timeout expired."); }
-        else { LOG_ERROR("Socket.IsReadyForSend [", fd, "]: In function 'epoll_wait (s)' - ", GET_ERROR(errno)); }
-        return false;
+
+        // Check callback functor.
+        using functor = callbacks::SocketCallbackFunctorAfterReceive;
+        auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_AFTER_RECEIVE_UDP);
+        if (callback != nullptr)
+        {
+            LOG_TRACE("Socket.RecvBatch [", fd, "]: Calling the SocketCallbackFunctorAfterReceive functor...");
+            for (std::size_t idx = 0; idx < received; ++idx) {
+                callback->operator()(datagrams[idx].data, datagrams[idx].received);
+            }
+        }
+
+        LOG_TRACE("Socket.RecvBatch [", fd, "]: Receiving datagrams is success: ", received, " datagrams.");
+        return static_cast<int32_t>(received);
     }
 
 
-    // Checks availability socket on read.
-    bool Socket::IsReadyForRecv (const int32_t time) noexcept
+    // Method that switches the socket to the io_uring backend of the calling thread.
+    bool Socket::EnableRingBackend(void) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.EnableRingBackend: Socket is invalid.");
+            return false;
+        }
+        if (ring != nullptr) { return true; }
+
+        SocketRing* const current = SocketRing::Instance();
+        if (current == nullptr) {
+            LOG_INFO("Socket.EnableRingBackend [", fd, "]: io_uring is not supported, epoll backend is used.");
+            return false;
+        }
+
+        ringFile = current->RegisterFile(fd);
+        if (ringFile == INVALID_SOCKET) { return false; }
+        ring = current;
+        LOG_INFO("Socket.EnableRingBackend [", fd, "]: io_uring backend is enabled.");
+        return true;
+    }
+
+    // Method that moves the socket to the reactor (and the io_uring ring) of the calling thread.
+    bool Socket::RebindReactor(void) noexcept
     {
-        event.events = EPOLLIN;
-        if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &event) == SOCKET_ERROR) {
-            LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: In function 'epoll_ctl (r)' - ", GET_ERROR(errno));
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("Socket.RebindReactor: Socket is invalid.");
             return false;
         }
 
-        struct epoll_event events = { };
-        const int32_t wfd = epoll_wait(epfd, &events, 1, time);
-        if (wfd == 1)
+        SocketStatePool* const current = &SocketStatePool::Instance();
+        if (pool != current)
         {
-            if ((events.events & EPOLLIN) != 0U) { return true; }
-            if (((events.events & EPOLLERR) != 0U) || ((events.events & EPOLLHUP) != 0U)) {
-                LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: Function 'epoll_wait (r)' return error event: ", uint32_t(events.events), '.');
-            }
-            else {
-                LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: Function 'epoll_wait (r)' return unknown event: ", uint32_t(events.events), '.');
+            if (pool != nullptr) { pool->DeleteDescriptor(fd); }
+            pool = current;
+            if (pool->RegisterSocket(fd, SocketStatePool::TEST_ALWAYS) == false) {
+                LOG_ERROR("Socket.RebindReactor [", fd, "]: Registration in socket state pool failed.");
+                return false;
             }
         }
-        else if (wfd == 0) { LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: In function 'epoll_wait (r)' - Timeout expired."); }
-        else { LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: In function 'epoll_wait (r)' - ", GET_ERROR(errno)); }
+
+        // Ring of the other thread cannot be used by the calling thread.
+        if (ring != nullptr && ring != SocketRing::Instance())
+        {
+            ring->UnregisterFile(ringFile);
+            ring = nullptr;
+            ringFile = INVALID_SOCKET;
+            return EnableRingBackend();
+        }
+        return true;
+    }
+
+
+    // Checks availability socket on read/write.
+    uint16_t Socket::CheckSocketState (const int32_t time) const noexcept
+    {
+        if (pool == nullptr || fd == INVALID_SOCKET) { return 0; }
+
+        const uint16_t status = pool->WaitForStatus(fd, SocketStatePool::STATUS_READ | SocketStatePool::STATUS_WRITE, time);
+        const bool read = (status & SocketStatePool::STATUS_READ) != 0;
+        const bool write = (status & SocketStatePool::STATUS_WRITE) != 0;
+        if (read == true && write == true) { return 3; }
+        if (read == true) { return 1; }
+        if (write == true) { return 2; }
+
+        if (status == 0) { LOG_ERROR("Socket.CheckSocketState [", fd, "]: Waiting of the socket status - Timeout expired."); }
+        else { LOG_ERROR("Socket.CheckSocketState [", fd, "]: Socket state pool return error status: ", status, '.'); }
+        return 0;
+    }
+
+
+    // Waits availability socket on write after the operation would block.
+    bool Socket::IsReadyForSend (const int32_t time) noexcept
+    {
+        if (pool == nullptr || fd == INVALID_SOCKET) { return false; }
+
+        // In edge-triggered mode the saved status is stale after the operation would block.
+        pool->ClearStatus(fd, SocketStatePool::STATUS_WRITE);
+        uint16_t status = pool->WaitForStatus(fd, SocketStatePool::STATUS_WRITE, time);
+        // Completions of MSG_ZEROCOPY sends are reported by the error status.
+        if ((status & SocketStatePool::STATUS_WRITE) == 0 && (status & SocketStatePool::STATUS_ERROR) != 0 && ReapZeroCopy() > 0) {
+            status = pool->WaitForStatus(fd, SocketStatePool::STATUS_WRITE, time);
+        }
+        if ((status & SocketStatePool::STATUS_WRITE) != 0) { return true; }
+
+        if (status == 0) { LOG_ERROR("Socket.IsReadyForSend [", fd, "]: Waiting of the socket status - Timeout expired."); }
+        else { LOG_ERROR("Socket.IsReadyForSend [", fd, "]: Socket state pool return error status: ", status, '.'); }
+        return false;
+    }
+
+
+    // Waits availability socket on read after the operation would block.
+    bool Socket::IsReadyForRecv (const int32_t time) noexcept
+    {
+        if (pool == nullptr || fd == INVALID_SOCKET) { return false; }
+
+        // In edge-triggered mode the saved status is stale after the operation would block.
+        pool->ClearStatus(fd, SocketStatePool::STATUS_READ);
+        uint16_t status = pool->WaitForStatus(fd, SocketStatePool::STATUS_READ, time);
+        // Completions of MSG_ZEROCOPY sends are reported by the error status.
+        if ((status & SocketStatePool::STATUS_READ) == 0 && (status & SocketStatePool::STATUS_ERROR) != 0 && ReapZeroCopy() > 0) {
+            status = pool->WaitForStatus(fd, SocketStatePool::STATUS_READ, time);
+        }
+        if ((status & SocketStatePool::STATUS_READ) != 0) { return true; }
+
+        if (status == 0) { LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: Waiting of the socket status - Timeout expired."); }
+        else { LOG_ERROR("Socket.IsReadyForRecv [", fd, "]: Socket state pool return error status: ", status, '.'); }
         return false;
     }
 
@@ -562,6 +1472,24 @@ namespace analyzer::framework::net
         return true;
     }
 
+    // Method that checks that the idle connection can be used for the next request.
+    bool Socket::IsReusable (void) noexcept
+    {
+        if (IsAlive() == false) { return false; }
+
+        char byte = 0;
+        const ssize_t result = recv(fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (result == 0) {
+            LOG_TRACE("Socket.IsReusable [", fd, "]: Connection is closed by external host.");
+            return false;
+        }
+        if (result > 0) {
+            LOG_TRACE("Socket.IsReusable [", fd, "]: Connection contains unread data.");
+            return false;
+        }
+        return (errno == EWOULDBLOCK || errno == EAGAIN);
+    }
+
     // Shutdown the connection.
     void Socket::Shutdown (const int32_t how) const
     {
@@ -579,11 +1507,14 @@ namespace analyzer::framework::net
     void Socket::Close(void)
     {
         if (fd != INVALID_SOCKET) {
+            pool->DeleteDescriptor(fd);
+            // Registered file holds the socket open, so it is unregistered before close.
+            if (ring != nullptr) { ring->UnregisterFile(ringFile); ring = nullptr; ringFile = INVALID_SOCKET; }
             close(fd);
             LOG_INFO("Socket.Close [", fd, "]: Connection closed with host: '", exHost, "'.");
             fd = INVALID_SOCKET;
+            zerocopyRequests = zerocopyCompletions = 0;
         }
-        if (epfd != INVALID_SOCKET) { close(epfd); epfd = INVALID_SOCKET; }
     }
 
     // Cleaning after error.
@@ -596,42 +1527,446 @@ namespace analyzer::framework::net
     // Destructor.
     Socket::~Socket(void)
     {
-        if (fd != INVALID_SOCKET) { close(fd); fd = INVALID_SOCKET; }
-        if (epfd != INVALID_SOCKET) { close(epfd); epfd = INVALID_SOCKET; }
+        if (fd != INVALID_SOCKET)
+        {
+            pool->DeleteDescriptor(fd);
+            if (ring != nullptr) { ring->UnregisterFile(ringFile); }
+            close(fd); fd = INVALID_SOCKET;
+        }
         exHost.clear();
     }
 
 
 
 
+    // Reactors of the finished threads which will be used by new threads.
+    static std::vector<SocketStatePool *> freeReactors;
+    // Mutex value for thread-safe access to the free reactors.
+    static system::LocalMutex reactorsMutex;
+
+
     SocketStatePool::SocketStatePool(void) noexcept
     {
-        // Create array for socket events.
-        events = system::allocMemoryForArray<struct epoll_event>(MAXIMUM_SOCKET_DESCRIPTORS);
-        if (events == nullptr) {
-            LOG_FATAL("SocketStatePool.SocketStatePool: In function 'alloc_memory'.");
-            std::terminate();
-        }
-
         // Create epoll descriptor.
-        epoll_fd = epoll_create1(0);
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
         if (epoll_fd == INVALID_SOCKET) {
             LOG_FATAL("SocketStatePool.SocketStatePool: In function 'epoll_create1' - ", GET_ERROR(errno));
             std::terminate();
         }
+    }
 
-        // Start thread for epoll loop with events pointer.
+    // Method that returns the free reactor or creates new one.
+    SocketStatePool* SocketStatePool::Acquire(void) noexcept
+    {
+        SocketStatePool* reactor = nullptr;
+        {
+            system::LockGuard lock(reactorsMutex);
+            if (freeReactors.empty() == false)
+            {
+                reactor = freeReactors.back();
+                freeReactors.pop_back();
+            }
+        }
+        // Reactors are never destroyed because sockets may outlive the thread that created them.
+        if (reactor == nullptr) { reactor = new (std::nothrow) SocketStatePool(); }
+        if (reactor != nullptr) { reactor->owner.store(std::this_thread::get_id(), std::memory_order_release); }
+        return reactor;
+    }
 
+    // Method that returns the reactor of the finished thread for reuse by other threads.
+    void SocketStatePool::Release (SocketStatePool* const reactor) noexcept
+    {
+        if (reactor == nullptr) { return; }
+        // Sockets of the finished thread are waited by poll() until the reactor is bound to the next thread.
+        reactor->owner.store(std::thread::id(), std::memory_order_release);
+        system::LockGuard lock(reactorsMutex);
+        try { freeReactors.push_back(reactor); }
+        catch (const std::exception& /*err*/) { }
     }
 
     SocketStatePool& SocketStatePool::Instance(void) noexcept
     {
-        // Since it's a static variable, if the class has already been created, its won't be created again.
-        // It's thread-safe since C++11.
-        static SocketStatePool instance;
-        return instance;
+        // The reactor is bound to the thread on first use and is returned to the free reactors when the thread is finished.
+        struct ReactorHolder
+        {
+            SocketStatePool* reactor = Acquire();
+            ~ReactorHolder(void) noexcept { Release(reactor); }
+        };
+
+        thread_local ReactorHolder holder;
+        if (holder.reactor == nullptr) {
+            LOG_FATAL("SocketStatePool.Instance: In function 'alloc_memory'.");
+            std::terminate();
+        }
+        return *holder.reactor;
+    }
+
+    // Method that converts epoll events to the socket statuses.
+    uint16_t SocketStatePool::ConvertEvents (const uint32_t events) noexcept
+    {
+        uint16_t status = 0;
+        if ((events & EPOLLERR) != 0U) { status |= STATUS_ERROR; }
+        if ((events & EPOLLHUP) != 0U) { status |= STATUS_CLOSED; }
+        if ((events & EPOLLIN) != 0U)
+        {
+            status |= STATUS_READ;
+            if ((events & EPOLLRDHUP) != 0U) { status |= STATUS_WRCLOSED; }
+        }
+        else if ((events & EPOLLRDHUP) != 0U) { status |= STATUS_CLOSED; }
+        if ((events & EPOLLOUT) != 0U) { status |= STATUS_WRITE; }
+        if ((events & ~static_cast<uint32_t>(EPOLLERR | EPOLLHUP | EPOLLIN | EPOLLRDHUP | EPOLLOUT)) != 0U) { status |= STATUS_ANOTHER; }
+        return status;
     }
 
+    // Method that converts task type to the socket statuses which are expected by this task.
+    uint16_t SocketStatePool::ConvertTask (const uint16_t task) noexcept
+    {
+        uint16_t statuses = 0;
+        if ((task & TASK_TYPE_READ) != 0) { statuses |= STATUS_READ | STATUS_WRCLOSED; }
+        if ((task & TASK_TYPE_WRITE) != 0) { statuses |= STATUS_WRITE; }
+        if ((task & TASK_TYPE_CLOSE) != 0) { statuses |= STATUS_CLOSED | STATUS_WRCLOSED; }
+        if ((task & TASK_TYPE_ALL) != 0) { statuses |= STATUS_READ | STATUS_WRITE | STATUS_CLOSED | STATUS_WRCLOSED; }
+        // Notification is always sent in case of errors.
+        return statuses | STATUS_ERROR | STATUS_CLOSED | STATUS_ANOTHER;
+    }
+
+    // Method that sends notification with the current status of socket descriptor.
+    void SocketStatePool::Signal (DescriptorState& state) noexcept
+    {
+        if (state.signaled == true || state.notification == nullptr) { return; }
+
+        auto subject = state.notification->ToSubject();
+        subject->SetValue(static_cast<SOCKET_STATUS>(state.status));
+        subject->Post();
+        state.signaled = true;
+        state.ordered = false;
+    }
+
+    // Method that processes the obtained statuses of socket descriptor and sends notification if needed.
+    void SocketStatePool::ProcessDescriptor (const int32_t fd, DescriptorState& state, const uint16_t obtained) noexcept
+    {
+        state.status |= obtained;
+        if ((state.type & WITHOUT_NOTIFICATION) == 0)
+        {
+            if ((state.ordered == true && (state.status & ConvertTask(state.task)) != 0) || (state.type & NOTIFY_ALWAYS) != 0) {
+                Signal(state);
+            }
+        }
+
+        if ((state.type & TEST_ONCE_AND_DELETE) != 0)
+        {
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == SOCKET_ERROR) {
+                LOG_ERROR("SocketStatePool.ProcessDescriptor [", fd, "]: In function 'epoll_ctl' - ", GET_ERROR(errno));
+            }
+            state.registered = false;
+            state.status |= STATUS_DELETE;
+            countOfDescriptors.fetch_sub(1, std::memory_order_relaxed);
+            if ((state.type & WITHOUT_NOTIFICATION) == 0) { Signal(state); }
+        }
+    }
+
+    // Method that deletes from epoll set the socket descriptor with expired live time.
+    void SocketStatePool::RemoveExpiredDescriptor (const int32_t fd) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        // Descriptor may be deleted or registered again before the handler of timer is called.
+        if (it == descriptors.end() || it->second.registered == false || it->second.limited == false || it->second.timer.IsArmed() == true) { return; }
+
+        DescriptorState& state = it->second;
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        state.registered = false;
+        state.limited = false;
+        state.status |= STATUS_DELETE;
+        countOfDescriptors.fetch_sub(1, std::memory_order_relaxed);
+        if (state.ordered == true) { Signal(state); }
+    }
+
+    // Handler of the timer of live time which deletes the socket descriptor from the reactor of the calling thread.
+    void SocketStatePool::ExpireDescriptor (void* context) noexcept
+    {
+        Instance().RemoveExpiredDescriptor(static_cast<int32_t>(reinterpret_cast<intptr_t>(context)));
+    }
+
+    // Method that adds new socket descriptor to common set.
+    bool SocketStatePool::RegisterSocket (const int32_t fd, const uint16_t type, const uint32_t liveTime) noexcept
+    {
+        if (fd == INVALID_SOCKET) {
+            LOG_ERROR("SocketStatePool.RegisterSocket: Socket descriptor is invalid.");
+            return false;
+        }
+
+        system::LockGuard lock(mutex);
+        DescriptorState* state = nullptr;
+        try { state = &descriptors[fd]; }
+        catch (const std::exception& err) {
+            LOG_ERROR("SocketStatePool.RegisterSocket [", fd, "]: When adding descriptor - '", err.what(), "'.");
+            return false;
+        }
+
+        // The notification is kept if descriptor number is registered again, so issued observers stay valid.
+        if (state->notification == nullptr)
+        {
+            state->notification = system::allocMemoryForObject<task::NotificationInit<SOCKET_STATUS>>(STATUS_UNKNOWN);
+            if (state->notification == nullptr) {
+                LOG_ERROR("SocketStatePool.RegisterSocket [", fd, "]: In function 'alloc_memory'.");
+                descriptors.erase(fd);
+                return false;
+            }
+        }
+        else if (state->signaled == true)
+        {
+            state->notification->ToSubject()->Rearm();
+            state->signaled = false;
+        }
+
+        struct epoll_event event = { };
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = fd;
+        const bool registered = state->registered;
+        if (epoll_ctl(epoll_fd, (registered == true) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) == SOCKET_ERROR) {
+            LOG_ERROR("SocketStatePool.RegisterSocket [", fd, "]: In function 'epoll_ctl' - ", GET_ERROR(errno));
+            descriptors.erase(fd);
+            if (registered == true) { countOfDescriptors.fetch_sub(1, std::memory_order_relaxed); }
+            return false;
+        }
+
+        state->type = type;
+        state->task = TASK_TYPE_ALL;
+        state->status = 0;
+        state->ordered = false;
+        state->registered = true;
+        state->limited = (liveTime != UNLIMITED_LIVE_TIME);
+        if (state->limited == true)
+        {
+            state->timer.SetHandler(ExpireDescriptor, reinterpret_cast<void*>(static_cast<intptr_t>(fd)));
+            wheel.Arm(state->timer, std::chrono::seconds(liveTime));
+        }
+        else { state->timer.Cancel(); }
+        if (registered == false) { countOfDescriptors.fetch_add(1, std::memory_order_relaxed); }
+        return true;
+    }
+
+    // Method that change the type of socket descriptor in common set.
+    bool SocketStatePool::ChangeSocketType (const int32_t fd, const uint16_t type) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        if (it == descriptors.end() || it->second.registered == false) {
+            LOG_ERROR("SocketStatePool.ChangeSocketType [", fd, "]: Socket descriptor is not registered.");
+            return false;
+        }
+        it->second.type = type;
+        return true;
+    }
+
+    // Method that checks socket status.
+    SocketStatePool::SOCKET_STATUS SocketStatePool::CheckSocketStatus (const int32_t fd) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        if (it == descriptors.end()) { return STATUS_DELETE; }
+        if (it->second.registered == false) { return static_cast<SOCKET_STATUS>(it->second.status | STATUS_DELETE); }
+        if (it->second.status == 0) { return STATUS_UNKNOWN; }
+        return static_cast<SOCKET_STATUS>(it->second.status);
+    }
+
+    // Method that orders the notification about the next status of socket descriptor with the last task type.
+    task::NotificationObserver<SocketStatePool::SOCKET_STATUS>* SocketStatePool::SetOrderNotification (const int32_t fd) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        if (it == descriptors.end()) {
+            LOG_ERROR("SocketStatePool.SetOrderNotification [", fd, "]: Socket descriptor is not registered.");
+            return nullptr;
+        }
+
+        DescriptorState& state = it->second;
+        if (state.signaled == true)
+        {
+            state.notification->ToSubject()->Rearm();
+            state.signaled = false;
+        }
+        state.ordered = true;
+
+        // The saved status already satisfies the task or descriptor is deleted.
+        if ((state.status & ConvertTask(state.task)) != 0 || state.registered == false)
+        {
+            if (state.registered == false) { state.status |= STATUS_DELETE; }
+            Signal(state);
+        }
+        return state.notification->ToObserver();
+    }
+
+    // Method that set request for socket descriptor.
+    task::NotificationObserver<SocketStatePool::SOCKET_STATUS>* SocketStatePool::RegisterTask (const int32_t fd, const TASK_TYPE task) noexcept
+    {
+        {
+            system::LockGuard lock(mutex);
+            const auto it = descriptors.find(fd);
+            if (it == descriptors.end()) {
+                LOG_ERROR("SocketStatePool.RegisterTask [", fd, "]: Socket descriptor is not registered.");
+                return nullptr;
+            }
+            it->second.task = task;
+        }
+        return SetOrderNotification(fd);
+    }
+
+    // Method that waits the events of one socket descriptor by poll() and processes them.
+    int32_t SocketStatePool::PollDescriptor (const int32_t fd, const uint16_t statuses, const int32_t time) noexcept
+    {
+        struct pollfd request = { fd, POLLRDHUP, 0 };
+        if ((statuses & (STATUS_READ | STATUS_WRCLOSED)) != 0) { request.events |= POLLIN; }
+        if ((statuses & STATUS_WRITE) != 0) { request.events |= POLLOUT; }
+
+        const int32_t count = poll(&request, 1, time);
+        if (count == SOCKET_ERROR)
+        {
+            // A signal occurred before any events were obtained.
+            if (errno == EINTR) { return 0; }
+            LOG_ERROR("SocketStatePool.PollDescriptor [", fd, "]: In function 'poll' - ", GET_ERROR(errno));
+            return SOCKET_ERROR;
+        }
+        if (count == 0) { return 0; }
+
+        // Events of poll() have the same values as the events of epoll.
+        uint16_t obtained = ConvertEvents(static_cast<uint32_t>(request.revents));
+        if ((request.revents & POLLNVAL) != 0) { obtained |= STATUS_ERROR; }
+
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        if (it != descriptors.end() && it->second.registered == true) {
+            ProcessDescriptor(fd, it->second, obtained);
+        }
+        return count;
+    }
+
+    // Method that drives the reactor until the socket descriptor obtains any of the selected statuses.
+    uint16_t SocketStatePool::WaitForStatus (const int32_t fd, const uint16_t statuses, const int32_t time) noexcept
+    {
+        const uint16_t expected = statuses | STATUS_ERROR | STATUS_CLOSED;
+        // Only the owner thread drives the epoll of reactor, other threads wait for the descriptor without stealing its edge.
+        const bool owned = IsOwnedByCurrentThread();
+        // Timeout expires in the wheel of the calling thread, so the waiting is woken by the nearest deadline of this thread.
+        TimingWheel& timers = (owned == true) ? wheel : Instance().GetTimingWheel();
+        WheelTimer timeout;
+        if (time > 0) { timers.Arm(timeout, std::chrono::milliseconds(time)); }
+
+        bool polled = false;
+        while (true)
+        {
+            {
+                system::LockGuard lock(mutex);
+                const auto it = descriptors.find(fd);
+                if (it == descriptors.end()) { return STATUS_DELETE; }
+                if ((it->second.status & expected) != 0) { return it->second.status; }
+                if (it->second.registered == false) { return it->second.status | STATUS_DELETE; }
+            }
+            if (polled == true && time >= 0 && timeout.IsArmed() == false) { return 0; }
+
+            const int32_t waiting = (time == 0) ? 0 : DEFAULT_TIME_SIGWAIT;
+            int32_t result = SOCKET_ERROR;
+            if (owned == true) { result = Poll(waiting); }
+            else
+            {
+                result = PollDescriptor(fd, expected, timers.GetWaitingTime(waiting));
+                timers.Advance();
+            }
+            if (result == SOCKET_ERROR) { return 0; }
+            polled = true;
+        }
+    }
+
+    // Method that resets the saved statuses of socket descriptor.
+    void SocketStatePool::ClearStatus (const int32_t fd, const uint16_t statuses) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        if (it != descriptors.end()) {
+            it->second.status &= static_cast<uint16_t>(~statuses);
+        }
+    }
+
+    // Method that waits events of all socket descriptors of the reactor and processes them.
+    int32_t SocketStatePool::Poll (const int32_t time) noexcept
+    {
+        thread_local std::vector<int32_t> ready;
+        ready.clear();
+        return Poll(time, ready);
+    }
+
+    // Method that waits events of all socket descriptors of the reactor, processes them and returns the ready descriptors.
+    int32_t SocketStatePool::Poll (const int32_t time, std::vector<int32_t>& ready) noexcept
+    {
+        // The edge of epoll is obtained only once, so the reactor is driven only by the thread that owns it.
+        if (IsOwnedByCurrentThread() == false) {
+            LOG_ERROR("SocketStatePool.Poll: Reactor is driven by another thread.");
+            return SOCKET_ERROR;
+        }
+
+        // Events buffer is owned by thread because the reactor of finished thread is reused by the next thread.
+        thread_local auto events = system::allocMemoryForArray<struct epoll_event>(MAXIMUM_SOCKET_DESCRIPTORS);
+        if (events == nullptr) {
+            LOG_ERROR("SocketStatePool.Poll: In function 'alloc_memory'.");
+            return SOCKET_ERROR;
+        }
+
+        const int32_t count = epoll_wait(epoll_fd, events.get(), MAXIMUM_SOCKET_DESCRIPTORS, wheel.GetWaitingTime(time));
+        if (count == SOCKET_ERROR)
+        {
+            // A signal occurred before any events were obtained.
+            if (errno == EINTR) { return 0; }
+            LOG_ERROR("SocketStatePool.Poll: In function 'epoll_wait' - ", GET_ERROR(errno));
+            return SOCKET_ERROR;
+        }
+
+        {
+            system::LockGuard lock(mutex);
+            for (int32_t idx = 0; idx < count; ++idx)
+            {
+                const int32_t fd = events[idx].data.fd;
+                const auto it = descriptors.find(fd);
+                if (it != descriptors.end() && it->second.registered == true) {
+                    ProcessDescriptor(fd, it->second, ConvertEvents(events[idx].events));
+                    ready.push_back(fd);
+                }
+            }
+
+        }
+
+        // Handlers of timers (also the live time of descriptors) may use the reactor, so they are called without lock.
+        wheel.Advance();
+        return count;
+    }
+
+    // Method that removes socket descriptor from epoll set.
+    void SocketStatePool::DeleteDescriptor (const int32_t fd) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = descriptors.find(fd);
+        if (it == descriptors.end()) { return; }
+
+        DescriptorState& state = it->second;
+        if (state.registered == true)
+        {
+            // Descriptor may be already closed, so errors are not important.
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            state.registered = false;
+            countOfDescriptors.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // Observer may wait for the ordered notification, so state is kept until descriptor number is registered again.
+        if (state.ordered == true)
+        {
+            state.limited = false;
+            state.timer.Cancel();
+            state.status |= STATUS_DELETE;
+            Signal(state);
+            return;
+        }
+        descriptors.erase(it);
+    }
 
 
 }  // namespace net.
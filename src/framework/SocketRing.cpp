@@ -0,0 +1,711 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "../../include/framework/Log.hpp"
+#include "../../include/framework/System.hpp"
+#include "../../include/framework/SocketRing.hpp"
+
+
+#define RING_LINK_TIMEOUT_TAG  UINT64_MAX        // Tag of all linked timeout entries (their completions are skipped).
+#define RING_SERVICE_TAG       (UINT64_MAX - 1)  // Tag of all cancel and buffer entries (their completions are skipped).
+#define RING_BUFFER_GROUP      0                 // Group identifier of the provided buffers.
+
+
+namespace analyzer::framework::net
+{
+    // Function that sets up the io_uring instance.
+    static inline int32_t IoUringSetup (const uint32_t entries, struct io_uring_params* params) noexcept
+    {
+        return static_cast<int32_t>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    // Function that submits the entries and waits for the completions.
+    static inline int32_t IoUringEnter (const int32_t fd, const uint32_t submit, const uint32_t complete,
+                                        const uint32_t flags, const void* arg, const std::size_t size) noexcept
+    {
+        return static_cast<int32_t>(syscall(__NR_io_uring_enter, fd, submit, complete, flags, arg, size));
+    }
+
+    // Function that registers the resources in the io_uring instance.
+    static inline int32_t IoUringRegister (const int32_t fd, const uint32_t opcode, const void* arg, const uint32_t count) noexcept
+    {
+        return static_cast<int32_t>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    // Function that maps the memory of the io_uring instance or anonymous memory if descriptor is invalid.
+    static inline void* MapMemory (const std::size_t size, const int32_t fd, const uint64_t offset) noexcept
+    {
+        void* memory = (fd == -1) ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+                                  : mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, static_cast<off_t>(offset));
+        return (memory == MAP_FAILED) ? nullptr : memory;
+    }
+
+
+
+    // Rings of the finished threads which will be used by new threads.
+    static std::vector<SocketRing *> freeRings;
+    // Mutex value for thread-safe access to the free rings.
+    static system::LocalMutex ringsMutex;
+
+
+    SocketRing::~SocketRing(void) noexcept
+    {
+        if (buffers != nullptr) { munmap(buffers, (RING_REGISTERED_BUFFERS + RING_PROVIDED_BUFFERS) * RING_BUFFER_SIZE); }
+        if (sqes != nullptr) { munmap(sqes, sqEntries * sizeof(struct io_uring_sqe)); }
+        if (cqRing != nullptr && cqRing != sqRing) { munmap(cqRing, cqRingSize); }
+        if (sqRing != nullptr) { munmap(sqRing, sqRingSize); }
+        if (ringFd != -1) { close(ringFd); }
+    }
+
+    // Method that sets up the ring, checks the supported operations and registers files and buffers.
+    bool SocketRing::Initialize(void) noexcept
+    {
+        struct io_uring_params params = { };
+        params.flags = IORING_SETUP_CLAMP;
+        ringFd = IoUringSetup(RING_QUEUE_ENTRIES, &params);
+        if (ringFd < 0) {
+            ringFd = -1;
+            LOG_WARNING("SocketRing.Initialize: In function 'io_uring_setup' - ", GET_ERROR(errno));
+            return false;
+        }
+
+        // Map the submission and completion queues.
+        sqEntries = params.sq_entries;
+        cqEntries = params.cq_entries;
+        sqRingSize = params.sq_off.array + sqEntries * sizeof(uint32_t);
+        cqRingSize = params.cq_off.cqes + cqEntries * sizeof(struct io_uring_cqe);
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap == true) { sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize); }
+
+        sqRing = MapMemory(sqRingSize, ringFd, IORING_OFF_SQ_RING);
+        cqRing = (singleMap == true) ? sqRing : MapMemory(cqRingSize, ringFd, IORING_OFF_CQ_RING);
+        sqes = static_cast<struct io_uring_sqe*>(MapMemory(sqEntries * sizeof(struct io_uring_sqe), ringFd, IORING_OFF_SQES));
+        if (sqRing == nullptr || cqRing == nullptr || sqes == nullptr) {
+            LOG_ERROR("SocketRing.Initialize: In function 'mmap' - ", GET_ERROR(errno));
+            return false;
+        }
+
+        auto sqBase = static_cast<std::byte*>(sqRing);
+        auto cqBase = static_cast<std::byte*>(cqRing);
+        sqHead = reinterpret_cast<uint32_t*>(sqBase + params.sq_off.head);
+        sqTail = reinterpret_cast<uint32_t*>(sqBase + params.sq_off.tail);
+        sqMask = *reinterpret_cast<uint32_t*>(sqBase + params.sq_off.ring_mask);
+        cqHead = reinterpret_cast<uint32_t*>(cqBase + params.cq_off.head);
+        cqTail = reinterpret_cast<uint32_t*>(cqBase + params.cq_off.tail);
+        cqMask = *reinterpret_cast<uint32_t*>(cqBase + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cqBase + params.cq_off.cqes);
+        localTail = *sqTail;
+
+        // Entries of submission queue are always used in order, so the indirection array is filled once.
+        auto sqArray = reinterpret_cast<uint32_t*>(sqBase + params.sq_off.array);
+        for (uint32_t idx = 0; idx < sqEntries; ++idx) { sqArray[idx] = idx; }
+
+        // Check that all required operations are supported.
+        constexpr std::size_t probeOps = 256;
+        auto probeMemory = system::allocMemoryForArray<std::byte>(sizeof(struct io_uring_probe) + probeOps * sizeof(struct io_uring_probe_op));
+        if (probeMemory == nullptr) {
+            LOG_ERROR("SocketRing.Initialize: In function 'alloc_memory'.");
+            return false;
+        }
+        auto probe = reinterpret_cast<struct io_uring_probe*>(probeMemory.get());
+        if (IoUringRegister(ringFd, IORING_REGISTER_PROBE, probe, probeOps) < 0) {
+            LOG_WARNING("SocketRing.Initialize: Probe of operations failed - ", GET_ERROR(errno));
+            return false;
+        }
+        for (const uint8_t opcode : { IORING_OP_CONNECT, IORING_OP_SEND, IORING_OP_RECV, IORING_OP_LINK_TIMEOUT,
+                                      IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED, IORING_OP_ASYNC_CANCEL })
+        {
+            if (opcode > probe->last_op || (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0) {
+                LOG_WARNING("SocketRing.Initialize: Operation '", static_cast<uint16_t>(opcode), "' is not supported.");
+                return false;
+            }
+        }
+
+        timeouts = system::allocMemoryForArray<RingTimeout>(sqEntries);
+        files = system::allocMemoryForArray<int32_t>(RING_REGISTERED_FILES);
+        multishotEvents = system::allocMemoryForArray<MultishotEvent>(cqEntries);
+        if (timeouts == nullptr || files == nullptr || multishotEvents == nullptr) {
+            LOG_ERROR("SocketRing.Initialize: In function 'alloc_memory'.");
+            return false;
+        }
+
+        // Register the empty table of fixed files.
+        std::fill(files.get(), files.get() + RING_REGISTERED_FILES, -1);
+        if (IoUringRegister(ringFd, IORING_REGISTER_FILES, files.get(), RING_REGISTERED_FILES) < 0) {
+            LOG_WARNING("SocketRing.Initialize: Registration of files failed - ", GET_ERROR(errno));
+            return false;
+        }
+
+        // Registered buffers are optional because they are limited by the locked memory on old kernels.
+        buffers = static_cast<std::byte*>(MapMemory((RING_REGISTERED_BUFFERS + RING_PROVIDED_BUFFERS) * RING_BUFFER_SIZE, -1, 0));
+        if (buffers == nullptr) {
+            LOG_ERROR("SocketRing.Initialize: In function 'mmap' - ", GET_ERROR(errno));
+            return false;
+        }
+        struct iovec vectors[RING_REGISTERED_BUFFERS] = { };
+        for (std::size_t idx = 0; idx < RING_REGISTERED_BUFFERS; ++idx)
+        {
+            vectors[idx].iov_base = buffers + idx * RING_BUFFER_SIZE;
+            vectors[idx].iov_len = RING_BUFFER_SIZE;
+        }
+        if (IoUringRegister(ringFd, IORING_REGISTER_BUFFERS, vectors, RING_REGISTERED_BUFFERS) == 0) {
+            registeredBuffers = RING_REGISTERED_BUFFERS;
+        }
+        else { LOG_WARNING("SocketRing.Initialize: Registration of buffers failed - ", GET_ERROR(errno)); }
+
+        // Multishot receive waits for the completions with timeout, so it requires the extended arguments of io_uring_enter.
+        // Buffers are provided by operations because they are supported by more kernels than the registered buffer rings.
+        multishotSupported = (params.features & IORING_FEAT_EXT_ARG) != 0 &&
+                             (probe->ops[IORING_OP_PROVIDE_BUFFERS].flags & IO_URING_OP_SUPPORTED) != 0 &&
+                             (probe->ops[IORING_OP_REMOVE_BUFFERS].flags & IO_URING_OP_SUPPORTED) != 0;
+        return true;
+    }
+
+    // Method that returns the free ring or creates new one.
+    SocketRing* SocketRing::Acquire(void) noexcept
+    {
+        {
+            system::LockGuard lock(ringsMutex);
+            if (freeRings.empty() == false)
+            {
+                SocketRing* ring = freeRings.back();
+                freeRings.pop_back();
+                return ring;
+            }
+        }
+
+        if (IsSupported() == false) { return nullptr; }
+        // Rings are never destroyed because registered sockets may outlive the thread that created them.
+        SocketRing* ring = new (std::nothrow) SocketRing();
+        if (ring != nullptr && ring->Initialize() == false)
+        {
+            delete ring;
+            return nullptr;
+        }
+        return ring;
+    }
+
+    // Method that returns the ring of the finished thread for reuse by other threads.
+    void SocketRing::Release (SocketRing* const ring) noexcept
+    {
+        if (ring == nullptr) { return; }
+        system::LockGuard lock(ringsMutex);
+        try { freeRings.push_back(ring); }
+        catch (const std::exception& /*err*/) { }
+    }
+
+    // Method that checks whether the kernel supports all required io_uring operations.
+    bool SocketRing::IsSupported(void) noexcept
+    {
+        static const bool supported = [] () noexcept {
+            SocketRing ring;
+            return ring.Initialize();
+        }();
+        return supported;
+    }
+
+    // Method that returns the ring of the calling thread.
+    SocketRing* SocketRing::Instance(void) noexcept
+    {
+        // The ring is bound to the thread on first use and is returned to the free rings when the thread is finished.
+        struct RingHolder
+        {
+            SocketRing* ring = Acquire();
+            ~RingHolder(void) noexcept { Release(ring); }
+        };
+
+        thread_local RingHolder holder;
+        return holder.ring;
+    }
+
+    // Method that returns the next free entry of the submission queue.
+    struct io_uring_sqe* SocketRing::GetEntry(void) noexcept
+    {
+        const uint32_t head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (localTail - head >= sqEntries) { return nullptr; }
+
+        struct io_uring_sqe* entry = &sqes[localTail & sqMask];
+        memset(entry, 0, sizeof(struct io_uring_sqe));
+        ++localTail;
+        ++queued;
+        return entry;
+    }
+
+    // Method that submits the queued entries if the submission queue has no space for the selected number of entries.
+    bool SocketRing::Reserve (const uint32_t count) noexcept
+    {
+        const uint32_t head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (sqEntries - (localTail - head) >= count) { return true; }
+        return (Enter(0, 0) >= 0 && sqEntries - (localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE)) >= count);
+    }
+
+    // Method that publishes the queued entries, submits them and waits for the completions.
+    int32_t SocketRing::Enter (const uint32_t complete, uint32_t flags, const int32_t time) noexcept
+    {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+
+        struct __kernel_timespec timespec = { };
+        struct io_uring_getevents_arg argument = { };
+        const void* arg = nullptr;
+        std::size_t size = 0;
+        if (time >= 0)
+        {
+            timespec.tv_sec = time / 1000;
+            timespec.tv_nsec = static_cast<int64_t>(time % 1000) * 1000000;
+            argument.ts = reinterpret_cast<uint64_t>(&timespec);
+            arg = &argument;
+            size = sizeof(argument);
+            flags |= IORING_ENTER_EXT_ARG;
+        }
+
+        while (true)
+        {
+            const int32_t result = IoUringEnter(ringFd, queued, complete, flags, arg, size);
+            if (result >= 0)
+            {
+                queued -= static_cast<uint32_t>(result);
+                return result;
+            }
+            // A signal occurred before waiting is finished.
+            if (errno == EINTR) { continue; }
+            return -errno;
+        }
+    }
+
+    // Method that moves all entries of the completion queue into the results of the completed operations.
+    void SocketRing::Reap(void) noexcept
+    {
+        uint32_t head = *cqHead;
+        const uint32_t tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head)
+        {
+            const struct io_uring_cqe& entry = cqes[head & cqMask];
+            if (entry.user_data == RING_LINK_TIMEOUT_TAG || entry.user_data == RING_SERVICE_TAG) { continue; }
+
+            if (multishotTag != 0 && entry.user_data == multishotTag)
+            {
+                // Number of completions between two reaps never exceeds the size of completion queue.
+                multishotEvents[multishotEventsCount].result = entry.res;
+                multishotEvents[multishotEventsCount].flags = entry.flags;
+                ++multishotEventsCount;
+                continue;
+            }
+
+            try { completions[entry.user_data] = entry.res; }
+            catch (const std::exception& err) {
+                LOG_ERROR("SocketRing.Reap: When saving the result - '", err.what(), "'.");
+            }
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        // Results of the operations which are never waited for are discarded from the oldest one.
+        if (completions.size() > cqEntries) { DiscardCompletions(); }
+    }
+
+    // Method that discards the oldest results of the completed operations up to the half of the completion queue.
+    void SocketRing::DiscardCompletions(void) noexcept
+    {
+        std::vector<uint64_t> tags;
+        try { tags.reserve(completions.size()); }
+        catch (const std::exception& err) {
+            LOG_ERROR("SocketRing.DiscardCompletions: When allocating memory - '", err.what(), "'.");
+            return;
+        }
+        for (const auto& completion : completions) { tags.push_back(completion.first); }
+
+        const std::size_t count = tags.size() - cqEntries / 2;
+        std::nth_element(tags.begin(), tags.begin() + static_cast<std::ptrdiff_t>(count - 1), tags.end());
+        discardedTag = std::max(discardedTag, tags[count - 1]);
+        for (auto it = completions.begin(); it != completions.end();)
+        {
+            if (it->first <= discardedTag) { it = completions.erase(it); }
+            else { ++it; }
+        }
+        LOG_WARNING("SocketRing.DiscardCompletions: ", count, " results of the operations are never waited for and discarded.");
+    }
+
+    // Method that queues the operation over the registered socket descriptor with the linked timeout.
+    uint64_t SocketRing::QueueOperation (const uint8_t opcode, const int32_t file, const void* address, const uint32_t length,
+                                         const uint64_t offset, const uint16_t buffer, const int32_t time) noexcept
+    {
+        if (ringFd == -1 || file < 0 || file >= RING_REGISTERED_FILES) {
+            LOG_ERROR("SocketRing.QueueOperation: Ring or index of socket descriptor is invalid.");
+            return 0;
+        }
+        if (Reserve((time >= 0) ? 2 : 1) == false) {
+            LOG_ERROR("SocketRing.QueueOperation: Submission queue is full.");
+            return 0;
+        }
+
+        const uint64_t tag = nextTag++;
+        struct io_uring_sqe* entry = GetEntry();
+        entry->opcode = opcode;
+        entry->flags = IOSQE_FIXED_FILE;
+        entry->fd = file;
+        entry->addr = reinterpret_cast<uint64_t>(address);
+        entry->len = length;
+        entry->off = offset;
+        entry->buf_index = buffer;
+        entry->user_data = tag;
+        if (opcode == IORING_OP_SEND) { entry->msg_flags = MSG_NOSIGNAL; }
+
+        if (time >= 0)
+        {
+            // Linked timeout cancels the operation if it is not completed in time.
+            entry->flags |= IOSQE_IO_LINK;
+            RingTimeout& timeout = timeouts[localTail & sqMask];
+            timeout.seconds = time / 1000;
+            timeout.nanoseconds = static_cast<int64_t>(time % 1000) * 1000000;
+
+            struct io_uring_sqe* link = GetEntry();
+            link->opcode = IORING_OP_LINK_TIMEOUT;
+            link->addr = reinterpret_cast<uint64_t>(&timeout);
+            link->len = 1;
+            link->user_data = RING_LINK_TIMEOUT_TAG;
+        }
+        return tag;
+    }
+
+    // Method that waits for the completion of the operation.
+    bool SocketRing::WaitOperation (const uint64_t tag, int32_t& result) noexcept
+    {
+        if (tag == 0) { return false; }
+
+        while (true)
+        {
+            Reap();
+            const auto it = completions.find(tag);
+            if (it != completions.end())
+            {
+                // Operation is cancelled only by the linked timeout.
+                result = (it->second == -ECANCELED) ? -ETIMEDOUT : it->second;
+                completions.erase(it);
+                return true;
+            }
+            if (tag <= discardedTag) {
+                LOG_ERROR("SocketRing.WaitOperation: Result of the operation is already discarded.");
+                return false;
+            }
+
+            const int32_t status = Enter(1, IORING_ENTER_GETEVENTS);
+            if (status < 0) {
+                LOG_ERROR("SocketRing.WaitOperation: In function 'io_uring_enter' - ", GET_ERROR(-status));
+                return false;
+            }
+        }
+    }
+
+    // Method that registers the socket descriptor in the table of fixed files of the ring.
+    int32_t SocketRing::RegisterFile (int32_t fd) noexcept
+    {
+        system::LockGuard lock(mutex);
+        for (uint32_t count = 0; count < RING_REGISTERED_FILES; ++count)
+        {
+            const uint32_t slot = (filesHint + count) % RING_REGISTERED_FILES;
+            if (files[slot] != -1) { continue; }
+
+            struct io_uring_files_update update = { };
+            update.offset = slot;
+            update.fds = reinterpret_cast<uint64_t>(&fd);
+            if (IoUringRegister(ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) < 0) {
+                LOG_ERROR("SocketRing.RegisterFile [", fd, "]: In function 'io_uring_register' - ", GET_ERROR(errno));
+                return -1;
+            }
+            files[slot] = fd;
+            filesHint = slot + 1;
+            return static_cast<int32_t>(slot);
+        }
+
+        LOG_ERROR("SocketRing.RegisterFile [", fd, "]: Table of registered socket descriptors is full.");
+        return -1;
+    }
+
+    // Method that removes the socket descriptor from the table of fixed files of the ring.
+    void SocketRing::UnregisterFile (const int32_t file) noexcept
+    {
+        if (file < 0 || file >= RING_REGISTERED_FILES) { return; }
+
+        system::LockGuard lock(mutex);
+        int32_t fd = -1;
+        struct io_uring_files_update update = { };
+        update.offset = static_cast<uint32_t>(file);
+        update.fds = reinterpret_cast<uint64_t>(&fd);
+        if (IoUringRegister(ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) < 0) {
+            LOG_ERROR("SocketRing.UnregisterFile [", files[file], "]: In function 'io_uring_register' - ", GET_ERROR(errno));
+        }
+        files[file] = -1;
+        filesHint = std::min(filesHint, static_cast<uint32_t>(file));
+    }
+
+    // Method that queues the connection of the registered socket descriptor.
+    uint64_t SocketRing::QueueConnect (const int32_t file, const struct sockaddr* addr, const socklen_t size, const int32_t time) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return QueueOperation(IORING_OP_CONNECT, file, addr, 0, size, 0, time);
+    }
+
+    // Method that queues the sending of data over the registered socket descriptor.
+    uint64_t SocketRing::QueueSend (const int32_t file, const char* data, const std::size_t length, const int32_t time) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return QueueOperation(IORING_OP_SEND, file, data, static_cast<uint32_t>(std::min<std::size_t>(length, INT32_MAX)), 0, 0, time);
+    }
+
+    // Method that queues the receiving of data over the registered socket descriptor.
+    uint64_t SocketRing::QueueRecv (const int32_t file, char* data, const std::size_t length, const int32_t time) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return QueueOperation(IORING_OP_RECV, file, data, static_cast<uint32_t>(std::min<std::size_t>(length, INT32_MAX)), 0, 0, time);
+    }
+
+    // Method that queues the sending of data from the registered buffer.
+    uint64_t SocketRing::QueueSendFixed (const int32_t file, const uint16_t buffer, const std::size_t length, const int32_t time) noexcept
+    {
+        if (buffer >= registeredBuffers || length > RING_BUFFER_SIZE) {
+            LOG_ERROR("SocketRing.QueueSendFixed: Registered buffer is invalid.");
+            return 0;
+        }
+        system::LockGuard lock(mutex);
+        // Offset -1 means the current position which is the only valid position for the stream socket.
+        return QueueOperation(IORING_OP_WRITE_FIXED, file, GetBuffer(buffer), static_cast<uint32_t>(length), UINT64_MAX, buffer, time);
+    }
+
+    // Method that queues the receiving of data into the registered buffer.
+    uint64_t SocketRing::QueueRecvFixed (const int32_t file, const uint16_t buffer, const std::size_t length, const int32_t time) noexcept
+    {
+        if (buffer >= registeredBuffers || length > RING_BUFFER_SIZE) {
+            LOG_ERROR("SocketRing.QueueRecvFixed: Registered buffer is invalid.");
+            return 0;
+        }
+        system::LockGuard lock(mutex);
+        return QueueOperation(IORING_OP_READ_FIXED, file, GetBuffer(buffer), static_cast<uint32_t>(length), UINT64_MAX, buffer, time);
+    }
+
+    // Method that submits all queued operations by one system call.
+    int32_t SocketRing::Submit(void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return Enter(0, 0);
+    }
+
+    // Method that submits all queued operations and waits for the completion of the selected operation.
+    bool SocketRing::WaitCompletion (const uint64_t tag, int32_t& result) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return WaitOperation(tag, result);
+    }
+
+    // Method that connects the registered socket descriptor to the external host.
+    int32_t SocketRing::Connect (const int32_t file, const struct sockaddr* addr, const socklen_t size, const int32_t time) noexcept
+    {
+        system::LockGuard lock(mutex);
+        int32_t result = -EINVAL;
+        if (WaitOperation(QueueOperation(IORING_OP_CONNECT, file, addr, 0, size, 0, time), result) == false) { return -EIO; }
+        return result;
+    }
+
+    // Method that sends data over the registered socket descriptor.
+    int32_t SocketRing::Send (const int32_t file, const char* data, const std::size_t length, const int32_t time) noexcept
+    {
+        system::LockGuard lock(mutex);
+        int32_t result = -EINVAL;
+        const auto size = static_cast<uint32_t>(std::min<std::size_t>(length, INT32_MAX));
+        if (WaitOperation(QueueOperation(IORING_OP_SEND, file, data, size, 0, 0, time), result) == false) { return -EIO; }
+        return result;
+    }
+
+    // Method that receives data over the registered socket descriptor.
+    int32_t SocketRing::Recv (const int32_t file, char* data, const std::size_t length, const int32_t time) noexcept
+    {
+        system::LockGuard lock(mutex);
+        int32_t result = -EINVAL;
+        const auto size = static_cast<uint32_t>(std::min<std::size_t>(length, INT32_MAX));
+        if (WaitOperation(QueueOperation(IORING_OP_RECV, file, data, size, 0, 0, time), result) == false) { return -EIO; }
+        return result;
+    }
+
+    // Method that queues the free buffers for the kernel within the selected budget.
+    void SocketRing::ProvideBuffers (const std::size_t budget) noexcept
+    {
+        for (uint16_t index = 0; index < RING_PROVIDED_BUFFERS && providedTotal < budget; ++index)
+        {
+            if (providedLengths[index] != 0) { continue; }
+            if (Reserve(1) == false) { return; }
+
+            const auto length = static_cast<uint32_t>(std::min<std::size_t>(RING_BUFFER_SIZE, budget - providedTotal));
+            struct io_uring_sqe* entry = GetEntry();
+            entry->opcode = IORING_OP_PROVIDE_BUFFERS;
+            entry->fd = 1;  // Number of buffers.
+            entry->addr = reinterpret_cast<uint64_t>(buffers + (RING_REGISTERED_BUFFERS + index) * RING_BUFFER_SIZE);
+            entry->len = length;
+            entry->off = index;
+            entry->buf_group = RING_BUFFER_GROUP;
+            entry->user_data = RING_SERVICE_TAG;
+
+            providedLengths[index] = length;
+            providedTotal += length;
+        }
+    }
+
+    // Method that queues the removal of all buffers which are owned by the kernel.
+    void SocketRing::RemoveBuffers(void) noexcept
+    {
+        if (providedTotal == 0 || Reserve(1) == false) { return; }
+
+        struct io_uring_sqe* entry = GetEntry();
+        entry->opcode = IORING_OP_REMOVE_BUFFERS;
+        entry->fd = RING_PROVIDED_BUFFERS;
+        entry->buf_group = RING_BUFFER_GROUP;
+        entry->user_data = RING_SERVICE_TAG;
+
+        providedTotal = 0;
+        memset(providedLengths, 0, sizeof(providedLengths));
+    }
+
+    // Method that queues the multishot receive operation.
+    bool SocketRing::ArmMultishot (const int32_t file) noexcept
+    {
+        if (Reserve(1) == false) { return false; }
+
+        multishotTag = nextTag++;
+        struct io_uring_sqe* entry = GetEntry();
+        entry->opcode = IORING_OP_RECV;
+        entry->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+        entry->ioprio = IORING_RECV_MULTISHOT;
+        entry->fd = file;
+        entry->buf_group = RING_BUFFER_GROUP;
+        entry->user_data = multishotTag;
+        return true;
+    }
+
+    // Method that copies data of the obtained multishot completions and returns their buffers to application.
+    int32_t SocketRing::ConsumeMultishot (char* data, std::size_t& idx, bool& active) noexcept
+    {
+        int32_t status = 1;
+        for (uint32_t event = 0; event < multishotEventsCount; ++event)
+        {
+            const MultishotEvent& current = multishotEvents[event];
+            if ((current.flags & IORING_CQE_F_MORE) == 0) { active = false; }
+            if ((current.flags & IORING_CQE_F_BUFFER) != 0)
+            {
+                const auto index = static_cast<uint16_t>(current.flags >> IORING_CQE_BUFFER_SHIFT);
+                if (current.result > 0) {
+                    memcpy(data + idx, buffers + (RING_REGISTERED_BUFFERS + index) * RING_BUFFER_SIZE, static_cast<std::size_t>(current.result));
+                    idx += static_cast<std::size_t>(current.result);
+                }
+                providedTotal -= providedLengths[index];
+                providedLengths[index] = 0;
+            }
+            // Kernel has no free buffers, so operation is armed again after the buffers are provided.
+            if (current.result == -ENOBUFS) { continue; }
+            if (current.result <= 0 && status > 0) { status = current.result; }
+        }
+        multishotEventsCount = 0;
+        return status;
+    }
+
+    // Method that receives data by one multishot operation until reach the end.
+    int32_t SocketRing::RecvMultishot (const int32_t file, char* data, const std::size_t length, const int32_t idleTime, const int32_t totalTime) noexcept
+    {
+        using std::chrono::steady_clock;
+
+        if (file < 0 || file >= RING_REGISTERED_FILES) { return -EBADF; }
+        system::LockGuard lock(mutex);
+        if (multishotSupported == false) { return -EOPNOTSUPP; }
+
+        // Buffers which were left by the previous receiving may exceed the free space.
+        if (providedTotal > length) { RemoveBuffers(); }
+
+        const steady_clock::time_point limit = steady_clock::now() + std::chrono::milliseconds(totalTime);
+        std::size_t idx = 0;
+        int32_t error = 0;
+        bool active = false;
+        bool finished = false;
+        uint32_t idleArms = 0;  // Number of arms of the operation without any data.
+        multishotEventsCount = 0;
+
+        while (true)
+        {
+            ProvideBuffers(length - idx);
+            if (active == false)
+            {
+                // Operation which is finished by the kernel without any data at every arm is not rearmed endlessly.
+                if (++idleArms > RING_PROVIDED_BUFFERS) { error = -ENOBUFS; break; }
+                if (ArmMultishot(file) == false) { error = -EBUSY; break; }
+                active = true;
+            }
+
+            int32_t waiting = idleTime;
+            if (totalTime >= 0)
+            {
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(limit - steady_clock::now()).count();
+                if (left <= 0) { break; }
+                waiting = (waiting < 0) ? static_cast<int32_t>(left) : std::min(waiting, static_cast<int32_t>(left));
+            }
+
+            const int32_t status = Enter(1, IORING_ENTER_GETEVENTS, waiting);
+            if (status < 0 && status != -ETIME) { error = status; break; }
+
+            Reap();
+            const std::size_t previous = idx;
+            const int32_t result = ConsumeMultishot(data, idx, active);
+            if (idx != previous) { idleArms = 0; }
+            if (result < 0)
+            {
+                // Kernel without multishot receive rejects the operation as invalid.
+                if (result == -EINVAL && idx == 0) { multishotSupported = false; error = -EOPNOTSUPP; }
+                else { error = result; }
+                finished = true;
+            }
+            else if (result == 0) { finished = true; }
+
+            // Idle timeout is expired without any data.
+            if (status == -ETIME || finished == true || idx == length) { break; }
+        }
+
+        // Completions of cancelled operation may still contain data which fit into the free space.
+        if (active == true)
+        {
+            struct io_uring_sqe* entry = (Reserve(1) == true) ? GetEntry() : nullptr;
+            if (entry != nullptr)
+            {
+                entry->opcode = IORING_OP_ASYNC_CANCEL;
+                entry->addr = multishotTag;
+                entry->user_data = RING_SERVICE_TAG;
+            }
+
+            while (active == true && entry != nullptr)
+            {
+                if (Enter(1, IORING_ENTER_GETEVENTS) < 0) { break; }
+                Reap();
+                ConsumeMultishot(data, idx, active);
+            }
+        }
+        multishotTag = 0;
+
+        if (error != 0 && idx == 0) { return error; }
+        return static_cast<int32_t>(idx);
+    }
+
+    // Method that returns the registered buffer.
+    char* SocketRing::GetBuffer (const uint16_t buffer) const noexcept
+    {
+        if (buffer >= registeredBuffers) { return nullptr; }
+        return reinterpret_cast<char*>(buffers + buffer * RING_BUFFER_SIZE);
+    }
+
+
+}  // namespace net.
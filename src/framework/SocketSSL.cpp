@@ -6,6 +6,11 @@
 // This file is part of ProtocolAnalyzer open source project under MIT License.
 // ============================================================================
 
+#include <algorithm>
+#include <netinet/tcp.h>
+
+#include "../../include/framework/Parser.hpp"
+#include "../../include/framework/System.hpp"
 #include "../../include/framework/Socket.hpp"
 
 
@@ -25,35 +30,70 @@ namespace analyzer::framework::net
 
 
     SocketSSL::SocketSSL (const uint16_t method, const char* ciphers, const uint32_t timeout) noexcept
-            : Socket(AF_INET, SOCK_STREAM, IPPROTO_TCP, timeout)
+            : Socket(AF_INET, SOCK_STREAM, IPPROTO_TCP, timeout), method(method)
     {
         if (method >= NUMBER_OF_CTX) {
             LOG_ERROR("SocketSSL.SocketSSL [", fd,"]: SSL input protocol type is invalid.");
             Socket::CloseAfterError();
             return;
         }
+        // List of ciphers is parsed once by the context of profile, but not by each connection.
+        SSLContextProfile profile;
+        profile.minimum = profile.maximum = method;
+        profileKey = SSLContextCache::MakeKey(profile);
+        if (ciphers == nullptr) {
+            Initialize(context.Get(method));
+            return;
+        }
 
-        ssl = SSL_new(context.Get(method));
-        if (ssl == nullptr) {
-            LOG_ERROR("SocketSSL.SocketSSL [", fd,"]: In function 'SSL_new' - ", CheckSSLErrors());
+        profile.ciphers = ciphers;
+        profileKey = SSLContextCache::MakeKey(profile);
+        SSL_CTX* ctx = SSLContextCache::Instance().Acquire(profile);
+        Initialize(ctx);
+        // SSL object holds its own reference of context.
+        SSL_CTX_free(ctx);
+    }
+
+    SocketSSL::SocketSSL (const SSLContextProfile& profile, const uint32_t timeout) noexcept
+            : Socket(AF_INET, SOCK_STREAM, IPPROTO_TCP, timeout), method(profile.maximum), profileKey(SSLContextCache::MakeKey(profile))
+    {
+        SSL_CTX* ctx = SSLContextCache::Instance().Acquire(profile);
+        Initialize(ctx);
+        SSL_CTX_free(ctx);
+    }
+
+    // Creates the SSL object of context with socket BIO.
+    void SocketSSL::Initialize (SSL_CTX* ctx) noexcept
+    {
+        if (ctx == nullptr) {
+            LOG_ERROR("SocketSSL.Initialize [", fd,"]: SSL context is invalid.");
             SSLCloseAfterError();
             return;
         }
 
-        if (ciphers != nullptr && SSL_set_cipher_list(ssl, ciphers) == 0)
-        {
-            LOG_ERROR("SocketSSL.SocketSSL [", fd,"]: In function 'SSL_set_cipher_list' - ", CheckSSLErrors());
+        // Records of TLS are written entirely, and the abbreviated handshake ends by the client flight which is followed by request.
+        // Nagle algorithm would delay this request until the acknowledgement of server.
+        const int32_t enable = 1;
+        if (fd != INVALID_SOCKET && setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) != 0) {
+            LOG_WARNING("SocketSSL.Initialize [", fd,"]: In function 'setsockopt' with TCP_NODELAY - ", GET_ERROR(errno));
+        }
+
+        ssl = SSL_new(ctx);
+        if (ssl == nullptr) {
+            LOG_ERROR("SocketSSL.Initialize [", fd,"]: In function 'SSL_new' - ", CheckSSLErrors());
             SSLCloseAfterError();
             return;
         }
 
         // All errors processing OpenSSL library.
         SSL_set_mode(ssl, SSL_MODE_AUTO_RETRY);
+        // Key of session is found by SSL object in the callback of new session.
+        SSL_set_app_data(ssl, &sessionKey);
 
         // Create new I/O object.
         bio = BIO_new_socket(fd, BIO_NOCLOSE);
         if (bio == nullptr) {
-            LOG_ERROR("SocketSSL.SocketSSL [", fd,"]: In function 'BIO_new_socket' - ", CheckSSLErrors());
+            LOG_ERROR("SocketSSL.Initialize [", fd,"]: In function 'BIO_new_socket' - ", CheckSSLErrors());
             SSLCloseAfterError();
             return;
         }
@@ -77,6 +117,7 @@ namespace analyzer::framework::net
         }
 
         SetServerNameIndication(host);
+        (void)ResumeSession(host, port);
         if (Socket::Connect(host, port) == false || DoHandshakeSSL() == false)
         {
             SSLCloseAfterError();
@@ -95,18 +136,59 @@ namespace analyzer::framework::net
     }
 
 
+    bool SocketSSL::ConnectWithEarlyData (const char* host, const uint16_t port, const char* data, const std::size_t length)
+    {
+        if (fd == INVALID_SOCKET || ssl == nullptr || bio == nullptr || data == nullptr) {
+            LOG_ERROR("SocketSSL.ConnectWithEarlyData: Socket is invalid.");
+            SSLCloseAfterError();
+            return false;
+        }
+
+        SetServerNameIndication(host);
+        bool early = false;
+        if (ResumeSession(host, port) == true)
+        {
+            // Server announces the limit of early data in the ticket (zero - early data is not allowed).
+            const SSL_SESSION* session = SSL_get0_session(ssl);
+            early = (session != nullptr && length != 0 && length <= SSL_SESSION_get_max_early_data(session));
+        }
+        if (Socket::Connect(host, port) == false) {
+            SSLCloseAfterError();
+            return false;
+        }
+        if (early == true && WriteEarlyData(data, length) != static_cast<int32_t>(length)) {
+            SSLCloseAfterError();
+            return false;
+        }
+        if (DoHandshakeSSL() == false) {
+            SSLCloseAfterError();
+            return false;
+        }
+
+        if (early == true && IsEarlyDataAccepted() == true) {
+            LOG_TRACE("SocketSSL.ConnectWithEarlyData [", fd,"]: Early data is accepted by '", exHost, "'.");
+            return true;
+        }
+        // Early data is discarded by server, so the request is sent over the established connection.
+        return Send(data, length);
+    }
+
+
     bool SocketSSL::Send (const char* data, const std::size_t length) noexcept
     {
         if (fd == INVALID_SOCKET || ssl == nullptr || bio == nullptr) {
             LOG_ERROR("SocketSSL.Send: Socket is invalid.");
             SSLCloseAfterError(); return false;
         }
+        // Records are encrypted by the kernel, so the data is sent without copying through OpenSSL.
+        if (IsKernelSendEnabled() == true) { return Socket::Send(data, length); }
         LOG_TRACE("SocketSSL.Send [", fd,"]: Sending data to '", exHost, "'...");
+        StartOperation();
 
         std::size_t idx = 0;
         while (idx != length)
         {
-            const int32_t result = SSL_write(ssl, &data[idx], static_cast<int32_t>(length));
+            const int32_t result = SSL_write(ssl, &data[idx], static_cast<int32_t>(length - idx));
             const std::size_t err = ERR_get_error();
             if (err != 0) {
                 LOG_ERROR("SocketSSL.Send [", fd,"]: In function 'SSL_write' - ", ERR_error_string(err, nullptr));
@@ -116,7 +198,7 @@ namespace analyzer::framework::net
             if (result <= 0)
             {
                 if (BIO_should_retry(bio) != 0) {
-                    if (IsReadyForSend(1500) == false) { SSLCloseAfterError(); return false; }
+                    if (IsReadyForSend(GetWaitingTime()) == false) { SSLCloseAfterError(); return false; }
                     continue;
                 }
                 LOG_ERROR("SocketSSL.Send [", fd,"]: In function 'SSL_write' - ", CheckSSLErrors());
@@ -130,19 +212,163 @@ namespace analyzer::framework::net
     }
 
 
-    int32_t SocketSSL::Recv (char* data, std::size_t length, const bool noWait)
+    // Sending the message which consists of several pieces (pieces are joined into TLS records).
+    bool SocketSSL::SendV (const struct iovec* const vector, const std::size_t count) noexcept
     {
-        using std::chrono::system_clock;
+        if (IsKernelSendEnabled() == true) { return Socket::SendV(vector, count); }
 
+        // Small pieces are joined, so each TLS record is filled up to the maximum size.
+        thread_local auto record = system::allocMemoryForArray<char>(SSL3_RT_MAX_PLAIN_LENGTH);
+        if (record == nullptr) { return false; }
+
+        std::size_t size = 0;
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            const char* data = static_cast<const char*>(vector[idx].iov_base);
+            std::size_t length = vector[idx].iov_len;
+            while (length != 0)
+            {
+                const std::size_t part = std::min<std::size_t>(length, SSL3_RT_MAX_PLAIN_LENGTH - size);
+                memcpy(record.get() + size, data, part);
+                size += part;
+                data += part;
+                length -= part;
+                if (size == SSL3_RT_MAX_PLAIN_LENGTH)
+                {
+                    if (Send(record.get(), size) == false) { return false; }
+                    size = 0;
+                }
+            }
+        }
+        return (size == 0 || Send(record.get(), size) == true);
+    }
+
+
+    // Returns the result of non-blocking SSL operation as the result of Socket operation.
+    static int32_t GetNonBlockingResult (SSL* ssl, const int32_t result) noexcept
+    {
+        switch (SSL_get_error(ssl, result))
+        {
+            case SSL_ERROR_WANT_READ:
+                return SOCKET_WANT_READ;
+            case SSL_ERROR_WANT_WRITE:
+                return SOCKET_WANT_WRITE;
+            case SSL_ERROR_ZERO_RETURN:
+                return 0;
+            default:
+                return SOCKET_ERROR;
+        }
+    }
+
+    // Sending the part of message without waiting.
+    int32_t SocketSSL::TrySend (const char* data, const std::size_t length) noexcept
+    {
+        if (fd == INVALID_SOCKET || ssl == nullptr) { return SOCKET_ERROR; }
+        if (IsKernelSendEnabled() == true) { return Socket::TrySend(data, length); }
+
+        ERR_clear_error();
+        const int32_t result = SSL_write(ssl, data, static_cast<int32_t>(length));
+        if (result > 0) { return result; }
+
+        const int32_t status = GetNonBlockingResult(ssl, result);
+        if (status == SOCKET_ERROR || status == 0) {
+            LOG_ERROR("SocketSSL.TrySend [", fd,"]: In function 'SSL_write' - ", CheckSSLErrors());
+            SSLCloseAfterError();
+            return SOCKET_ERROR;
+        }
+        return status;
+    }
+
+    // Receiving the available data without waiting.
+    int32_t SocketSSL::TryRecv (char* data, const std::size_t length) noexcept
+    {
+        if (fd == INVALID_SOCKET || ssl == nullptr) { return SOCKET_ERROR; }
+
+        ERR_clear_error();
+        const int32_t result = SSL_read(ssl, data, static_cast<int32_t>(length));
+        if (result > 0) { return result; }
+
+        const int32_t status = GetNonBlockingResult(ssl, result);
+        if (status == SOCKET_ERROR) {
+            // Connection which is closed without close_notify is reported as the end of data.
+            if (SSL_get_error(ssl, result) == SSL_ERROR_SYSCALL && ERR_peek_error() == 0) { return 0; }
+            LOG_ERROR("SocketSSL.TryRecv [", fd,"]: In function 'SSL_read' - ", CheckSSLErrors());
+            SSLCloseAfterError();
+        }
+        return status;
+    }
+
+    // Continue the handshake without waiting.
+    int32_t SocketSSL::TryHandshake (void) noexcept
+    {
+        if (fd == INVALID_SOCKET || ssl == nullptr) { return SOCKET_ERROR; }
+
+        ERR_clear_error();
+        const int32_t result = SSL_do_handshake(ssl);
+        if (result == 1) {
+            LOG_TRACE("SocketSSL.TryHandshake [", fd,"]: Handshake to '", exHost, "' is success.");
+            CompleteSession();
+            return SOCKET_SUCCESS;
+        }
+
+        const int32_t status = GetNonBlockingResult(ssl, result);
+        if (status == SOCKET_ERROR || status == 0) {
+            LOG_ERROR("SocketSSL.TryHandshake [", fd,"]: In function 'SSL_do_handshake' - ", CheckSSLErrors());
+            SSLCloseAfterError();
+            return SOCKET_ERROR;
+        }
+        return status;
+    }
+
+    // Sends the data in the first flight of handshake.
+    int32_t SocketSSL::WriteEarlyData (const char* data, const std::size_t length) noexcept
+    {
+        StartOperation();
+
+        std::size_t idx = 0;
+        while (idx != length)
+        {
+            std::size_t written = 0;
+            ERR_clear_error();
+            const int32_t result = SSL_write_early_data(ssl, &data[idx], length - idx, &written);
+            if (result == 1) {
+                idx += written;
+                continue;
+            }
+
+            const int32_t status = GetNonBlockingResult(ssl, result);
+            if (status != SOCKET_WANT_READ && status != SOCKET_WANT_WRITE) {
+                LOG_ERROR("SocketSSL.WriteEarlyData [", fd,"]: In function 'SSL_write_early_data' - ", CheckSSLErrors());
+                return SOCKET_ERROR;
+            }
+            const bool ready = (status == SOCKET_WANT_READ) ? IsReadyForRecv(GetWaitingTime()) : IsReadyForSend(GetWaitingTime());
+            if (ready == false) { return SOCKET_ERROR; }
+        }
+        LOG_TRACE("SocketSSL.WriteEarlyData [", fd,"]: Sending early data to '", exHost, "' is success:  ", idx, " bytes.");
+        return static_cast<int32_t>(idx);
+    }
+
+
+    // Sending the part of file through user space.
+    bool SocketSSL::SendFile (const int32_t file, const off_t offset, const std::size_t length) noexcept
+    {
+        // Kernel encrypts the records of file pages, otherwise the data is encrypted in user space.
+        if (IsKernelSendEnabled() == true) { return Socket::SendFile(file, offset, length); }
+        return SendFileByCopy(file, offset, length);
+    }
+
+
+    int32_t SocketSSL::Recv (char* data, std::size_t length, const bool noWait)
+    {
         if (fd == INVALID_SOCKET || ssl == nullptr || bio == nullptr) {
             LOG_ERROR("SocketSSL: Socket is invalid.");
             SSLCloseAfterError(); return -1;
         }
         LOG_TRACE("SocketSSL.Recv [", fd,"]: Receiving data from '", exHost, "'...");
-        const system_clock::time_point limit = system_clock::now() + GetTimeout();
+        StartOperation();
 
         std::size_t idx = 0;
-        while (length > 0 && system_clock::now() < limit)
+        while (length > 0 && IsOperationExpired() == false)
         {
             const int32_t result = SSL_read(ssl, &data[idx], static_cast<int32_t>(length));
             const std::size_t err = ERR_get_error();
@@ -156,7 +382,7 @@ namespace analyzer::framework::net
             {
                 if (BIO_should_retry(bio) != 0)
                 {
-                    if (IsReadyForRecv(1500) == false) {
+                    if (IsReadyForRecv(GetReceiveWaitingTime()) == false) {
                         if (idx == 0) { SSLCloseAfterError(); return -1; }
                         break;  // In this case no error.
                     }
@@ -178,17 +404,15 @@ namespace analyzer::framework::net
 
     int32_t SocketSSL::RecvToEnd (char* data, std::size_t length) noexcept
     {
-        using std::chrono::system_clock;
-
         if (fd == INVALID_SOCKET || ssl == nullptr || bio == nullptr) {
             LOG_ERROR("SocketSSL.RecvToEnd: Socket is invalid.");
             SSLCloseAfterError(); return -1;
         }
         LOG_TRACE("SocketSSL.RecvToEnd [", fd,"]: Receiving data from '", exHost, "'...");
-        const system_clock::time_point limit = system_clock::now() + GetTimeout();
+        StartOperation();
 
         std::size_t idx = 0;
-        while (length > 0 && IsReadyForRecv(1500) == true && system_clock::now() < limit)
+        while (length > 0 && IsOperationExpired() == false)
         {
             const int32_t result = SSL_read(ssl, &data[idx], static_cast<int32_t>(length));
             const std::size_t err = ERR_get_error();
@@ -198,8 +422,14 @@ namespace analyzer::framework::net
             }
 
             if (result == 0) { break; }
-            if (result < 0) {
-                if (BIO_should_retry(bio) != 0) { continue; }
+            if (result < 0)
+            {
+                // No data was received within the waiting time.
+                if (BIO_should_retry(bio) != 0)
+                {
+                    if (IsReadyForRecv(GetReceiveWaitingTime()) == false) { break; }
+                    continue;
+                }
                 LOG_ERROR("SocketSSL.RecvToEnd [", fd,"]: In function 'SSL_read' - ", CheckSSLErrors());
                 CloseAfterError(); return -1;
             }
@@ -221,6 +451,7 @@ namespace analyzer::framework::net
             return false;
         }
         LOG_TRACE("SocketSSL.DoHandshakeSSL [", fd,"]: Doing handshake...");
+        StartOperation();
 
         while (true)
         {
@@ -233,12 +464,16 @@ namespace analyzer::framework::net
 
             if (result == 1) {
                 LOG_TRACE("SocketSSL.DoHandshakeSSL [", fd,"]: Handshake to '", exHost, "' is success.");
+                CompleteSession();
                 return true;
             }
             if (result <= 0)
             {
-                if (BIO_should_retry(bio) != 0) {
-                    if (IsReadyForSend(1500) == false) { SSLCloseAfterError(); break; }
+                if (BIO_should_retry(bio) != 0)
+                {
+                    // Handshake waits for the socket operation which would block.
+                    const bool ready = (SSL_want_read(ssl) != 0) ? IsReadyForRecv(GetWaitingTime()) : IsReadyForSend(GetWaitingTime());
+                    if (ready == false) { SSLCloseAfterError(); break; }
                     continue;
                 }
                 LOG_ERROR("SocketSSL.DoHandshakeSSL [", fd,"]: Handshake failed - ", CheckSSLErrors());
@@ -261,6 +496,72 @@ namespace analyzer::framework::net
     }
 
 
+    bool SocketSSL::ResumeSession (const char* host, const uint16_t port) noexcept
+    {
+        if (ssl == nullptr || host == nullptr) { return false; }
+
+        // Server name is a part of key, because the server may issue different sessions for different names.
+        const char* name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+        sessionKey = SSLSessionCache::MakeKey(host, port, (name != nullptr) ? name : "", profileKey);
+        sessionOffered = false;
+
+        SSL_SESSION* session = SSLSessionCache::Instance().Find(sessionKey);
+        if (session == nullptr) { return false; }
+        const int32_t result = SSL_set_session(ssl, session);
+        SSL_SESSION_free(session);
+        if (result != 1) {
+            LOG_WARNING("SocketSSL.ResumeSession [", fd,"]: In function 'SSL_set_session' - ", CheckSSLErrors());
+            return false;
+        }
+        LOG_TRACE("SocketSSL.ResumeSession [", fd,"]: Cached session of '", host, "' is offered.");
+        sessionOffered = true;
+        return true;
+    }
+
+    bool SocketSSL::EnableKernelTLS (void) noexcept
+    {
+        if (ssl == nullptr) { return false; }
+#if (defined(OPENSSL_VERSION_NUMBER) && OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS))  // If OPENSSL version 3.0 or more with KTLS.
+        // OpenSSL installs the keys by setsockopt(TLS_TX/TLS_RX) after the handshake and ignores the errors of kernel.
+        SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+        return true;
+#else
+        LOG_WARNING("SocketSSL.EnableKernelTLS [", fd,"]: OpenSSL library is built without kTLS.");
+        return false;
+#endif
+    }
+
+    // Return true if the sent records are encrypted by the kernel.
+    bool SocketSSL::IsKernelSendEnabled (void) const noexcept
+    {
+#if (defined(OPENSSL_VERSION_NUMBER) && OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS))  // If OPENSSL version 3.0 or more with KTLS.
+        return (ssl != nullptr && BIO_get_ktls_send(SSL_get_wbio(ssl)) != 0);
+#else
+        return false;
+#endif
+    }
+
+
+    // Saves the new session or ticket in SSLSessionCache.
+    int32_t SocketSSL::StoreSession (SSL* ssl, SSL_SESSION* session) noexcept
+    {
+        // Application data of SSL object is the key of session (SocketSSL and TlsEngine).
+        const auto* key = static_cast<const std::string*>(SSL_get_app_data(ssl));
+        if (key == nullptr || key->empty() == true || SSL_SESSION_is_resumable(session) == 0) { return 0; }
+        // Cache holds the reference of session.
+        SSLSessionCache::Instance().Store(*key, session);
+        return 1;
+    }
+
+    // Updates the counters of SSLSessionCache after handshake.
+    void SocketSSL::CompleteSession (void) noexcept
+    {
+        if (sessionOffered == false) { return; }
+        sessionOffered = false;
+        SSLSessionCache::Instance().Complete(IsSessionReused());
+    }
+
+
     std::vector<std::string> SocketSSL::GetCiphersList(void) const noexcept
     {
         std::vector<std::string> result;
@@ -342,10 +643,20 @@ namespace analyzer::framework::net
     // Close connection.
     void SocketSSL::Close(void)
     {
-        if (ssl != nullptr) { SSL_free(ssl); ssl = nullptr; }
+        CloseSSL();
         Socket::Close();
     }
 
+    // Send close_notify alert and free the SSL object.
+    void SocketSSL::CloseSSL (void) noexcept
+    {
+        if (ssl == nullptr) { return; }
+        // OpenSSL invalidates the session of connection which is closed without close_notify, so it could not be resumed.
+        if (IsHandshakeReady() == true && SSL_shutdown(ssl) < 0) { ERR_clear_error(); }
+        SSL_free(ssl);
+        ssl = nullptr;
+    }
+
     // Returns true when the handshake is complete.
     bool SocketSSL::IsHandshakeReady(void) const
     {
@@ -437,6 +748,21 @@ namespace analyzer::framework::net
     }
 
 
+    // Check that the idle connection is alive and there is no unread application data.
+    bool SocketSSL::IsReusable(void) noexcept
+    {
+        if (ssl == nullptr || IsAlive() == false) { return false; }
+
+        // Service records (for example, session tickets) are processed, but the application data is left in the buffer.
+        char byte = 0;
+        const int32_t result = SSL_peek(ssl, &byte, 1);
+        if (result > 0) { return false; }
+        const int32_t error = SSL_get_error(ssl, result);
+        ERR_clear_error();
+        return (error == SSL_ERROR_WANT_READ);
+    }
+
+
     // Get selected cipher name in ssl connection.
     std::string SocketSSL::GetSelectedCipherName(void) const noexcept
     {
@@ -456,7 +782,7 @@ namespace analyzer::framework::net
     // Destructor.
     SocketSSL::~SocketSSL(void)
     {
-        if (ssl != nullptr) { SSL_free(ssl); ssl = nullptr; }
+        CloseSSL();
         Socket::Close();
     }
 
@@ -476,20 +802,16 @@ namespace analyzer::framework::net
         OpenSSL_add_all_digests();
         OpenSSL_add_all_algorithms();
 
-        ctx[SSL_METHOD_TLS1] = SSL_CTX_new( TLSv1_client_method() );
-        if (ctx[SSL_METHOD_TLS1] == nullptr) {
-            LOG_FATAL("SSLContext: In function 'SSL_CTX_new (TLSv1.0)' - ", CheckSSLErrors());
-            std::terminate();
-        }
-        ctx[SSL_METHOD_TLS11] = SSL_CTX_new( TLSv1_1_client_method() );
-        if (ctx[SSL_METHOD_TLS11] == nullptr) {
-            LOG_FATAL("SSLContext: In function 'SSL_CTX_new (TLSv1.1)' - ", CheckSSLErrors());
-            std::terminate();
-        }
-        ctx[SSL_METHOD_TLS12] = SSL_CTX_new( TLSv1_2_client_method() );
-        if (ctx[SSL_METHOD_TLS12] == nullptr) {
-            LOG_FATAL("SSLContext: In function 'SSL_CTX_new (TLSv1.2)' - ", CheckSSLErrors());
-            std::terminate();
+        // Each context is pinned to one version, so the method of socket defines the version of protocol.
+        for (uint16_t idx = 0; idx < NUMBER_OF_CTX; ++idx)
+        {
+            SSLContextProfile profile;
+            profile.minimum = profile.maximum = idx;
+            ctx[idx] = SSLContextCache::Instance().Acquire(profile);
+            if (ctx[idx] == nullptr) {
+                LOG_FATAL("SSLContext: Cannot create the context of method ", idx, '.');
+                std::terminate();
+            }
         }
         LOG_INFO("SSLContext: Initialize SSL library is success.");
     }
@@ -502,12 +824,321 @@ namespace analyzer::framework::net
 
     SSLContext::~SSLContext(void) noexcept
     {
-        SSL_CTX_free( ctx[SSL_METHOD_TLS1] );
-        SSL_CTX_free( ctx[SSL_METHOD_TLS11] );
-        SSL_CTX_free( ctx[SSL_METHOD_TLS12] );
-        //SSL_CTX_free( ctx[SSL_METHOD_TLS13] );
+        for (SSL_CTX* item : ctx) {
+            SSL_CTX_free(item);
+        }
+    }
+
+
+    bool SSLContextProfile::LoadDefinition (std::string_view path) noexcept
+    {
+        using parser::JsonValue;
+        using parser::JsonParser;
+
+        const auto definition = JsonParser::ParseFile(path);
+        if (definition.has_value() == false) {
+            LOG_ERROR("SSLContextProfile.LoadDefinition: Cannot parse the protocol definition file '", path, "'.");
+            return false;
+        }
+        const JsonValue* const options = definition->FindByPath("Protocol.NetworkSettings.Global.SSLOptions");
+        if (options == nullptr) {
+            LOG_WARNING("SSLContextProfile.LoadDefinition: There are no SSL options in the protocol definition file '", path, "'.");
+            return false;
+        }
+        const auto getString = [options] (const char* name) noexcept -> std::string_view {
+            const JsonValue* const value = options->Find(name);
+            return (value != nullptr && value->AsString().has_value() == true) ? *value->AsString() : std::string_view();
+        };
+
+        const std::string_view version = getString("Version");
+        if (version.empty() == true || version == "auto") {
+            minimum = SSL_METHOD_TLS1;
+            maximum = SSL_METHOD_TLS13;
+        }
+        else
+        {
+            const std::pair<std::string_view, uint16_t> versions[] = {
+                { "tls1.0", SSL_METHOD_TLS1 }, { "tls1.1", SSL_METHOD_TLS11 }, { "tls1.2", SSL_METHOD_TLS12 }, { "tls1.3", SSL_METHOD_TLS13 }
+            };
+            const auto it = std::find_if(std::begin(versions), std::end(versions), [version] (const auto& item) { return item.first == version; });
+            if (it == std::end(versions)) {
+                LOG_ERROR("SSLContextProfile.LoadDefinition: Unknown version of protocol '", version, "'.");
+                return false;
+            }
+            minimum = maximum = it->second;
+        }
+
+        // Excluded masks are removed from the default list of ciphers.
+        ciphers.clear();
+        for (const char* name : { "CipherExclusionsByMask", "HashExclusionsByMask", "PKIExclusionsByMask" })
+        {
+            for (const std::string_view mask : common::text::splitInPlace(getString(name), ';')) {
+                if (mask.empty() == false) { ciphers.append(":!").append(mask); }
+            }
+        }
+        if (ciphers.empty() == false) { ciphers.insert(0, "DEFAULT"); }
+
+        certificate = getString("SSLClientCertificatePath");
+        LOG_INFO("SSLContextProfile.LoadDefinition: SSL options are read from '", path, "'.");
+        return true;
+    }
+
+
+    // Method that returns the instance of the SSL context cache singleton class.
+    SSLContextCache& SSLContextCache::Instance (void) noexcept
+    {
+        static SSLContextCache instance;
+        return instance;
+    }
+
+    // Returns the key of profile in cache.
+    std::string SSLContextCache::MakeKey (const SSLContextProfile& profile) noexcept
+    {
+        std::string key = std::to_string(profile.minimum);
+        key.push_back('-');
+        key.append(std::to_string(profile.maximum)).push_back('/');
+        key.append(profile.ciphers).push_back('\0');
+        key.append(profile.protocols).push_back('\0');
+        key.push_back((profile.verify == true) ? '1' : '0');
+        key.append(profile.certificate);
+        return key;
+    }
+
+    // Creates the context of profile.
+    SSL_CTX* SSLContextCache::Create (const SSLContextProfile& profile) noexcept
+    {
+        const int32_t versions[NUMBER_OF_CTX] = { TLS1_VERSION, TLS1_1_VERSION, TLS1_2_VERSION, TLS1_3_VERSION };
+        if (profile.minimum > profile.maximum || profile.maximum >= NUMBER_OF_CTX) {
+            LOG_ERROR("SSLContextCache.Create: Range of protocol versions is invalid.");
+            return nullptr;
+        }
+
+        SSL_CTX* ctx = SSL_CTX_new( TLS_client_method() );
+        if (ctx == nullptr) {
+            LOG_ERROR("SSLContextCache.Create: In function 'SSL_CTX_new' - ", CheckSSLErrors());
+            return nullptr;
+        }
+
+        const char* function = nullptr;
+        if (SSL_CTX_set_min_proto_version(ctx, versions[profile.minimum]) != 1 || SSL_CTX_set_max_proto_version(ctx, versions[profile.maximum]) != 1) {
+            function = "SSL_CTX_set_proto_version";
+        }
+        else if (profile.ciphers.empty() == false && SSL_CTX_set_cipher_list(ctx, profile.ciphers.c_str()) == 0) {
+            function = "SSL_CTX_set_cipher_list";
+        }
+        else if (profile.protocols.empty() == false &&
+                 SSL_CTX_set_alpn_protos(ctx, reinterpret_cast<const unsigned char*>(profile.protocols.data()), static_cast<uint32_t>(profile.protocols.size())) != 0) {
+            function = "SSL_CTX_set_alpn_protos";
+        }
+        else if (profile.verify == true && SSL_CTX_set_default_verify_paths(ctx) != 1) {
+            function = "SSL_CTX_set_default_verify_paths";
+        }
+        else if (profile.certificate.empty() == false && (SSL_CTX_use_certificate_chain_file(ctx, profile.certificate.c_str()) != 1 ||
+                 SSL_CTX_use_PrivateKey_file(ctx, profile.certificate.c_str(), SSL_FILETYPE_PEM) != 1 || SSL_CTX_check_private_key(ctx) != 1)) {
+            function = "SSL_CTX_use_certificate_chain_file";
+        }
+        if (function != nullptr) {
+            LOG_ERROR("SSLContextCache.Create: In function '", function, "' - ", CheckSSLErrors());
+            SSL_CTX_free(ctx);
+            return nullptr;
+        }
+
+        if (profile.verify == true) { SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr); }
+        // Client sessions are saved only in SSLSessionCache.
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, SocketSSL::StoreSession);
+        return ctx;
+    }
+
+    SSL_CTX* SSLContextCache::Acquire (const SSLContextProfile& profile) noexcept
+    {
+        const std::string key = MakeKey(profile);
+        system::LockGuard lock(mutex);
+
+        auto it = contexts.find(key);
+        if (it == contexts.end())
+        {
+            // Context is created under mutex, so concurrent connections of the new profile do not build it twice.
+            SSL_CTX* ctx = Create(profile);
+            if (ctx == nullptr) { return nullptr; }
+            it = contexts.emplace(key, ctx).first;
+            LOG_TRACE("SSLContextCache.Acquire: New context is created (total: ", contexts.size(), ").");
+        }
+        (void)SSL_CTX_up_ref(it->second);
+        return it->second;
+    }
+
+    // Return the number of contexts in cache.
+    std::size_t SSLContextCache::Size (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return contexts.size();
+    }
+
+    // Release the references of cache.
+    void SSLContextCache::Clear (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        for (const auto& [key, ctx] : contexts) {
+            SSL_CTX_free(ctx);
+        }
+        contexts.clear();
+    }
+
+    SSLContextCache::~SSLContextCache (void) noexcept
+    {
+        Clear();
+    }
+
+
+    // Method that returns the instance of the SSL session cache singleton class.
+    SSLSessionCache& SSLSessionCache::Instance (void) noexcept
+    {
+        static SSLSessionCache instance;
+        return instance;
     }
 
+    // Returns the key of session in cache.
+    std::string SSLSessionCache::MakeKey (std::string_view host, const uint16_t port, std::string_view serverName, std::string_view profile) noexcept
+    {
+        std::string key(host);
+        key.push_back('\0');
+        key.append(std::to_string(port)).push_back('\0');
+        key.append(serverName).push_back('\0');
+        key.append(profile);
+        return key;
+    }
+
+    // Returns the key of session in cache for the default profile of method.
+    std::string SSLSessionCache::MakeKey (std::string_view host, const uint16_t port, std::string_view serverName, const uint16_t method) noexcept
+    {
+        SSLContextProfile profile;
+        profile.minimum = profile.maximum = method;
+        return MakeKey(host, port, serverName, SSLContextCache::MakeKey(profile));
+    }
+
+    // Returns true if the session can not be resumed anymore.
+    static bool IsSessionExpired (const SSL_SESSION* session, const time_t now) noexcept
+    {
+        return (SSL_SESSION_is_resumable(session) == 0 || SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) <= now);
+    }
+
+    SSL_SESSION* SSLSessionCache::Find (const std::string& key) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = sessions.find(key);
+        if (it == sessions.end())
+        {
+            statistics.misses++;
+            return nullptr;
+        }
+
+        SSL_SESSION* session = it->second;
+        if (IsSessionExpired(session, time(nullptr)) == true)
+        {
+            SSL_SESSION_free(session);
+            sessions.erase(it);
+            statistics.misses++;
+            return nullptr;
+        }
+
+        statistics.hits++;
+        // Reference of single-use ticket is passed to the caller.
+        if (SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION) { sessions.erase(it); }
+        else { SSL_SESSION_up_ref(session); }
+        return session;
+    }
+
+    void SSLSessionCache::Store (const std::string& key, SSL_SESSION* session) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = sessions.find(key);
+        if (it != sessions.end())
+        {
+            SSL_SESSION_free(it->second);
+            it->second = session;
+        }
+        else
+        {
+            if (sessions.size() >= MAXIMUM_SSL_SESSIONS) { Shrink(); }
+            try { sessions.emplace(key, session); }
+            catch (const std::bad_alloc& /*err*/) {
+                SSL_SESSION_free(session);
+                return;
+            }
+        }
+        statistics.stored++;
+    }
+
+    // Removes the expired sessions if the cache is full (must be called under mutex).
+    void SSLSessionCache::Shrink (void) noexcept
+    {
+        const time_t now = time(nullptr);
+        for (auto it = sessions.begin(); it != sessions.end(); )
+        {
+            if (IsSessionExpired(it->second, now) == true)
+            {
+                SSL_SESSION_free(it->second);
+                it = sessions.erase(it);
+            }
+            else { ++it; }
+        }
+        // If all sessions are valid, then any one of them is removed.
+        if (sessions.size() >= MAXIMUM_SSL_SESSIONS)
+        {
+            SSL_SESSION_free(sessions.begin()->second);
+            sessions.erase(sessions.begin());
+        }
+    }
+
+    // Update the counters by the result of handshake with the offered session.
+    void SSLSessionCache::Complete (const bool reused) noexcept
+    {
+        system::LockGuard lock(mutex);
+        if (reused == true) { statistics.resumed++; }
+        else { statistics.rejected++; }
+    }
+
+    // Remove the session of key.
+    void SSLSessionCache::Remove (const std::string& key) noexcept
+    {
+        system::LockGuard lock(mutex);
+        const auto it = sessions.find(key);
+        if (it != sessions.end())
+        {
+            SSL_SESSION_free(it->second);
+            sessions.erase(it);
+        }
+    }
+
+    // Return the counters of cache.
+    SSLSessionStatistics SSLSessionCache::GetStatistics (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return statistics;
+    }
+
+    // Return the number of sessions in cache.
+    std::size_t SSLSessionCache::Size (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        return sessions.size();
+    }
+
+    // Remove all sessions from cache.
+    void SSLSessionCache::Clear (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        for (auto&& [key, session] : sessions) { SSL_SESSION_free(session); }
+        sessions.clear();
+    }
+
+    SSLSessionCache::~SSLSessionCache (void) noexcept
+    {
+        Clear();
+    }
+
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wglobal-constructors"
 
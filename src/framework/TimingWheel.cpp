@@ -0,0 +1,231 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <limits>
+#include <algorithm>
+
+#include "../../include/framework/TimingWheel.hpp"
+
+
+namespace analyzer::framework::net
+{
+    static constexpr uint64_t SLOT_MASK = TIMING_WHEEL_SLOTS - 1;
+    // Maximum distance between the current tick and the expiration.
+    static constexpr uint64_t MAXIMUM_DELTA = (1ULL << (TIMING_WHEEL_SLOT_BITS * TIMING_WHEEL_LEVELS)) - 1;
+
+    // Cancel the timer if it is armed.
+    void WheelTimer::Cancel (void) noexcept
+    {
+        TimingWheel* const owner = wheel.load(std::memory_order_acquire);
+        if (owner != nullptr) { owner->Cancel(*this); }
+    }
+
+    // Return the time in milliseconds until expiration (zero if timer is not armed).
+    int32_t WheelTimer::GetTimeLeft (void) const noexcept
+    {
+        const TimingWheel* const owner = wheel.load(std::memory_order_acquire);
+        return (owner != nullptr) ? owner->GetTimeLeft(*this) : 0;
+    }
+
+
+    // Add the timer to the slot which corresponds to its expiration.
+    void TimingWheel::Insert (WheelTimer& timer) noexcept
+    {
+        const uint64_t delta = timer.expiry - current;
+        std::size_t level = 0;
+        while (level + 1 < TIMING_WHEEL_LEVELS && delta >= (1ULL << (TIMING_WHEEL_SLOT_BITS * (level + 1)))) { level++; }
+
+        const std::size_t index = (timer.expiry >> (TIMING_WHEEL_SLOT_BITS * level)) & SLOT_MASK;
+        WheelTimer*& head = slots[level][index];
+        timer.prev = nullptr;
+        timer.next = head;
+        if (head != nullptr) { head->prev = &timer; }
+        head = &timer;
+
+        timer.slot = level * TIMING_WHEEL_SLOTS + index;
+        occupied[level][index / 64] |= (1ULL << (index % 64));
+        levels[level]++;
+    }
+
+    // Remove the timer from its slot.
+    void TimingWheel::Remove (WheelTimer& timer) noexcept
+    {
+        const std::size_t level = timer.slot / TIMING_WHEEL_SLOTS;
+        const std::size_t index = timer.slot % TIMING_WHEEL_SLOTS;
+        if (timer.prev != nullptr) { timer.prev->next = timer.next; }
+        else { slots[level][index] = timer.next; }
+        if (timer.next != nullptr) { timer.next->prev = timer.prev; }
+        timer.prev = timer.next = nullptr;
+
+        if (slots[level][index] == nullptr) { occupied[level][index / 64] &= ~(1ULL << (index % 64)); }
+        levels[level]--;
+    }
+
+    // Return the index of the first non-empty slot of level starting from the index (TIMING_WHEEL_SLOTS if all slots are empty).
+    std::size_t TimingWheel::FindSlot (const std::size_t level, const std::size_t index) const noexcept
+    {
+        // Slots are checked cyclically, so the index after the last slot is the first slot.
+        for (std::size_t idx = 0; idx <= TIMING_WHEEL_SLOTS / 64; ++idx)
+        {
+            const std::size_t word = (index / 64 + idx) % (TIMING_WHEEL_SLOTS / 64);
+            uint64_t bits = occupied[level][word];
+            if (idx == 0) { bits &= ~0ULL << (index % 64); }
+            else if (idx == TIMING_WHEEL_SLOTS / 64) { bits &= ~(~0ULL << (index % 64)); }
+            if (bits != 0) { return word * 64 + static_cast<std::size_t>(__builtin_ctzll(bits)); }
+        }
+        return TIMING_WHEEL_SLOTS;
+    }
+
+    // Return the nearest tick after the current tick when any slot must be processed (zero if there are no timers).
+    uint64_t TimingWheel::GetNextTick (void) const noexcept
+    {
+        uint64_t next = std::numeric_limits<uint64_t>::max();
+        for (std::size_t level = 0; level < TIMING_WHEEL_LEVELS; ++level)
+        {
+            if (levels[level] == 0) { continue; }
+
+            // Slot of level is processed when the tick reaches the beginning of its range.
+            const std::size_t shift = TIMING_WHEEL_SLOT_BITS * level;
+            const uint64_t start = (current >> shift) + 1;
+            const std::size_t index = FindSlot(level, start & SLOT_MASK);
+            const uint64_t offset = (index - start) & SLOT_MASK;
+            next = std::min(next, (start + offset) << shift);
+        }
+        return (next == std::numeric_limits<uint64_t>::max()) ? 0 : next;
+    }
+
+    void TimingWheel::Arm (WheelTimer& timer, const std::chrono::milliseconds delay) noexcept
+    {
+        timer.Cancel();
+
+        system::LockGuard lock(mutex);
+        const auto expiration = std::chrono::steady_clock::now() - origin + std::max(delay, std::chrono::milliseconds(0));
+        const auto tick = static_cast<uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(expiration).count());
+        // The slot of the current tick is already processed.
+        timer.expiry = std::clamp(tick, current + 1, current + MAXIMUM_DELTA);
+        timer.wheel = this;
+        Insert(timer);
+    }
+
+    // Cancel the timer if it is armed in this wheel.
+    void TimingWheel::Cancel (WheelTimer& timer) noexcept
+    {
+        system::LockGuard lock(mutex);
+        if (timer.wheel != this) { return; }
+        Remove(timer);
+        timer.wheel = nullptr;
+    }
+
+    std::size_t TimingWheel::Advance (void) noexcept
+    {
+        const uint64_t target = GetTick();
+        std::size_t expired = 0;
+        (void)mutex.Lock();
+        while (current < target)
+        {
+            // Ticks without any slots for processing are skipped.
+            const uint64_t next = GetNextTick();
+            if (next == 0 || next > target)
+            {
+                current = target;
+                break;
+            }
+            current = next;
+
+            // Timers of upper levels are moved to lower levels from the top, so they can reach the slot of the current tick.
+            for (std::size_t level = TIMING_WHEEL_LEVELS - 1; level > 0; --level)
+            {
+                const std::size_t shift = TIMING_WHEEL_SLOT_BITS * level;
+                if ((current & ((1ULL << shift) - 1)) != 0) { continue; }
+
+                WheelTimer** head = &slots[level][(current >> shift) & SLOT_MASK];
+                while (*head != nullptr)
+                {
+                    WheelTimer* timer = *head;
+                    Remove(*timer);
+                    Insert(*timer);
+                }
+            }
+
+            WheelTimer** head = &slots[0][current & SLOT_MASK];
+            while (*head != nullptr)
+            {
+                WheelTimer* timer = *head;
+                Remove(*timer);
+                timer->wheel = nullptr;
+                expired++;
+
+                // Handler is called without lock, so it may arm and cancel timers (including this timer).
+                const TimerHandler handler = timer->handler;
+                void* const context = timer->context;
+                if (handler != nullptr)
+                {
+                    (void)mutex.Unlock();
+                    handler(context);
+                    (void)mutex.Lock();
+                }
+            }
+        }
+        (void)mutex.Unlock();
+        return expired;
+    }
+
+    int32_t TimingWheel::GetWaitingTime (const int32_t time) const noexcept
+    {
+        system::LockGuard lock(mutex);
+        const uint64_t next = GetNextTick();
+        if (next == 0) { return time; }
+
+        const uint64_t now = GetTick();
+        const uint64_t left = std::min<uint64_t>((next > now) ? next - now : 0, std::numeric_limits<int32_t>::max());
+        return (time < 0 || left < static_cast<uint64_t>(time)) ? static_cast<int32_t>(left) : time;
+    }
+
+    // Return the time in milliseconds until expiration of the timer (zero if timer is not armed in this wheel).
+    int32_t TimingWheel::GetTimeLeft (const WheelTimer& timer) const noexcept
+    {
+        system::LockGuard lock(mutex);
+        if (timer.wheel != this) { return 0; }
+
+        const uint64_t now = GetTick();
+        return static_cast<int32_t>(std::min<uint64_t>((timer.expiry > now) ? timer.expiry - now : 0, std::numeric_limits<int32_t>::max()));
+    }
+
+    // Return the current tick of the monotonic clock.
+    uint64_t TimingWheel::GetTick (void) const noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - origin).count());
+    }
+
+    // Return the number of armed timers.
+    std::size_t TimingWheel::Size (void) const noexcept
+    {
+        system::LockGuard lock(mutex);
+        std::size_t count = 0;
+        for (const std::size_t number : levels) { count += number; }
+        return count;
+    }
+
+    TimingWheel::~TimingWheel (void) noexcept
+    {
+        system::LockGuard lock(mutex);
+        for (auto& level : slots)
+        {
+            for (WheelTimer*& head : level)
+            {
+                while (head != nullptr)
+                {
+                    WheelTimer* const timer = head;
+                    Remove(*timer);
+                    timer->wheel = nullptr;
+                }
+            }
+        }
+    }
+
+}  // namespace net.
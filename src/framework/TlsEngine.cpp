@@ -0,0 +1,289 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include "../../include/framework/TlsEngine.hpp"
+
+
+namespace analyzer::framework::net
+{
+    // Returns the SSL library error in string form.
+    static std::string CheckSSLErrors (void) noexcept
+    {
+        const std::size_t err = ERR_get_error();
+        if (err != 0) { return ERR_error_string(err, nullptr); }
+        return std::string("NO ANY ERROR.");
+    }
+
+
+    TlsEngine::TlsEngine (const uint16_t method) noexcept
+            : method(method)
+    {
+        SSL_CTX* ctx = SocketSSL::GetContextSSL(method);
+        if (ctx == nullptr) {
+            LOG_ERROR("TlsEngine.TlsEngine: SSL input protocol type is invalid.");
+            return;
+        }
+        Initialize(ctx, false);
+    }
+
+    TlsEngine::TlsEngine (SSL_CTX* ctx, const bool server) noexcept
+    {
+        if (ctx == nullptr) {
+            LOG_ERROR("TlsEngine.TlsEngine: SSL context is invalid.");
+            return;
+        }
+        Initialize(ctx, server);
+    }
+
+    // Creates the SSL object with the pair of memory BIOs.
+    void TlsEngine::Initialize (SSL_CTX* ctx, const bool server) noexcept
+    {
+        ssl = SSL_new(ctx);
+        input = BIO_new(BIO_s_mem());
+        output = BIO_new(BIO_s_mem());
+        if (ssl == nullptr || input == nullptr || output == nullptr) {
+            LOG_ERROR("TlsEngine.Initialize: In function 'SSL_new' or 'BIO_new' - ", CheckSSLErrors());
+            BIO_free(input);
+            BIO_free(output);
+            SSL_free(ssl);
+            ssl = nullptr;
+            input = output = nullptr;
+            return;
+        }
+
+        // Empty input means that the engine waits for data, but not the end of stream.
+        BIO_set_mem_eof_return(input, -1);
+        BIO_set_mem_eof_return(output, -1);
+        // Both BIOs are owned by SSL object.
+        SSL_set_bio(ssl, input, output);
+        // Key of session is found by SSL object in the callback of new session.
+        SSL_set_app_data(ssl, &sessionKey);
+
+        if (server == true) { SSL_set_accept_state(ssl); }
+        else { SSL_set_connect_state(ssl); }
+    }
+
+
+    // Returns the result of SSL operation as the result of non-blocking socket operation.
+    int32_t TlsEngine::GetResult (const int32_t result, const char* function) noexcept
+    {
+        switch (SSL_get_error(ssl, result))
+        {
+            case SSL_ERROR_WANT_READ:
+                return SOCKET_WANT_READ;
+            case SSL_ERROR_WANT_WRITE:
+                return SOCKET_WANT_WRITE;
+            case SSL_ERROR_ZERO_RETURN:
+                return 0;
+            default:
+                LOG_ERROR("TlsEngine: In function '", function, "' - ", CheckSSLErrors());
+                return SOCKET_ERROR;
+        }
+    }
+
+
+    // Set Server Name Indication to TLS extension.
+    bool TlsEngine::SetServerNameIndication (const std::string& serverName) const noexcept
+    {
+        if (ssl == nullptr || SSL_set_tlsext_host_name(ssl, const_cast<char*>(serverName.c_str())) == 0) {
+            LOG_ERROR("TlsEngine.SetServerNameIndication: In function 'SSL_set_tlsext_host_name' - ", CheckSSLErrors());
+            return false;
+        }
+        return true;
+    }
+
+
+    bool TlsEngine::ResumeSession (const char* host, const uint16_t port) noexcept
+    {
+        if (ssl == nullptr || host == nullptr || method >= NUMBER_OF_CTX) { return false; }
+
+        const char* name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+        sessionKey = SSLSessionCache::MakeKey(host, port, (name != nullptr) ? name : "", method);
+        sessionOffered = false;
+
+        SSL_SESSION* session = SSLSessionCache::Instance().Find(sessionKey);
+        if (session == nullptr) { return false; }
+        const int32_t result = SSL_set_session(ssl, session);
+        SSL_SESSION_free(session);
+        if (result != 1) {
+            LOG_WARNING("TlsEngine.ResumeSession: In function 'SSL_set_session' - ", CheckSSLErrors());
+            return false;
+        }
+        sessionOffered = true;
+        return true;
+    }
+
+
+    int32_t TlsEngine::Handshake (void) noexcept
+    {
+        if (ssl == nullptr) { return SOCKET_ERROR; }
+
+        ERR_clear_error();
+        const int32_t result = SSL_do_handshake(ssl);
+        if (result == 1)
+        {
+            if (sessionOffered == true) {
+                sessionOffered = false;
+                SSLSessionCache::Instance().Complete(IsSessionReused());
+            }
+            return SOCKET_SUCCESS;
+        }
+
+        const int32_t status = GetResult(result, "SSL_do_handshake");
+        return (status == 0) ? SOCKET_ERROR : status;
+    }
+
+
+    int32_t TlsEngine::Write (const char* data, const std::size_t length) noexcept
+    {
+        if (ssl == nullptr) { return SOCKET_ERROR; }
+        if (length == 0) { return 0; }
+
+        ERR_clear_error();
+        // Memory BIO is not limited, so the data is encrypted entirely by one call.
+        const int32_t result = SSL_write(ssl, data, static_cast<int32_t>(length));
+        if (result > 0) { return result; }
+
+        const int32_t status = GetResult(result, "SSL_write");
+        return (status == 0) ? SOCKET_ERROR : status;
+    }
+
+
+    int32_t TlsEngine::Read (char* data, const std::size_t length) noexcept
+    {
+        if (ssl == nullptr) { return SOCKET_ERROR; }
+
+        ERR_clear_error();
+        const int32_t result = SSL_read(ssl, data, static_cast<int32_t>(length));
+        if (result > 0) { return result; }
+        return GetResult(result, "SSL_read");
+    }
+
+    // Decrypt all available records into the buffer.
+    int32_t TlsEngine::Read (ReceiveBuffer& buffer) noexcept
+    {
+        while (true)
+        {
+            const auto [space, size] = buffer.Prepare();
+            if (space == nullptr) { return SOCKET_ERROR; }
+
+            const int32_t result = Read(space, size);
+            if (result <= 0) { return result; }
+            buffer.Commit(static_cast<std::size_t>(result));
+        }
+    }
+
+
+    // Append the encrypted input which is received from the peer.
+    bool TlsEngine::Feed (const char* data, const std::size_t length) noexcept
+    {
+        if (ssl == nullptr) { return false; }
+        if (length != 0 && BIO_write(input, data, static_cast<int32_t>(length)) != static_cast<int32_t>(length)) {
+            LOG_ERROR("TlsEngine.Feed: In function 'BIO_write' - ", CheckSSLErrors());
+            return false;
+        }
+        return true;
+    }
+
+    // Append and consume all encrypted input of the buffer.
+    bool TlsEngine::Feed (ReceiveBuffer& buffer) noexcept
+    {
+        struct iovec spans[16];
+        while (buffer.Empty() == false)
+        {
+            const std::size_t count = buffer.Spans(spans, sizeof(spans) / sizeof(spans[0]));
+            std::size_t length = 0;
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                if (Feed(static_cast<const char*>(spans[idx].iov_base), spans[idx].iov_len) == false) { return false; }
+                length += spans[idx].iov_len;
+            }
+            buffer.Consume(length);
+        }
+        return true;
+    }
+
+
+    ReceiveBuffer& TlsEngine::GetOutput (void) noexcept
+    {
+        if (ssl == nullptr) { return pending; }
+
+        // Records are moved from BIO to the chunks of buffer, so the memory of BIO does not grow.
+        while (BIO_ctrl_pending(output) != 0)
+        {
+            const auto [space, size] = pending.Prepare();
+            if (space == nullptr) { break; }
+
+            const int32_t result = BIO_read(output, space, static_cast<int32_t>(size));
+            if (result <= 0) { break; }
+            pending.Commit(static_cast<std::size_t>(result));
+        }
+        return pending;
+    }
+
+    // Return the number of bytes of encrypted output.
+    std::size_t TlsEngine::PendingOutput (void) const noexcept
+    {
+        if (ssl == nullptr) { return pending.Size(); }
+        return pending.Size() + BIO_ctrl_pending(output);
+    }
+
+
+    int32_t TlsEngine::Transmit (Socket& socket) noexcept
+    {
+        ReceiveBuffer& buffer = GetOutput();
+        std::size_t sent = 0;
+        while (buffer.Empty() == false)
+        {
+            const std::string_view front = buffer.Front();
+            const int32_t result = socket.TrySend(front.data(), front.size());
+            if (result == SOCKET_WANT_WRITE || result == SOCKET_WANT_READ) { return SOCKET_WANT_WRITE; }
+            if (result <= 0) { return SOCKET_ERROR; }
+
+            buffer.Consume(static_cast<std::size_t>(result));
+            sent += static_cast<std::size_t>(result);
+        }
+        return static_cast<int32_t>(sent);
+    }
+
+
+    int32_t TlsEngine::Receive (Socket& socket) noexcept
+    {
+        char data[RECEIVE_CHUNK_SIZE];
+        std::size_t received = 0;
+        while (true)
+        {
+            const int32_t result = socket.TryRecv(data, sizeof(data));
+            if (result == SOCKET_WANT_READ || result == SOCKET_WANT_WRITE) {
+                return (received != 0) ? static_cast<int32_t>(received) : SOCKET_WANT_READ;
+            }
+            if (result < 0) { return SOCKET_ERROR; }
+            if (result == 0) { return static_cast<int32_t>(received); }
+
+            if (Feed(data, static_cast<std::size_t>(result)) == false) { return SOCKET_ERROR; }
+            received += static_cast<std::size_t>(result);
+        }
+    }
+
+
+    // Append close_notify alert to the encrypted output.
+    bool TlsEngine::Shutdown (void) noexcept
+    {
+        if (ssl == nullptr) { return false; }
+        ERR_clear_error();
+        return (SSL_shutdown(ssl) >= 0);
+    }
+
+
+    TlsEngine::~TlsEngine (void) noexcept
+    {
+        // BIOs are released with SSL object.
+        SSL_free(ssl);
+    }
+
+}  // namespace net.
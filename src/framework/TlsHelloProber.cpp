@@ -0,0 +1,639 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <openssl/rand.h>
+
+#include "../../include/framework/System.hpp"
+#include "../../include/framework/TlsHelloProber.hpp"
+
+
+namespace analyzer::framework::net
+{
+    using common::types::BinaryStructuredDataEngine;
+    using common::types::DATA_BIG_ENDIAN;
+
+    // Types of TLS records and handshake messages.
+    static constexpr uint8_t RECORD_ALERT = 21;
+    static constexpr uint8_t RECORD_HANDSHAKE = 22;
+    static constexpr uint8_t HANDSHAKE_CLIENT_HELLO = 1;
+    static constexpr uint8_t HANDSHAKE_SERVER_HELLO = 2;
+    // Types of TLS extensions.
+    static constexpr uint16_t EXTENSION_SERVER_NAME = 0x0000;
+    static constexpr uint16_t EXTENSION_SUPPORTED_GROUPS = 0x000A;
+    static constexpr uint16_t EXTENSION_EC_POINT_FORMATS = 0x000B;
+    static constexpr uint16_t EXTENSION_SIGNATURE_ALGORITHMS = 0x000D;
+    static constexpr uint16_t EXTENSION_ALPN = 0x0010;
+    static constexpr uint16_t EXTENSION_SUPPORTED_VERSIONS = 0x002B;
+    static constexpr uint16_t EXTENSION_KEY_SHARE = 0x0033;
+    // Signaling cipher suite value of secure renegotiation.
+    static constexpr uint16_t CIPHER_RENEGOTIATION_SCSV = 0x00FF;
+    // Size of TLS record header.
+    static constexpr std::size_t RECORD_HEADER_SIZE = 5;
+    // Maximum length of the plain text of TLS record.
+    static constexpr std::size_t MAXIMUM_RECORD_LENGTH = 16384;
+    // Maximum length of received records before ServerHello is parsed.
+    static constexpr std::size_t MAXIMUM_ANSWER_LENGTH = 65536;
+
+    // Pattern of TLS record header: Type, Version, Length.
+    static const uint16_t RECORD_PATTERN[3] = { 1, 2, 2 };
+    // Pattern of the fixed part of ServerHello: Type, Length, Version, Random, Session ID length.
+    static const uint16_t SERVER_HELLO_PATTERN[5] = { 1, 3, 2, 32, 1 };
+    // Random of HelloRetryRequest (SHA-256 of "HelloRetryRequest").
+    static const uint8_t HELLO_RETRY_RANDOM[32] = { 0xCF, 0x21, 0xAD, 0x74, 0xE5, 0x9A, 0x61, 0x11, 0xBE, 0x1D, 0x8C, 0x02, 0x1E, 0x65, 0xB8, 0x91,
+                                                    0xC2, 0xA2, 0x11, 0x16, 0x7A, 0xBB, 0x8C, 0x5E, 0x07, 0x9E, 0x09, 0xE2, 0xC8, 0xA8, 0x33, 0x9C };
+
+    /**
+     * @enum CLIENT_HELLO_FIELD
+     * @brief Indexes of the fields of crafted ClientHello record (each extension is the triple of type, length and body after them).
+     */
+    enum CLIENT_HELLO_FIELD : uint16_t
+    {
+        FIELD_RECORD_TYPE = 0,
+        FIELD_RECORD_VERSION = 1,
+        FIELD_RECORD_LENGTH = 2,
+        FIELD_HANDSHAKE_TYPE = 3,
+        FIELD_HANDSHAKE_LENGTH = 4,
+        FIELD_CLIENT_VERSION = 5,
+        FIELD_RANDOM = 6,
+        FIELD_SESSION_LENGTH = 7,
+        FIELD_SESSION = 8,
+        FIELD_CIPHERS_LENGTH = 9,
+        FIELD_CIPHERS = 10,
+        FIELD_COMPRESSION_LENGTH = 11,
+        FIELD_COMPRESSION = 12,
+        FIELD_EXTENSIONS_LENGTH = 13,
+        FIELD_EXTENSIONS = 14
+    };
+
+
+    // Returns the version of protocol in wire format.
+    static constexpr uint16_t GetWireVersion (const uint16_t version) noexcept { return static_cast<uint16_t>(0x0301 + version); }
+
+    // Appends the 16-bit value in network byte order.
+    static void AppendUint16 (std::string& output, const uint16_t value) noexcept
+    {
+        output.push_back(static_cast<char>(value >> 8));
+        output.push_back(static_cast<char>(value & 0xFF));
+    }
+
+    // Returns the 16-bit value in network byte order.
+    static uint16_t ReadUint16 (const char* data) noexcept
+    {
+        return static_cast<uint16_t>((static_cast<uint8_t>(data[0]) << 8) | static_cast<uint8_t>(data[1]));
+    }
+
+    // Returns the memory of field of structured data.
+    static std::byte* GetFieldMemory (const BinaryStructuredDataEngine& engine, const uint16_t field) noexcept
+    {
+        return engine.Data().GetAt(engine.GetFieldBitOffset(field) / 8);
+    }
+
+    /**
+     * @struct CipherTable
+     * @brief Structure that contains the cipher suites which are known for OpenSSL.
+     */
+    struct CipherTable
+    {
+        // Cipher suites of TLS 1.3.
+        std::vector<uint16_t> modern = { };
+        // Cipher suites of TLS 1.2 and older versions.
+        std::vector<uint16_t> legacy = { };
+        // Names of cipher suites in OpenSSL format.
+        std::unordered_map<uint16_t, std::string> names = { };
+    };
+
+    // Returns the table of cipher suites which is read once from OpenSSL.
+    static const CipherTable& GetCipherTable (void) noexcept
+    {
+        static const CipherTable table = [] () noexcept
+        {
+            CipherTable result;
+            SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+            if (ctx == nullptr) { return result; }
+
+            // Insecure suites are also enumerated, so the security level does not filter them.
+            SSL_CTX_set_security_level(ctx, 0);
+            (void)SSL_CTX_set_cipher_list(ctx, "ALL:COMPLEMENTOFALL");
+            (void)SSL_CTX_set_ciphersuites(ctx, "TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256:TLS_AES_128_GCM_SHA256:"
+                                                "TLS_AES_128_CCM_SHA256:TLS_AES_128_CCM_8_SHA256");
+
+            STACK_OF(SSL_CIPHER)* ciphers = SSL_CTX_get_ciphers(ctx);
+            for (int32_t idx = 0; idx < sk_SSL_CIPHER_num(ciphers); ++idx)
+            {
+                const SSL_CIPHER* cipher = sk_SSL_CIPHER_value(ciphers, idx);
+                const auto id = static_cast<uint16_t>(SSL_CIPHER_get_protocol_id(cipher));
+                if ((id >> 8) == 0x13) { result.modern.push_back(id); }
+                else { result.legacy.push_back(id); }
+                result.names.emplace(id, SSL_CIPHER_get_name(cipher));
+            }
+            SSL_CTX_free(ctx);
+            return result;
+        }();
+        return table;
+    }
+
+
+    TlsHelloProber::TlsHelloProber (const uint32_t inFlight, const uint32_t time) noexcept
+            : ProbeDriver(inFlight, time)
+    { }
+
+    // Method that crafts the TLS record with ClientHello.
+    bool TlsHelloProber::CreateClientHello (const ClientHelloOptions& options, BinaryStructuredDataEngine& hello) noexcept
+    {
+        if (options.version >= NUMBER_OF_CTX || options.ciphers.empty() == true) {
+            LOG_ERROR("TlsHelloProber.CreateClientHello: Version or list of cipher suites is invalid.");
+            return false;
+        }
+        const bool modern = (options.version == SSL_METHOD_TLS13);
+
+        // Bodies of extensions are prepared before the pattern, because their lengths are the fields of pattern.
+        std::vector<std::pair<uint16_t, std::string>> extensions;
+        if (options.serverName.empty() == false)
+        {
+            std::string body;
+            AppendUint16(body, static_cast<uint16_t>(options.serverName.size() + 3));
+            body.push_back(0);  // Type of name: host_name.
+            AppendUint16(body, static_cast<uint16_t>(options.serverName.size()));
+            body.append(options.serverName);
+            extensions.emplace_back(EXTENSION_SERVER_NAME, std::move(body));
+        }
+        // Groups: x25519, secp256r1, secp384r1, secp521r1, x448, ffdhe2048, ffdhe3072.
+        extensions.emplace_back(EXTENSION_SUPPORTED_GROUPS, std::string("\x00\x0E\x00\x1D\x00\x17\x00\x18\x00\x19\x00\x1E\x01\x00\x01\x01", 16));
+        // Point formats: uncompressed.
+        extensions.emplace_back(EXTENSION_EC_POINT_FORMATS, std::string("\x01\x00", 2));
+        // Signature algorithms: ECDSA, EdDSA, RSA-PSS, RSA PKCS#1 with SHA-2 and SHA-1.
+        extensions.emplace_back(EXTENSION_SIGNATURE_ALGORITHMS, std::string("\x00\x1A\x04\x03\x05\x03\x06\x03\x08\x07\x08\x08\x08\x04"
+                                                                            "\x08\x05\x08\x06\x04\x01\x05\x01\x06\x01\x02\x03\x02\x01", 28));
+        if (options.protocols.empty() == false)
+        {
+            std::string list;
+            for (const std::string& protocol : options.protocols)
+            {
+                if (protocol.empty() == true || protocol.size() > UINT8_MAX) { continue; }
+                list.push_back(static_cast<char>(protocol.size()));
+                list.append(protocol);
+            }
+            std::string body;
+            AppendUint16(body, static_cast<uint16_t>(list.size()));
+            body.append(list);
+            extensions.emplace_back(EXTENSION_ALPN, std::move(body));
+        }
+        if (modern == true)
+        {
+            extensions.emplace_back(EXTENSION_SUPPORTED_VERSIONS, std::string("\x02\x03\x04", 3));
+            // Empty list of key shares: server selects the group in HelloRetryRequest without key exchange.
+            extensions.emplace_back(EXTENSION_KEY_SHARE, std::string("\x00\x00", 2));
+        }
+
+        // Secure renegotiation is indicated by the signaling suite in older versions.
+        const std::size_t ciphers = options.ciphers.size() + ((modern == true) ? 0 : 1);
+        std::vector<uint16_t> pattern = { 1, 2, 2, 1, 3, 2, 32, 1, 32, 2, static_cast<uint16_t>(ciphers * 2), 1, 1, 2 };
+        std::size_t extensionsLength = 0;
+        for (const auto& [ type, body ] : extensions)
+        {
+            pattern.insert(pattern.end(), { 2, 2, static_cast<uint16_t>(body.size()) });
+            extensionsLength += 4 + body.size();
+        }
+
+        const std::size_t bodyLength = 2 + 32 + 1 + 32 + 2 + ciphers * 2 + 1 + 1 + 2 + extensionsLength;
+        if (bodyLength + 4 > MAXIMUM_RECORD_LENGTH || pattern.size() > UINT16_MAX) {
+            LOG_ERROR("TlsHelloProber.CreateClientHello: ClientHello does not fit into one record.");
+            return false;
+        }
+
+        // Fields of TLS record are stored in network byte order.
+        hello.Clear();
+        hello.SetDataEndianType(DATA_BIG_ENDIAN);
+        if (hello.CreateTemplate(pattern.data(), static_cast<uint16_t>(pattern.size())) == false) {
+            LOG_ERROR("TlsHelloProber.CreateClientHello: In function 'CreateTemplate'.");
+            return false;
+        }
+
+        (void)hello.SetBitField<uint8_t>(FIELD_RECORD_TYPE, RECORD_HANDSHAKE);
+        (void)hello.SetBitField<uint16_t>(FIELD_RECORD_VERSION, GetWireVersion(SSL_METHOD_TLS1));
+        (void)hello.SetBitField<uint16_t>(FIELD_RECORD_LENGTH, static_cast<uint16_t>(bodyLength + 4));
+        (void)hello.SetBitField<uint8_t>(FIELD_HANDSHAKE_TYPE, HANDSHAKE_CLIENT_HELLO);
+        (void)hello.SetBitField<uint32_t>(FIELD_HANDSHAKE_LENGTH, static_cast<uint32_t>(bodyLength));
+        // Version of TLS 1.3 is offered only by the extension.
+        (void)hello.SetBitField<uint16_t>(FIELD_CLIENT_VERSION, GetWireVersion((modern == true) ? SSL_METHOD_TLS12 : options.version));
+        // Session ID is not empty for compatibility of TLS 1.3 with middleboxes.
+        (void)RAND_bytes(reinterpret_cast<unsigned char*>(GetFieldMemory(hello, FIELD_RANDOM)), 32);
+        (void)hello.SetBitField<uint8_t>(FIELD_SESSION_LENGTH, 32);
+        (void)RAND_bytes(reinterpret_cast<unsigned char*>(GetFieldMemory(hello, FIELD_SESSION)), 32);
+
+        (void)hello.SetBitField<uint16_t>(FIELD_CIPHERS_LENGTH, static_cast<uint16_t>(ciphers * 2));
+        std::byte* memory = GetFieldMemory(hello, FIELD_CIPHERS);
+        for (const uint16_t cipher : options.ciphers)
+        {
+            *memory++ = static_cast<std::byte>(cipher >> 8);
+            *memory++ = static_cast<std::byte>(cipher & 0xFF);
+        }
+        if (modern == false)
+        {
+            *memory++ = static_cast<std::byte>(CIPHER_RENEGOTIATION_SCSV >> 8);
+            *memory = static_cast<std::byte>(CIPHER_RENEGOTIATION_SCSV & 0xFF);
+        }
+        (void)hello.SetBitField<uint8_t>(FIELD_COMPRESSION_LENGTH, 1);
+        (void)hello.SetBitField<uint8_t>(FIELD_COMPRESSION, 0);  // Null compression.
+
+        (void)hello.SetBitField<uint16_t>(FIELD_EXTENSIONS_LENGTH, static_cast<uint16_t>(extensionsLength));
+        auto field = static_cast<uint16_t>(FIELD_EXTENSIONS);
+        for (const auto& [ type, body ] : extensions)
+        {
+            (void)hello.SetBitField<uint16_t>(field++, type);
+            (void)hello.SetBitField<uint16_t>(field++, static_cast<uint16_t>(body.size()));
+            memcpy(GetFieldMemory(hello, field++), body.data(), body.size());
+        }
+        return true;
+    }
+
+    // Parses the body of ServerHello message.
+    static SERVER_ANSWER ParseServerHelloMessage (const std::string& message, ServerHelloInfo& info) noexcept
+    {
+        uint8_t header[39];
+        if (message.size() < sizeof(header)) { return ANSWER_MALFORMED; }
+        memcpy(header, message.data(), sizeof(header));
+
+        BinaryStructuredDataEngine hello(DATA_BIG_ENDIAN);
+        if (hello.AssignData<DATA_BIG_ENDIAN>(&header, SERVER_HELLO_PATTERN, 5) == false ||
+            hello.GetBitField<uint8_t>(0) != HANDSHAKE_SERVER_HELLO) {
+            return ANSWER_MALFORMED;
+        }
+        info.version = hello.GetBitField<uint16_t>(2);
+        info.retry = (memcmp(GetFieldMemory(hello, 3), HELLO_RETRY_RANDOM, sizeof(HELLO_RETRY_RANDOM)) == 0);
+
+        const std::size_t end = 4 + hello.GetBitField<uint32_t>(1);
+        std::size_t position = sizeof(header) + hello.GetBitField<uint8_t>(4);
+        // Cipher suite and compression method.
+        if (position + 3 > end) { return ANSWER_MALFORMED; }
+        info.cipher = ReadUint16(message.data() + position);
+        position += 3;
+        // Extensions are absent in the answers of old servers.
+        if (position == end) { return ANSWER_HELLO; }
+        if (position + 2 > end || position + 2 + ReadUint16(message.data() + position) != end) { return ANSWER_MALFORMED; }
+        position += 2;
+
+        while (position + 4 <= end)
+        {
+            const uint16_t type = ReadUint16(message.data() + position);
+            const std::size_t length = ReadUint16(message.data() + position + 2);
+            const char* body = message.data() + position + 4;
+            position += 4 + length;
+            if (position > end) { return ANSWER_MALFORMED; }
+
+            info.extensions.push_back(type);
+            if (type == EXTENSION_SUPPORTED_VERSIONS && length == 2) {
+                info.version = ReadUint16(body);
+            }
+            // List of ALPN protocols contains exactly one selected protocol.
+            else if (type == EXTENSION_ALPN && length >= 3 && static_cast<std::size_t>(static_cast<uint8_t>(body[2])) + 3 <= length) {
+                info.protocol.assign(body + 3, static_cast<uint8_t>(body[2]));
+            }
+        }
+        return (position == end) ? ANSWER_HELLO : ANSWER_MALFORMED;
+    }
+
+    // Method that parses the first handshake message or alert of server.
+    SERVER_ANSWER TlsHelloProber::ParseServerHello (const char* data, const std::size_t length, ServerHelloInfo& info) noexcept
+    {
+        info = ServerHelloInfo();
+        // Handshake message may be fragmented into several records.
+        std::string message;
+        std::size_t offset = 0;
+
+        while (length - offset >= RECORD_HEADER_SIZE)
+        {
+            uint8_t header[RECORD_HEADER_SIZE];
+            memcpy(header, data + offset, sizeof(header));
+            BinaryStructuredDataEngine record(DATA_BIG_ENDIAN);
+            if (record.AssignData<DATA_BIG_ENDIAN>(&header, RECORD_PATTERN, 3) == false) { return ANSWER_MALFORMED; }
+
+            const auto type = record.GetBitField<uint8_t>(0);
+            const auto size = static_cast<std::size_t>(record.GetBitField<uint16_t>(2));
+            if ((type != RECORD_HANDSHAKE && type != RECORD_ALERT) || (record.GetBitField<uint16_t>(1) >> 8) != 0x03 || size > MAXIMUM_RECORD_LENGTH) {
+                return ANSWER_MALFORMED;
+            }
+            if (length - offset - sizeof(header) < size) { break; }
+
+            const char* body = data + offset + sizeof(header);
+            offset += sizeof(header) + size;
+            if (type == RECORD_ALERT)
+            {
+                if (size < 2) { return ANSWER_MALFORMED; }
+                info.alert = static_cast<uint8_t>(body[1]);
+                return ANSWER_ALERT;
+            }
+
+            message.append(body, size);
+            if (message.size() >= 4)
+            {
+                const std::size_t messageLength = (static_cast<std::size_t>(static_cast<uint8_t>(message[1])) << 16) |
+                                                  (static_cast<std::size_t>(static_cast<uint8_t>(message[2])) << 8) | static_cast<uint8_t>(message[3]);
+                if (message.size() >= messageLength + 4) { return ParseServerHelloMessage(message, info); }
+            }
+        }
+        return ANSWER_INCOMPLETE;
+    }
+
+    // Method that returns the name of cipher suite in OpenSSL format.
+    std::string_view TlsHelloProber::GetCipherName (const uint16_t cipher) noexcept
+    {
+        const CipherTable& table = GetCipherTable();
+        const auto it = table.names.find(cipher);
+        return (it != table.names.end()) ? std::string_view(it->second) : std::string_view();
+    }
+
+    // Method that returns all cipher suites of the version which are known for OpenSSL.
+    const std::vector<uint16_t>& TlsHelloProber::GetKnownCiphers (const uint16_t version) noexcept
+    {
+        const CipherTable& table = GetCipherTable();
+        return (version == SSL_METHOD_TLS13) ? table.modern : table.legacy;
+    }
+
+
+    // Method that adds the version of protocol for probes.
+    bool TlsHelloProber::AddVersion (const uint16_t version) noexcept
+    {
+        if (version >= NUMBER_OF_CTX || tasks.empty() == false) {
+            LOG_ERROR("TlsHelloProber.AddVersion: Version is invalid or probing is already started.");
+            return false;
+        }
+        if (std::find(versions.begin(), versions.end(), version) == versions.end()) { versions.push_back(version); }
+        return true;
+    }
+
+    // Method that adds the ALPN protocol which is offered in all probes.
+    bool TlsHelloProber::AddProtocol (std::string_view protocol) noexcept
+    {
+        if (protocol.empty() == true || protocol.size() > UINT8_MAX || tasks.empty() == false) {
+            LOG_ERROR("TlsHelloProber.AddProtocol: Protocol is invalid or probing is already started.");
+            return false;
+        }
+        if (std::find(protocols.begin(), protocols.end(), protocol) == protocols.end()) { protocols.emplace_back(protocol); }
+        return true;
+    }
+
+    // Method that adds the external host for probing.
+    bool TlsHelloProber::AddTarget (const char* host, const uint16_t port, const int32_t family) noexcept
+    {
+        if (tasks.empty() == false) {
+            LOG_ERROR("TlsHelloProber.AddTarget: Probing is already started.");
+            return false;
+        }
+
+        return ResolveTarget(host, port, family);
+    }
+
+    // Creates the tasks of all targets and versions.
+    void TlsHelloProber::PrepareTasks (void) noexcept
+    {
+        if (tasks.empty() == false) { return; }
+        if (versions.empty() == true) { versions.push_back(SSL_METHOD_TLS12); }
+
+        tasks.reserve(targets.size() * versions.size());
+        for (std::size_t target = 0; target < targets.size(); ++target)
+        {
+            for (const uint16_t version : versions)
+            {
+                Task task;
+                task.target = target;
+                task.version = version;
+                task.ciphers = GetKnownCiphers(version);
+                tasks.emplace_back(std::move(task));
+            }
+            // Only the first task of the host is started until its connection is confirmed.
+            queue.push_back(target * versions.size());
+        }
+    }
+
+    // Selects the next task or returns false if no probe can be started now.
+    bool TlsHelloProber::NextProbe (void) noexcept
+    {
+        // Probes of all tasks are interleaved, so each host and version obtains a part of the probes in flight.
+        while (queue.empty() == false)
+        {
+            const std::size_t idx = queue.front();
+            queue.pop_front();
+
+            if (targets[tasks[idx].target]->Admit() == false) {
+                Report(idx, HELLO_SKIPPED, 0, clock::time_point(), nullptr);
+                continue;
+            }
+            nextTask = idx;
+            return true;
+        }
+        return false;
+    }
+
+    // Reports the result of probe.
+    void TlsHelloProber::Report (const std::size_t task, const HELLO_STATE state, const int32_t error, const clock::time_point start,
+                                 const ServerHelloInfo* info) noexcept
+    {
+        const ProbeTarget& target = *targets[tasks[task].target];
+        const auto latency = (start == clock::time_point()) ? std::chrono::microseconds(0)
+                                                            : std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+        const uint16_t cipher = (state == HELLO_ACCEPTED && info != nullptr) ? info->cipher : 0;
+        const HelloProbeResult result = { target.host, target.port, tasks[task].version, state, cipher,
+                                          (cipher != 0) ? GetCipherName(cipher) : std::string_view(),
+                                          (info != nullptr) ? std::string_view(info->protocol) : std::string_view(),
+                                          (info != nullptr) ? info->alert : static_cast<uint8_t>(0), error, latency };
+        finished++;
+        resultHandler(result, resultContext);
+    }
+
+    // Reports the local error of probe (the task which checks the connection passes the check to the next task of the host).
+    void TlsHelloProber::ReportError (const std::size_t task, const int32_t error) noexcept
+    {
+        const std::size_t end = (tasks[task].target + 1) * versions.size();
+        if (targets[tasks[task].target]->Reopen() == true && task + 1 < end) { queue.push_back(task + 1); }
+        Report(task, HELLO_ERROR, error, clock::time_point(), nullptr);
+    }
+
+    // Marks the host as unreachable and reports the tasks which are not started yet.
+    void TlsHelloProber::SkipTarget (const std::size_t target, const std::size_t task) noexcept
+    {
+        // Tasks after the task which checks the connection are not in the queue yet (queued tasks are skipped by NextProbe).
+        if (targets[target]->Reject() == false) { return; }
+        for (std::size_t idx = task + 1; idx < (target + 1) * versions.size(); ++idx) {
+            Report(idx, HELLO_SKIPPED, 0, clock::time_point(), nullptr);
+        }
+    }
+
+    // Starts the probe of selected task (returns false if the probe should be repeated later).
+    bool TlsHelloProber::StartProbe (SocketStatePool& reactor) noexcept
+    {
+        const ProbeTarget& target = *targets[tasks[nextTask].target];
+        ClientHelloOptions options;
+        options.version = tasks[nextTask].version;
+        options.ciphers = tasks[nextTask].ciphers;
+        options.protocols = protocols;
+        if (target.named == true) { options.serverName = target.host; }
+        BinaryStructuredDataEngine hello;
+        if (CreateClientHello(options, hello) == false) {
+            ReportError(nextTask, EINVAL);
+            return true;
+        }
+
+        HelloProbeAttempt attempt;
+        attempt.task = nextTask;
+        attempt.output.assign(reinterpret_cast<const char*>(hello.Data().Data()), hello.ByteSize());
+
+        int32_t fd = INVALID_SOCKET, error = 0;
+        switch (Connect(reactor, target.address, std::move(attempt), fd, error))
+        {
+            case CONNECT_DELAYED:
+                return false;
+            case CONNECT_FAILED:
+                ReportError(nextTask, error);
+                break;
+            default:
+                if (error != 0) { Finish(reactor, fd, HELLO_UNREACHABLE, error, nullptr); }
+                break;
+        }
+        return true;
+    }
+
+    // Continues the connection and the exchange of probe after the event of socket.
+    void TlsHelloProber::ContinueProbe (SocketStatePool& reactor, const int32_t fd) noexcept
+    {
+        HelloProbeAttempt& attempt = attempts.find(fd)->second;
+        if (attempt.connected == false)
+        {
+            int32_t error = 0;
+            if (CheckConnection(reactor, fd, attempt, error) == false) { return; }
+            if (error != 0) {
+                Finish(reactor, fd, HELLO_UNREACHABLE, error, nullptr);
+                return;
+            }
+
+            // Other tasks of the host are started only after its connection is confirmed.
+            const std::size_t target = tasks[attempt.task].target;
+            if (targets[target]->Confirm() == true) {
+                for (std::size_t idx = attempt.task + 1; idx < (target + 1) * versions.size(); ++idx) { queue.push_back(idx); }
+            }
+        }
+        Exchange(reactor, fd, attempt);
+    }
+
+    // Finishes the probe which is not completed in time.
+    void TlsHelloProber::ExpireProbe (SocketStatePool& reactor, const int32_t fd, const bool connected) noexcept
+    {
+        Finish(reactor, fd, (connected == true) ? HELLO_ERROR : HELLO_UNREACHABLE, ETIMEDOUT, nullptr);
+    }
+
+    // Sends the rest of ClientHello and parses the received records.
+    void TlsHelloProber::Exchange (SocketStatePool& reactor, const int32_t fd, HelloProbeAttempt& attempt) noexcept
+    {
+        while (attempt.output.empty() == false)
+        {
+            const ssize_t sent = send(fd, attempt.output.data(), attempt.output.size(), MSG_NOSIGNAL);
+            if (sent >= 0) {
+                attempt.output.erase(0, static_cast<std::size_t>(sent));
+                continue;
+            }
+            if (errno == EINTR) { continue; }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // The rest of ClientHello is sent by the next edge of writable socket.
+                reactor.ClearStatus(fd, SocketStatePool::STATUS_WRITE);
+                return;
+            }
+            Finish(reactor, fd, HELLO_REJECTED, errno, nullptr);
+            return;
+        }
+
+        char data[RECEIVE_CHUNK_SIZE];
+        int32_t error = 0;
+        bool closed = false;
+        while (closed == false && attempt.input.size() < MAXIMUM_ANSWER_LENGTH)
+        {
+            const ssize_t received = recv(fd, data, sizeof(data), 0);
+            if (received > 0) {
+                attempt.input.append(data, static_cast<std::size_t>(received));
+                continue;
+            }
+            if (received < 0 && errno == EINTR) { continue; }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                reactor.ClearStatus(fd, SocketStatePool::STATUS_READ);
+                break;
+            }
+            error = (received == 0) ? ECONNRESET : errno;
+            closed = true;
+        }
+
+        ServerHelloInfo info;
+        switch (ParseServerHello(attempt.input.data(), attempt.input.size(), info))
+        {
+            case ANSWER_HELLO:
+            {
+                const std::vector<uint16_t>& offered = tasks[attempt.task].ciphers;
+                // Server which does not support the offered version answers with the lower version.
+                if (info.version != GetWireVersion(tasks[attempt.task].version)) {
+                    Finish(reactor, fd, HELLO_REJECTED, EPROTONOSUPPORT, &info);
+                }
+                else if (std::find(offered.begin(), offered.end(), info.cipher) == offered.end()) {
+                    Finish(reactor, fd, HELLO_ERROR, EPROTO, &info);
+                }
+                else { Finish(reactor, fd, HELLO_ACCEPTED, 0, &info); }
+                break;
+            }
+            case ANSWER_ALERT:
+                Finish(reactor, fd, HELLO_REJECTED, 0, &info);
+                break;
+            case ANSWER_INCOMPLETE:
+                if (attempt.input.size() >= MAXIMUM_ANSWER_LENGTH) { Finish(reactor, fd, HELLO_ERROR, EMSGSIZE, nullptr); }
+                else if (closed == true) { Finish(reactor, fd, HELLO_REJECTED, error, nullptr); }
+                break;
+            default:
+                Finish(reactor, fd, HELLO_ERROR, EPROTO, nullptr);
+                break;
+        }
+    }
+
+    // Finishes the probe, reports its result and schedules the next probe of task.
+    void TlsHelloProber::Finish (SocketStatePool& reactor, const int32_t fd, const HELLO_STATE state, const int32_t error, const ServerHelloInfo* info) noexcept
+    {
+        if (attempts.find(fd) == attempts.end()) { return; }
+        const HelloProbeAttempt attempt = Release(reactor, fd);
+
+        const std::size_t task = attempt.task;
+        Report(task, state, error, attempt.start, info);
+        if (state == HELLO_ACCEPTED)
+        {
+            // Accepted suite is removed from the next offer, so the server selects the next suite of its preference.
+            std::vector<uint16_t>& ciphers = tasks[task].ciphers;
+            ciphers.erase(std::remove(ciphers.begin(), ciphers.end(), info->cipher), ciphers.end());
+            if (ciphers.empty() == false) { queue.push_back(task); }
+        }
+        // Other tasks of the host are not started if it is unreachable.
+        else if (state == HELLO_UNREACHABLE) { SkipTarget(tasks[task].target, task); }
+    }
+
+    // Method that enumerates the cipher suites of all added hosts and versions and reports the result of each probe by handler.
+    std::size_t TlsHelloProber::Run (HelloProbeHandler handler, void* context) noexcept
+    {
+        if (handler == nullptr) {
+            LOG_ERROR("TlsHelloProber.Run: Handler is not set.");
+            return 0;
+        }
+        PrepareTasks();
+
+        resultHandler = handler;
+        resultContext = context;
+        const std::size_t before = finished;
+        LOG_INFO("TlsHelloProber.Run: Probing of ", targets.size(), " targets with ", versions.size(), " versions is started.");
+        (void)Drive();
+        LOG_INFO("TlsHelloProber.Run: Probing is finished: ", finished - before, " probes.");
+        return finished - before;
+    }
+
+}  // namespace net.
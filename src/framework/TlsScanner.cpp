@@ -0,0 +1,298 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include "../../include/framework/System.hpp"
+#include "../../include/framework/TlsScanner.hpp"
+
+
+namespace analyzer::framework::net
+{
+    TlsScanner::TlsScanner (const uint32_t inFlight, const uint32_t time) noexcept
+            : ProbeDriver(inFlight, time)
+    { }
+
+    // Method that adds the version of protocol for probes.
+    bool TlsScanner::AddVersion (const uint16_t version) noexcept
+    {
+        if (version >= NUMBER_OF_CTX || contexts.empty() == false) {
+            LOG_ERROR("TlsScanner.AddVersion: Version is invalid or scanning is already started.");
+            return false;
+        }
+        if (std::find(versions.begin(), versions.end(), version) == versions.end()) { versions.push_back(version); }
+        return true;
+    }
+
+    // Method that adds the ALPN protocol for probes.
+    bool TlsScanner::AddProtocol (std::string_view protocol) noexcept
+    {
+        if (protocol.empty() == true || protocol.size() > UINT8_MAX || contexts.empty() == false) {
+            LOG_ERROR("TlsScanner.AddProtocol: Protocol is invalid or scanning is already started.");
+            return false;
+        }
+        if (std::find(protocols.begin(), protocols.end(), protocol) == protocols.end()) { protocols.emplace_back(protocol); }
+        return true;
+    }
+
+    // Method that adds the external host for scanning.
+    bool TlsScanner::AddTarget (const char* host, const uint16_t port, const int32_t family) noexcept
+    {
+        if (ResolveTarget(host, port, family) == false) { return false; }
+        queue.push_back(targets.size() - 1);
+        return true;
+    }
+
+    // Creates the shared contexts for all combinations of version and ALPN protocol.
+    bool TlsScanner::PrepareContexts (void) noexcept
+    {
+        if (contexts.empty() == false) { return true; }
+        if (versions.empty() == true) { versions.push_back(SSL_METHOD_TLS12); }
+
+        for (std::size_t probe = 0; probe < ProbesPerTarget(); ++probe)
+        {
+            SSLContextProfile profile;
+            profile.minimum = profile.maximum = versions[probe / std::max<std::size_t>(protocols.size(), 1)];
+            if (protocols.empty() == false)
+            {
+                const std::string& protocol = protocols[probe % protocols.size()];
+                profile.protocols.push_back(static_cast<char>(protocol.size()));
+                profile.protocols.append(protocol);
+            }
+
+            SSL_CTX* ctx = SSLContextCache::Instance().Acquire(profile);
+            if (ctx == nullptr) {
+                LOG_ERROR("TlsScanner.PrepareContexts: Cannot create SSL context of probe.");
+                return false;
+            }
+            contexts.push_back(ctx);
+        }
+        return true;
+    }
+
+    // Selects the next probe or returns false if no probe can be started now.
+    bool TlsScanner::NextProbe (void) noexcept
+    {
+        // Probes of all reachable targets are interleaved, so each host obtains a part of the probes in flight.
+        while (queue.empty() == false)
+        {
+            const std::size_t idx = queue.front();
+            queue.pop_front();
+
+            TlsScanTarget& entry = *targets[idx];
+            // The first probe checks the connection, the target returns to the queue when the connection is established.
+            if (entry.state == ProbeTarget::TARGET_CONNECTING || entry.next >= ProbesPerTarget() || entry.Admit() == false) { continue; }
+
+            nextTarget = idx;
+            nextProbe = entry.next++;
+            if (entry.state == ProbeTarget::TARGET_REACHABLE && entry.next < ProbesPerTarget()) { queue.push_back(idx); }
+            return true;
+        }
+        return false;
+    }
+
+    // Reports the result of probe.
+    void TlsScanner::Report (const std::size_t target, const std::size_t probe, const PROBE_STATE state, const int32_t error,
+                             const clock::time_point start, std::string_view selected) noexcept
+    {
+        const std::size_t count = std::max<std::size_t>(protocols.size(), 1);
+        const auto latency = (start == clock::time_point()) ? std::chrono::microseconds(0)
+                                                            : std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+        const TlsProbeResult result = { targets[target]->host, targets[target]->port, versions[probe / count],
+                                        (protocols.empty() == true) ? std::string_view() : std::string_view(protocols[probe % count]),
+                                        selected, state, error, latency };
+        finished++;
+        resultHandler(result, resultContext);
+    }
+
+    // Reports the local error of probe (the first probe is passed to the next probe of the host).
+    void TlsScanner::ReportError (const std::size_t target, const std::size_t probe, const int32_t error) noexcept
+    {
+        if (targets[target]->Reopen() == true) { queue.push_back(target); }
+        Report(target, probe, PROBE_ERROR, error, clock::time_point(), std::string_view());
+    }
+
+    // Marks the host as unreachable and reports the probes which are not started yet.
+    void TlsScanner::SkipTarget (const std::size_t target) noexcept
+    {
+        TlsScanTarget& entry = *targets[target];
+        (void)entry.Reject();
+        for (; entry.next < ProbesPerTarget(); ++entry.next) {
+            Report(target, entry.next, PROBE_SKIPPED, 0, clock::time_point(), std::string_view());
+        }
+    }
+
+    // Starts the selected probe (returns false if the probe should be repeated later).
+    bool TlsScanner::StartProbe (SocketStatePool& reactor) noexcept
+    {
+        const TlsScanTarget& target = *targets[nextTarget];
+        TlsScanAttempt attempt;
+        attempt.target = nextTarget;
+        attempt.probe = nextProbe;
+        attempt.engine = system::allocMemoryForObject<TlsEngine>(contexts[nextProbe], false);
+        if (attempt.engine == nullptr || attempt.engine->IsValid() == false ||
+            (target.named == true && attempt.engine->SetServerNameIndication(target.host) == false))
+        {
+            ReportError(nextTarget, nextProbe, ENOMEM);
+            return true;
+        }
+
+        int32_t fd = INVALID_SOCKET, error = 0;
+        switch (Connect(reactor, target.address, std::move(attempt), fd, error))
+        {
+            case CONNECT_DELAYED:
+                return false;
+            case CONNECT_FAILED:
+                ReportError(nextTarget, nextProbe, error);
+                break;
+            default:
+                if (error != 0) { Finish(reactor, fd, PROBE_UNREACHABLE, error); }
+                break;
+        }
+        return true;
+    }
+
+    // Continues the connection and the handshake of probe after the event of socket.
+    void TlsScanner::ContinueProbe (SocketStatePool& reactor, const int32_t fd) noexcept
+    {
+        TlsScanAttempt& attempt = attempts.find(fd)->second;
+        if (attempt.connected == false)
+        {
+            int32_t error = 0;
+            if (CheckConnection(reactor, fd, attempt, error) == false) { return; }
+            if (error != 0) {
+                Finish(reactor, fd, PROBE_UNREACHABLE, error);
+                return;
+            }
+
+            // Other probes of the host are started only after its connection is confirmed.
+            TlsScanTarget& entry = *targets[attempt.target];
+            if (entry.Confirm() == true && entry.next < ProbesPerTarget()) { queue.push_back(attempt.target); }
+        }
+        Handshake(reactor, fd, attempt);
+    }
+
+    // Finishes the probe which is not completed in time.
+    void TlsScanner::ExpireProbe (SocketStatePool& reactor, const int32_t fd, const bool connected) noexcept
+    {
+        Finish(reactor, fd, (connected == true) ? PROBE_REJECTED : PROBE_UNREACHABLE, ETIMEDOUT);
+    }
+
+    // Moves the handshake forward while there is data to send or to receive.
+    void TlsScanner::Handshake (SocketStatePool& reactor, const int32_t fd, TlsScanAttempt& attempt) noexcept
+    {
+        char data[RECEIVE_CHUNK_SIZE];
+        while (true)
+        {
+            const int32_t status = attempt.engine->Handshake();
+
+            // Handshake messages and alerts are sent before the result is checked.
+            ReceiveBuffer& output = attempt.engine->GetOutput();
+            while (output.Empty() == false)
+            {
+                const std::string_view front = output.Front();
+                const ssize_t sent = send(fd, front.data(), front.size(), MSG_NOSIGNAL);
+                if (sent >= 0) {
+                    output.Consume(static_cast<std::size_t>(sent));
+                    continue;
+                }
+                if (errno == EINTR) { continue; }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    // The rest of output is sent by the next edge of writable socket.
+                    reactor.ClearStatus(fd, SocketStatePool::STATUS_WRITE);
+                    break;
+                }
+                Finish(reactor, fd, PROBE_REJECTED, errno);
+                return;
+            }
+
+            if (status == SOCKET_SUCCESS) {
+                Finish(reactor, fd, PROBE_SUPPORTED, 0);
+                return;
+            }
+            if (status == SOCKET_ERROR) {
+                Finish(reactor, fd, PROBE_REJECTED, EPROTO);
+                return;
+            }
+
+            // Engine waits for the records of server, so all available data is fed to it.
+            bool fed = false;
+            while (true)
+            {
+                const ssize_t received = recv(fd, data, sizeof(data), 0);
+                if (received > 0)
+                {
+                    if (attempt.engine->Feed(data, static_cast<std::size_t>(received)) == false) {
+                        Finish(reactor, fd, PROBE_ERROR, ENOMEM);
+                        return;
+                    }
+                    fed = true;
+                    continue;
+                }
+                if (received == 0)
+                {
+                    // Server may close the connection right after its last handshake message, so the fed data is processed first.
+                    if (fed == true) { break; }
+                    Finish(reactor, fd, PROBE_REJECTED, ECONNRESET);
+                    return;
+                }
+                if (errno == EINTR) { continue; }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    reactor.ClearStatus(fd, SocketStatePool::STATUS_READ);
+                    break;
+                }
+                Finish(reactor, fd, PROBE_REJECTED, errno);
+                return;
+            }
+            if (fed == false) { return; }
+        }
+    }
+
+    // Finishes the probe and reports its result.
+    void TlsScanner::Finish (SocketStatePool& reactor, const int32_t fd, const PROBE_STATE state, const int32_t error) noexcept
+    {
+        if (attempts.find(fd) == attempts.end()) { return; }
+        const TlsScanAttempt attempt = Release(reactor, fd);
+
+        std::string_view selected;
+        if (state == PROBE_SUPPORTED)
+        {
+            const unsigned char* protocol = nullptr;
+            unsigned int length = 0;
+            SSL_get0_alpn_selected(attempt.engine->GetSSL(), &protocol, &length);
+            if (protocol != nullptr) { selected = std::string_view(reinterpret_cast<const char*>(protocol), length); }
+        }
+        Report(attempt.target, attempt.probe, state, error, attempt.start, selected);
+
+        // Other probes of the host are not started if it is unreachable.
+        if (state == PROBE_UNREACHABLE) { SkipTarget(attempt.target); }
+    }
+
+    // Method that runs all probes of added hosts and reports each result by handler.
+    std::size_t TlsScanner::Run (TlsProbeHandler handler, void* context) noexcept
+    {
+        if (handler == nullptr) {
+            LOG_ERROR("TlsScanner.Run: Handler is not set.");
+            return 0;
+        }
+        if (PrepareContexts() == false) { return 0; }
+
+        resultHandler = handler;
+        resultContext = context;
+        const std::size_t before = finished;
+        LOG_INFO("TlsScanner.Run: Scanning of ", targets.size(), " targets with ", ProbesPerTarget(), " probes per target is started.");
+        (void)Drive();
+        LOG_INFO("TlsScanner.Run: Scanning is finished: ", finished - before, " probes.");
+        return finished - before;
+    }
+
+    TlsScanner::~TlsScanner (void) noexcept
+    {
+        // Each context of probe holds one reference of SSLContextCache.
+        for (SSL_CTX* ctx : contexts) { SSL_CTX_free(ctx); }
+    }
+
+}  // namespace net.
@@ -60,7 +60,7 @@ namespace analyzer::framework::utility
             protocols["TLS 1.0"] = SSL_METHOD_TLS1;
             protocols["TLS 1.1"] = SSL_METHOD_TLS11;
             protocols["TLS 1.2"] = SSL_METHOD_TLS12;
-            //protocols["TLS 1.3"] == SSL_METHOD_TLS13;
+            protocols["TLS 1.3"] = SSL_METHOD_TLS13;
 
             std::set<std::string> result;
             for (const auto& [ protocol, method ] : protocols)
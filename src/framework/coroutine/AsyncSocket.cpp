@@ -0,0 +1,448 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "../../../include/framework/AsyncSocket.hpp"
+#include "../../../include/framework/GlobalInfo.hpp"  // storage::GlobalInfo.
+
+
+namespace analyzer::framework::net
+{
+    // Statuses which resume the coroutine that waits for read.
+    static constexpr uint16_t READ_STATUSES = SocketStatePool::STATUS_READ | SocketStatePool::STATUS_WRCLOSED |
+                                              SocketStatePool::STATUS_CLOSED | SocketStatePool::STATUS_ERROR;
+    // Statuses which resume the coroutine that waits for write (peer may close only its direction, so STATUS_CLOSED is not used).
+    static constexpr uint16_t WRITE_STATUSES = SocketStatePool::STATUS_WRITE | SocketStatePool::STATUS_ERROR;
+
+
+    EventLoop::EventLoop (void) noexcept
+        : reactor(SocketStatePool::Instance())
+    {
+        wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeup == INVALID_SOCKET) {
+            LOG_ERROR("EventLoop.EventLoop: In function 'eventfd' - ", GET_ERROR(errno));
+            return;
+        }
+        if (reactor.RegisterSocket(wakeup, SocketStatePool::TEST_ALWAYS) == false) {
+            LOG_ERROR("EventLoop.EventLoop: Wakeup descriptor is not registered.");
+        }
+    }
+
+    EventLoop& EventLoop::Instance (void) noexcept
+    {
+        thread_local EventLoop loop;
+        return loop;
+    }
+
+    // Coroutine which runs the spawned task.
+    EventLoop::Runner EventLoop::Start (AsyncTask<void> task) noexcept
+    {
+        active++;
+        co_await Schedule();
+        co_await std::move(task);
+        active--;
+    }
+
+    void EventLoop::Spawn (AsyncTask<void>&& task) noexcept
+    {
+        if (task.IsValid() == false) {
+            LOG_ERROR("EventLoop.Spawn: Memory for coroutine is not allocated.");
+            return;
+        }
+        (void)Start(std::move(task));
+    }
+
+    // Method that adds the waiter of socket descriptor.
+    bool EventLoop::AddWaiter (const int32_t fd, Waiter& waiter, const int32_t time) noexcept
+    {
+        const bool write = (waiter.expected == SocketStatePool::STATUS_WRITE);
+        reactor.ClearStatus(fd, waiter.expected);
+
+        // Errors are reported immediately because they are not repeated by edge-triggered reactor.
+        const uint16_t status = reactor.CheckSocketStatus(fd);
+        if ((status & SocketStatePool::STATUS_DELETE) != 0) {
+            LOG_ERROR("EventLoop.AddWaiter [", fd, "]: Socket descriptor is not registered in the reactor of thread.");
+            waiter.status = status | SocketStatePool::STATUS_ERROR;
+            return false;
+        }
+        if ((status & (write == true ? WRITE_STATUSES : READ_STATUSES)) != 0) {
+            waiter.status = status;
+            return false;
+        }
+
+        Waiter** slot = nullptr;
+        try
+        {
+            Descriptor& descriptor = waiters[fd];
+            slot = (write == true) ? &descriptor.writer : &descriptor.reader;
+            if (*slot != nullptr) {
+                LOG_ERROR("EventLoop.AddWaiter [", fd, "]: Socket descriptor is already awaited by another coroutine.");
+                waiter.status = SocketStatePool::STATUS_ERROR;
+                return false;
+            }
+
+        }
+        catch (const std::exception& err) {
+            LOG_ERROR("EventLoop.AddWaiter [", fd, "]: When adding waiter - '", err.what(), "'.");
+            waiter.status = SocketStatePool::STATUS_ERROR;
+            return false;
+        }
+
+        *slot = &waiter;
+        if (time >= 0)
+        {
+            waiter.timer.SetHandler(Expire, &waiter);
+            reactor.GetTimingWheel().Arm(waiter.timer, std::chrono::milliseconds(time));
+        }
+        return true;
+    }
+
+    // Resume the waiter of socket descriptor with the obtained statuses.
+    void EventLoop::Complete (Waiter*& waiter, const uint16_t status) noexcept
+    {
+        waiter->timer.Cancel();
+        waiter->status = status;
+        ready.push_back(waiter->handle);
+        waiter = nullptr;
+    }
+
+    // Resume the waiter with expired timeout.
+    void EventLoop::Expire (void* context) noexcept
+    {
+        auto* waiter = static_cast<Waiter*>(context);
+        EventLoop& loop = *waiter->loop;
+        const auto it = loop.waiters.find(waiter->fd);
+        if (it == loop.waiters.end()) { return; }
+
+        Waiter*& slot = (it->second.writer == waiter) ? it->second.writer : it->second.reader;
+        if (slot != waiter) { return; }
+        loop.Complete(slot, 0);
+        if (it->second.reader == nullptr && it->second.writer == nullptr) { loop.waiters.erase(it); }
+    }
+
+    // Resume the waiters of socket descriptors which are ready.
+    void EventLoop::Dispatch (const std::vector<int32_t>& descriptors) noexcept
+    {
+        for (const int32_t fd : descriptors)
+        {
+            if (fd == wakeup)
+            {
+                uint64_t counter = 0;
+                (void)read(wakeup, &counter, sizeof(counter));
+                continue;
+            }
+
+            const auto it = waiters.find(fd);
+            if (it == waiters.end()) { continue; }
+
+            const uint16_t status = reactor.CheckSocketStatus(fd);
+            if (it->second.reader != nullptr && (status & READ_STATUSES) != 0) { Complete(it->second.reader, status); }
+            if (it->second.writer != nullptr && (status & WRITE_STATUSES) != 0) { Complete(it->second.writer, status); }
+            if (it->second.reader == nullptr && it->second.writer == nullptr) { waiters.erase(it); }
+        }
+    }
+
+    // Return the waiting time of reactor (deadlines of waiters are taken into account by the reactor).
+    int32_t EventLoop::GetWaitingTime (void) noexcept
+    {
+        if (ready.empty() == false) { return 0; }
+        system::LockGuard lock(mutex);
+        return (posted.empty() == true) ? DEFAULT_LOOP_WAIT : 0;
+    }
+
+    bool EventLoop::Run (void) noexcept
+    {
+        std::vector<int32_t> descriptors;
+        std::vector<std::coroutine_handle<>> running;
+        stopped.store(false, std::memory_order_release);
+
+        while (active != 0 && stopped.load(std::memory_order_acquire) == false)
+        {
+            {
+                system::LockGuard lock(mutex);
+                ready.insert(ready.end(), posted.begin(), posted.end());
+                posted.clear();
+            }
+
+            // Coroutines which become ready during resumption are resumed at the next iteration.
+            running.swap(ready);
+            for (const std::coroutine_handle<> handle : running) { handle.resume(); }
+            running.clear();
+            if (active == 0) { break; }
+
+            descriptors.clear();
+            if (reactor.Poll(GetWaitingTime(), descriptors) == SOCKET_ERROR) {
+                LOG_ERROR("EventLoop.Run: Reactor is failed.");
+                return false;
+            }
+            Dispatch(descriptors);
+        }
+        return (active == 0);
+    }
+
+    // Stop the event loop after the current iteration (thread-safe).
+    void EventLoop::Stop (void) noexcept
+    {
+        stopped.store(true, std::memory_order_release);
+        const uint64_t counter = 1;
+        (void)write(wakeup, &counter, sizeof(counter));
+    }
+
+    void EventLoop::Post (std::coroutine_handle<> handle) noexcept
+    {
+        {
+            system::LockGuard lock(mutex);
+            try { posted.push_back(handle); }
+            catch (const std::exception& err) {
+                LOG_FATAL("EventLoop.Post: When adding coroutine - '", err.what(), "'.");
+                std::terminate();
+            }
+        }
+        const uint64_t counter = 1;
+        (void)write(wakeup, &counter, sizeof(counter));
+    }
+
+    EventLoop::~EventLoop (void) noexcept
+    {
+        if (wakeup != INVALID_SOCKET)
+        {
+            reactor.DeleteDescriptor(wakeup);
+            close(wakeup);
+        }
+    }
+
+
+    /**
+     * @struct ResolveAwaiter
+     * @brief Awaitable object which suspends the coroutine until the host is resolved by the resolver threads.
+     */
+    struct ResolveAwaiter
+    {
+        EventLoop & loop;
+        const char * host;
+        uint16_t port;
+        int32_t family;
+        int32_t type;
+        std::coroutine_handle<> handle = nullptr;
+        int32_t result = RESOLVER_NOT_CACHED;
+
+        // Resume the coroutine in the thread of event loop after the resolution.
+        static void Handler (const char* /*host*/, uint16_t /*port*/, const int32_t status, void* context) noexcept
+        {
+            auto* self = static_cast<ResolveAwaiter*>(context);
+            self->result = status;
+            self->loop.Post(self->handle);
+        }
+
+        bool await_ready(void) const noexcept { return false; }
+        bool await_suspend (std::coroutine_handle<> coroutine) noexcept
+        {
+            handle = coroutine;
+            if (ResolverCache::Instance().ResolveAsync(host, port, family, type, Handler, this) == false) {
+                result = EAI_FAIL;
+                return false;
+            }
+            return true;
+        }
+        int32_t await_resume(void) const noexcept { return result; }
+    };
+
+
+    // Wait until the socket is ready for the operation which returned SOCKET_WANT_READ or SOCKET_WANT_WRITE.
+    AsyncTask<bool> AsyncSocket::WaitFor (const int32_t want) noexcept
+    {
+        const uint16_t expected = (want == SOCKET_WANT_WRITE) ? SocketStatePool::STATUS_WRITE : SocketStatePool::STATUS_READ;
+        const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(socket.GetTimeout()).count();
+        const uint16_t status = co_await loop.Wait(socket.GetFd(), expected, static_cast<int32_t>(time));
+        if (status == 0) {
+            LOG_ERROR("AsyncSocket.WaitFor [", socket.GetFd(), "]: Timeout expired.");
+        }
+        co_return (status != 0);
+    }
+
+    AsyncTask<bool> AsyncSocket::AsyncConnect (const std::string host, const uint16_t port) noexcept
+    {
+        if (socket.GetFd() == INVALID_SOCKET) {
+            LOG_ERROR("AsyncSocket.AsyncConnect: Socket is invalid.");
+            co_return false;
+        }
+
+        std::vector<SocketAddress> addresses;
+        int32_t status = ResolverCache::Instance().Find(host.c_str(), port, socket.GetFamily(), socket.GetType(), addresses);
+        if (status == RESOLVER_NOT_CACHED)
+        {
+            status = co_await ResolveAwaiter { loop, host.c_str(), port, socket.GetFamily(), socket.GetType() };
+            if (status == RESOLVER_SUCCESS) {
+                status = ResolverCache::Instance().Find(host.c_str(), port, socket.GetFamily(), socket.GetType(), addresses);
+            }
+        }
+        if (status != RESOLVER_SUCCESS) {
+            LOG_ERROR("AsyncSocket.AsyncConnect [", socket.GetFd(), "]: Host '", host, "' is not resolved - ", gai_strerror(status));
+            socket.Close();
+            co_return false;
+        }
+
+        for (const SocketAddress& address : addresses)
+        {
+            int32_t result = socket.StartConnect(address, host.c_str());
+            if (result == SOCKET_WANT_WRITE)
+            {
+                const bool writable = co_await WaitFor(SOCKET_WANT_WRITE);
+                result = (writable == true) ? socket.FinishConnect() : SOCKET_ERROR;
+            }
+            if (result != SOCKET_SUCCESS) { continue; }
+
+            // SSL socket performs the handshake with the same name of server as in Connect method.
+            auto* secure = dynamic_cast<SocketSSL*>(&socket);
+            if (secure != nullptr && secure->SetServerNameIndication(host) == false) {
+                socket.Close();
+                co_return false;
+            }
+            if (secure != nullptr) { (void)secure->ResumeSession(host.c_str(), port); }
+            co_return co_await AsyncHandshake();
+        }
+
+        LOG_ERROR("AsyncSocket.AsyncConnect [", socket.GetFd(), "]: Connecting to '", host, "' failed.");
+        socket.Close();
+        co_return false;
+    }
+
+    // Perform the SSL handshake without blocking the thread (always true for Socket).
+    AsyncTask<bool> AsyncSocket::AsyncHandshake (void) noexcept
+    {
+        while (true)
+        {
+            const int32_t result = socket.TryHandshake();
+            if (result == SOCKET_SUCCESS) { co_return true; }
+            if (result == SOCKET_ERROR) { co_return false; }
+            if (co_await WaitFor(result) == false) {
+                socket.Close();
+                co_return false;
+            }
+        }
+    }
+
+    AsyncTask<bool> AsyncSocket::AsyncSend (const char* const data, std::size_t length) noexcept
+    {
+        if (socket.GetFd() == INVALID_SOCKET) {
+            LOG_ERROR("AsyncSocket.AsyncSend: Socket is invalid.");
+            co_return false;
+        }
+
+        // Check callback functor.
+        using functor = callbacks::SocketCallbackFunctorBeforeSend;
+        auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP);
+        if (callback != nullptr)
+        {
+            LOG_TRACE("AsyncSocket.AsyncSend [", socket.GetFd(), "]: Calling the SocketCallbackFunctorBeforeSend functor...");
+            callback->operator()(const_cast<char*>(data), &length);
+        }
+
+        std::size_t idx = 0;
+        while (idx != length)
+        {
+            const int32_t result = socket.TrySend(&data[idx], length - idx);
+            if (result > 0) {
+                idx += static_cast<std::size_t>(result);
+                continue;
+            }
+            if (result == SOCKET_ERROR) { co_return false; }
+            if (result == SOCKET_WANT_READ || result == SOCKET_WANT_WRITE)
+            {
+                // Coroutine is awaited in separate statement (GCC 12 evaluates co_await in short-circuit conditions incorrectly).
+                const bool ready = co_await WaitFor(result);
+                if (ready == true) { continue; }
+            }
+
+            socket.Close();
+            co_return false;
+        }
+        co_return true;
+    }
+
+    AsyncTask<int32_t> AsyncSocket::AsyncRecv (char* data, const std::size_t length) noexcept
+    {
+        if (socket.GetFd() == INVALID_SOCKET) {
+            LOG_ERROR("AsyncSocket.AsyncRecv: Socket is invalid.");
+            co_return SOCKET_ERROR;
+        }
+
+        while (true)
+        {
+            const int32_t result = socket.TryRecv(data, length);
+            if (result == SOCKET_WANT_READ || result == SOCKET_WANT_WRITE)
+            {
+                if (co_await WaitFor(result) == false) { co_return 0; }
+                continue;
+            }
+            if (result <= 0) { co_return result; }
+
+            // Check callback functor.
+            using functor = callbacks::SocketCallbackFunctorAfterReceive;
+            auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_AFTER_RECEIVE_TCP);
+            if (callback != nullptr)
+            {
+                LOG_TRACE("AsyncSocket.AsyncRecv [", socket.GetFd(), "]: Calling the SocketCallbackFunctorAfterReceive functor...");
+                callback->operator()(data, static_cast<std::size_t>(result));
+            }
+            co_return result;
+        }
+    }
+
+    AsyncTask<bool> AsyncSocket::AsyncRecv (char* data, const std::size_t length, std::size_t& obtainLength, Framer& framer) noexcept
+    {
+        obtainLength = 0;
+        if (socket.GetFd() == INVALID_SOCKET) {
+            LOG_ERROR("AsyncSocket.AsyncRecv: Socket is invalid.");
+            co_return false;
+        }
+
+        framer.Reset();
+        FRAME_STATE state = FRAME_NEED_MORE;
+        std::size_t idx = 0;
+        while (idx != length && state != FRAME_COMPLETE)
+        {
+            // Number of bytes is limited by framer, so the data of the next frame is not received.
+            const std::size_t expected = framer.Expected();
+            const std::size_t size = (expected != 0 && expected < length - idx) ? expected : length - idx;
+
+            const int32_t result = socket.TryRecv(&data[idx], size);
+            if (result == SOCKET_WANT_READ || result == SOCKET_WANT_WRITE)
+            {
+                if (co_await WaitFor(result) == false) { break; }
+                continue;
+            }
+            if (result == SOCKET_ERROR) { co_return false; }
+            if (result == 0) { break; }
+
+            state = framer.Feed(&data[idx], static_cast<std::size_t>(result));
+            idx += static_cast<std::size_t>(result);
+            // Stream position of the next frame is unknown after the format error.
+            if (state == FRAME_ERROR) {
+                LOG_ERROR("AsyncSocket.AsyncRecv [", socket.GetFd(), "]: Received data does not match the format of frame.");
+                socket.Close();
+                co_return false;
+            }
+        }
+
+        // Check callback functor.
+        using functor = callbacks::SocketCallbackFunctorAfterReceive;
+        auto callback = storage::GI.GetCallback<functor>(modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_AFTER_RECEIVE_TCP);
+        if (callback != nullptr)
+        {
+            LOG_TRACE("AsyncSocket.AsyncRecv [", socket.GetFd(), "]: Calling the SocketCallbackFunctorAfterReceive functor...");
+            callback->operator()(data, idx);
+        }
+
+        obtainLength = idx;
+        co_return (state == FRAME_COMPLETE);
+    }
+
+}  // namespace net.
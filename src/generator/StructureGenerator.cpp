@@ -0,0 +1,671 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+// Build-time generator that converts the protocol definition (config/ProtocolDefinition.json)
+// into C++ header with constexpr structure layouts, typed field accessors and validators
+// built on BinaryStructuredDataEngine class. Numeric accessors load and store the fields directly
+// by the constexpr offsets in network byte order with the declared signedness of the field.
+//
+// Usage: StructureGenerator <ProtocolDefinition.json> <Output.hpp>
+
+#include <limits>
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+
+#include "../../include/framework/Parser.hpp"
+
+
+using analyzer::framework::parser::JsonValue;
+using analyzer::framework::parser::JsonParser;
+
+
+namespace
+{
+    /**
+     * @struct FieldLayout
+     * @brief Structure that describes one field of the structure layout in the generated header.
+     */
+    struct FieldLayout
+    {
+        // Identifier of the field in generated code.
+        std::string name;
+        // Description of the field for documentation comment.
+        std::string description;
+        // Size of the field in bytes.
+        uint16_t size = 0;
+        // True if the field is a string (the field value is not converted to native integer).
+        bool isString = false;
+        // True if the field is declared as signed integer (i8, i16, i32 or i64).
+        bool isSigned = false;
+        // Numeric ranges of valid values.
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        // Numeric list of valid values.
+        std::vector<uint64_t> values;
+        // String list of valid values.
+        std::vector<std::string> strings;
+        // Name of the first subfield of composite field (empty for the field of structured data).
+        std::string anchor;
+    };
+
+    /**
+     * @struct RoundLayout
+     * @brief Structure that describes one round of the protocol in the generated header.
+     */
+    struct RoundLayout
+    {
+        // Identifier of the round in generated code.
+        std::string name;
+        // Name of the round in protocol definition.
+        std::string key;
+        // Description of the round for documentation comment.
+        std::string description;
+        // Fields of the round in the order of their placement.
+        std::vector<FieldLayout> fields;
+        // Composite fields with valid values that are checked over the sequence of their subfields.
+        std::vector<FieldLayout> composites;
+        // Messages about the skipped fields and the ignored valid values.
+        std::vector<std::string> skipped;
+    };
+
+
+    // Function that converts any string to the valid C++ identifier.
+    std::string toIdentifier (std::string_view name, std::string_view fallback)
+    {
+        std::string result;
+        for (const char symbol : name) {
+            result.push_back((std::isalnum(static_cast<unsigned char>(symbol)) != 0) ? symbol : '_');
+        }
+        if (result.empty() == true) { return std::string(fallback); }
+        if (std::isdigit(static_cast<unsigned char>(result[0])) != 0) { result.insert(result.begin(), '_'); }
+        return result;
+    }
+
+    // Function that returns the string member of JSON object or empty string.
+    std::string getString (const JsonValue& object, std::string_view key)
+    {
+        const JsonValue* const member = object.Find(key);
+        if (member != nullptr && member->AsString().has_value() == true) {
+            return std::string(member->AsString().value());
+        }
+        return { };
+    }
+
+    // Function that returns the size of the field in bytes by the type or the 'Size' member.
+    uint16_t getFieldSize (const JsonValue& field, std::string_view type)
+    {
+        const JsonValue* const size = field.Find("Size");
+        if (size != nullptr && size->AsNumber().has_value() == true)
+        {
+            const double value = size->AsNumber().value();
+            if (value > 0 && value <= std::numeric_limits<uint16_t>::max()) {
+                return static_cast<uint16_t>(value);
+            }
+            return 0;
+        }
+
+        if (type == "bool" || type == "char" || type == "i8") { return 1; }
+        if (type == "i16") { return 2; }
+        if (type == "i32" || type == "float") { return 4; }
+        if (type == "i64" || type == "double") { return 8; }
+        return 0;
+    }
+
+    // Function that returns the native type for the field of selected size and signedness.
+    std::string_view getNativeType (const uint16_t size, const bool isSigned)
+    {
+        if (size == 1) { return (isSigned == true) ? "int8_t" : "uint8_t"; }
+        if (size == 2) { return (isSigned == true) ? "int16_t" : "uint16_t"; }
+        if (size <= 4) { return (isSigned == true) ? "int32_t" : "uint32_t"; }
+        return (isSigned == true) ? "int64_t" : "uint64_t";
+    }
+
+    // Function that returns the maximum value of the field of selected size and signedness.
+    uint64_t getMaximumValue (const uint16_t size, const bool isSigned)
+    {
+        if (size >= 8) { return (isSigned == true) ? uint64_t(std::numeric_limits<int64_t>::max()) : std::numeric_limits<uint64_t>::max(); }
+        return (uint64_t(1) << (size * 8 - ((isSigned == true) ? 1 : 0))) - 1;
+    }
+
+    // Function that parses the numeric range in format 'first-last'.
+    bool parseRange (std::string_view range, std::pair<uint64_t, uint64_t>& result)
+    {
+        try
+        {
+            const std::size_t position = range.find('-');
+            if (position == std::string_view::npos) { return false; }
+            result.first = std::stoull(std::string(range.substr(0, position)));
+            result.second = std::stoull(std::string(range.substr(position + 1)));
+            return result.first <= result.second;
+        }
+        catch (const std::exception& /*err*/) { }
+        return false;
+    }
+
+    // Function that reads 'ValidValues' member of the field.
+    void parseValidValues (const JsonValue& field, FieldLayout& layout)
+    {
+        const JsonValue* const valid = field.Find("ValidValues");
+        if (valid == nullptr) { return; }
+
+        // Format: "ValidValues": [ "value1", "value2" ].
+        if (valid->Type() == JsonValue::JSON_ARRAY)
+        {
+            for (std::size_t idx = 0; idx < valid->Size(); ++idx)
+            {
+                if (valid->At(idx)->AsString().has_value() == true) {
+                    layout.strings.emplace_back(valid->At(idx)->AsString().value());
+                }
+                else if (valid->At(idx)->AsNumber().has_value() == true) {
+                    layout.values.push_back(static_cast<uint64_t>(valid->At(idx)->AsNumber().value()));
+                }
+            }
+            return;
+        }
+
+        // Format: "ValidValues": { "Range": "1-65535", "Values": [ 52, 37, 307 ] }.
+        const JsonValue* const range = valid->Find("Range");
+        if (range != nullptr && range->AsString().has_value() == true)
+        {
+            std::pair<uint64_t, uint64_t> bounds;
+            if (parseRange(range->AsString().value(), bounds) == true) {
+                layout.ranges.push_back(bounds);
+            }
+        }
+
+        const JsonValue* const values = valid->Find("Values");
+        if (values != nullptr)
+        {
+            for (std::size_t idx = 0; idx < values->Size(); ++idx)
+            {
+                if (values->At(idx)->AsNumber().has_value() == true) {
+                    layout.values.push_back(static_cast<uint64_t>(values->At(idx)->AsNumber().value()));
+                }
+            }
+        }
+    }
+
+    // Function that reports the numeric valid values which do not fit the type of the field (they are limited by the validator).
+    void checkValidValues (const FieldLayout& field, std::vector<std::string>& messages)
+    {
+        if (field.isString == true) { return; }
+
+        const uint64_t maximum = getMaximumValue(field.size, field.isSigned);
+        const std::string type(getNativeType(field.size, field.isSigned));
+        for (const auto& [first, last] : field.ranges)
+        {
+            const std::string range = std::to_string(first) + '-' + std::to_string(last);
+            if (first > maximum) {
+                messages.push_back("Range " + range + " of the field '" + field.name + "' is ignored: it is out of type " + type + ".");
+            }
+            else if (last > maximum) {
+                messages.push_back("Range " + range + " of the field '" + field.name + "' exceeds type " + type + ": it is limited to " +
+                                   std::to_string(first) + '-' + std::to_string(maximum) + ".");
+            }
+        }
+        for (const uint64_t value : field.values)
+        {
+            if (value > maximum) {
+                messages.push_back("Value " + std::to_string(value) + " of the field '" + field.name + "' is ignored: it is out of type " + type + ".");
+            }
+        }
+    }
+
+    // Function that reads all fields of the round.
+    RoundLayout parseRound (std::string_view key, const JsonValue& round)
+    {
+        RoundLayout layout;
+        layout.key = std::string(key);
+        layout.name = toIdentifier(getString(round, "Name"), key);
+        layout.description = getString(round, "Description");
+
+        const JsonValue* const fields = round.Find("Fields");
+        if (fields == nullptr || fields->Type() != JsonValue::JSON_ARRAY) { return layout; }
+
+        for (std::size_t idx = 0; idx < fields->Size(); ++idx)
+        {
+            const JsonValue& field = *fields->At(idx);
+            const std::string name = toIdentifier(getString(field, "Name"), "Field" + std::to_string(idx + 1));
+            const std::string type = getString(field, "Type");
+
+            // Composite field is flattened to the sequence of subfields.
+            const JsonValue* const definition = field.Find("Definition");
+            if (definition != nullptr && definition->Type() == JsonValue::JSON_ARRAY && definition->Size() != 0)
+            {
+                FieldLayout composite;
+                composite.name = name;
+                for (std::size_t jdx = 0; jdx < definition->Size(); ++jdx)
+                {
+                    const JsonValue& part = *definition->At(jdx);
+                    FieldLayout subfield;
+                    const JsonValue* const index = part.Find("Index");
+                    subfield.name = name + '_' + std::to_string((index != nullptr && index->AsNumber().has_value() == true) ?
+                                                                static_cast<std::size_t>(index->AsNumber().value()) : jdx + 1);
+                    subfield.description = "Part of the field '" + name + "'.";
+                    subfield.size = getFieldSize(part, getString(part, "Type"));
+                    subfield.isString = (subfield.size > 8);
+                    if (subfield.size == 0) {
+                        layout.skipped.push_back("Subfield '" + subfield.name + "' is skipped: size is not defined.");
+                        composite.size = 0;
+                        composite.anchor.clear();
+                        break;
+                    }
+                    if (composite.anchor.empty() == true) { composite.anchor = subfield.name; }
+                    composite.size = static_cast<uint16_t>(composite.size + subfield.size);
+                    parseValidValues(part, subfield);
+                    checkValidValues(subfield, layout.skipped);
+                    layout.fields.push_back(std::move(subfield));
+                }
+
+                // Valid values of composite field are checked over the whole sequence of its subfields.
+                parseValidValues(field, composite);
+                if (composite.ranges.empty() == true && composite.values.empty() == true && composite.strings.empty() == true) { continue; }
+                if (composite.anchor.empty() == true) {
+                    layout.skipped.push_back("Valid values of the field '" + name + "' are ignored: not all subfields are defined.");
+                    continue;
+                }
+                composite.description = getString(field, "Description");
+                composite.isString = (type == "string" || composite.size > 8);
+                if ((composite.isString == true && composite.strings.empty() == true) ||
+                    (composite.isString == false && composite.ranges.empty() == true && composite.values.empty() == true)) {
+                    layout.skipped.push_back("Valid values of the field '" + name + "' are ignored: they do not match the type of the field.");
+                    continue;
+                }
+                checkValidValues(composite, layout.skipped);
+                layout.composites.push_back(std::move(composite));
+                continue;
+            }
+
+            FieldLayout layoutField;
+            layoutField.name = name;
+            layoutField.description = getString(field, "Description");
+            layoutField.size = getFieldSize(field, type);
+            layoutField.isString = (type == "string" || layoutField.size > 8);
+            layoutField.isSigned = (type == "i8" || type == "i16" || type == "i32" || type == "i64");
+            if (layoutField.size == 0) {
+                layout.skipped.push_back("Field '" + name + "' is skipped: size is not defined.");
+                continue;
+            }
+            parseValidValues(field, layoutField);
+            checkValidValues(layoutField, layout.skipped);
+            layout.fields.push_back(std::move(layoutField));
+        }
+        return layout;
+    }
+
+    // Function that outputs the validator of numeric field.
+    void writeNumericValidator (std::ostream& out, const FieldLayout& field)
+    {
+        const std::string_view native = getNativeType(field.size, field.isSigned);
+        const uint64_t maximum = getMaximumValue(field.size, field.isSigned);
+        // Literals of unsigned field are compared without sign conversion.
+        const std::string_view suffix = (field.isSigned == true) ? "" : "U";
+
+        // Function that joins the conditions by logical OR.
+        const auto join = [] (const std::vector<std::string>& conditions) -> std::string
+        {
+            std::string result;
+            for (std::size_t idx = 0; idx < conditions.size(); ++idx) {
+                result += ((idx != 0) ? " || " : "") + conditions[idx];
+            }
+            return result;
+        };
+
+        std::vector<std::string> ranges, values;
+        for (const auto& [first, last] : field.ranges)
+        {
+            if (first > maximum) { continue; }
+            std::vector<std::string> bounds;
+            if (first != 0 || field.isSigned == true) { bounds.push_back("value >= " + std::to_string(first) + std::string(suffix)); }
+            if (last < maximum) { bounds.push_back("value <= " + std::to_string(last) + std::string(suffix)); }
+            if (bounds.empty() == true) { ranges.emplace_back("true"); }
+            else if (bounds.size() == 1) { ranges.push_back(bounds[0]); }
+            else { ranges.push_back("(" + bounds[0] + " && " + bounds[1] + ")"); }
+        }
+        for (const uint64_t value : field.values)
+        {
+            if (value <= maximum) { values.push_back("value == " + std::to_string(value) + std::string(suffix)); }
+        }
+        // All valid values are out of type of the field, so no value is valid.
+        if (field.ranges.empty() == false && ranges.empty() == true) { ranges.emplace_back("false"); }
+        if (field.values.empty() == false && values.empty() == true) { values.emplace_back("false"); }
+
+        // The value MUST be in one of the ranges and MUST be one of the listed values (if they are defined).
+        std::string condition;
+        if (ranges.empty() == false && values.empty() == false) { condition = "(" + join(ranges) + ")\n                && (" + join(values) + ")"; }
+        else if (ranges.empty() == false) { condition = join(ranges); }
+        else { condition = join(values); }
+
+        out << "        /**\n"
+            << "         * @fn static constexpr bool IsValid" << field.name << " (" << native << ") noexcept;\n"
+            << "         * @brief Method that checks the value of the field '" << field.name << "' by the list of valid values.\n"
+            << "         */\n"
+            << "        static constexpr bool IsValid" << field.name << " (const " << native << " value) noexcept\n"
+            << "        {\n"
+            << "            return " << condition << ";\n"
+            << "        }\n\n";
+    }
+
+    // Function that outputs the validator of string field.
+    void writeStringValidator (std::ostream& out, const FieldLayout& field)
+    {
+        out << "        /**\n"
+            << "         * @fn static bool IsValid" << field.name << " (const types::BinaryStructuredDataEngine &) noexcept;\n"
+            << "         * @brief Method that checks the value of the field '" << field.name << "' by the list of valid values.\n"
+            << "         */\n"
+            << "        static bool IsValid" << field.name << " (const types::BinaryStructuredDataEngine& engine) noexcept\n"
+            << "        {\n"
+            << "            const std::byte* const field = engine.Data().Data() + Offsets[" << ((field.anchor.empty() == true) ? field.name : field.anchor) << "];\n"
+            << "            const std::string_view value(reinterpret_cast<const char*>(field), "
+            << ((field.anchor.empty() == true) ? "Pattern[" + field.name + "]" : std::to_string(field.size)) << ");\n"
+            << "            return ";
+        for (std::size_t idx = 0; idx < field.strings.size(); ++idx)
+        {
+            // The string value is compared with the stored value supplemented with zero bytes.
+            std::ostringstream literal;
+            for (const char symbol : field.strings[idx]) {
+                if (symbol == '"' || symbol == '\\') { literal << '\\' << symbol; }
+                else if (std::isprint(static_cast<unsigned char>(symbol)) != 0) { literal << symbol; }
+                else {
+                    char escaped[8] = { };
+                    std::snprintf(escaped, sizeof(escaped), "\\%03o", static_cast<unsigned char>(symbol));
+                    literal << escaped;
+                }
+            }
+            out << ((idx != 0) ? "\n                || " : "")
+                << "IsEqualString(value, \"" << literal.str() << "\")";
+        }
+        out << ";\n"
+            << "        }\n\n";
+    }
+
+    // Function that outputs the structure of one round.
+    void writeRound (std::ostream& out, const RoundLayout& round, std::string_view section)
+    {
+        out << "    /**\n"
+            << "     * @struct " << round.name << "\n"
+            << "     * @brief Structure layout of the " << section << " round '" << round.key << "'";
+        if (round.description.empty() == false) { out << ": " << round.description; }
+        out << ".\n";
+        for (const std::string& message : round.skipped) {
+            out << "     *\n"
+                << "     * @note " << message << "\n";
+        }
+        out << "     */\n"
+            << "    struct " << round.name << "\n"
+            << "    {\n";
+
+        // Indexes of the fields.
+        out << "        /**\n"
+            << "         * @enum FIELD\n"
+            << "         * @brief Indexes of the fields in structured data.\n"
+            << "         */\n"
+            << "        enum FIELD : uint16_t\n"
+            << "        {\n";
+        for (std::size_t idx = 0; idx < round.fields.size(); ++idx)
+        {
+            out << "            " << round.fields[idx].name << " = " << idx << ((idx + 1 != round.fields.size()) ? "," : "");
+            if (round.fields[idx].description.empty() == false) { out << "  // " << round.fields[idx].description; }
+            out << "\n";
+        }
+        out << "        };\n\n";
+
+        // Constexpr layout of the round.
+        std::size_t offset = 0;
+        std::ostringstream pattern, offsets;
+        offsets << "0";
+        for (std::size_t idx = 0; idx < round.fields.size(); ++idx)
+        {
+            offset += round.fields[idx].size;
+            pattern << ((idx != 0) ? ", " : "") << round.fields[idx].size;
+            offsets << ", " << offset;
+        }
+        out << "        static constexpr uint16_t FieldsCount = " << round.fields.size() << ";\n"
+            << "        static constexpr uint16_t Pattern[FieldsCount] = { " << pattern.str() << " };\n"
+            << "        static constexpr std::size_t Offsets[FieldsCount + 1] = { " << offsets.str() << " };\n"
+            << "        static constexpr std::size_t ByteSize = Offsets[FieldsCount];\n\n"
+            << "        static_assert(ByteSize == " << offset << ", \"Invalid structure layout.\");\n\n";
+
+        // Construction of the structured data.
+        out << "        /**\n"
+            << "         * @fn static types::BinaryStructuredDataEngine Create() noexcept;\n"
+            << "         * @brief Method that creates empty structured data of the round in network byte order.\n"
+            << "         * @return Structured data of the round.\n"
+            << "         *\n"
+            << "         * @attention Need to check existence of data after use this method.\n"
+            << "         */\n"
+            << "        static types::BinaryStructuredDataEngine Create(void) noexcept\n"
+            << "        {\n"
+            << "            types::BinaryStructuredDataEngine engine(types::DATA_BIG_ENDIAN);\n"
+            << "            engine.CreateTemplate(Pattern, FieldsCount);\n"
+            << "            return engine;\n"
+            << "        }\n\n"
+            << "        /**\n"
+            << "         * @fn static types::BinaryStructuredDataEngine Decode (const std::byte *, std::size_t) noexcept;\n"
+            << "         * @brief Method that creates structured data of the round from the received data in network byte order.\n"
+            << "         * @param [in] data - Pointer to the received data.\n"
+            << "         * @param [in] length - Length of the received data.\n"
+            << "         * @return Structured data of the round or empty structured data if the length is not equal to ByteSize.\n"
+            << "         */\n"
+            << "        static types::BinaryStructuredDataEngine Decode (const std::byte* data, const std::size_t length) noexcept\n"
+            << "        {\n"
+            << "            constexpr uint8_t mode = types::DATA_MODE_INDEPENDENT | types::DATA_MODE_SAFE_OPERATOR | types::DATA_MODE_ALLOCATION | types::DATA_MODE_OPERATOR_ALIGN_LOW_ORDER;\n"
+            << "            types::BinaryDataEngine buffer(mode, types::DATA_BIG_ENDIAN);\n"
+            << "            if (data == nullptr || length != ByteSize || buffer.AssignData(data, length) == false) {\n"
+            << "                return types::BinaryStructuredDataEngine(types::DATA_BIG_ENDIAN);\n"
+            << "            }\n"
+            << "            return types::BinaryStructuredDataEngine(buffer, Pattern, FieldsCount, types::DATA_BIG_ENDIAN);\n"
+            << "        }\n\n";
+
+        // Typed accessors and validators.
+        bool hasValidators = false;
+        for (const FieldLayout& field : round.fields)
+        {
+            if (field.isString == true)
+            {
+                out << "        static types::BinaryDataEngine Get" << field.name << " (const types::BinaryStructuredDataEngine& engine) noexcept {\n"
+                    << "            return engine.GetField<types::DATA_MODE_DEFAULT, types::DATA_BIG_ENDIAN>(" << field.name << ");\n"
+                    << "        }\n\n";
+                if (field.strings.empty() == false) {
+                    writeStringValidator(out, field);
+                    hasValidators = true;
+                }
+                continue;
+            }
+
+            // The field is accessed directly by the constexpr offset without the runtime lookup of the layout.
+            const std::string_view native = getNativeType(field.size, field.isSigned);
+            out << "        static " << native << " Get" << field.name << " (const types::BinaryStructuredDataEngine& engine) noexcept {\n"
+                << "            if (engine.ByteSize() != ByteSize) { return " << native << "(); }\n"
+                << "            return LoadField<" << native << ", Pattern[" << field.name << "]>(engine.Data().Data() + Offsets[" << field.name << "]);\n"
+                << "        }\n"
+                << "        static bool Set" << field.name << " (const types::BinaryStructuredDataEngine& engine, const " << native << " value) noexcept {\n"
+                << "            if (engine.ByteSize() != ByteSize) { return false; }\n"
+                << "            StoreField<" << native << ", Pattern[" << field.name << "]>(const_cast<std::byte*>(engine.Data().Data()) + Offsets[" << field.name << "], value);\n"
+                << "            return true;\n"
+                << "        }\n\n";
+            if (field.ranges.empty() == false || field.values.empty() == false) {
+                writeNumericValidator(out, field);
+                hasValidators = true;
+            }
+        }
+        for (const FieldLayout& composite : round.composites)
+        {
+            if (composite.isString == true) { writeStringValidator(out, composite); }
+            else { writeNumericValidator(out, composite); }
+            hasValidators = true;
+        }
+
+        // Validation of all fields.
+        out << "        /**\n"
+            << "         * @fn static bool Validate (const types::BinaryStructuredDataEngine &) noexcept;\n"
+            << "         * @brief Method that checks the layout of structured data and the values of all fields with the list of valid values.\n"
+            << "         * @param [in] engine - Structured data of the round.\n"
+            << "         * @return True - if structured data is valid, otherwise - false.\n"
+            << "         */\n"
+            << "        static bool Validate (const types::BinaryStructuredDataEngine& engine) noexcept\n"
+            << "        {\n"
+            << "            if (engine.ByteSize() != ByteSize || engine.FieldsCount() != FieldsCount) { return false; }\n";
+        if (hasValidators == true)
+        {
+            out << "            return ";
+            bool first = true;
+            for (const FieldLayout& field : round.fields)
+            {
+                if (field.isString == true && field.strings.empty() == false) {
+                    out << ((first == false) ? "\n                && " : "") << "IsValid" << field.name << "(engine)";
+                    first = false;
+                }
+                else if (field.isString == false && (field.ranges.empty() == false || field.values.empty() == false)) {
+                    out << ((first == false) ? "\n                && " : "") << "IsValid" << field.name << "(Get" << field.name << "(engine))";
+                    first = false;
+                }
+            }
+            // Composite fields are checked after their subfields.
+            for (const FieldLayout& composite : round.composites)
+            {
+                out << ((first == false) ? "\n                && " : "") << "IsValid" << composite.name;
+                if (composite.isString == true) { out << "(engine)"; }
+                else {
+                    out << "(LoadField<" << getNativeType(composite.size, composite.isSigned) << ", " << composite.size
+                        << ">(engine.Data().Data() + Offsets[" << composite.anchor << "]))";
+                }
+                first = false;
+            }
+            out << ";\n";
+        }
+        else { out << "            return true;\n"; }
+        out << "        }\n"
+            << "    };\n\n";
+    }
+
+    // Function that outputs all rounds of the section (Request or Response).
+    void writeSection (std::ostream& output, const JsonValue* section, std::string_view name)
+    {
+        std::ostringstream out;
+        out << "namespace " << name << "\n"
+            << "{\n";
+        if (section != nullptr && section->Type() == JsonValue::JSON_OBJECT)
+        {
+            for (std::size_t idx = 0; idx < section->Size(); ++idx)
+            {
+                const RoundLayout round = parseRound(section->KeyAt(idx), *section->At(idx));
+                for (const std::string& message : round.skipped) {
+                    std::cerr << "[warning] " << name << " round '" << round.key << "': " << message << std::endl;
+                }
+                if (round.fields.empty() == true) {
+                    out << "    // Round '" << round.key << "' is skipped: no fields with defined size.\n\n";
+                    continue;
+                }
+                writeRound(out, round, name);
+            }
+        }
+        out << "}  // namespace " << name << ".\n\n";
+
+        // All sections are nested in the namespace of the protocol.
+        std::istringstream lines(out.str());
+        std::string line;
+        while (std::getline(lines, line)) {
+            output << ((line.empty() == false) ? "    " : "") << line << '\n';
+        }
+    }
+
+}  // namespace.
+
+
+int32_t main (int32_t size, char** data)
+{
+    if (size != 3) {
+        std::cerr << "Usage: " << data[0] << " <ProtocolDefinition.json> <Output.hpp>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto definition = JsonParser::ParseFile(data[1]);
+    if (definition.has_value() == false) {
+        std::cerr << "[error] Cannot parse protocol definition '" << data[1] << "'." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const JsonValue* const protocol = definition->Find("Protocol");
+    if (protocol == nullptr || protocol->Type() != JsonValue::JSON_OBJECT) {
+        std::cerr << "[error] Protocol definition does not contain 'Protocol' object." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string name = toIdentifier(getString(*protocol, "Name"), "Protocol");
+    std::string guard = "PROTOCOL_ANALYZER_GENERATED_" + name + "_HPP";
+    std::transform(guard.begin(), guard.end(), guard.begin(), [] (const char symbol) { return static_cast<char>(std::toupper(static_cast<unsigned char>(symbol))); });
+
+    std::ostringstream out;
+    out << "// ============================================================================\n"
+        << "// This file is generated by StructureGenerator from the protocol definition.\n"
+        << "// All changes in this file will be lost after regeneration.\n"
+        << "// ============================================================================\n\n"
+        << "#ifndef " << guard << "\n"
+        << "#define " << guard << "\n\n"
+        << "#include <cstddef>\n"
+        << "#include <string_view>\n"
+        << "#include <type_traits>\n\n"
+        << "#include \"BinaryStructuredDataEngine.hpp\"\n\n\n"
+        << "/**\n"
+        << " * @namespace analyzer::framework::net::protocols::" << name << "\n"
+        << " * @brief Structure layouts of the protocol '" << getString(*protocol, "Name") << "'";
+    const std::string description = getString(*protocol, "Description");
+    if (description.empty() == false) { out << ": " << description; }
+    out << ".\n"
+        << " */\n"
+        << "namespace analyzer::framework::net::protocols::" << name << "\n"
+        << "{\n"
+        << "    namespace types = analyzer::framework::common::types;\n\n"
+        << "    // Function that compares the stored string field with the valid value supplemented with zero bytes.\n"
+        << "    static inline bool IsEqualString (std::string_view value, std::string_view valid) noexcept\n"
+        << "    {\n"
+        << "        if (valid.size() > value.size() || value.compare(0, valid.size(), valid) != 0) { return false; }\n"
+        << "        return value.find_first_not_of('\\0', valid.size()) == std::string_view::npos;\n"
+        << "    }\n\n"
+        << "    // Function that loads the field of selected size stored in network byte order (signed value is sign-extended).\n"
+        << "    template <typename Type, std::size_t Size>\n"
+        << "    static inline Type LoadField (const std::byte* memory) noexcept\n"
+        << "    {\n"
+        << "        static_assert(std::is_integral<Type>::value == true && Size != 0 && Size <= sizeof(Type), \"Invalid field type.\");\n"
+        << "        uint64_t result = 0;\n"
+        << "        for (std::size_t idx = 0; idx < Size; ++idx) {\n"
+        << "            result = (result << 8) | std::to_integer<uint64_t>(memory[idx]);\n"
+        << "        }\n"
+        << "        if constexpr (std::is_signed<Type>::value == true && Size < sizeof(uint64_t)) {\n"
+        << "            if (((result >> (Size * 8 - 1)) & 1U) != 0) { result |= ~uint64_t(0) << (Size * 8); }\n"
+        << "        }\n"
+        << "        return static_cast<Type>(result);\n"
+        << "    }\n\n"
+        << "    // Function that stores the field of selected size in network byte order (high-order bits that do not fit are ignored).\n"
+        << "    template <typename Type, std::size_t Size>\n"
+        << "    static inline void StoreField (std::byte* memory, const Type value) noexcept\n"
+        << "    {\n"
+        << "        static_assert(std::is_integral<Type>::value == true && Size != 0 && Size <= sizeof(Type), \"Invalid field type.\");\n"
+        << "        auto rest = static_cast<uint64_t>(static_cast<std::make_unsigned_t<Type>>(value));\n"
+        << "        for (std::size_t idx = Size; idx > 0; --idx) {\n"
+        << "            memory[idx - 1] = static_cast<std::byte>(rest & 0xFFU);\n"
+        << "            rest >>= 8;\n"
+        << "        }\n"
+        << "    }\n\n";
+
+    writeSection(out, protocol->Find("Request"), "request");
+    writeSection(out, protocol->Find("Response"), "response");
+
+    out << "}  // namespace " << name << ".\n\n\n"
+        << "#endif  // " << guard << "\n";
+
+    std::ofstream output(data[2], std::ios_base::out | std::ios_base::trunc);
+    if (output.is_open() == false || (output << out.str()).good() == false) {
+        std::cerr << "[error] Cannot write output file '" << data[2] << "'." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
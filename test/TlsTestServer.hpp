@@ -0,0 +1,115 @@
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#ifndef PROTOCOL_ANALYZER_TLS_TEST_SERVER_HPP
+#define PROTOCOL_ANALYZER_TLS_TEST_SERVER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+
+// Fixture of TLS tests: self-signed server context, listener on loopback interface and server loop.
+namespace test
+{
+    // Create the self-signed certificate for "localhost" and its EC key.
+    inline bool CreateCertificate (EVP_PKEY*& key, X509*& certificate)
+    {
+        key = nullptr;
+        certificate = nullptr;
+        EVP_PKEY_CTX* generator = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        if (generator == nullptr || EVP_PKEY_keygen_init(generator) != 1 ||
+            EVP_PKEY_CTX_set_ec_paramgen_curve_nid(generator, NID_X9_62_prime256v1) != 1 || EVP_PKEY_keygen(generator, &key) != 1) {
+            EVP_PKEY_CTX_free(generator);
+            return false;
+        }
+        EVP_PKEY_CTX_free(generator);
+
+        certificate = X509_new();
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+        X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+        X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+        X509_set_pubkey(certificate, key);
+        X509_NAME* name = X509_get_subject_name(certificate);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+        X509_set_issuer_name(certificate, name);
+        return (X509_sign(certificate, key, EVP_sha256()) != 0);
+    }
+
+    // Create the server context with self-signed certificate (nullptr - error).
+    inline SSL_CTX* CreateServerContext (void)
+    {
+        EVP_PKEY* key = nullptr;
+        X509* certificate = nullptr;
+        SSL_CTX* ctx = (CreateCertificate(key, certificate) == true) ? SSL_CTX_new(TLS_server_method()) : nullptr;
+        if (ctx != nullptr && (SSL_CTX_use_certificate(ctx, certificate) != 1 || SSL_CTX_use_PrivateKey(ctx, key) != 1))
+        {
+            SSL_CTX_free(ctx);
+            ctx = nullptr;
+        }
+        X509_free(certificate);
+        EVP_PKEY_free(key);
+        return ctx;
+    }
+
+    // Open the listener on loopback interface and return its port (negative value - error).
+    inline int32_t OpenListener (uint16_t& port, const int32_t backlog = 64)
+    {
+        const int32_t listener = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in address = { };
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, backlog) != 0 ||
+            getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &length) != 0) {
+            close(listener);
+            return -1;
+        }
+        port = ntohs(address.sin_port);
+        return listener;
+    }
+
+    // Server exchange which answers "pong" to "ping" after the handshake.
+    inline void AnswerPong (SSL* ssl)
+    {
+        char buffer[4];
+        if (SSL_accept(ssl) == 1 && SSL_read(ssl, buffer, sizeof(buffer)) == sizeof(buffer)) {
+            (void)SSL_write(ssl, "pong", 4);
+        }
+    }
+
+    // Server exchange which only accepts the handshake.
+    inline void AcceptHandshake (SSL* ssl)
+    {
+        (void)SSL_accept(ssl);
+    }
+
+    // Server which accepts the selected number of connections and runs the exchange (handshake is included) for each of them.
+    template <typename Exchange>
+    void Serve (SSL_CTX* ctx, const int32_t listener, const std::size_t count, Exchange exchange)
+    {
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            const int32_t fd = accept(listener, nullptr, nullptr);
+            SSL* ssl = SSL_new(ctx);
+            SSL_set_fd(ssl, fd);
+            exchange(ssl);
+            if (SSL_is_init_finished(ssl) == 1) { (void)SSL_shutdown(ssl); }
+            SSL_free(ssl);
+            close(fd);
+        }
+    }
+
+}  // namespace test.
+
+
+#endif  // PROTOCOL_ANALYZER_TLS_TEST_SERVER_HPP
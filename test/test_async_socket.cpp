@@ -0,0 +1,135 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <memory>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+#include "../include/framework/AsyncSocket.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_SESSIONS   256
+
+
+// Function that echoes one length-prefixed frame for each accepted connection.
+static void Echo (const int32_t listener, const std::size_t count) noexcept
+{
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        const int32_t server = accept(listener, nullptr, nullptr);
+        char buffer[1024] = { };
+        std::size_t received = 0;
+        while (received < 2 || received < 2 + static_cast<std::size_t>(static_cast<uint8_t>(buffer[0]) << 8U | static_cast<uint8_t>(buffer[1])))
+        {
+            const ssize_t result = recv(server, buffer + received, sizeof(buffer) - received, 0);
+            if (result <= 0) { break; }
+            received += static_cast<std::size_t>(result);
+        }
+        send(server, buffer, received, 0);
+        close(server);
+    }
+}
+
+// Session which sends the frame and receives the echo.
+static net::AsyncTask<void> Session (const uint16_t port, const std::size_t number, std::size_t& completed) noexcept
+{
+    net::Socket socket;
+    net::AsyncSocket connection(socket);
+    if (co_await connection.AsyncConnect("127.0.0.1", port) == false) { co_return; }
+
+    const std::string body = "session " + std::to_string(number);
+    std::string frame = { static_cast<char>(body.size() >> 8U), static_cast<char>(body.size() & 0xFFU) };
+    frame += body;
+    if (co_await connection.AsyncSend(frame.data(), frame.size()) == false) { co_return; }
+
+    char buffer[1024] = { };
+    std::size_t obtained = 0;
+    net::LengthPrefixFramer framer(2);
+    const bool received = co_await connection.AsyncRecv(buffer, sizeof(buffer), obtained, framer);
+    if (received == true && std::string(buffer, obtained) == frame) {
+        completed++;
+    }
+}
+
+// Session which waits the data from the host that never responds.
+static net::AsyncTask<void> Silent (const uint16_t port, bool& expired) noexcept
+{
+    net::Socket socket(AF_INET, SOCK_STREAM, IPPROTO_TCP, 1);
+    net::AsyncSocket connection(socket);
+    if (co_await connection.AsyncConnect("127.0.0.1", port) == false) { co_return; }
+
+    char buffer[16] = { };
+    expired = (co_await connection.AsyncRecv(buffer, sizeof(buffer)) == 0);
+}
+
+// Function that creates the listener on loopback interface.
+static int32_t Listen (uint16_t& port) noexcept
+{
+    const int32_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 1024) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return INVALID_SOCKET;
+    }
+    port = ntohs(address.sin_port);
+    return listener;
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    uint16_t port = 0, silentPort = 0;
+    const int32_t listener = Listen(port);
+    const int32_t silent = Listen(silentPort);
+    if (listener == INVALID_SOCKET || silent == INVALID_SOCKET) {
+        std::cout << "[error] Listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // All sessions are performed concurrently by one thread.
+    std::thread server(Echo, listener, NUMBER_OF_SESSIONS);
+    net::EventLoop& loop = net::EventLoop::Instance();
+    std::size_t completed = 0;
+    bool expired = false;
+    loop.Spawn(Silent(silentPort, expired));
+    for (std::size_t idx = 0; idx < NUMBER_OF_SESSIONS; ++idx) {
+        loop.Spawn(Session(port, idx, completed));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool finished = loop.Run();
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    server.join();
+
+    std::cout << "Completed sessions: " << completed << " of " << NUMBER_OF_SESSIONS << " in " << duration << " ms." << std::endl;
+    if (finished == false || completed != NUMBER_OF_SESSIONS) {
+        std::cout << "[error] Async sessions fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (expired == false) {
+        std::cout << "[error] Async timeout fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    close(silent);
+    close(listener);
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+namespace types = analyzer::framework::common::types;
+using analyzer::framework::common::types::BinaryStructuredDataEngine;
+
+
+int32_t main (int32_t size, char** data)
+{
+    // IPv4 header: Version, IHL, DSCP, ECN, Total Length, Identification, Flags, Fragment Offset, TTL, Protocol, Checksum.
+    const uint16_t bit_pattern[11] = { 4, 4, 6, 2, 16, 16, 3, 13, 8, 8, 16 };
+    const uint8_t header[12] = { 0x45, 0x00, 0x00, 0x54, 0xAB, 0xCD, 0x40, 0x00, 0x40, 0x01, 0x12, 0x34 };
+
+    BinaryStructuredDataEngine packed;
+    if (packed.AssignData(&header, bit_pattern, 11, types::PATTERN_BITS) == false) {
+        std::cout << "[error] AssignData with bit-pattern fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << packed.ToFormattedString() << std::endl << std::endl;
+
+    const uint64_t expected[11] = { 4, 5, 0, 0, 0x54, 0xABCD, 2, 0, 64, 1, 0x1234 };
+    for (uint16_t field = 0; field < 11; ++field)
+    {
+        const auto value = packed.GetBitField<uint64_t>(field);
+        std::cout << "Field " << field + 1 << ": " << value << std::endl;
+        if (value != expected[field]) {
+            std::cout << "[error] GetBitField fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 20-bit and 3-bit fields do not overlap neighbours.
+    const uint16_t odd_pattern[4] = { 3, 20, 13, 4 };
+    BinaryStructuredDataEngine fields;
+    if (fields.CreateTemplate(odd_pattern, 4, types::PATTERN_BITS) == false || fields.ByteSize() != 5) {
+        std::cout << "[error] CreateTemplate with bit-pattern fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    fields.SetBitField<uint8_t>(0, 0x05);
+    fields.SetBitField<uint32_t>(1, 0xFEDCB);
+    fields.SetBitField<uint16_t>(2, 0x1ABC);
+    fields.SetBitField<uint8_t>(3, 0x09);
+    std::cout << fields << std::endl;
+
+    if (fields.GetBitField<uint8_t>(0) != 0x05 || fields.GetBitField<uint32_t>(1) != 0xFEDCB ||
+        fields.GetBitField<uint16_t>(2) != 0x1ABC || fields.GetBitField<uint8_t>(3) != 0x09 ||
+        fields.GetFieldBit(1, 0) == false || fields.GetFieldBit(1, 2) == true) {
+        std::cout << "[error] SetBitField fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Byte pattern in both endian types.
+    const uint16_t byte_pattern[3] = { 2, 1, 4 };
+    BinaryStructuredDataEngine little(types::DATA_LITTLE_ENDIAN);
+    little.CreateTemplate(byte_pattern, 3);
+    little.SetBitField<uint32_t>(2, 0x11223344);
+    little.SetField<types::DATA_SYSTEM_ENDIAN, uint16_t>(0, 0xBEEF);
+    if (little.GetBitField<uint32_t>(2) != 0x11223344 || little.GetBitField<uint16_t>(0) != 0xBEEF) {
+        std::cout << "[error] Bulk access with byte-pattern fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_WORKERS     4
+#define NUMBER_OF_FLOWS       64
+#define DATAGRAMS_PER_FLOW    200
+#define FANOUT_TEST_PORT      47124
+#define FANOUT_TEST_MARKER    "fanout-marker"
+
+
+// Analysis state which is owned by one capture worker.
+struct FlowState
+{
+    std::atomic<uint64_t> captured = 0;
+    std::vector<uint32_t> datagrams = std::vector<uint32_t>(65536, 0);
+};
+
+// Function that counts the test datagrams by source port in the thread of worker.
+static void OnFrame (const net::CapturedFrame& frame, void* context) noexcept
+{
+    const std::size_t markerLength = sizeof(FANOUT_TEST_MARKER) - 1;
+    if (frame.type != PACKET_HOST || frame.protocol != ETH_P_IP || frame.data.Size() != ETH_HLEN + 28 + markerLength) { return; }
+    const std::byte* packet = frame.data.Data() + ETH_HLEN;
+    if (packet[9] != std::byte(IPPROTO_UDP) || memcmp(packet + 28, FANOUT_TEST_MARKER, markerLength) != 0) { return; }
+
+    auto* state = static_cast<FlowState*>(context);
+    const auto port = static_cast<uint16_t>(std::to_integer<uint16_t>(packet[20]) << 8 | std::to_integer<uint16_t>(packet[21]));
+    state->datagrams[port]++;
+    state->captured.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    struct sockaddr_in address = { };
+    address.sin_family = AF_INET;
+    address.sin_port = htons(FANOUT_TEST_PORT);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    // Receiver prevents the ICMP errors which contain the copy of datagram.
+    const int32_t receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    if (receiver == -1 || bind(receiver, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cout << "[error] Open UDP receiver fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    // Each sender is a separate flow with its own source port.
+    int32_t senders[NUMBER_OF_FLOWS];
+    for (int32_t& fd : senders) { fd = socket(AF_INET, SOCK_DGRAM, 0); }
+
+    const std::pair<uint16_t, const char*> modes[] = {
+        { PACKET_FANOUT_HASH, "hash" }, { PACKET_FANOUT_LB, "round-robin" }, { PACKET_FANOUT_CPU, "cpu" }, { PACKET_FANOUT_ROLLOVER, "rollover" }
+    };
+    for (const auto& [mode, name] : modes)
+    {
+        FlowState states[NUMBER_OF_WORKERS];
+        std::vector<void*> contexts;
+        for (FlowState& state : states) { contexts.push_back(&state); }
+
+        net::CaptureSession session(1U << 16, 32, 10);
+        if (session.Start("lo", contexts, OnFrame, mode) == false || session.Size() != NUMBER_OF_WORKERS) {
+            std::cout << "[error] Start capture session in " << name << " mode fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const std::size_t total = NUMBER_OF_FLOWS * DATAGRAMS_PER_FLOW;
+        std::size_t captured = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t idx = 0; idx < DATAGRAMS_PER_FLOW; ++idx)
+        {
+            for (const int32_t fd : senders) {
+                (void)sendto(fd, FANOUT_TEST_MARKER, sizeof(FANOUT_TEST_MARKER) - 1, 0, reinterpret_cast<struct sockaddr*>(&address), sizeof(address));
+            }
+            // Senders are slowed down when the workers are behind, so the rings are not overflowed.
+            if (idx % 16 == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+        }
+        while (captured < total && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            captured = 0;
+            for (const FlowState& state : states) { captured += state.captured.load(std::memory_order_relaxed); }
+        }
+        session.Stop();
+
+        std::cout << "Mode '" << name << "': captured " << captured << " of " << total << " datagrams." << std::endl;
+        std::size_t busy = 0;
+        for (std::size_t idx = 0; idx < NUMBER_OF_WORKERS; ++idx)
+        {
+            net::CaptureWorkerStatistics statistics;
+            if (session.GetStatistics(idx, statistics) == false) {
+                std::cout << "[error] Get statistics of worker fail..." << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::cout << "    Worker " << idx << ": frames " << statistics.frames << " (" << static_cast<uint64_t>(statistics.framesPerSecond)
+                      << " fps), kernel packets " << statistics.kernel.packets << ", drops " << statistics.kernel.drops << std::endl;
+            if (statistics.frames < states[idx].captured || statistics.kernel.packets < statistics.frames) {
+                std::cout << "[error] Statistics of worker fail..." << std::endl;
+                return EXIT_FAILURE;
+            }
+            if (statistics.frames != 0) { busy++; }
+        }
+
+        if (captured != total) {
+            std::cout << "[error] Capture in " << name << " mode fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        // Frames of one flow are processed by one worker in hash mode.
+        if (mode == PACKET_FANOUT_HASH)
+        {
+            for (std::size_t port = 0; port < 65536; ++port)
+            {
+                std::size_t owners = 0;
+                for (const FlowState& state : states) { owners += (state.datagrams[port] != 0) ? 1 : 0; }
+                if (owners > 1) {
+                    std::cout << "[error] Flow " << port << " is split between workers..." << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        if (mode == PACKET_FANOUT_LB && busy != NUMBER_OF_WORKERS) {
+            std::cout << "[error] Round-robin distribution fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (const int32_t fd : senders) { close(fd); }
+    close(receiver);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
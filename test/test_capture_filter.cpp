@@ -0,0 +1,228 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_DATAGRAMS   500
+#define TARGET_PORT           47125
+#define OTHER_PORT            47126
+#define PCAP_FILE             "capture_filter_test.pcap"
+#define DEFINITION_FILE       "capture_filter_test.json"
+
+
+// Build Ethernet frame with IPv4 or IPv6 header and transport header.
+static std::vector<std::byte> MakeFrame (bool ipv6, uint8_t protocol, uint16_t source, uint16_t destination, uint16_t fragment = 0)
+{
+    std::vector<std::byte> frame(ipv6 ? 14 + 40 + 8 : 14 + 20 + 8, std::byte(0));
+    const auto put = [&frame] (std::size_t offset, uint16_t value) { frame[offset] = std::byte(value >> 8); frame[offset + 1] = std::byte(value & 0xFF); };
+    put(12, ipv6 ? ETH_P_IPV6 : ETH_P_IP);
+    if (ipv6 == false)
+    {
+        frame[14] = std::byte(0x45);
+        put(20, fragment);
+        frame[23] = std::byte(protocol);
+        // Source 127.0.0.1, destination 10.0.0.1.
+        frame[26] = std::byte(127); frame[29] = std::byte(1);
+        frame[30] = std::byte(10); frame[33] = std::byte(1);
+        put(34, source);
+        put(36, destination);
+    }
+    else
+    {
+        frame[14] = std::byte(0x60);
+        frame[20] = std::byte(protocol);
+        // Source ::1, destination 2001:db8::1.
+        frame[37] = std::byte(1);
+        put(38, 0x2001); put(40, 0x0DB8); frame[53] = std::byte(1);
+        put(54, source);
+        put(56, destination);
+    }
+    return frame;
+}
+
+// Write the frame into pcap file.
+static void WriteFrame (std::ofstream& file, const net::CapturedFrame& frame)
+{
+    const uint32_t header[4] = { static_cast<uint32_t>(frame.time.tv_sec), static_cast<uint32_t>(frame.time.tv_nsec / 1000),
+                                 static_cast<uint32_t>(frame.data.Size()), frame.originalLength };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(frame.data.Data()), static_cast<std::streamsize>(frame.data.Size()));
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    // Interpreter checks the predicates on the constructed frames.
+    net::CaptureFilter filter;
+    if (filter.AddTarget("127.0.0.1", TARGET_PORT, IPPROTO_UDP) == false || filter.AddTarget("::1", 0) == false || filter.Compile() == false) {
+        std::cout << "[error] Compile filter fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::pair<std::vector<std::byte>, bool> cases[] = {
+        { MakeFrame(false, IPPROTO_UDP, 40000, TARGET_PORT), true },
+        { MakeFrame(false, IPPROTO_UDP, TARGET_PORT, 40000), true },
+        { MakeFrame(false, IPPROTO_UDP, 40000, OTHER_PORT), false },
+        { MakeFrame(false, IPPROTO_TCP, 40000, TARGET_PORT), false },
+        { MakeFrame(false, IPPROTO_UDP, 40000, TARGET_PORT, 0x0010), false },
+        { MakeFrame(true, IPPROTO_TCP, 40000, OTHER_PORT), true },
+        { MakeFrame(true, IPPROTO_UDP, 40000, TARGET_PORT), true }
+    };
+    for (std::size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); ++idx)
+    {
+        const auto& [frame, expected] = cases[idx];
+        if ((filter.Run(frame.data(), static_cast<uint32_t>(frame.size())) != 0) != expected) {
+            std::cout << "[error] Interpretation of frame " << idx << " fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    // Truncated frame is rejected as in kernel.
+    if (filter.Run(cases[0].first.data(), 30) != 0) {
+        std::cout << "[error] Interpretation of truncated frame fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    // Filter without targets is not compiled into the program which accepts all frames.
+    net::CaptureFilter empty;
+    if (empty.Compile() == true || empty.GetProgram().empty() == false) {
+        std::cout << "[error] Compile of empty filter fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Program of " << filter.Size() << " targets: " << filter.GetProgram().size() << " instructions." << std::endl;
+
+    // Kernel drops the frames of other port, and the unfiltered ring receives all frames.
+    net::CaptureFilter kernelFilter;
+    (void)kernelFilter.AddTarget("127.0.0.1", TARGET_PORT, IPPROTO_UDP);
+    (void)kernelFilter.Compile();
+    net::PacketCapture filtered(1U << 16, 16, 10), unfiltered(1U << 16, 16, 10);
+    if (filtered.Open("lo", ETH_P_ALL, &kernelFilter) == false || unfiltered.Open("lo") == false) {
+        std::cout << "[error] Open capture with filter fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const int32_t fd = socket(AF_INET, SOCK_DGRAM, 0);
+    const int32_t receivers[2] = { socket(AF_INET, SOCK_DGRAM, 0), socket(AF_INET, SOCK_DGRAM, 0) };
+    struct sockaddr_in addresses[2] = { };
+    for (std::size_t idx = 0; idx < 2; ++idx)
+    {
+        addresses[idx].sin_family = AF_INET;
+        addresses[idx].sin_port = htons((idx == 0) ? TARGET_PORT : OTHER_PORT);
+        addresses[idx].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        (void)bind(receivers[idx], reinterpret_cast<struct sockaddr*>(&addresses[idx]), sizeof(addresses[idx]));
+    }
+    for (std::size_t idx = 0; idx < NUMBER_OF_DATAGRAMS * 2; ++idx) {
+        (void)sendto(fd, "filter", 6, 0, reinterpret_cast<struct sockaddr*>(&addresses[idx % 2]), sizeof(addresses[idx % 2]));
+    }
+
+    std::size_t accepted = 0, rejected = 0, total = 0;
+    net::CapturedFrame frame;
+    while (filtered.NextFrame(frame, 100) == true)
+    {
+        if (kernelFilter.Run(frame.data.Data(), static_cast<uint32_t>(frame.data.Size())) != 0) { accepted++; }
+        else { rejected++; }
+    }
+    std::ofstream file(PCAP_FILE, std::ios_base::binary | std::ios_base::trunc);
+    const uint32_t header[6] = { 0xA1B2C3D4, 0x00040002, 0, 0, 65535, 1 };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    while (unfiltered.NextFrame(frame, 100) == true)
+    {
+        WriteFrame(file, frame);
+        total++;
+    }
+    file.close();
+    close(fd);
+    for (const int32_t receiver : receivers) { close(receiver); }
+
+    std::cout << "Kernel filter: accepted " << accepted << ", wrong " << rejected << " of " << total << " frames." << std::endl;
+    if (accepted != NUMBER_OF_DATAGRAMS * 2 || rejected != 0 || total < NUMBER_OF_DATAGRAMS * 4) {
+        std::cout << "[error] Kernel filter fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Offline replay with the same filter gives the same frames.
+    net::PcapReader reader;
+    std::size_t replayed = 0;
+    if (reader.Open(PCAP_FILE) == false) {
+        std::cout << "[error] Open pcap file fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    while (reader.NextFrame(frame, &kernelFilter) == true) { replayed++; }
+    reader.Close();
+    std::cout << "Offline replay: accepted " << replayed << " frames." << std::endl;
+    if (replayed != accepted) {
+        std::cout << "[error] Offline replay fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Program with offsets of Ethernet frame is not applied to the file with other link type (LINKTYPE_RAW).
+    std::fstream raw(PCAP_FILE, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+    const uint32_t linkType = 101;
+    raw.seekp(20);
+    raw.write(reinterpret_cast<const char*>(&linkType), sizeof(linkType));
+    raw.close();
+    const bool opened = reader.Open(PCAP_FILE);
+    const bool filteredRaw = reader.NextFrame(frame, &kernelFilter);
+    const bool unfilteredRaw = reader.NextFrame(frame);
+    reader.Close();
+    (void)std::remove(PCAP_FILE);
+    if (opened == false || filteredRaw == true || unfilteredRaw == false) {
+        std::cout << "[error] Replay of other link type fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Targets are read from the protocol definition.
+    std::ofstream definition(DEFINITION_FILE, std::ios_base::trunc);
+    definition << R"({ "Protocol": { "NetworkSettings": { "Global": { "Transport": "udp" },
+                   "Target": [ { "Host": "127.0.0.1", "Port": 47125 }, { "Host": "::1", "Port": 53 }, { "Description": "none" } ] } } })";
+    definition.close();
+    net::CaptureFilter loaded;
+    const std::size_t count = loaded.LoadDefinition(DEFINITION_FILE);
+    (void)std::remove(DEFINITION_FILE);
+    if (count != 2 || loaded.Compile() == false || loaded.Run(cases[0].first.data(), static_cast<uint32_t>(cases[0].first.size())) == 0) {
+        std::cout << "[error] Load of protocol definition fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Alternatives of host and transport are separated by '/', and the definition with incorrect target adds nothing.
+    definition.open(DEFINITION_FILE, std::ios_base::trunc);
+    definition << R"({ "Protocol": { "NetworkSettings": { "Global": { "Transport": "tcp/udp" },
+                   "Target": [ { "Host": "127.0.0.1/::1", "Port": 47125 } ] } } })";
+    definition.close();
+    net::CaptureFilter alternatives;
+    const std::size_t number = alternatives.LoadDefinition(DEFINITION_FILE);
+    if (number != 1 || alternatives.Size() != 2 || alternatives.Compile() == false ||
+        alternatives.Run(cases[3].first.data(), static_cast<uint32_t>(cases[3].first.size())) == 0 ||
+        alternatives.Run(cases[6].first.data(), static_cast<uint32_t>(cases[6].first.size())) == 0) {
+        std::cout << "[error] Load of alternatives fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    definition.open(DEFINITION_FILE, std::ios_base::trunc);
+    definition << R"({ "Protocol": { "NetworkSettings": { "Target": [ { "Host": "127.0.0.1", "Port": 53 }, { "Host": "::1", "Port": 70000 } ] } } })";
+    definition.close();
+    net::CaptureFilter incorrect;
+    const std::size_t nothing = incorrect.LoadDefinition(DEFINITION_FILE);
+    (void)std::remove(DEFINITION_FILE);
+    if (nothing != 0 || incorrect.Size() != 0 || incorrect.Compile() == true) {
+        std::cout << "[error] Load of incorrect target fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+#include <vector>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+namespace types = analyzer::framework::common::types;
+using analyzer::framework::common::types::BinaryStructuredDataEngine;
+using analyzer::framework::common::types::BinaryStructuredDataColumns;
+
+
+int32_t main (int32_t size, char** data)
+{
+    // Record: Type (1 byte), Length (2 bytes), Sequence (4 bytes), Timestamp (8 bytes), Reserved (3 bytes).
+    const uint16_t pattern[5] = { 1, 2, 4, 8, 3 };
+    const std::size_t recordsCount = 1000;
+
+    BinaryStructuredDataEngine record;
+    if (record.CreateTemplate(pattern, 5) == false) {
+        std::cout << "[error] CreateTemplate fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    record.SetDataEndianType(types::DATA_BIG_ENDIAN);
+
+    std::vector<std::byte> stream;
+    for (std::size_t idx = 0; idx < recordsCount; ++idx)
+    {
+        record.SetBitField<uint8_t>(0, static_cast<uint8_t>(idx % 7));
+        record.SetBitField<uint16_t>(1, static_cast<uint16_t>(idx * 3));
+        record.SetBitField<uint32_t>(2, static_cast<uint32_t>(0x10000000 + idx));
+        record.SetBitField<uint64_t>(3, 0x0102030405060708ULL + idx);
+        record.SetBitField<uint32_t>(4, static_cast<uint32_t>(idx));
+        stream.insert(stream.end(), record.Data().Data(), record.Data().Data() + record.Data().Size());
+    }
+
+    BinaryStructuredDataColumns columns;
+    if (columns.CreateLayout(record) == false || columns.RecordSize() != 18) {
+        std::cout << "[error] CreateLayout fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (columns.DecodeStream(stream.data(), stream.size() + 5) != recordsCount) {
+        std::cout << "[error] DecodeStream fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto kinds = columns.GetColumn<uint8_t>(0);
+    const auto lengths = columns.GetColumn<uint16_t>(1);
+    const auto sequences = columns.GetColumn<uint32_t>(2);
+    const auto timestamps = columns.GetColumn<uint64_t>(3);
+    const auto reserved = columns.GetColumn<uint32_t>(4);
+    if (kinds == nullptr || lengths == nullptr || sequences == nullptr || timestamps == nullptr || reserved == nullptr ||
+        columns.GetColumn<uint32_t>(1) != nullptr) {
+        std::cout << "[error] GetColumn fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    for (std::size_t idx = 0; idx < recordsCount; ++idx)
+    {
+        if (kinds[idx] != idx % 7 || lengths[idx] != static_cast<uint16_t>(idx * 3) || sequences[idx] != 0x10000000 + idx ||
+            timestamps[idx] != 0x0102030405060708ULL + idx || reserved[idx] != idx) {
+            std::cout << "[error] Column value mismatch in row " << idx << "..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto statistics = columns.GetColumnStatistics(2);
+    std::cout << "Sequence: min " << statistics.minimum << ", max " << statistics.maximum << ", count " << statistics.count << std::endl;
+    if (statistics.minimum != 0x10000000 || statistics.maximum != 0x10000000 + recordsCount - 1 ||
+        columns.CountOutOfRange(0, 0, 3) != 3 * (recordsCount / 7) + 2) {
+        std::cout << "[error] Column analysis fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Separate datagrams with packed bit-pattern (IPv4 header prefix: Version, IHL, DSCP, ECN, Total Length).
+    const uint16_t bit_pattern[5] = { 4, 4, 6, 2, 16 };
+    const std::byte first[4] = { std::byte(0x45), std::byte(0x00), std::byte(0x00), std::byte(0x54) };
+    const std::byte second[5] = { std::byte(0x46), std::byte(0xB9), std::byte(0x05), std::byte(0xDC), std::byte(0xFF) };
+    const std::byte truncated[2] = { std::byte(0x45), std::byte(0x00) };
+    const std::byte* const datagrams[3] = { first, truncated, second };
+    const std::size_t datagramLengths[3] = { sizeof(first), sizeof(truncated), sizeof(second) };
+
+    BinaryStructuredDataColumns headers;
+    if (headers.CreateLayout(bit_pattern, 5, types::PATTERN_BITS) == false || headers.DecodeRecords(datagrams, datagramLengths, 3) != 2) {
+        std::cout << "[error] DecodeRecords fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto ihl = headers.GetColumn<uint8_t>(1);
+    const auto dscp = headers.GetColumn<uint8_t>(2);
+    const auto ecn = headers.GetColumn<uint8_t>(3);
+    const auto total = headers.GetColumn<uint16_t>(4);
+    if (headers.RowsCount() != 3 || headers.IsValidRow(1) == true || ihl[0] != 5 || ihl[2] != 6 ||
+        dscp[2] != 0x2E || ecn[2] != 0x01 || total[0] != 0x54 || total[2] != 0x05DC || total[1] != 0) {
+        std::cout << "[error] Bit-pattern column value mismatch..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
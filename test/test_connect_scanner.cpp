@@ -0,0 +1,102 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::ScanResult;
+using net::ConnectScanner;
+
+
+// Number of ports in each state.
+static std::size_t counters[4] = { };
+
+// Handler that counts the results of scanning.
+static void Handler (const ScanResult& result, void* /*context*/) noexcept
+{
+    counters[result.state]++;
+    if (result.state == net::PORT_OPEN) {
+        std::cout << "Open port: " << result.host << ':' << result.port << " (" << result.latency.count() << " us)" << std::endl;
+    }
+}
+
+// Function that opens the listening socket on loopback and returns its port (or zero if the socket is closed at once).
+static uint16_t OpenPort (const bool listening, int32_t& fd) noexcept
+{
+    fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0 ||
+        (listening == true && listen(fd, 64) != 0)) {
+        close(fd);
+        return 0;
+    }
+    if (listening == false) { close(fd); }
+    return ntohs(address.sin_port);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    // Three listening ports and ten ports which were released at once.
+    std::string ports;
+    int32_t listeners[3] = { };
+    for (int32_t& listener : listeners)
+    {
+        const uint16_t port = OpenPort(true, listener);
+        if (port == 0) {
+            std::cout << "[error] Listener fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        ports.append(std::to_string(port)).push_back(',');
+    }
+    for (std::size_t idx = 0; idx < 10; ++idx)
+    {
+        int32_t fd = INVALID_SOCKET;
+        ports.append(std::to_string(OpenPort(false, fd))).push_back(',');
+    }
+    ports.pop_back();
+
+    ConnectScanner scanner(4, 300, 1000);
+    if (scanner.AddTarget("127.0.0.1", ports) == false) {
+        std::cout << "[error] AddTarget fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t scanned = scanner.Run(Handler);
+    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "Scanned: " << scanned << " ports in " << time.count() << " ms." << std::endl;
+    std::cout << "Open: " << counters[net::PORT_OPEN] << ", closed: " << counters[net::PORT_CLOSED]
+              << ", filtered: " << counters[net::PORT_FILTERED] << ", error: " << counters[net::PORT_ERROR] << std::endl;
+
+    // Thirteen attempts with the rate of 1000 attempts per second take at least 12 ms.
+    if (scanned != 13 || counters[net::PORT_OPEN] != 3 || counters[net::PORT_CLOSED] != 10 || time.count() < 12) {
+        std::cout << "[error] Scanning fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (scanner.InFlight() != 0) {
+        std::cout << "[error] Attempts in flight after scanning..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    for (const int32_t listener : listeners) { close(listener); }
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::ConnectionPool;
+using net::ConnectionLease;
+using net::ConnectionParameters;
+
+
+// Function that answers one request on the server side of connection.
+static bool Exchange (ConnectionLease& lease, const int32_t server) noexcept
+{
+    const char request[] = "request";
+    char buffer[64] = { };
+    if (lease->Send(request, sizeof(request)) == false || recv(server, buffer, sizeof(buffer), 0) != sizeof(request) ||
+        send(server, buffer, sizeof(request), 0) != sizeof(request)) {
+        return false;
+    }
+    return (lease->Recv(buffer, sizeof(buffer), true) == sizeof(request) && std::string(buffer) == request);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    const int32_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cout << "[error] Listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    ConnectionParameters parameters;
+    parameters.host = "127.0.0.1";
+    parameters.port = ntohs(address.sin_port);
+
+    ConnectionPool pool(2, std::chrono::seconds(1));
+    int32_t server = INVALID_SOCKET;
+    {
+        ConnectionLease lease = pool.Acquire(parameters);
+        server = accept(listener, nullptr, nullptr);
+        if (!lease || lease.IsReused() == true || server == INVALID_SOCKET || Exchange(lease, server) == false) {
+            std::cout << "[error] New connection fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The second request uses the same connection without new handshake.
+    {
+        ConnectionLease lease = pool.Acquire(parameters);
+        if (!lease || lease.IsReused() == false || Exchange(lease, server) == false || pool.TotalCount() != 1) {
+            std::cout << "[error] Connection reuse fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Idle connection is acquired by another thread and is observed by the reactor of this thread.
+    bool moved = false;
+    std::thread worker([&pool, &parameters, &moved, server](void) {
+        ConnectionLease lease = pool.Acquire(parameters);
+        moved = (lease && lease.IsReused() == true && net::SocketStatePool::Instance().DescriptorsCount() == 1 &&
+                 Exchange(lease, server) == true);
+    });
+    worker.join();
+    if (moved == false || pool.TotalCount() != 1 || pool.IdleCount() != 1) {
+        std::cout << "[error] Reuse by another thread fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Connection which is closed by external host is replaced by the new one.
+    close(server);
+    {
+        ConnectionLease lease = pool.Acquire(parameters);
+        server = accept(listener, nullptr, nullptr);
+        if (!lease || lease.IsReused() == true || Exchange(lease, server) == false || pool.TotalCount() != 1) {
+            std::cout << "[error] Health check fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        lease.Discard();
+    }
+    close(server);
+    if (pool.TotalCount() != 0 || pool.IdleCount() != 0) {
+        std::cout << "[error] Discard fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The total number of connections is limited.
+    {
+        ConnectionLease first = pool.Acquire(parameters);
+        ConnectionLease second = pool.Acquire(parameters);
+        ConnectionLease third = pool.Acquire(parameters);
+        if (!first || !second || third || pool.TotalCount() != 2) {
+            std::cout << "[error] Limit of connections fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        close(accept(listener, nullptr, nullptr));
+        close(accept(listener, nullptr, nullptr));
+    }
+
+    // Idle connections are closed after the idle time.
+    std::cout << "Idle connections: " << pool.IdleCount() << std::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    if (pool.EvictIdle() != 2 || pool.TotalCount() != 0) {
+        std::cout << "[error] Eviction fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define FILE_SIZE          (8 * 1024 * 1024)
+#define TEST_FILE          "kernel_tls_test.bin"
+#define TEST_MESSAGE       "header"
+#define ANSWER_SIZE        (1024 * 1024)
+
+
+// Create the server context with self-signed certificate and AES-GCM cipher suite.
+static SSL_CTX* CreateServerContext (void)
+{
+    SSL_CTX* ctx = test::CreateServerContext();
+    // Kernel supports AES-GCM records.
+    if (ctx != nullptr) { SSL_CTX_set_cipher_list(ctx, "ECDHE-ECDSA-AES128-GCM-SHA256"); }
+    return ctx;
+}
+
+// Server exchange which receives the message and the content of file, and answers "done" with the data if the content is correct.
+static void ReceiveFile (SSL* ssl)
+{
+    if (SSL_accept(ssl) != 1) { return; }
+
+    std::vector<char> buffer(65536);
+    std::size_t received = 0;
+    bool correct = true;
+    const std::size_t total = sizeof(TEST_MESSAGE) - 1 + FILE_SIZE;
+    while (received < total)
+    {
+        const int32_t result = SSL_read(ssl, buffer.data(), static_cast<int32_t>(std::min(buffer.size(), total - received)));
+        if (result <= 0) { break; }
+        for (int32_t pos = 0; pos < result; ++pos, ++received)
+        {
+            const char expected = (received < sizeof(TEST_MESSAGE) - 1) ? TEST_MESSAGE[received]
+                                                                         : static_cast<char>((received - sizeof(TEST_MESSAGE) + 1) * 7);
+            correct = correct && (buffer[static_cast<std::size_t>(pos)] == expected);
+        }
+    }
+    if (received != total || correct == false || SSL_write(ssl, "done", 4) != 4) { return; }
+
+    // Answer is received by the client through the kernel decryption of records if it is available.
+    for (std::size_t idx = 0; idx < ANSWER_SIZE; ++idx) { buffer[idx % buffer.size()] = static_cast<char>(idx * 3); }
+    for (std::size_t sent = 0; sent < ANSWER_SIZE; sent += buffer.size()) {
+        if (SSL_write(ssl, buffer.data(), static_cast<int32_t>(buffer.size())) <= 0) { return; }
+    }
+}
+
+// Server which checks the received file in each connection.
+static void Serve (SSL_CTX* ctx, int32_t listener, std::size_t count)
+{
+    test::Serve(ctx, listener, count, ReceiveFile);
+}
+
+// Send the message and the file and receive the answer, return the time of exchange in microseconds (negative value - error).
+static int64_t Transfer (uint16_t port, int32_t file, bool offload, bool& kernelSend)
+{
+    net::SocketSSL socket(SSL_METHOD_TLS12);
+    if (offload == true && socket.EnableKernelTLS() == false) { return -1; }
+
+    char buffer[4];
+    std::vector<char> answer(ANSWER_SIZE);
+    const auto start = std::chrono::steady_clock::now();
+    if (socket.Connect("127.0.0.1", port) == false || socket.Send(TEST_MESSAGE, sizeof(TEST_MESSAGE) - 1) == false ||
+        socket.SendFile(file, 0, FILE_SIZE) == false || socket.Recv(buffer, sizeof(buffer)) != sizeof(buffer) || memcmp(buffer, "done", 4) != 0 ||
+        socket.Recv(answer.data(), answer.size()) != static_cast<int32_t>(answer.size())) {
+        return -1;
+    }
+    for (std::size_t idx = 0; idx < answer.size(); ++idx) {
+        if (answer[idx] != static_cast<char>(idx * 3)) { return -1; }
+    }
+    const int64_t time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    kernelSend = socket.IsKernelSendEnabled();
+    socket.Close();
+    return time;
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    std::vector<char> content(FILE_SIZE);
+    for (std::size_t idx = 0; idx < content.size(); ++idx) { content[idx] = static_cast<char>(idx * 7); }
+    const int32_t file = open(TEST_FILE, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (file == -1 || write(file, content.data(), content.size()) != static_cast<ssize_t>(content.size())) {
+        std::cout << "[error] Create test file fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint16_t port = 0;
+    const int32_t listener = test::OpenListener(port, 16);
+    if (listener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SSL_CTX* ctx = CreateServerContext();
+    if (ctx == nullptr) {
+        std::cout << "[error] Create server context fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The same data is sent with user space encryption and with kTLS (or its silent fallback if the kernel module is missing).
+    std::thread server(Serve, ctx, listener, 2);
+    bool plainKernel = true, offloadKernel = false;
+    const int64_t plainTime = Transfer(port, file, false, plainKernel);
+    const int64_t offloadTime = Transfer(port, file, true, offloadKernel);
+    server.join();
+    close(file);
+    (void)std::remove(TEST_FILE);
+
+    if (plainTime < 0 || offloadTime < 0 || plainKernel == true) {
+        std::cout << "[error] Transfer of file fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "User space encryption: " << plainTime << " us, " << (offloadKernel ? "kTLS" : "kTLS is not available, fallback") << ": "
+              << offloadTime << " us." << std::endl;
+
+    SSL_CTX_free(ctx);
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_DATAGRAMS   20000
+#define CAPTURE_TEST_PORT     47123
+#define CAPTURE_TEST_MARKER   "capture-marker"
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    // Small blocks with short retire timeout make the test use the whole ring many times.
+    net::PacketCapture capture(1U << 16, 16, 10);
+    if (capture.Open("lo") == false) {
+        std::cout << "[error] Open capture on loopback interface fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Receiver prevents the ICMP errors which contain the copy of datagram.
+    const int32_t fd = socket(AF_INET, SOCK_DGRAM, 0);
+    const int32_t receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in address = { };
+    address.sin_family = AF_INET;
+    address.sin_port = htons(CAPTURE_TEST_PORT);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd == -1 || receiver == -1 || bind(receiver, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cout << "[error] Open UDP sockets fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::size_t markerLength = sizeof(CAPTURE_TEST_MARKER) - 1;
+    const auto loopback = static_cast<int32_t>(if_nametoindex("lo"));
+    std::size_t sent = 0, captured = 0, frames = 0, incorrect = 0;
+    net::CapturedFrame frame;
+
+    // Frames are read between the bursts of datagrams, so the ring is not overflowed.
+    const auto start = std::chrono::steady_clock::now();
+    while (captured < NUMBER_OF_DATAGRAMS && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+    {
+        for (std::size_t idx = 0; idx < 512 && sent < NUMBER_OF_DATAGRAMS; ++idx, ++sent) {
+            (void)sendto(fd, CAPTURE_TEST_MARKER, markerLength, 0, reinterpret_cast<struct sockaddr*>(&address), sizeof(address));
+        }
+
+        while (captured < sent && capture.NextFrame(frame, 100) == true)
+        {
+            frames++;
+            if (frame.interface != loopback || frame.data.Size() > frame.originalLength || frame.time.tv_sec == 0) { incorrect++; }
+            // Loopback interface shows each datagram as outgoing and as incoming frame.
+            if (frame.type != PACKET_HOST || frame.protocol != ETH_P_IP || frame.data.Size() < ETH_HLEN + 20 + markerLength) { continue; }
+            // Protocol field of IPv4 header.
+            if (frame.data.Data()[ETH_HLEN + 9] != std::byte(IPPROTO_UDP)) { continue; }
+
+            const std::byte* payload = frame.data.Data() + frame.data.Size() - markerLength;
+            if (memcmp(payload, CAPTURE_TEST_MARKER, markerLength) == 0) { captured++; }
+        }
+    }
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    close(receiver);
+    close(fd);
+
+    net::CaptureStatistics statistics;
+    if (capture.GetStatistics(statistics) == false) {
+        std::cout << "[error] Get capture statistics fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Captured datagrams: " << captured << " of " << sent << ", frames: " << frames << ", time: " << duration << " ms." << std::endl;
+    std::cout << "Kernel counters: packets " << statistics.packets << ", drops " << statistics.drops << ", freezes " << statistics.freezes << std::endl;
+    if (captured != NUMBER_OF_DATAGRAMS || incorrect != 0 || statistics.packets < frames) {
+        std::cout << "[error] Capture of datagrams fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Waiting without traffic ends by timeout.
+    capture.Close();
+    if (capture.NextFrame(frame, 10) == true || capture.Open("missing0") == true) {
+        std::cout << "[error] Capture without ring fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+#include <type_traits>
+
+#include "ProtocolDefinition.hpp"  // Generated by StructureGenerator from config/ProtocolDefinition.json.
+
+namespace protocol = analyzer::framework::net::protocols::ProtocolName;
+
+
+int32_t main (int32_t size, char** data)
+{
+    using Round = protocol::request::RoundName1;
+    static_assert(Round::ByteSize == 8, "Unexpected layout of the request round.");
+
+    auto request = Round::Create();
+    if (request == false) {
+        std::cout << "[error] Create fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Value 0 is out of range '1-65535'.
+    if (Round::Validate(request) == true) {
+        std::cout << "[error] Validate fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Composite field 'FieldName2' MUST contain one of the valid strings over all its subfields.
+    Round::SetFieldName1(request, 307);
+    Round::SetFieldName2_2(request, 0xDEADBEEF);
+    if (Round::Validate(request) == true || Round::GetFieldName2_2(request) != 0xDEADBEEF) {
+        std::cout << "[error] Composite field fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Round::SetFieldName2_1(request, 0x7661);      // "va"
+    Round::SetFieldName2_2(request, 0x6C756531);  // "lue1"
+    std::cout << request.ToFormattedString() << std::endl;
+    if (Round::Validate(request) == false || Round::GetFieldName2_2(request) != 0x6C756531) {
+        std::cout << "[error] Accessors fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Field 'FieldName1' is declared as i16 and is stored at the constexpr offset in network byte order.
+    static_assert(std::is_same<decltype(Round::GetFieldName1(request)), int16_t>::value == true, "Unexpected type of the signed field.");
+    const std::byte* const memory = request.Data().Data() + Round::Offsets[Round::FieldName1];
+    if (memory[0] != std::byte(0x01) || memory[1] != std::byte(0x33)) {
+        std::cout << "[error] Layout fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Round::SetFieldName1(request, -2);
+    if (Round::GetFieldName1(request) != -2 || memory[0] != std::byte(0xFF) || memory[1] != std::byte(0xFE) || Round::Validate(request) == true) {
+        std::cout << "[error] Signed field fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    using Response = protocol::response::RoundName3;
+    const std::byte received[2] = { std::byte(0x01), std::byte(0x33) };
+    const auto response = Response::Decode(received, sizeof(received));
+    if (Response::Validate(response) == false || Response::GetFieldName1(response) != 0x0133) {
+        std::cout << "[error] Decode fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+// Function that sends the payload from the server side of connection and closes it for write.
+static void Answer (const int32_t listener, const std::string& payload) noexcept
+{
+    const int32_t server = accept(listener, nullptr, nullptr);
+    for (std::size_t idx = 0; idx < payload.size(); )
+    {
+        const ssize_t result = send(server, payload.data() + idx, payload.size() - idx, 0);
+        if (result <= 0) { break; }
+        idx += static_cast<std::size_t>(result);
+    }
+    shutdown(server, SHUT_WR);
+    char byte = 0;
+    recv(server, &byte, 1, 0);
+    close(server);
+}
+
+// Function that receives the payload to the buffer of socket and checks it.
+static bool Receive (const uint16_t port, const std::string& payload) noexcept
+{
+    net::Socket client;
+    if (client.Connect("127.0.0.1", port) == false || client.RecvToBuffer() != static_cast<int32_t>(payload.size())) { return false; }
+
+    net::ReceiveBuffer& buffer = client.GetReceiveBuffer();
+    struct iovec spans[32] = { };
+    const std::size_t count = buffer.Spans(spans, 32);
+    std::string joined;
+    for (std::size_t idx = 0; idx < count; ++idx) { joined.append(static_cast<const char*>(spans[idx].iov_base), spans[idx].iov_len); }
+    if (joined != payload) { return false; }
+    std::cout << "Received: " << buffer.Size() << " bytes in " << count << " spans." << std::endl;
+
+    // Processed data is released and the rest is moved to the beginning.
+    buffer.Consume(50000);
+    buffer.Compact();
+    std::string rest(buffer.Size(), '\0');
+    if (buffer.Peek(rest.data(), rest.size()) != payload.size() - 50000 || rest != payload.substr(50000) ||
+        buffer.Capacity() != (rest.size() + RECEIVE_CHUNK_SIZE - 1) / RECEIVE_CHUNK_SIZE * RECEIVE_CHUNK_SIZE) {
+        return false;
+    }
+    buffer.Consume(buffer.Size());
+    return (buffer.Empty() == true && buffer.Capacity() == 0);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    const int32_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cout << "[error] Listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string payload(200000, '\0');
+    for (std::size_t idx = 0; idx < payload.size(); ++idx) { payload[idx] = static_cast<char>(idx % 253); }
+
+    // Response which is larger than any fixed buffer is received completely.
+    std::thread first(Answer, listener, std::cref(payload));
+    const bool received = Receive(ntohs(address.sin_port), payload);
+    first.join();
+    if (received == false) {
+        std::cout << "[error] Receive buffer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The second response uses the chunks from the pool without new allocations.
+    const std::size_t allocated = net::ChunkPool::Instance().Allocated();
+    std::thread second(Answer, listener, std::cref(payload));
+    const bool repeated = Receive(ntohs(address.sin_port), payload);
+    second.join();
+    std::cout << "Allocated chunks: " << allocated << ", free chunks: " << net::ChunkPool::Instance().Size() << std::endl;
+    if (repeated == false || net::ChunkPool::Instance().Allocated() != allocated) {
+        std::cout << "[error] Chunk pool fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Response of connection which stays open is finished after the idle gap instead of the timeout of socket.
+    std::thread third([listener] () noexcept {
+        const int32_t server = accept(listener, nullptr, nullptr);
+        (void)send(server, "keep-alive", 10, 0);
+        char byte = 0;
+        (void)recv(server, &byte, 1, 0);
+        close(server);
+    });
+    net::Socket client;
+    const auto start = std::chrono::steady_clock::now();
+    const int32_t idle = (client.Connect("127.0.0.1", ntohs(address.sin_port)) == true) ? client.RecvToBuffer() : -1;
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    client.Close();
+    third.join();
+    std::cout << "Idle gap: " << idle << " bytes in " << duration << " ms." << std::endl;
+    if (idle != 10 || duration >= DEFAULT_TIMEOUT * 1000) {
+        std::cout << "[error] Idle gap fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    close(listener);
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <iostream>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::SocketAddress;
+using net::ResolverCache;
+
+static std::atomic<int32_t> handled(0);
+
+static void ResolvedHandler (const char* /*host*/, const uint16_t port, const int32_t status, void* context) noexcept
+{
+    if (status == RESOLVER_SUCCESS && context != nullptr) { *static_cast<uint16_t*>(context) = port; }
+    handled.fetch_add(1);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    ResolverCache& cache = ResolverCache::Instance();
+    cache.SetTimeToLive(std::chrono::seconds(60), std::chrono::seconds(1));
+
+    // Second resolution of the same host is returned from cache.
+    std::vector<SocketAddress> addresses;
+    if (cache.Find("127.0.0.1", 80, AF_INET, SOCK_STREAM, addresses) != RESOLVER_NOT_CACHED ||
+        cache.Resolve("127.0.0.1", 80, AF_INET, SOCK_STREAM, addresses) != RESOLVER_SUCCESS || addresses.empty() == true ||
+        cache.Find("127.0.0.1", 80, AF_INET, SOCK_STREAM, addresses) != RESOLVER_SUCCESS || cache.Size() != 1) {
+        std::cout << "[error] Positive caching fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto& address = reinterpret_cast<const sockaddr_in&>(addresses.front().storage);
+    if (address.sin_family != AF_INET || ntohs(address.sin_port) != 80 || address.sin_addr.s_addr != htonl(INADDR_LOOPBACK)) {
+        std::cout << "[error] Resolved address fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Error of resolution is cached with the own lifetime.
+    const int32_t status = cache.Resolve("unknown.host.invalid", 80, AF_INET, SOCK_STREAM, addresses);
+    if (status == RESOLVER_SUCCESS || cache.Find("unknown.host.invalid", 80, AF_INET, SOCK_STREAM, addresses) != status) {
+        std::cout << "[error] Negative caching fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Negative result: " << gai_strerror(status) << std::endl;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    if (cache.Find("unknown.host.invalid", 80, AF_INET, SOCK_STREAM, addresses) != RESOLVER_NOT_CACHED) {
+        std::cout << "[error] Negative lifetime fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Asynchronous resolution does not block the calling thread.
+    uint16_t resolvedPort = 0;
+    if (cache.ResolveAsync("localhost", 8080, AF_INET, SOCK_DGRAM, ResolvedHandler, &resolvedPort) == false) {
+        std::cout << "[error] ResolveAsync fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (uint32_t idx = 0; idx < 500 && handled.load() == 0; ++idx) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); }
+    if (resolvedPort != 8080 || cache.Find("localhost", 8080, AF_INET, SOCK_DGRAM, addresses) != RESOLVER_SUCCESS) {
+        std::cout << "[error] Asynchronous resolution fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Targets from the scanner settings are resolved before the first connection.
+    const std::string path = "/tmp/test_resolver_settings.json";
+    std::ofstream settings(path);
+    settings << R"({ "Network": { "Targets": [ { "Host": "127.0.0.1", "Port": 5000, "Transport": "udp" },)"
+             << R"( { "Host": "127.0.0.1", "Port": 5001 }, { "Host": "127.0.0.1", "Port": 5002, "Transport": "tcp/udp" },)"
+             << R"( { "Host": "127.0.0.1", "Port": 70000 } ], "Resolver": { "TimeToLive": 30, "NegativeTimeToLive": 2 } } })";
+    settings.close();
+    if (cache.Prewarm(path) != 3) {
+        std::cout << "[error] Prewarm fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    bool prewarmed = false;
+    for (uint32_t idx = 0; idx < 500 && prewarmed == false; ++idx)
+    {
+        prewarmed = cache.Find("127.0.0.1", 5000, AF_UNSPEC, SOCK_DGRAM, addresses) == RESOLVER_SUCCESS &&
+                    cache.Find("127.0.0.1", 5001, AF_UNSPEC, SOCK_STREAM, addresses) == RESOLVER_SUCCESS &&
+                    cache.Find("127.0.0.1", 5002, AF_UNSPEC, SOCK_STREAM, addresses) == RESOLVER_SUCCESS &&
+                    cache.Find("127.0.0.1", 5002, AF_UNSPEC, SOCK_DGRAM, addresses) == RESOLVER_SUCCESS;
+        if (prewarmed == false) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); }
+    }
+    std::remove(path.c_str());
+    if (prewarmed == false) {
+        std::cout << "[error] Prewarmed targets are not cached..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Entry of unspecified family serves the requests of the selected family without new resolution.
+    if (cache.Find("127.0.0.1", 5002, AF_INET, SOCK_DGRAM, addresses) != RESOLVER_SUCCESS || addresses.size() != 1 ||
+        addresses.front().storage.ss_family != AF_INET || cache.Find("127.0.0.1", 5002, AF_INET6, SOCK_DGRAM, addresses) != RESOLVER_NOT_CACHED ||
+        cache.Find("127.0.0.1", 70000 % 65536, AF_UNSPEC, SOCK_STREAM, addresses) != RESOLVER_NOT_CACHED) {
+        std::cout << "[error] Prewarmed family fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Socket obtains the address of destination from cache.
+    net::Socket receiver(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    net::Socket sender(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    const char message[] = "resolver";
+    char buffer[64] = { };
+    if (receiver.Bind(45457) == false || sender.SendTo("127.0.0.1", 45457, message, sizeof(message)) == false ||
+        receiver.Recv(buffer, sizeof(buffer), true) != sizeof(message) ||
+        cache.Find("127.0.0.1", 45457, AF_INET, SOCK_DGRAM, addresses) != RESOLVER_SUCCESS) {
+        std::cout << "[error] Socket resolution fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Cached entries: " << cache.Size() << std::endl;
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
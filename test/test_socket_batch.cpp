@@ -0,0 +1,105 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::SocketAddress;
+using net::OutgoingDatagram;
+using net::IncomingDatagram;
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::ERROR);
+
+    constexpr uint16_t port = 45455;
+    constexpr std::size_t count = 300;
+    constexpr std::size_t roundSize = 100;
+    constexpr std::size_t datagramSize = 64;
+
+    net::Socket receiver(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    net::Socket sender(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (receiver.Bind(port) == false) {
+        std::cout << "[error] Bind fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Address of the receiver is resolved only once for all datagrams.
+    SocketAddress destination = { };
+    if (sender.ResolveAddress("127.0.0.1", port, destination) == false) {
+        std::cout << "[error] ResolveAddress fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto payload = system::allocMemoryForArray<char>(count * datagramSize);
+    auto output = system::allocMemoryForArray<char>(count * datagramSize);
+    auto outgoing = system::allocMemoryForArray<OutgoingDatagram>(count);
+    auto incoming = system::allocMemoryForArray<IncomingDatagram>(count);
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        memset(payload.get() + idx * datagramSize, static_cast<int32_t>(idx % 251), datagramSize);
+        outgoing[idx].data = payload.get() + idx * datagramSize;
+        outgoing[idx].length = datagramSize;
+        outgoing[idx].destination = &destination;
+        incoming[idx].data = output.get() + idx * datagramSize;
+        incoming[idx].length = datagramSize;
+    }
+
+    // Datagrams are sent in rounds which do not overflow the receive buffer of socket.
+    std::size_t received = 0;
+    for (std::size_t round = 0; round < count; round += roundSize)
+    {
+        if (sender.SendBatch(outgoing.get() + round, roundSize) != static_cast<int32_t>(roundSize)) {
+            std::cout << "[error] SendBatch fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Datagrams which are already available are received without waiting.
+        while (received != round + roundSize)
+        {
+            const int32_t result = receiver.RecvBatch(incoming.get() + received, round + roundSize - received, 1000);
+            if (result <= 0) { break; }
+            received += static_cast<std::size_t>(result);
+        }
+    }
+    std::cout << "Received datagrams: " << received << std::endl;
+    if (received != count || memcmp(payload.get(), output.get(), count * datagramSize) != 0) {
+        std::cout << "[error] RecvBatch fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        if (incoming[idx].received != datagramSize || incoming[idx].truncated == true) {
+            std::cout << "[error] Datagram size fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // There are no more datagrams, so the waiting is finished by timeout.
+    if (receiver.RecvBatch(incoming.get(), 1, 50) != 0) {
+        std::cout << "[error] RecvBatch timeout fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Datagram from the expected host is accepted from any source port.
+    const char message[] = "datagram";
+    char buffer[64] = { };
+    if (sender.SendTo(destination, message, sizeof(message)) == false ||
+        receiver.RecvFrom("127.0.0.1", 0, buffer, sizeof(buffer)) != sizeof(message) || std::string(buffer) != message) {
+        std::cout << "[error] RecvFrom fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Received: " << buffer << std::endl;
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
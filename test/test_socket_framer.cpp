@@ -0,0 +1,103 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    // Delimiter which is split between the parts of data is found.
+    net::DelimiterFramer delimiter("\r\n\r\n");
+    const char parts[][8] = { "HTTP/1.", "1 200\r\n", "A: b\r", "\n\r", "\nbody" };
+    net::FRAME_STATE state = net::FRAME_NEED_MORE;
+    for (const char* part : parts) {
+        if (state == net::FRAME_NEED_MORE) { state = delimiter.Feed(part, strlen(part)); }
+    }
+    if (state != net::FRAME_COMPLETE || delimiter.FrameLength() != 22) {
+        std::cout << "[error] Delimiter framer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const int32_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cout << "[error] Listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::Socket client;
+    const int32_t server = (client.Connect("127.0.0.1", ntohs(address.sin_port)) == true) ? accept(listener, nullptr, nullptr) : INVALID_SOCKET;
+    if (server == INVALID_SOCKET) {
+        std::cout << "[error] Connection fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Response header is received until the delimiter.
+    const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+    send(server, response.data(), response.size(), 0);
+    char buffer[4096] = { };
+    std::size_t obtained = 0;
+    if (client.Recv(buffer, sizeof(buffer), obtained, delimiter) == false || delimiter.FrameLength() != response.size()) {
+        std::cout << "[error] Receiving with delimiter framer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Two length-prefixed frames are sent together, but each receiving obtains exactly one frame.
+    std::string frames;
+    for (const std::size_t body : { 1000, 300 })
+    {
+        frames.push_back(static_cast<char>(body >> 8U));
+        frames.push_back(static_cast<char>(body & 0xFFU));
+        frames.append(body, static_cast<char>('a' + body % 26));
+    }
+    send(server, frames.data(), frames.size(), 0);
+    net::LengthPrefixFramer prefix(2);
+    if (client.Recv(buffer, sizeof(buffer), obtained, prefix) == false || obtained != 1002 || prefix.FrameLength() != 1002 ||
+        client.Recv(buffer, sizeof(buffer), obtained, prefix) == false || obtained != 302 || std::string(buffer + 2, 300) != frames.substr(1004)) {
+        std::cout << "[error] Receiving with length-prefix framer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Type-Length-Value record with little-endian fields.
+    const char record[] = { 0x07, 0x00, 0x05, 0x00, 0x00, 0x00, 'v', 'a', 'l', 'u', 'e' };
+    send(server, record, sizeof(record), 0);
+    net::TlvFramer tlv(2, 4, false);
+    if (client.Recv(buffer, sizeof(buffer), obtained, tlv) == false || obtained != 11 || tlv.GetType() != 7) {
+        std::cout << "[error] Receiving with TLV framer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "TLV type: " << tlv.GetType() << ", value: " << std::string(buffer + 6, 5) << std::endl;
+
+    // Frame which exceeds the limit is rejected.
+    net::LengthPrefixFramer limited(2, true, 0, 0, 16);
+    const char large[] = { 0x01, 0x00 };
+    send(server, large, sizeof(large), 0);
+    if (client.Recv(buffer, sizeof(buffer), obtained, limited) == true || client.GetFd() != INVALID_SOCKET) {
+        std::cout << "[error] Limit of frame fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    close(server);
+    close(listener);
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::SocketAddress;
+using net::IncomingDatagram;
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::ERROR);
+
+    constexpr uint16_t port = 45456;
+    constexpr std::size_t count = 200;
+    constexpr std::size_t segmentSize = 100;
+    constexpr std::size_t buffers = 4;
+
+    net::Socket receiver(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    net::Socket sender(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    SocketAddress destination = { };
+    if (receiver.Bind(port) == false || sender.ResolveAddress("127.0.0.1", port, destination) == false) {
+        std::cout << "[error] Socket initialization fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const bool coalescing = receiver.EnableReceiveCoalescing();
+
+    auto payload = system::allocMemoryForArray<char>(count * segmentSize);
+    auto output = system::allocMemoryForArray<char>(count * segmentSize);
+    auto storage = system::allocMemoryForArray<char>(buffers * MAXIMUM_UDP_PAYLOAD);
+    for (std::size_t idx = 0; idx < count * segmentSize; ++idx) { payload[idx] = static_cast<char>(idx % 251); }
+
+    // Kernel splits each send into equal datagrams (or they are sent by batch if offload is not supported).
+    if (sender.SendSegmented(payload.get(), segmentSize, count, &destination) != static_cast<int32_t>(count)) {
+        std::cout << "[error] SendSegmented fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Segmentation: " << std::boolalpha << sender.IsSegmentationEnabled() << ", coalescing: " << coalescing << std::endl;
+
+    // Coalesced datagram contains the segments in the order of sending.
+    IncomingDatagram incoming[buffers] = { };
+    std::size_t bytes = 0;
+    std::size_t datagrams = 0;
+    while (bytes < count * segmentSize)
+    {
+        for (std::size_t idx = 0; idx < buffers; ++idx)
+        {
+            incoming[idx].data = storage.get() + idx * MAXIMUM_UDP_PAYLOAD;
+            incoming[idx].length = MAXIMUM_UDP_PAYLOAD;
+        }
+
+        const int32_t result = receiver.RecvBatch(incoming, buffers, 1000);
+        if (result <= 0) { break; }
+        for (int32_t idx = 0; idx < result; ++idx)
+        {
+            if (incoming[idx].segment != segmentSize || incoming[idx].truncated == true ||
+                bytes + incoming[idx].received > count * segmentSize) {
+                std::cout << "[error] Segment size fail..." << std::endl;
+                return EXIT_FAILURE;
+            }
+            memcpy(output.get() + bytes, incoming[idx].data, incoming[idx].received);
+            bytes += incoming[idx].received;
+            datagrams++;
+        }
+    }
+
+    std::cout << "Received segments: " << bytes / segmentSize << " in " << datagrams << " datagrams." << std::endl;
+    if (bytes != count * segmentSize || memcmp(payload.get(), output.get(), bytes) != 0) {
+        std::cout << "[error] Receive fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
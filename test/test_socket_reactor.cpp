@@ -0,0 +1,123 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::SocketStatePool;
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    int32_t pair[2] = { };
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) != 0) {
+        std::cout << "[error] socketpair fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SocketStatePool& reactor = SocketStatePool::Instance();
+    if (reactor.RegisterSocket(pair[0], SocketStatePool::TEST_ALWAYS) == false) {
+        std::cout << "[error] RegisterSocket fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Initial edge reports that the socket is writable, but there is no data to read.
+    if ((reactor.WaitForStatus(pair[0], SocketStatePool::STATUS_WRITE, 100) & SocketStatePool::STATUS_WRITE) == 0 ||
+        reactor.WaitForStatus(pair[0], SocketStatePool::STATUS_READ, 50) != 0) {
+        std::cout << "[error] Initial status fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const char message[] = "reactor";
+    if (write(pair[1], message, sizeof(message)) != sizeof(message) ||
+        (reactor.WaitForStatus(pair[0], SocketStatePool::STATUS_READ, 100) & SocketStatePool::STATUS_READ) == 0) {
+        std::cout << "[error] Read status fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Saved status is returned without any system call until it is reset after EAGAIN.
+    char buffer[64] = { };
+    while (read(pair[0], buffer, sizeof(buffer)) > 0) { }
+    reactor.ClearStatus(pair[0], SocketStatePool::STATUS_READ);
+    if ((reactor.CheckSocketStatus(pair[0]) & SocketStatePool::STATUS_READ) != 0) {
+        std::cout << "[error] ClearStatus fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Readiness is delivered to the observer thread while the worker thread drives the reactor.
+    auto observer = reactor.RegisterTask(pair[0], SocketStatePool::TASK_TYPE_READ);
+    if (observer == nullptr) {
+        std::cout << "[error] RegisterTask fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SocketStatePool::SOCKET_STATUS notified = SocketStatePool::STATUS_UNKNOWN;
+    std::thread waiter([observer, &notified] () { observer->WaitFor(notified, std::chrono::seconds(2)); });
+    if (write(pair[1], message, sizeof(message)) != sizeof(message)) {
+        std::cout << "[error] write fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    reactor.Poll(100);
+    waiter.join();
+    std::cout << "Notified status: " << notified << std::endl;
+    if ((notified & SocketStatePool::STATUS_READ) == 0) {
+        std::cout << "[error] Notification fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Other threads do not call epoll_wait on the reactor, but they wait for the descriptor by poll().
+    while (read(pair[0], buffer, sizeof(buffer)) > 0) { }
+    reactor.ClearStatus(pair[0], SocketStatePool::STATUS_READ);
+    int32_t foreignPoll = 0;
+    uint16_t foreignStatus = 0;
+    std::thread foreign([&reactor, &pair, &foreignPoll, &foreignStatus] () {
+        foreignPoll = reactor.Poll(0);
+        foreignStatus = reactor.WaitForStatus(pair[0], SocketStatePool::STATUS_READ, 2000);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (write(pair[1], message, sizeof(message)) != sizeof(message)) {
+        std::cout << "[error] write fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    foreign.join();
+    if (foreignPoll != SOCKET_ERROR || (foreignStatus & SocketStatePool::STATUS_READ) == 0) {
+        std::cout << "[error] Foreign thread fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    reactor.DeleteDescriptor(pair[0]);
+    close(pair[0]);
+    close(pair[1]);
+
+    // Sockets of the same thread share one reactor.
+    const uint32_t before = reactor.DescriptorsCount();
+    net::Socket receiver(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    net::Socket sender(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (reactor.DescriptorsCount() != before + 2 || receiver.Bind(45454) == false) {
+        std::cout << "[error] Socket registration fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (sender.SendTo("127.0.0.1", 45454, message, sizeof(message)) == false ||
+        receiver.Recv(buffer, sizeof(buffer), true) != sizeof(message)) {
+        std::cout << "[error] Loopback exchange fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Received: " << buffer << std::endl;
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+using net::SocketRing;
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::ERROR);
+
+    if (SocketRing::IsSupported() == false)
+    {
+        net::Socket fallback;
+        std::cout << "io_uring is not supported, epoll backend is used." << std::endl;
+        if (fallback.EnableRingBackend() == true || fallback.IsRingBackendEnabled() == true) {
+            std::cout << "[error] Fallback to epoll backend fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Success..." << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    SocketRing* ring = SocketRing::Instance();
+    std::cout << "Multishot receive: " << std::boolalpha << ring->IsMultishotSupported()
+              << ", registered buffers: " << ring->BuffersCount() << std::endl;
+
+    int32_t pair[2] = { };
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) != 0) {
+        std::cout << "[error] socketpair fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const int32_t first = ring->RegisterFile(pair[0]);
+    const int32_t second = ring->RegisterFile(pair[1]);
+    if (first == INVALID_SOCKET || second == INVALID_SOCKET) {
+        std::cout << "[error] RegisterFile fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Linked timeout cancels the receiving if there is no data.
+    char buffer[64] = { };
+    if (ring->Recv(first, buffer, sizeof(buffer), 100) != -ETIMEDOUT) {
+        std::cout << "[error] Linked timeout fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Both operations are submitted by one system call.
+    const char message[] = "io_uring";
+    const uint64_t recvTag = ring->QueueRecv(second, buffer, sizeof(buffer), 1000);
+    const uint64_t sendTag = ring->QueueSend(first, message, sizeof(message), 1000);
+    int32_t received = 0;
+    int32_t sent = 0;
+    if (ring->Submit() != 4 || ring->WaitCompletion(sendTag, sent) == false || ring->WaitCompletion(recvTag, received) == false ||
+        sent != sizeof(message) || received != sizeof(message) || std::string(buffer) != message) {
+        std::cout << "[error] Batched submission fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Results of the operations which are never waited for do not accumulate in the ring.
+    uint64_t firstTag = 0;
+    for (uint32_t batch = 0; batch < 8; ++batch)
+    {
+        uint64_t lastTag = 0;
+        for (uint32_t idx = 0; idx < RING_QUEUE_ENTRIES / 2; ++idx) {
+            lastTag = ring->QueueSend(first, message, 1, 1000);
+        }
+        if (firstTag == 0) { firstTag = lastTag - RING_QUEUE_ENTRIES / 2 + 1; }
+        if (ring->WaitCompletion(lastTag, sent) == false) {
+            std::cout << "[error] Unawaited operations fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        while (recv(pair[1], buffer, sizeof(buffer), 0) > 0) { }
+    }
+    if (ring->WaitCompletion(firstTag, sent) == true || ring->Recv(first, buffer, sizeof(buffer), 100) != -ETIMEDOUT) {
+        std::cout << "[error] Discarding of results fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Kernel reads and writes data directly in the registered buffers.
+    if (ring->BuffersCount() >= 2)
+    {
+        memcpy(ring->GetBuffer(0), message, sizeof(message));
+        const uint64_t readTag = ring->QueueRecvFixed(first, 1, sizeof(message), 1000);
+        const uint64_t writeTag = ring->QueueSendFixed(second, 0, sizeof(message), 1000);
+        if (ring->WaitCompletion(writeTag, sent) == false || ring->WaitCompletion(readTag, received) == false ||
+            received != sizeof(message) || std::string(ring->GetBuffer(1)) != message) {
+            std::cout << "[error] Registered buffers fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    ring->UnregisterFile(first);
+    ring->UnregisterFile(second);
+    close(pair[0]);
+    close(pair[1]);
+
+    // TCP exchange over loopback through the Socket interface.
+    const int32_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 1) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cout << "[error] Listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::Socket client;
+    if (client.EnableRingBackend() == false || client.Connect("127.0.0.1", ntohs(address.sin_port)) == false) {
+        std::cout << "[error] Connect fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const int32_t server = accept(listener, nullptr, nullptr);
+    if (server == INVALID_SOCKET || client.Send(message, sizeof(message)) == false ||
+        recv(server, buffer, sizeof(buffer), 0) != sizeof(message)) {
+        std::cout << "[error] Send fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Receiving is stopped when the buffer is full, but no any data is lost.
+    constexpr std::size_t total = 40000;
+    constexpr std::size_t part = 10000;
+    auto payload = system::allocMemoryForArray<char>(total);
+    auto output = system::allocMemoryForArray<char>(total);
+    for (std::size_t idx = 0; idx < total; ++idx) { payload[idx] = static_cast<char>(idx % 251); }
+    if (send(server, payload.get(), total, 0) != static_cast<ssize_t>(total)) {
+        std::cout << "[error] Server send fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const int32_t head = client.RecvToEnd(output.get(), part);
+    const int32_t rest = client.Recv(output.get() + part, total - part);
+    std::cout << "Received: " << head << " + " << rest << " bytes." << std::endl;
+    if (head != part || rest != total - part || memcmp(payload.get(), output.get(), total) != 0) {
+        std::cout << "[error] Receive fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Closed connection finishes the receiving without waiting.
+    close(server);
+    if (client.RecvToEnd(output.get(), total) != 0) {
+        std::cout << "[error] Receive after close fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "../include/framework/GlobalInfo.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+/**
+ * @class SocketCallbackFunctorBeforeSendImpl   test_socket_sendv.cpp   "test/test_socket_sendv.cpp"
+ * @brief This class-functor converts the data to upper case before sending.
+ */
+class SocketCallbackFunctorBeforeSendImpl final : public callbacks::SocketCallbackFunctorBeforeSend
+{
+public:
+    void operator() (char* data, std::size_t* length) const noexcept final
+    {
+        for (std::size_t idx = 0; idx < *length; ++idx) { data[idx] = static_cast<char>(toupper(data[idx])); }
+    }
+};
+
+
+// Function that receives the required number of bytes on the server side of connection.
+static bool RecvAll (const int32_t server, char* data, const std::size_t length) noexcept
+{
+    std::size_t idx = 0;
+    while (idx != length)
+    {
+        const ssize_t result = recv(server, data + idx, length - idx, 0);
+        if (result <= 0) { return false; }
+        idx += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    const int32_t listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = { };
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cout << "[error] Listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::Socket client;
+    const int32_t server = (client.Connect("127.0.0.1", ntohs(address.sin_port)) == true) ? accept(listener, nullptr, nullptr) : INVALID_SOCKET;
+    if (server == INVALID_SOCKET) {
+        std::cout << "[error] Connection fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Header, body and trailer are sent without joining them.
+    char header[] = "header:", body[] = "body:", trailer[] = "trailer";
+    struct iovec pieces[3] = { { header, sizeof(header) - 1 }, { body, sizeof(body) - 1 }, { trailer, sizeof(trailer) - 1 } };
+    char buffer[64] = { };
+    if (client.SendV(pieces, 3) == false || RecvAll(server, buffer, 19) == false || std::string(buffer) != "header:body:trailer") {
+        std::cout << "[error] SendV fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Received: " << buffer << std::endl;
+
+    // The functor is called for each piece.
+    storage::GI.SetCallback(new SocketCallbackFunctorBeforeSendImpl(), modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP);
+    memset(buffer, 0, sizeof(buffer));
+    const bool converted = (client.SendV(pieces, 3) == true && RecvAll(server, buffer, 19) == true && std::string(buffer) == "HEADER:BODY:TRAILER");
+    storage::GI.SetCallback(nullptr, modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP);
+    if (converted == false) {
+        std::cout << "[error] Callback functor fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Large payload is sent with MSG_ZEROCOPY and its buffers are released after the completion notifications.
+    std::string payload(1 << 20, '\0');
+    for (std::size_t idx = 0; idx < payload.size(); ++idx) { payload[idx] = static_cast<char>(idx % 251); }
+    std::string received(payload.size(), '\0');
+    bool complete = false;
+    std::thread reader([&] () noexcept { complete = RecvAll(server, received.data(), received.size()); });
+
+    const bool zerocopy = client.EnableZeroCopy();
+    struct iovec parts[4] = { };
+    for (std::size_t idx = 0; idx < 4; ++idx) { parts[idx] = { payload.data() + idx * (payload.size() / 4), payload.size() / 4 }; }
+    const bool sent = client.SendV(parts, 4);
+    reader.join();
+    if (sent == false || complete == false || received != payload) {
+        std::cout << "[error] Zero-copy send fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (std::size_t attempt = 0; attempt < 10 && client.ZeroCopyPending() != 0; ++attempt) { client.ReapZeroCopy(100); }
+    std::cout << "Zero-copy: " << std::boolalpha << zerocopy << ", pending sends: " << client.ZeroCopyPending() << std::endl;
+    if (client.ZeroCopyPending() != 0) {
+        std::cout << "[error] Zero-copy completion fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The part of file is sent by sendfile.
+    char name[] = "/tmp/test_socket_sendv_XXXXXX";
+    const int32_t file = mkstemp(name);
+    unlink(name);
+    if (file == INVALID_SOCKET || write(file, payload.data(), 100000) != 100000) {
+        std::cout << "[error] File fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    received.assign(50000, '\0');
+    if (client.SendFile(file, 1000, 50000) == false || RecvAll(server, received.data(), 50000) == false ||
+        received.compare(0, 50000, payload, 1000, 50000) != 0) {
+        std::cout << "[error] SendFile fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // With the functor the file is sent by chunks of the reused buffer, so they are copied to the kernel even in zero-copy mode.
+    std::string expected = payload.substr(0, 100000);
+    for (char& symbol : expected) { symbol = static_cast<char>(toupper(symbol)); }
+    received.assign(expected.size(), '\0');
+    complete = false;
+    reader = std::thread([&] () noexcept { complete = RecvAll(server, received.data(), received.size()); });
+    storage::GI.SetCallback(new SocketCallbackFunctorBeforeSendImpl(), modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP);
+    const bool copied = client.SendFile(file, 0, expected.size());
+    storage::GI.SetCallback(nullptr, modules::MODULE_SOCKET, callbacks::MODULE_SOCKET_BEFORE_SEND_TCP);
+    reader.join();
+    if (copied == false || complete == false || received != expected || client.ZeroCopyPending() != 0 || client.IsZeroCopyEnabled() != zerocopy) {
+        std::cout << "[error] SendFile with callback fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    close(file);
+
+    // Data of pipe is sent by splice.
+    int32_t channel[2] = { };
+    if (pipe(channel) != 0 || write(channel[1], payload.data(), 4096) != 4096) {
+        std::cout << "[error] Pipe fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    received.assign(4096, '\0');
+    if (client.SendFile(channel[0], 0, 4096) == false || RecvAll(server, received.data(), 4096) == false ||
+        received.compare(0, 4096, payload, 0, 4096) != 0) {
+        std::cout << "[error] SendFile from pipe fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    close(channel[0]);
+    close(channel[1]);
+
+    close(server);
+    close(listener);
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+#include <openssl/pem.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_OBJECTS     5000
+#define NUMBER_OF_THREADS     8
+#define TEST_CIPHERS          "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-ECDSA-CHACHA20-POLY1305"
+#define CERTIFICATE_FILE      "ssl_context_cache_test.pem"
+#define DEFINITION_FILE       "ssl_context_cache_test.json"
+
+
+// Server selects the ALPN protocol of client.
+static int32_t SelectProtocol (SSL* /*ssl*/, const unsigned char** out, unsigned char* outLength, const unsigned char* in, unsigned int inLength, void* /*arg*/)
+{
+    static const char protocol[] = "http/1.1";
+    for (unsigned int idx = 0; idx < inLength; idx += in[idx] + 1U)
+    {
+        if (in[idx] == sizeof(protocol) - 1 && memcmp(in + idx + 1, protocol, sizeof(protocol) - 1) == 0) {
+            *out = in + idx + 1;
+            *outLength = in[idx];
+            return SSL_TLSEXT_ERR_OK;
+        }
+    }
+    return SSL_TLSEXT_ERR_NOACK;
+}
+
+// Server which requires the client certificate and answers "pong" to "ping".
+static void Serve (SSL_CTX* ctx, int32_t listener, std::size_t count, std::size_t* certificates)
+{
+    test::Serve(ctx, listener, count, [certificates] (SSL* ssl)
+    {
+        char buffer[4];
+        if (SSL_accept(ssl) == 1 && SSL_read(ssl, buffer, sizeof(buffer)) == sizeof(buffer))
+        {
+            X509* peer = SSL_get1_peer_certificate(ssl);
+            if (peer != nullptr) { (*certificates)++; }
+            X509_free(peer);
+            (void)SSL_write(ssl, "pong", 4);
+        }
+    });
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    // Contexts are shared by the same profile and are different for different profiles.
+    net::SSLContextProfile first, second;
+    first.ciphers = TEST_CIPHERS;
+    second.ciphers = TEST_CIPHERS;
+    second.protocols = std::string("\x08http/1.1", 9);
+    const std::size_t before = net::SSLContextCache::Instance().Size();
+    SSL_CTX* contexts[3] = { net::SSLContextCache::Instance().Acquire(first), net::SSLContextCache::Instance().Acquire(first),
+                             net::SSLContextCache::Instance().Acquire(second) };
+    if (contexts[0] == nullptr || contexts[0] != contexts[1] || contexts[2] == nullptr || contexts[2] == contexts[0] ||
+        net::SSLContextCache::Instance().Size() != before + 2) {
+        std::cout << "[error] Sharing of contexts fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (SSL_CTX* ctx : contexts) { SSL_CTX_free(ctx); }
+
+    // Invalid profiles are not cached.
+    net::SSLContextProfile invalid;
+    invalid.ciphers = "NO-SUCH-CIPHER";
+    net::SSLContextProfile range;
+    range.minimum = SSL_METHOD_TLS13;
+    range.maximum = SSL_METHOD_TLS12;
+    if (net::SSLContextCache::Instance().Acquire(invalid) != nullptr || net::SSLContextCache::Instance().Acquire(range) != nullptr) {
+        std::cout << "[error] Invalid profile is accepted..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Threads get the same context of new profile.
+    net::SSLContextProfile shared;
+    shared.minimum = SSL_METHOD_TLS12;
+    shared.maximum = SSL_METHOD_TLS13;
+    SSL_CTX* results[NUMBER_OF_THREADS] = { };
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0; idx < NUMBER_OF_THREADS; ++idx) {
+        threads.emplace_back([&shared, &results, idx] () { results[idx] = net::SSLContextCache::Instance().Acquire(shared); });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+    for (SSL_CTX* ctx : results)
+    {
+        if (ctx == nullptr || ctx != results[0]) {
+            std::cout << "[error] Concurrent acquisition of context fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        SSL_CTX_free(ctx);
+    }
+
+    // Cipher list is parsed once by the shared context instead of each connection.
+    SSL_CTX* base = net::SSLContextCache::Instance().Acquire(net::SSLContextProfile());
+    SSL_CTX* cached = net::SSLContextCache::Instance().Acquire(first);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < NUMBER_OF_OBJECTS; ++idx)
+    {
+        SSL* ssl = SSL_new(base);
+        (void)SSL_set_cipher_list(ssl, TEST_CIPHERS);
+        SSL_free(ssl);
+    }
+    const auto parsedTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < NUMBER_OF_OBJECTS; ++idx) {
+        SSL_free(SSL_new(cached));
+    }
+    const auto cachedTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    SSL_CTX_free(base);
+    SSL_CTX_free(cached);
+    std::cout << NUMBER_OF_OBJECTS << " SSL objects: " << parsedTime << " us with cipher list per object, " << cachedTime << " us with shared context." << std::endl;
+
+    // Client certificate, ALPN and ciphers are applied by the context of profile.
+    EVP_PKEY* key = nullptr;
+    X509* certificate = nullptr;
+    if (test::CreateCertificate(key, certificate) == false) {
+        std::cout << "[error] Create certificate fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    FILE* file = fopen(CERTIFICATE_FILE, "w");
+    (void)PEM_write_X509(file, certificate);
+    (void)PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr);
+    (void)fclose(file);
+
+    SSL_CTX* server = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_use_certificate(server, certificate);
+    SSL_CTX_use_PrivateKey(server, key);
+    SSL_CTX_set_alpn_select_cb(server, SelectProtocol, nullptr);
+    SSL_CTX_set_verify(server, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, [] (int32_t, X509_STORE_CTX*) { return 1; });
+
+    uint16_t port = 0;
+    const int32_t listener = test::OpenListener(port, 16);
+    if (listener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::SSLContextProfile client = second;
+    client.certificate = CERTIFICATE_FILE;
+    std::size_t certificates = 0;
+    std::thread thread(Serve, server, listener, 2, &certificates);
+    {
+        net::SocketSSL socket(client);
+        char buffer[4];
+        if (socket.Connect("127.0.0.1", port) == false || socket.Send("ping", 4) == false || socket.Recv(buffer, sizeof(buffer)) != sizeof(buffer) ||
+            socket.GetRawSelectedProtocol() != "http/1.1" || socket.GetSelectedCipherName() != "ECDHE-ECDSA-AES128-GCM-SHA256") {
+            std::cout << "[error] Connection with profile fail..." << std::endl;
+            thread.detach();
+            return EXIT_FAILURE;
+        }
+        socket.Close();
+    }
+    // Self-signed certificate of server is rejected by verification.
+    net::SSLContextProfile verified = client;
+    verified.verify = true;
+    {
+        net::SocketSSL socket(verified);
+        if (socket.Connect("127.0.0.1", port) == true) {
+            std::cout << "[error] Verification of server certificate fail..." << std::endl;
+            thread.detach();
+            return EXIT_FAILURE;
+        }
+    }
+    thread.join();
+    (void)std::remove(CERTIFICATE_FILE);
+    if (certificates != 1) {
+        std::cout << "[error] Client certificate is not sent..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Profile is read from the SSL options of protocol definition.
+    std::ofstream definition(DEFINITION_FILE, std::ios_base::trunc);
+    definition << R"({ "Protocol": { "NetworkSettings": { "Global": { "Transport": "tls", "SSLOptions": { "Version": "tls1.2",
+                   "CipherExclusionsByMask": "3DES;RC4", "HashExclusionsByMask": "MD5", "PKIExclusionsByMask": "",
+                   "SSLClientCertificatePath": "/tmp/client.pem" } } } } })";
+    definition.close();
+    net::SSLContextProfile loaded;
+    const bool result = loaded.LoadDefinition(DEFINITION_FILE);
+    (void)std::remove(DEFINITION_FILE);
+    if (result == false || loaded.minimum != SSL_METHOD_TLS12 || loaded.maximum != SSL_METHOD_TLS12 ||
+        loaded.ciphers != "DEFAULT:!3DES:!RC4:!MD5" || loaded.certificate != "/tmp/client.pem") {
+        std::cout << "[error] Load of protocol definition fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SSL_CTX_free(server);
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <thread>
+#include <iostream>
+#include <unistd.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_CONNECTIONS   20
+
+
+// Create the TLS 1.2 server context with self-signed certificate.
+static SSL_CTX* CreateServerContext (void)
+{
+    SSL_CTX* ctx = test::CreateServerContext();
+    if (ctx != nullptr) { SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION); }
+    return ctx;
+}
+
+// Server which answers "pong" to "ping" in each connection.
+static void Serve (SSL_CTX* ctx, int32_t listener, std::size_t count)
+{
+    test::Serve(ctx, listener, count, test::AnswerPong);
+}
+
+// Connect to the server and exchange the messages, return the time of connection in microseconds (negative value - error).
+static int64_t Exchange (uint16_t port, bool& reused)
+{
+    const auto start = std::chrono::steady_clock::now();
+    net::SocketSSL socket(SSL_METHOD_TLS12);
+    char buffer[4];
+    if (socket.Connect("127.0.0.1", port) == false || socket.Send("ping", 4) == false || socket.Recv(buffer, sizeof(buffer)) != sizeof(buffer)) {
+        return -1;
+    }
+    reused = socket.IsSessionReused();
+    socket.Close();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Connect to the server with the selected profile and exchange the messages, return true if the connection is successful.
+static bool ExchangeByProfile (uint16_t port, const net::SSLContextProfile& profile, bool& reused)
+{
+    net::SocketSSL socket(profile);
+    char buffer[4];
+    if (socket.Connect("127.0.0.1", port) == false || socket.Send("ping", 4) == false || socket.Recv(buffer, sizeof(buffer)) != sizeof(buffer)) {
+        return false;
+    }
+    reused = socket.IsSessionReused();
+    socket.Close();
+    return true;
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    uint16_t port = 0;
+    const int32_t listener = test::OpenListener(port, 16);
+    if (listener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SSL_CTX* first = CreateServerContext();
+    SSL_CTX* second = CreateServerContext();
+    if (first == nullptr || second == nullptr) {
+        std::cout << "[error] Create server context fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The first connection performs the full handshake, and others resume its session.
+    std::thread server(Serve, first, listener, NUMBER_OF_CONNECTIONS);
+    int64_t full = 0, resumed = 0;
+    for (std::size_t idx = 0; idx < NUMBER_OF_CONNECTIONS; ++idx)
+    {
+        bool reused = false;
+        const int64_t time = Exchange(port, reused);
+        if (time < 0 || reused != (idx != 0)) {
+            std::cout << "[error] Connection " << idx << " fail (reused: " << reused << ")..." << std::endl;
+            server.detach();
+            return EXIT_FAILURE;
+        }
+        if (idx == 0) { full = time; }
+        else { resumed += time; }
+    }
+    server.join();
+    std::cout << "Full handshake: " << full << " us, average resumed handshake: " << resumed / (NUMBER_OF_CONNECTIONS - 1) << " us." << std::endl;
+
+    net::SSLSessionStatistics statistics = net::SSLSessionCache::Instance().GetStatistics();
+    std::cout << "Hits: " << statistics.hits << ", misses: " << statistics.misses << ", resumed: " << statistics.resumed
+              << ", rejected: " << statistics.rejected << ", stored: " << statistics.stored << std::endl;
+    if (statistics.hits != NUMBER_OF_CONNECTIONS - 1 || statistics.misses != 1 || statistics.resumed != NUMBER_OF_CONNECTIONS - 1 ||
+        statistics.rejected != 0 || net::SSLSessionCache::Instance().Size() != 1) {
+        std::cout << "[error] Counters of session cache fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Restarted server does not know the session, so it is rejected and replaced by the new one.
+    server = std::thread(Serve, second, listener, 2);
+    bool reusedAfterRestart = true, reusedNew = false;
+    const int64_t rejectedTime = Exchange(port, reusedAfterRestart);
+    const int64_t newTime = Exchange(port, reusedNew);
+    server.join();
+    statistics = net::SSLSessionCache::Instance().GetStatistics();
+    if (rejectedTime < 0 || newTime < 0 || reusedAfterRestart == true || reusedNew == false || statistics.rejected != 1) {
+        std::cout << "[error] Rejection of cached session fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Session is offered only to the same server.
+    const std::string key = net::SSLSessionCache::MakeKey("127.0.0.1", port, "127.0.0.1", SSL_METHOD_TLS12);
+    SSL_SESSION* session = net::SSLSessionCache::Instance().Find(key);
+    SSL_SESSION* other = net::SSLSessionCache::Instance().Find(net::SSLSessionCache::MakeKey("127.0.0.1", port + 1, "127.0.0.1", SSL_METHOD_TLS12));
+    if (session == nullptr || other != nullptr) {
+        std::cout << "[error] Keys of session cache fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    SSL_SESSION_free(session);
+    net::SSLSessionCache::Instance().Clear();
+
+    // Session of one profile is not offered by the profile with other ciphers, because the server would reject the handshake.
+    net::SSLContextProfile strong, weak;
+    strong.ciphers = "ECDHE-ECDSA-AES256-GCM-SHA384";
+    weak.ciphers = "ECDHE-ECDSA-AES128-GCM-SHA256";
+    server = std::thread(Serve, first, listener, 3);
+    bool strongReused = true, weakReused = true, strongResumed = false;
+    // All connections are made even after failure, so the server thread is finished.
+    const bool strongConnected = ExchangeByProfile(port, strong, strongReused);
+    const bool weakConnected = ExchangeByProfile(port, weak, weakReused);
+    const bool profiles = (ExchangeByProfile(port, strong, strongResumed) == true && strongConnected == true && weakConnected == true);
+    server.join();
+    if (profiles == false || strongReused == true || weakReused == true || strongResumed == false || net::SSLSessionCache::Instance().Size() != 2) {
+        std::cout << "[error] Sessions of different profiles fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    net::SSLSessionCache::Instance().Clear();
+
+    SSL_CTX_free(first);
+    SSL_CTX_free(second);
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <memory>
+#include <iostream>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_TIMERS   50000
+
+
+// Deadline of one session.
+struct Session
+{
+    net::WheelTimer timer;
+    std::chrono::steady_clock::time_point armed;
+    std::chrono::milliseconds delay;
+    std::size_t* expired;
+    bool early;
+};
+
+// Function that is called when the deadline of session expires.
+static void OnExpire (void* context) noexcept
+{
+    auto* session = static_cast<Session*>(context);
+    (*session->expired)++;
+    session->early = (std::chrono::steady_clock::now() - session->armed < session->delay);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    net::SocketStatePool& reactor = net::SocketStatePool::Instance();
+    net::TimingWheel& wheel = reactor.GetTimingWheel();
+    std::size_t expired = 0;
+
+    // Deadlines from 1 ms to 2 s are spread over all levels of lower part of the wheel.
+    auto sessions = std::make_unique<Session[]>(NUMBER_OF_TIMERS);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < NUMBER_OF_TIMERS; ++idx)
+    {
+        Session& session = sessions[idx];
+        session.delay = std::chrono::milliseconds(1 + (idx * 7919) % 2000);
+        session.armed = std::chrono::steady_clock::now();
+        session.expired = &expired;
+        session.early = false;
+        session.timer.SetHandler(OnExpire, &session);
+        wheel.Arm(session.timer, session.delay);
+    }
+    // Half of sessions is completed before the deadline.
+    for (std::size_t idx = 0; idx < NUMBER_OF_TIMERS; idx += 2) { sessions[idx].timer.Cancel(); }
+    const auto bookkeeping = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Arm and cancel of " << NUMBER_OF_TIMERS << " timers: " << bookkeeping << " us, armed: " << wheel.Size() << std::endl;
+    if (wheel.Size() != NUMBER_OF_TIMERS / 2) {
+        std::cout << "[error] Cancel of timers fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Reactor sleeps until the nearest deadline, so the infinite waiting is interrupted by the timers.
+    std::size_t polls = 0;
+    while (wheel.Size() != 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    {
+        if (reactor.Poll(DEFAULT_TIME_SIGWAIT) == SOCKET_ERROR) {
+            std::cout << "[error] Reactor fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        polls++;
+    }
+
+    std::size_t early = 0, fired = 0;
+    for (std::size_t idx = 0; idx < NUMBER_OF_TIMERS; ++idx) {
+        if (sessions[idx].early == true) { early++; }
+    }
+    fired = expired;
+    std::cout << "Expired timers: " << fired << ", early: " << early << ", reactor wakeups: " << polls << std::endl;
+    if (fired != NUMBER_OF_TIMERS / 2 || early != 0 || polls > 2100) {
+        std::cout << "[error] Expiration of timers fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Deadline beyond the lowest levels is moved down and expires in time.
+    Session last = { net::WheelTimer(OnExpire, &last), std::chrono::steady_clock::now(), std::chrono::milliseconds(300), &expired, false };
+    wheel.Arm(last.timer, last.delay);
+    while (last.timer.IsArmed() == true) { reactor.Poll(DEFAULT_TIME_SIGWAIT); }
+    const auto late = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - last.armed - last.delay).count();
+    std::cout << "Lateness of single timer: " << late << " ms." << std::endl;
+    if (last.early == true || late > 20) {
+        std::cout << "[error] Single timer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Timeout of waiting for the descriptor is armed in the same wheel, so the timers of session expire during the waiting.
+    int32_t pair[2] = { };
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) != 0 || reactor.RegisterSocket(pair[0], net::SocketStatePool::TEST_ALWAYS) == false) {
+        std::cout << "[error] Register socket fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    reactor.ClearStatus(pair[0], net::SocketStatePool::STATUS_WRITE);
+    Session during = { net::WheelTimer(OnExpire, &during), std::chrono::steady_clock::now(), std::chrono::milliseconds(50), &expired, false };
+    wheel.Arm(during.timer, during.delay);
+    const uint16_t status = reactor.WaitForStatus(pair[0], net::SocketStatePool::STATUS_READ, 200);
+    const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - during.armed).count();
+    std::cout << "Waiting for descriptor: " << waited << " ms, armed timers: " << wheel.Size() << std::endl;
+    if (status != 0 || during.timer.IsArmed() == true || waited < 200 || waited > 250 || wheel.Size() != 0) {
+        std::cout << "[error] Timeout of waiting fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Live time of descriptor is the timer of the wheel.
+    if (reactor.RegisterSocket(pair[1], net::SocketStatePool::TEST_ALWAYS, 1) == false || wheel.Size() != 1) {
+        std::cout << "[error] Live time of descriptor fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto registered = std::chrono::steady_clock::now();
+    while ((reactor.CheckSocketStatus(pair[1]) & net::SocketStatePool::STATUS_DELETE) == 0 &&
+           std::chrono::steady_clock::now() - registered < std::chrono::seconds(2)) {
+        reactor.Poll(DEFAULT_TIME_SIGWAIT);
+    }
+    const auto lived = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - registered).count();
+    std::cout << "Live time of descriptor: " << lived << " ms." << std::endl;
+    if (lived < 1000 || lived > 1050 || wheel.Size() != 0) {
+        std::cout << "[error] Expiration of descriptor fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    reactor.DeleteDescriptor(pair[0]);
+    reactor.DeleteDescriptor(pair[1]);
+    close(pair[0]);
+    close(pair[1]);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
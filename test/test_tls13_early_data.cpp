@@ -0,0 +1,140 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <unistd.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_CONNECTIONS   10
+#define MAXIMUM_EARLY_DATA      16384
+
+
+// Number of requests which were received by server as early data.
+static std::atomic<std::size_t> earlyRequests = 0;
+
+
+// Create the TLS 1.3 server context with self-signed certificate.
+static SSL_CTX* CreateServerContext (const uint32_t maxEarlyData)
+{
+    SSL_CTX* ctx = test::CreateServerContext();
+    if (ctx != nullptr)
+    {
+        SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION);
+        SSL_CTX_set_max_early_data(ctx, maxEarlyData);
+    }
+    return ctx;
+}
+
+// Server exchange which answers "pong" to "ping" received as early data or after the handshake.
+static void AnswerEarlyData (SSL* ssl)
+{
+    char buffer[4];
+    std::size_t received = 0, length = 0;
+    int32_t result;
+    while ((result = SSL_read_early_data(ssl, buffer + received, sizeof(buffer) - received, &length)) == SSL_READ_EARLY_DATA_SUCCESS) {
+        received += length;
+    }
+    if (result != SSL_READ_EARLY_DATA_ERROR && SSL_do_handshake(ssl) == 1)
+    {
+        if (received == sizeof(buffer)) { earlyRequests++; }
+        else if (SSL_read(ssl, buffer, sizeof(buffer)) == sizeof(buffer)) { received = sizeof(buffer); }
+        if (received == sizeof(buffer)) { (void)SSL_write(ssl, "pong", 4); }
+    }
+}
+
+// Server which answers "pong" to "ping" in each connection.
+static void Serve (SSL_CTX* ctx, int32_t listener, std::size_t count)
+{
+    test::Serve(ctx, listener, count, AnswerEarlyData);
+}
+
+// Connect to the server with the request in early data, return the time of exchange in microseconds (negative value - error).
+static int64_t Exchange (uint16_t port, bool& reused, bool& accepted)
+{
+    const auto start = std::chrono::steady_clock::now();
+    net::SocketSSL socket(SSL_METHOD_TLS13);
+    char buffer[4];
+    if (socket.ConnectWithEarlyData("127.0.0.1", port, "ping", 4) == false || socket.Recv(buffer, sizeof(buffer)) != sizeof(buffer) ||
+        SSL_version(socket.GetSSL()) != TLS1_3_VERSION) {
+        return -1;
+    }
+    reused = socket.IsSessionReused();
+    accepted = socket.IsEarlyDataAccepted();
+    socket.Close();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    uint16_t port = 0;
+    const int32_t listener = test::OpenListener(port, 16);
+    if (listener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SSL_CTX* first = CreateServerContext(MAXIMUM_EARLY_DATA);
+    SSL_CTX* second = CreateServerContext(0);
+    if (first == nullptr || second == nullptr) {
+        std::cout << "[error] Create server context fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The first connection sends the request after the full handshake, and others send it in the first flight with PSK of ticket.
+    std::thread server(Serve, first, listener, NUMBER_OF_CONNECTIONS);
+    int64_t full = 0, early = 0;
+    for (std::size_t idx = 0; idx < NUMBER_OF_CONNECTIONS; ++idx)
+    {
+        bool reused = false, accepted = false;
+        const int64_t time = Exchange(port, reused, accepted);
+        if (time < 0 || reused != (idx != 0) || accepted != (idx != 0)) {
+            std::cout << "[error] Connection " << idx << " fail (reused: " << reused << ", early data: " << accepted << ")..." << std::endl;
+            server.detach();
+            return EXIT_FAILURE;
+        }
+        if (idx == 0) { full = time; }
+        else { early += time; }
+    }
+    server.join();
+    std::cout << "Full handshake: " << full << " us, average 0-RTT exchange: " << early / (NUMBER_OF_CONNECTIONS - 1) << " us." << std::endl;
+    if (earlyRequests != NUMBER_OF_CONNECTIONS - 1) {
+        std::cout << "[error] Server received " << earlyRequests << " requests in early data..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Restarted server rejects the ticket and early data, so the request is sent again after the handshake.
+    server = std::thread(Serve, second, listener, 2);
+    bool reusedRejected = true, acceptedRejected = true, reusedNew = false, acceptedNew = true;
+    const int64_t rejectedTime = Exchange(port, reusedRejected, acceptedRejected);
+    const int64_t newTime = Exchange(port, reusedNew, acceptedNew);
+    server.join();
+    if (rejectedTime < 0 || reusedRejected == true || acceptedRejected == true || newTime < 0 || reusedNew == false || acceptedNew == true ||
+        earlyRequests != NUMBER_OF_CONNECTIONS - 1) {
+        std::cout << "[error] Rejection of early data fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::SSLSessionCache::Instance().Clear();
+    SSL_CTX_free(first);
+    SSL_CTX_free(second);
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <poll.h>
+#include <thread>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_MESSAGES     1000
+#define RESPONSE_SIZE          100000
+#define NUMBER_OF_CONNECTIONS  2
+
+
+// Move the encrypted output of one engine to the input of other engine.
+static std::size_t Pump (net::TlsEngine& from, net::TlsEngine& to)
+{
+    net::ReceiveBuffer& output = from.GetOutput();
+    const std::size_t size = output.Size();
+    return (to.Feed(output) == true) ? size : 0;
+}
+
+// Wait until the socket becomes readable.
+static bool WaitForRecv (const net::Socket& socket)
+{
+    struct pollfd descriptor = { socket.GetFd(), POLLIN, 0 };
+    return (poll(&descriptor, 1, 3000) == 1);
+}
+
+// Exchange the messages with the server over the plain socket, return true if session is resumed.
+static bool Exchange (uint16_t port, bool& reused)
+{
+    net::Socket socket;
+    net::TlsEngine engine(SSL_METHOD_TLS12);
+    if (socket.Connect("127.0.0.1", port) == false || engine.SetServerNameIndication("localhost") == false) { return false; }
+    (void)engine.ResumeSession("127.0.0.1", port);
+
+    int32_t status;
+    while ((status = engine.Handshake()) == SOCKET_WANT_READ)
+    {
+        if (engine.Transmit(socket) < 0 || WaitForRecv(socket) == false || engine.Receive(socket) <= 0) { return false; }
+    }
+    if (status != SOCKET_SUCCESS || engine.Write("ping", 4) != 4 || engine.Transmit(socket) < 0) { return false; }
+
+    net::ReceiveBuffer response;
+    while (response.Size() < 4)
+    {
+        if (engine.Read(response) == SOCKET_ERROR) { return false; }
+        if (response.Size() < 4 && (WaitForRecv(socket) == false || engine.Receive(socket) <= 0)) { return false; }
+    }
+    char buffer[4];
+    if (response.Peek(buffer, sizeof(buffer)) != 4 || memcmp(buffer, "pong", 4) != 0) { return false; }
+
+    reused = engine.IsSessionReused();
+    (void)engine.Shutdown();
+    (void)engine.Transmit(socket);
+    socket.Close();
+    return true;
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+
+    SSL_CTX* ctx = test::CreateServerContext();
+    if (ctx == nullptr) {
+        std::cout << "[error] Create server context fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Client and server engines are driven in the same thread without sockets.
+    {
+        net::TlsEngine client(SSL_METHOD_TLS13), server(ctx, true);
+        std::size_t flights = 0;
+        int32_t clientStatus = SOCKET_WANT_READ, serverStatus = SOCKET_WANT_READ;
+        while ((clientStatus != SOCKET_SUCCESS || serverStatus != SOCKET_SUCCESS) && flights < 10)
+        {
+            clientStatus = client.Handshake();
+            flights += (Pump(client, server) != 0) ? 1 : 0;
+            serverStatus = server.Handshake();
+            flights += (Pump(server, client) != 0) ? 1 : 0;
+        }
+        if (clientStatus != SOCKET_SUCCESS || serverStatus != SOCKET_SUCCESS || SSL_version(client.GetSSL()) != TLS1_3_VERSION) {
+            std::cout << "[error] In-process handshake fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "In-process handshake: " << flights << " flights." << std::endl;
+
+        // All records are accumulated in the output buffer and are transmitted together.
+        std::string expected;
+        for (std::size_t idx = 0; idx < NUMBER_OF_MESSAGES; ++idx)
+        {
+            const std::string message = "message-" + std::to_string(idx) + ';';
+            if (client.Write(message.data(), message.size()) != static_cast<int32_t>(message.size())) {
+                std::cout << "[error] Encryption of message fail..." << std::endl;
+                return EXIT_FAILURE;
+            }
+            expected += message;
+        }
+        struct iovec spans[64];
+        const std::size_t count = client.GetOutput().Spans(spans, 64);
+        std::cout << "Batch of " << NUMBER_OF_MESSAGES << " records: " << client.PendingOutput() << " encrypted bytes in " << count << " spans." << std::endl;
+        (void)Pump(client, server);
+
+        net::ReceiveBuffer received;
+        if (server.Read(received) != SOCKET_WANT_READ || received.Size() != expected.size()) {
+            std::cout << "[error] Decryption of batch fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::string text(received.Size(), '\0');
+        (void)received.Peek(text.data(), text.size());
+        if (text != expected || client.PendingOutput() != 0) {
+            std::cout << "[error] Content of batch fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Large response is split into several records.
+        const std::string response(RESPONSE_SIZE, 'r');
+        received.Clear();
+        if (server.Write(response.data(), response.size()) != RESPONSE_SIZE || Pump(server, client) <= RESPONSE_SIZE ||
+            client.Read(received) != SOCKET_WANT_READ || received.Size() != RESPONSE_SIZE) {
+            std::cout << "[error] Large response fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Alert close_notify is delivered as the end of data.
+        char buffer[16];
+        if (client.Shutdown() == false || Pump(client, server) == 0 || server.Read(buffer, sizeof(buffer)) != 0) {
+            std::cout << "[error] Shutdown of engine fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Engine is driven by non-blocking socket, and the session is shared through SSLSessionCache.
+    uint16_t port = 0;
+    const int32_t listener = test::OpenListener(port, 16);
+    if (listener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::thread server([ctx, listener] () { test::Serve(ctx, listener, NUMBER_OF_CONNECTIONS, test::AnswerPong); });
+    for (std::size_t idx = 0; idx < NUMBER_OF_CONNECTIONS; ++idx)
+    {
+        bool reused = false;
+        if (Exchange(port, reused) == false || reused != (idx != 0)) {
+            std::cout << "[error] Exchange over socket " << idx << " fail (reused: " << reused << ")..." << std::endl;
+            server.detach();
+            return EXIT_FAILURE;
+        }
+    }
+    server.join();
+    std::cout << "Exchanges over socket: " << NUMBER_OF_CONNECTIONS << ", resumed: " << net::SSLSessionCache::Instance().GetStatistics().resumed << std::endl;
+
+    net::SSLSessionCache::Instance().Clear();
+    SSL_CTX_free(ctx);
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <set>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <unistd.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+// Cipher suites of server.
+static const char* LEGACY_CIPHERS = "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-ECDSA-CHACHA20-POLY1305";
+static const char* MODERN_CIPHERS = "TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256";
+
+
+// Create the server context with self-signed certificate and restricted cipher suites.
+static SSL_CTX* CreateServerContext (void)
+{
+    SSL_CTX* ctx = test::CreateServerContext();
+    if (ctx != nullptr)
+    {
+        SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+        SSL_CTX_set_cipher_list(ctx, LEGACY_CIPHERS);
+        SSL_CTX_set_ciphersuites(ctx, MODERN_CIPHERS);
+    }
+    return ctx;
+}
+
+// Server selects h2 protocol of client.
+static int32_t SelectProtocol (SSL* /*ssl*/, const unsigned char** out, unsigned char* outLength, const unsigned char* in, unsigned int inLength, void* /*arg*/)
+{
+    for (unsigned int idx = 0; idx < inLength; idx += in[idx] + 1U)
+    {
+        if (std::string_view(reinterpret_cast<const char*>(in + idx + 1), in[idx]) == "h2") {
+            *out = in + idx + 1;
+            *outLength = in[idx];
+            return SSL_TLSEXT_ERR_OK;
+        }
+    }
+    return SSL_TLSEXT_ERR_NOACK;
+}
+
+// Server which answers ClientHello of each connection until it is stopped.
+static void Serve (SSL_CTX* ctx, int32_t listener, const std::atomic<bool>* stopped)
+{
+    while (stopped->load() == false)
+    {
+        struct pollfd descriptor = { listener, POLLIN, 0 };
+        if (poll(&descriptor, 1, 100) != 1) { continue; }
+
+        const int32_t fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) { continue; }
+        SSL* ssl = SSL_new(ctx);
+        SSL_set_fd(ssl, fd);
+        // Handshake is failed, because the prober resets the connection after the answer.
+        (void)SSL_accept(ssl);
+        SSL_free(ssl);
+        close(fd);
+    }
+}
+
+// Answer crafted ClientHello by the server engine over memory BIO.
+static std::string AnswerClientHello (SSL_CTX* ctx, const common::types::BinaryStructuredDataEngine& hello)
+{
+    SSL* ssl = SSL_new(ctx);
+    BIO* input = BIO_new(BIO_s_mem());
+    BIO* output = BIO_new(BIO_s_mem());
+    SSL_set_bio(ssl, input, output);
+    SSL_set_accept_state(ssl);
+
+    (void)BIO_write(input, hello.Data().Data(), static_cast<int32_t>(hello.ByteSize()));
+    (void)SSL_do_handshake(ssl);
+
+    char* data = nullptr;
+    const long length = BIO_get_mem_data(output, &data);
+    std::string answer(data, static_cast<std::size_t>(length));
+    SSL_free(ssl);
+    return answer;
+}
+
+// Handler saves the accepted cipher suites and the final state of each host and version.
+static void SaveResult (const net::HelloProbeResult& result, void* context) noexcept
+{
+    auto& results = *static_cast<std::map<std::string, std::pair<std::set<std::string>, std::vector<net::HELLO_STATE>>>*>(context);
+    const std::string key = std::string(result.host) + ':' + std::to_string(result.port) + '/' + std::to_string(result.version);
+    auto& [ ciphers, states ] = results[key];
+    if (result.state == net::HELLO_ACCEPTED) {
+        ciphers.emplace(std::string(result.name) + '/' + std::string(result.selected));
+    }
+    states.push_back(result.state);
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+    // Prober resets the connections after the answer of server.
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    SSL_CTX* ctx = CreateServerContext();
+    if (ctx == nullptr) {
+        std::cout << "[error] Create server context fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    SSL_CTX_set_alpn_select_cb(ctx, SelectProtocol, nullptr);
+
+    // Crafted ClientHello is answered by ServerHello of TLS 1.2 and by HelloRetryRequest of TLS 1.3.
+    net::ClientHelloOptions options;
+    options.serverName = "localhost";
+    options.protocols = { "spdy/3", "h2" };
+    options.ciphers = net::TlsHelloProber::GetKnownCiphers(SSL_METHOD_TLS12);
+    common::types::BinaryStructuredDataEngine hello;
+    net::ServerHelloInfo info;
+    if (net::TlsHelloProber::CreateClientHello(options, hello) == false) {
+        std::cout << "[error] Create TLS 1.2 ClientHello fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    // Fragment of the first record is incomplete.
+    std::string answer = AnswerClientHello(ctx, hello);
+    if (net::TlsHelloProber::ParseServerHello(answer.data(), 64, info) != net::ANSWER_INCOMPLETE ||
+        net::TlsHelloProber::ParseServerHello(answer.data(), answer.size(), info) != net::ANSWER_HELLO ||
+        info.version != 0x0303 || info.retry == true || info.protocol != "h2" ||
+        std::string(LEGACY_CIPHERS).find(net::TlsHelloProber::GetCipherName(info.cipher)) == std::string::npos) {
+        std::cout << "[error] Parse TLS 1.2 ServerHello fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    options.version = SSL_METHOD_TLS13;
+    options.ciphers = net::TlsHelloProber::GetKnownCiphers(SSL_METHOD_TLS13);
+    if (net::TlsHelloProber::CreateClientHello(options, hello) == false) {
+        std::cout << "[error] Create TLS 1.3 ClientHello fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    answer = AnswerClientHello(ctx, hello);
+    if (net::TlsHelloProber::ParseServerHello(answer.data(), answer.size(), info) != net::ANSWER_HELLO ||
+        info.version != 0x0304 || info.retry == false ||
+        std::string(MODERN_CIPHERS).find(net::TlsHelloProber::GetCipherName(info.cipher)) == std::string::npos) {
+        std::cout << "[error] Parse TLS 1.3 HelloRetryRequest fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    // Answer which is not TLS record is malformed.
+    if (net::TlsHelloProber::ParseServerHello("HTTP/1.1 400 Bad Request\r\n", 26, info) != net::ANSWER_MALFORMED) {
+        std::cout << "[error] Parse malformed answer fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint16_t port = 0, closedPort = 0;
+    const int32_t listener = test::OpenListener(port);
+    // Port of closed listener refuses connections.
+    const int32_t closedListener = test::OpenListener(closedPort);
+    close(closedListener);
+    if (listener < 0 || closedListener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::TlsHelloProber prober(16, 3000);
+    if (prober.AddVersion(SSL_METHOD_TLS11) == false || prober.AddVersion(SSL_METHOD_TLS12) == false ||
+        prober.AddVersion(SSL_METHOD_TLS13) == false || prober.AddProtocol("h2") == false ||
+        prober.AddVersion(NUMBER_OF_CTX) == true || prober.AddProtocol("") == true) {
+        std::cout << "[error] Configuration of prober fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (prober.AddTarget("localhost", port) == false || prober.AddTarget("127.0.0.1", closedPort) == false) {
+        std::cout << "[error] Add target fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::atomic<bool> stopped = false;
+    std::thread server(Serve, ctx, listener, &stopped);
+    std::map<std::string, std::pair<std::set<std::string>, std::vector<net::HELLO_STATE>>> results;
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t count = prober.Run(SaveResult, &results);
+    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    stopped.store(true);
+    server.join();
+
+    // Server: one rejected TLS 1.1 probe, three accepted TLS 1.2 suites and two accepted TLS 1.3 suites with the final rejections.
+    // Closed port: one unreachable probe and two skipped versions.
+    if (count != 11 || prober.InFlight() != 0) {
+        std::cout << "[error] Number of probes fail: " << count << "..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << count << " probes of 2 targets: " << time << " ms." << std::endl;
+
+    const std::string prefix = "localhost:" + std::to_string(port) + '/';
+    const auto& [ legacyCiphers, legacyStates ] = results[prefix + std::to_string(SSL_METHOD_TLS12)];
+    const auto& [ modernCiphers, modernStates ] = results[prefix + std::to_string(SSL_METHOD_TLS13)];
+    const auto& [ oldCiphers, oldStates ] = results[prefix + std::to_string(SSL_METHOD_TLS11)];
+    const std::set<std::string> expectedLegacy = { "ECDHE-ECDSA-AES128-GCM-SHA256/h2", "ECDHE-ECDSA-AES256-GCM-SHA384/h2", "ECDHE-ECDSA-CHACHA20-POLY1305/h2" };
+    // Selected protocol of TLS 1.3 is encrypted.
+    const std::set<std::string> expectedModern = { "TLS_AES_256_GCM_SHA384/", "TLS_CHACHA20_POLY1305_SHA256/" };
+    if (legacyCiphers != expectedLegacy || legacyStates.size() != 4 || legacyStates.back() != net::HELLO_REJECTED ||
+        modernCiphers != expectedModern || modernStates.size() != 3 || modernStates.back() != net::HELLO_REJECTED ||
+        oldCiphers.empty() == false || oldStates != std::vector<net::HELLO_STATE>{ net::HELLO_REJECTED }) {
+        std::cout << "[error] Enumeration of cipher suites fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Only the first probe of unreachable host is started.
+    std::size_t unreachable = 0, skipped = 0;
+    const std::string closedPrefix = "127.0.0.1:" + std::to_string(closedPort) + '/';
+    for (const auto& [ key, result ] : results)
+    {
+        if (key.compare(0, closedPrefix.size(), closedPrefix) != 0) { continue; }
+        for (const net::HELLO_STATE state : result.second)
+        {
+            unreachable += (state == net::HELLO_UNREACHABLE) ? 1 : 0;
+            skipped += (state == net::HELLO_SKIPPED) ? 1 : 0;
+        }
+    }
+    if (unreachable != 1 || skipped != 2) {
+        std::cout << "[error] Probes of unreachable host fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SSL_CTX_free(ctx);
+    close(listener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}
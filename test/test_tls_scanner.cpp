@@ -0,0 +1,160 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// ============================================================================
+// Copyright (c) 2017-2018, by Vitaly Grigoriev, <Vit.link420@gmail.com>.
+// This file is part of ProtocolAnalyzer open source project under MIT License.
+// ============================================================================
+
+#include <map>
+#include <thread>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+#include "TlsTestServer.hpp"
+#include "../include/framework/AnalyzerApi.hpp"
+
+using namespace analyzer::framework;
+
+
+#define NUMBER_OF_PROBES    6  // Two versions and three ALPN protocols.
+
+
+// Server selects h2 or http/1.1 protocol of client.
+static int32_t SelectProtocol (SSL* /*ssl*/, const unsigned char** out, unsigned char* outLength, const unsigned char* in, unsigned int inLength, void* /*arg*/)
+{
+    for (unsigned int idx = 0; idx < inLength; idx += in[idx] + 1U)
+    {
+        const std::string_view protocol(reinterpret_cast<const char*>(in + idx + 1), in[idx]);
+        if (protocol == "h2" || protocol == "http/1.1") {
+            *out = in + idx + 1;
+            *outLength = in[idx];
+            return SSL_TLSEXT_ERR_OK;
+        }
+    }
+    return SSL_TLSEXT_ERR_NOACK;
+}
+
+// Server which accepts the handshakes of the selected number of connections.
+static void Serve (SSL_CTX* ctx, int32_t listener, std::size_t count)
+{
+    test::Serve(ctx, listener, count, test::AcceptHandshake);
+}
+
+// Handler saves the results of probes by host, version and protocol.
+static void SaveResult (const net::TlsProbeResult& result, void* context) noexcept
+{
+    auto& results = *static_cast<std::map<std::string, std::pair<net::PROBE_STATE, std::string>>*>(context);
+    const std::string key = std::string(result.host) + ':' + std::to_string(result.port) + '/' + std::to_string(result.version) + '/' + std::string(result.protocol);
+    results[key] = { result.state, std::string(result.selected) };
+}
+
+
+int32_t main (int32_t size, char** data)
+{
+    log::Logger::Instance().SwitchLoggingEngine();
+    log::Logger::Instance().SetLogLevel(log::LEVEL::FATAL);
+    // Scanner resets the connections after handshake.
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    // Modern server supports TLS 1.2, TLS 1.3 and selects ALPN protocol, legacy server supports only TLS 1.2 without ALPN.
+    SSL_CTX* modern = test::CreateServerContext();
+    SSL_CTX* legacy = test::CreateServerContext();
+    if (modern == nullptr || legacy == nullptr) {
+        std::cout << "[error] Create server context fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    SSL_CTX_set_alpn_select_cb(modern, SelectProtocol, nullptr);
+    SSL_CTX_set_max_proto_version(legacy, TLS1_2_VERSION);
+
+    uint16_t modernPort = 0, legacyPort = 0, closedPort = 0;
+    const int32_t modernListener = test::OpenListener(modernPort);
+    const int32_t legacyListener = test::OpenListener(legacyPort);
+    // Port of closed listener refuses connections.
+    const int32_t closedListener = test::OpenListener(closedPort);
+    close(closedListener);
+    if (modernListener < 0 || legacyListener < 0 || closedListener < 0) {
+        std::cout << "[error] Open listener fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    net::TlsScanner scanner(16, 3000);
+    if (scanner.AddVersion(SSL_METHOD_TLS12) == false || scanner.AddVersion(SSL_METHOD_TLS13) == false ||
+        scanner.AddProtocol("h2") == false || scanner.AddProtocol("http/1.1") == false || scanner.AddProtocol("spdy/3") == false ||
+        scanner.AddVersion(NUMBER_OF_CTX) == true || scanner.AddProtocol("") == true) {
+        std::cout << "[error] Configuration of scanner fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    // The same server is added by address and by name (with SNI extension).
+    if (scanner.AddTarget("127.0.0.1", modernPort) == false || scanner.AddTarget("localhost", modernPort) == false ||
+        scanner.AddTarget("127.0.0.1", legacyPort) == false || scanner.AddTarget("127.0.0.1", closedPort) == false) {
+        std::cout << "[error] Add target fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::thread modernServer(Serve, modern, modernListener, 2 * NUMBER_OF_PROBES);
+    std::thread legacyServer(Serve, legacy, legacyListener, NUMBER_OF_PROBES);
+    std::map<std::string, std::pair<net::PROBE_STATE, std::string>> results;
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t count = scanner.Run(SaveResult, &results);
+    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    modernServer.join();
+    legacyServer.join();
+
+    if (count != 4 * NUMBER_OF_PROBES || results.size() != count || scanner.InFlight() != 0) {
+        std::cout << "[error] Number of probes fail: " << count << "..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << count << " probes of 4 targets: " << time << " ms." << std::endl;
+
+    const std::string versions[2] = { std::to_string(SSL_METHOD_TLS12), std::to_string(SSL_METHOD_TLS13) };
+    for (const std::string host : { "127.0.0.1", "localhost" })
+    {
+        // Modern server selects h2 and http/1.1 and ignores unknown protocol.
+        const std::string prefix = host + std::string(":") + std::to_string(modernPort) + '/';
+        for (const std::string& version : versions)
+        {
+            if (results[prefix + version + "/h2"] != std::make_pair(net::PROBE_SUPPORTED, std::string("h2")) ||
+                results[prefix + version + "/http/1.1"] != std::make_pair(net::PROBE_SUPPORTED, std::string("http/1.1")) ||
+                results[prefix + version + "/spdy/3"] != std::make_pair(net::PROBE_SUPPORTED, std::string())) {
+                std::cout << "[error] Probes of modern server fail..." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    // Legacy server rejects TLS 1.3.
+    const std::string legacyPrefix = "127.0.0.1:" + std::to_string(legacyPort) + '/';
+    for (const char* protocol : { "/h2", "/http/1.1", "/spdy/3" })
+    {
+        if (results[legacyPrefix + versions[0] + protocol] != std::make_pair(net::PROBE_SUPPORTED, std::string()) ||
+            results[legacyPrefix + versions[1] + protocol].first != net::PROBE_REJECTED) {
+            std::cout << "[error] Probes of legacy server fail..." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Only the first probe of unreachable host is started.
+    std::size_t unreachable = 0, skipped = 0;
+    const std::string closedPrefix = "127.0.0.1:" + std::to_string(closedPort) + '/';
+    for (const auto& [ key, result ] : results)
+    {
+        if (key.compare(0, closedPrefix.size(), closedPrefix) != 0) { continue; }
+        unreachable += (result.first == net::PROBE_UNREACHABLE) ? 1 : 0;
+        skipped += (result.first == net::PROBE_SKIPPED) ? 1 : 0;
+    }
+    if (unreachable != 1 || skipped != NUMBER_OF_PROBES - 1) {
+        std::cout << "[error] Probes of unreachable host fail..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SSL_CTX_free(modern);
+    SSL_CTX_free(legacy);
+    close(modernListener);
+    close(legacyListener);
+
+    std::cout << "Success..." << std::endl;
+    return EXIT_SUCCESS;
+}